@@ -0,0 +1,127 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../engine/culling/culling_kernels.h"
+#include "../engine/culling/frustum_culler.h"
+
+// SoA + SIMD 커널과 glm 기반 AoS scalar 구현의 컬링 시간 비교
+namespace {
+    constexpr uint32_t OBJECT_COUNT = 1 << 20;
+    constexpr uint32_t ITERATION_COUNT = 50;
+
+    struct SphereObject {
+        glm::vec3 center;
+        float radius;
+    };
+
+    struct AabbObject {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    uint32_t cullSpheresGlm(const Frustum& frustum, const std::vector<SphereObject>& objects, uint32_t* output) {
+        uint32_t count = 0;
+
+        for (uint32_t index = 0; index < objects.size(); index++) {
+            const SphereObject& object = objects[index];
+            bool isVisible = true;
+
+            for (const glm::vec4& plane : frustum.planes) {
+                if (glm::dot(glm::vec3(plane), object.center) + plane.w < -object.radius) {
+                    isVisible = false;
+                    break;
+                }
+            }
+            if (isVisible) {
+                output[count++] = index;
+            }
+        }
+        return count;
+    }
+
+    uint32_t cullAabbsGlm(const Frustum& frustum, const std::vector<AabbObject>& objects, uint32_t* output) {
+        uint32_t count = 0;
+
+        for (uint32_t index = 0; index < objects.size(); index++) {
+            const AabbObject& object = objects[index];
+            bool isVisible = true;
+
+            for (const glm::vec4& plane : frustum.planes) {
+                const glm::vec3 positive {
+                    plane.x >= 0.0f ? object.max.x : object.min.x,
+                    plane.y >= 0.0f ? object.max.y : object.min.y,
+                    plane.z >= 0.0f ? object.max.z : object.min.z,
+                };
+                if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) {
+                    isVisible = false;
+                    break;
+                }
+            }
+            if (isVisible) {
+                output[count++] = index;
+            }
+        }
+        return count;
+    }
+
+    template<typename Function>
+    void measure(const char* name, Function&& function) {
+        uint32_t visibleCount = function();
+        const auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t iteration = 0; iteration < ITERATION_COUNT; iteration++) {
+            visibleCount = function();
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        const double milliseconds = elapsed.count() / ITERATION_COUNT;
+
+        std::cout << name << ": " << milliseconds << " ms, "
+                  << OBJECT_COUNT / milliseconds / 1000.0 << " M objects/s, visible " << visibleCount << std::endl;
+    }
+}
+
+int main() {
+    std::mt19937 random(1234);
+    std::uniform_real_distribution position(-500.0f, 500.0f);
+    std::uniform_real_distribution extent(0.5f, 5.0f);
+
+    CullingBounds bounds {};
+    bounds.reserve(OBJECT_COUNT);
+    std::vector<SphereObject> spheres(OBJECT_COUNT);
+    std::vector<AabbObject> aabbs(OBJECT_COUNT);
+
+    for (uint32_t index = 0; index < OBJECT_COUNT; index++) {
+        const glm::vec3 center { position(random), position(random), position(random) };
+        const glm::vec3 halfExtent { extent(random), extent(random), extent(random) };
+
+        bounds.add(center - halfExtent, center + halfExtent);
+        spheres[index] = { { bounds.centerX[index], bounds.centerY[index], bounds.centerZ[index] }, bounds.radius[index] };
+        aabbs[index] = { center - halfExtent, center + halfExtent };
+    }
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 400.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3 { 0.0f }, glm::vec3 { 0.0f, 0.0f, -1.0f }, glm::vec3 { 0.0f, 1.0f, 0.0f });
+    const Frustum frustum = Frustum::fromMatrix(projection * view);
+
+    std::vector<uint32_t> output(OBJECT_COUNT);
+    JobSystem jobSystem {};
+    FrustumCuller culler { jobSystem };
+
+    std::cout << "objects: " << OBJECT_COUNT << ", kernel: " << CullingKernels::getSimdName()
+              << ", workers: " << jobSystem.getWorkerCount() << std::endl;
+
+    measure("sphere glm AoS", [&]() { return cullSpheresGlm(frustum, spheres, output.data()); });
+    measure("sphere SoA scalar", [&]() { return CullingKernels::cullSpheresScalar(frustum, bounds, 0, OBJECT_COUNT, output.data()); });
+    measure("sphere SoA SIMD", [&]() { return CullingKernels::cullSpheres(frustum, bounds, 0, OBJECT_COUNT, output.data()); });
+    measure("sphere SoA SIMD threaded", [&]() { return static_cast<uint32_t>(culler.cullSpheres(frustum, bounds).size()); });
+
+    measure("aabb glm AoS", [&]() { return cullAabbsGlm(frustum, aabbs, output.data()); });
+    measure("aabb SoA scalar", [&]() { return CullingKernels::cullAabbsScalar(frustum, bounds, 0, OBJECT_COUNT, output.data()); });
+    measure("aabb SoA SIMD", [&]() { return CullingKernels::cullAabbs(frustum, bounds, 0, OBJECT_COUNT, output.data()); });
+    measure("aabb SoA SIMD threaded", [&]() { return static_cast<uint32_t>(culler.cullAabbs(frustum, bounds).size()); });
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../engine/thread/job_system.h"
+
+// 스레드 수를 1 부터 늘려가며 parallelFor 처리량과 job 하나의 오버헤드를 측정
+namespace {
+    constexpr uint32_t ELEMENT_COUNT = 1 << 22;
+    constexpr uint32_t GRAIN_SIZE = 4096;
+    constexpr uint32_t EMPTY_JOB_COUNT = 100000;
+    constexpr uint32_t ITERATION_COUNT = 10;
+
+    template<typename Function>
+    double measure(Function&& function) {
+        function();
+        const auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t iteration = 0; iteration < ITERATION_COUNT; iteration++) {
+            function();
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / ITERATION_COUNT;
+    }
+}
+
+int main() {
+    const uint32_t maxThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    std::vector<float> values(ELEMENT_COUNT);
+
+    auto compute = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t index = begin; index < end; index++) {
+            values[index] = std::sqrt(std::sin(index * 0.001f) * std::cos(index * 0.002f) + 2.0f);
+        }
+    };
+    // JobSystem(0) 은 hardware_concurrency - 1 을 뜻하므로 1 스레드 기준값은 직접 측정
+    const double baseline = measure([&]() { compute(0, ELEMENT_COUNT); });
+
+    std::cout << "threads, parallelFor ms, speedup, efficiency, empty job ns" << std::endl;
+    std::cout << 1 << ", " << baseline << ", 1, 1, -" << std::endl;
+
+    for (uint32_t threadCount = 2; threadCount <= maxThreadCount; threadCount++) {
+        JobSystem jobSystem { threadCount - 1 };
+
+        const double milliseconds = measure([&]() {
+            jobSystem.parallelFor(ELEMENT_COUNT, GRAIN_SIZE, compute);
+        });
+        const double emptyJobMilliseconds = measure([&]() {
+            JobCounter counter {};
+
+            for (uint32_t index = 0; index < EMPTY_JOB_COUNT; index++) {
+                jobSystem.run([]() {}, &counter);
+            }
+            jobSystem.wait(counter);
+        });
+        const double speedup = baseline / milliseconds;
+
+        std::cout << threadCount << ", " << milliseconds << ", " << speedup << ", " << speedup / threadCount
+                  << ", " << emptyJobMilliseconds * 1e6 / EMPTY_JOB_COUNT << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../engine/mesh/mesh_lod.h"
+#include "../engine/mesh/mesh_optimizer.h"
+#include "../engine/mesh/mesh_simplifier.h"
+
+// 큰 scene 에서 LOD 선택 전후의 triangle 수와 frame 시간 비교
+// GPU 없이 돌도록 frame 시간은 선택된 index 구간의 vertex 변환 시간으로 근사 (vertex shader 비용)
+namespace {
+    constexpr uint32_t RING_COUNT = 128;
+    constexpr uint32_t SEGMENT_COUNT = 256;
+    constexpr uint32_t INSTANCE_COUNT = 4096;
+    constexpr float SCENE_RADIUS = 80.0f;
+    constexpr float VIEWPORT_HEIGHT = 1080.0f;
+    constexpr uint32_t ITERATION_COUNT = 3;
+
+    struct Instance {
+        glm::vec3 position;
+        float scale;
+    };
+
+    // 표면이 울퉁불퉁한 닫힌 구. 극점을 제외한 모든 vertex 가 위치를 공유하지 않음
+    MeshData createBumpySphere() {
+        MeshData mesh;
+        const auto getPosition = [](float theta, float phi) {
+            const float radius = 1.0f + 0.05f * std::sin(8.0f * theta) * std::cos(6.0f * phi);
+            return glm::vec3 { std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) } * radius;
+        };
+        mesh.vertices.push_back({ getPosition(0.0f, 0.0f), { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f } });
+
+        for (uint32_t ring = 1; ring < RING_COUNT; ring++) {
+            for (uint32_t segment = 0; segment < SEGMENT_COUNT; segment++) {
+                const float theta = glm::pi<float>() * static_cast<float>(ring) / RING_COUNT;
+                const float phi = 2.0f * glm::pi<float>() * static_cast<float>(segment) / SEGMENT_COUNT;
+                mesh.vertices.push_back({ getPosition(theta, phi), {}, { static_cast<float>(segment) / SEGMENT_COUNT, theta } });
+            }
+        }
+        mesh.vertices.push_back({ getPosition(glm::pi<float>(), 0.0f), { 0.0f, -1.0f, 0.0f }, { 0.0f, 1.0f } });
+        const auto bottomPole = static_cast<uint32_t>(mesh.vertices.size() - 1);
+
+        const auto getVertex = [](uint32_t ring, uint32_t segment) {
+            return 1 + (ring - 1) * SEGMENT_COUNT + segment % SEGMENT_COUNT;
+        };
+        for (uint32_t segment = 0; segment < SEGMENT_COUNT; segment++) {
+            mesh.indices.insert(mesh.indices.end(), { 0, getVertex(1, segment + 1), getVertex(1, segment) });
+            mesh.indices.insert(mesh.indices.end(), { bottomPole, getVertex(RING_COUNT - 1, segment), getVertex(RING_COUNT - 1, segment + 1) });
+        }
+        for (uint32_t ring = 1; ring + 1 < RING_COUNT; ring++) {
+            for (uint32_t segment = 0; segment < SEGMENT_COUNT; segment++) {
+                const uint32_t a = getVertex(ring, segment);
+                const uint32_t b = getVertex(ring, segment + 1);
+                const uint32_t c = getVertex(ring + 1, segment);
+                const uint32_t d = getVertex(ring + 1, segment + 1);
+                mesh.indices.insert(mesh.indices.end(), { a, b, c, b, d, c });
+            }
+        }
+        MeshOptimizer::generateNormals(mesh);
+        MeshOptimizer::optimize(mesh);
+        return mesh;
+    }
+
+    // 인스턴스마다 고른 LOD 의 index 를 모두 변환. 반환값은 최적화 방지용
+    float transformVertices(const MeshData& mesh, const glm::mat4& viewProjection, const std::vector<Instance>& instances, const std::vector<uint32_t>& selectedLods) {
+        float checksum = 0.0f;
+
+        for (size_t instance = 0; instance < instances.size(); instance++) {
+            const MeshLod& lod = mesh.lods[selectedLods[instance]];
+            const Instance& placement = instances[instance];
+
+            for (uint32_t index = lod.indexOffset; index < lod.indexOffset + lod.indexCount; index++) {
+                const glm::vec3 position = mesh.vertices[mesh.indices[index]].position * placement.scale + placement.position;
+                const glm::vec4 clip = viewProjection * glm::vec4 { position, 1.0f };
+                checksum += clip.z / clip.w;
+            }
+        }
+        return checksum;
+    }
+
+    template<typename Function>
+    double measure(Function&& function) {
+        function();
+        const auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t iteration = 0; iteration < ITERATION_COUNT; iteration++) {
+            function();
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / ITERATION_COUNT;
+    }
+}
+
+int main() {
+    MeshData mesh = createBumpySphere();
+
+    const auto simplifyStart = std::chrono::steady_clock::now();
+    MeshSimplifier::generateLods(mesh);
+    const std::chrono::duration<double, std::milli> simplifyTime = std::chrono::steady_clock::now() - simplifyStart;
+
+    std::cout << "mesh: " << mesh.vertices.size() << " vertices, LOD generation " << simplifyTime.count() << " ms" << std::endl;
+
+    for (size_t lod = 0; lod < mesh.lods.size(); lod++) {
+        std::cout << "  LOD " << lod << ": " << mesh.lods[lod].indexCount / 3 << " triangles, error " << mesh.lods[lod].error << std::endl;
+    }
+    std::mt19937 random(1234);
+    std::uniform_real_distribution angle(0.0f, 2.0f * glm::pi<float>());
+    std::uniform_real_distribution unit(0.0f, 1.0f);
+    std::uniform_real_distribution scale(0.5f, 2.0f);
+
+    // 면적 기준 균일 분포라 먼 객체가 대부분
+    std::vector<Instance> instances(INSTANCE_COUNT);
+
+    for (Instance& instance : instances) {
+        const float distance = SCENE_RADIUS * std::sqrt(unit(random)) + 2.0f;
+        const float direction = angle(random);
+        instance = { { std::cos(direction) * distance, 0.0f, std::sin(direction) * distance }, scale(random) };
+    }
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 2000.0f);
+    const glm::mat4 viewProjection = projection
+        * glm::lookAt(glm::vec3 { 0.0f, 2.0f, 0.0f }, glm::vec3 { 0.0f, 2.0f, -1.0f }, glm::vec3 { 0.0f, 1.0f, 0.0f });
+    const float lodScale = MeshLods::getLodScale(projection, VIEWPORT_HEIGHT);
+    const glm::vec3 cameraPosition { 0.0f, 2.0f, 0.0f };
+
+    std::vector<uint32_t> baseLods(INSTANCE_COUNT, 0);
+    std::vector<uint32_t> selectedLods(INSTANCE_COUNT, 0);
+
+    const double selectionTime = measure([&]() {
+        for (uint32_t instance = 0; instance < INSTANCE_COUNT; instance++) {
+            // mesh 반지름은 약 1.05
+            const float radius = 1.05f * instances[instance].scale;
+            const float distance = std::max(glm::distance(instances[instance].position, cameraPosition) - radius, 0.0f);
+            selectedLods[instance] = MeshLods::selectLod(mesh.lods, distance / instances[instance].scale, lodScale);
+        }
+    });
+    uint64_t baseTriangleCount = 0;
+    uint64_t selectedTriangleCount = 0;
+    std::vector<uint32_t> lodHistogram(mesh.lods.size(), 0);
+
+    for (uint32_t instance = 0; instance < INSTANCE_COUNT; instance++) {
+        baseTriangleCount += mesh.lods[0].indexCount / 3;
+        selectedTriangleCount += mesh.lods[selectedLods[instance]].indexCount / 3;
+        lodHistogram[selectedLods[instance]]++;
+    }
+    float checksum = 0.0f;
+    const double baseFrameTime = measure([&]() { checksum += transformVertices(mesh, viewProjection, instances, baseLods); });
+    const double selectedFrameTime = measure([&]() { checksum += transformVertices(mesh, viewProjection, instances, selectedLods); });
+
+    std::cout << "instances: " << INSTANCE_COUNT << ", LOD selection " << selectionTime << " ms" << std::endl;
+    std::cout << "instances per LOD:";
+
+    for (const uint32_t count : lodHistogram) {
+        std::cout << " " << count;
+    }
+    std::cout << std::endl;
+    std::cout << "triangles: " << baseTriangleCount << " -> " << selectedTriangleCount
+              << " (" << static_cast<double>(selectedTriangleCount) * 100.0 / static_cast<double>(baseTriangleCount) << "%)" << std::endl;
+    std::cout << "vertex transform frame: " << baseFrameTime << " ms -> " << selectedFrameTime << " ms"
+              << " (checksum " << checksum << ")" << std::endl;
+    return 0;
+}
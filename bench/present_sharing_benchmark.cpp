@@ -0,0 +1,285 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+#include "../engine/memory/memory_supports.h"
+#include "../engine/queue/queue_factory.h"
+#include "../engine/texture/texture_supports.h"
+
+// graphics queue 가 그린 image 를 다른 family 의 queue 가 읽을 때, EXCLUSIVE + 소유권 이동과 CONCURRENT 의 frame 시간 비교
+// 창 없이 돌도록 present 대신 두 번째 family 에서 image 를 buffer 로 복사 (presentation engine 이 읽는 자리)
+// 기준값으로 한 family 에서 모두 처리하는 UNIFIED 도 측정
+namespace {
+    constexpr VkExtent2D IMAGE_EXTENT { 1920, 1080 };
+    constexpr VkFormat IMAGE_FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
+    // GPU 쪽 일을 늘리려고 frame 마다 여러 번 clear
+    constexpr uint32_t CLEAR_COUNT = 16;
+    constexpr uint32_t FRAME_COUNT = 500;
+
+    struct Device {
+        VkInstance instance = VK_NULL_HANDLE;
+        VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+        VkDevice device = VK_NULL_HANDLE;
+        uint32_t graphicsFamily = 0;
+        // barrier 를 기록할 수 있는 graphics 외의 family. 없으면 UNIFIED 만 측정
+        std::optional<uint32_t> consumerFamily;
+        VkQueue graphicsQueue = VK_NULL_HANDLE;
+        VkQueue consumerQueue = VK_NULL_HANDLE;
+    };
+
+    // 한 mode 를 측정하는 동안 쓰는 객체
+    struct Frame {
+        ImageAllocation image;
+        BufferAllocation buffer;
+        VkCommandPool graphicsPool = VK_NULL_HANDLE;
+        VkCommandPool consumerPool = VK_NULL_HANDLE;
+        VkCommandBuffer graphicsCommands = VK_NULL_HANDLE;
+        VkCommandBuffer consumerCommands = VK_NULL_HANDLE;
+        VkSemaphore renderFinished = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+    };
+
+    Device createDevice() {
+        Device result {};
+
+        VkApplicationInfo applicationInfo {};
+        applicationInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        applicationInfo.pApplicationName = "PresentSharingBenchmark";
+        applicationInfo.apiVersion = VK_API_VERSION_1_0;
+
+        VkInstanceCreateInfo instanceCreateInfo {};
+        instanceCreateInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        instanceCreateInfo.pApplicationInfo = &applicationInfo;
+
+        if (vkCreateInstance(&instanceCreateInfo, nullptr, &result.instance) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create instance!");
+        }
+        uint32_t physicalDeviceCount = 1;
+
+        if (vkEnumeratePhysicalDevices(result.instance, &physicalDeviceCount, &result.physicalDevice) < 0 || physicalDeviceCount == 0) {
+            throw std::runtime_error("failed to find GPUs with Vulkan support!");
+        }
+        const std::vector queueFamilies = QueueFactory::getQueueFamilyProperties(result.physicalDevice);
+        std::optional<uint32_t> graphicsFamily;
+
+        for (uint32_t index = 0; index < queueFamilies.size(); index++) {
+            if (!graphicsFamily && (queueFamilies[index].queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
+                graphicsFamily = index;
+            } else if (!result.consumerFamily && QueueFactory::supportsOwnershipTransfer(queueFamilies[index])) {
+                result.consumerFamily = index;
+            }
+        }
+        if (!graphicsFamily) {
+            throw std::runtime_error("failed to find graphics queue family!");
+        }
+        result.graphicsFamily = *graphicsFamily;
+
+        constexpr float queuePriority = 1.0f;
+        std::vector queueCreateInfos { QueueFactory::createDeviceQueueCreateInfo(&queuePriority, result.graphicsFamily) };
+
+        if (result.consumerFamily) {
+            queueCreateInfos.push_back(QueueFactory::createDeviceQueueCreateInfo(&queuePriority, *result.consumerFamily));
+        }
+        VkDeviceCreateInfo deviceCreateInfo {};
+        deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
+        deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
+
+        if (vkCreateDevice(result.physicalDevice, &deviceCreateInfo, nullptr, &result.device) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create logical device!");
+        }
+        result.graphicsQueue = QueueFactory::getDeviceQueue(result.device, result.graphicsFamily);
+        result.consumerQueue = result.consumerFamily ? QueueFactory::getDeviceQueue(result.device, *result.consumerFamily) : result.graphicsQueue;
+        return result;
+    }
+
+    VkCommandBuffer createCommandBuffer(VkDevice device, VkCommandPool& pool, uint32_t queueFamilyIndex) {
+        VkCommandPoolCreateInfo poolCreateInfo {};
+        poolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolCreateInfo.queueFamilyIndex = queueFamilyIndex;
+        vkCreateCommandPool(device, &poolCreateInfo, nullptr, &pool);
+
+        VkCommandBufferAllocateInfo allocateInfo {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.commandPool = pool;
+        allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocateInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer;
+        vkAllocateCommandBuffers(device, &allocateInfo, &commandBuffer);
+
+        VkCommandBufferBeginInfo beginInfo {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        return commandBuffer;
+    }
+
+    void recordClears(VkCommandBuffer commandBuffer, VkImage image) {
+        // 이전 frame 의 내용은 필요 없으므로 UNDEFINED 에서 시작 (엔진의 CLEAR render pass 와 같음)
+        const VkImageMemoryBarrier toClear = TextureSupports::createImageMemoryBarrier(
+            image, 0, 1, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT
+        );
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toClear);
+
+        VkImageSubresourceRange range {};
+        range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        range.levelCount = 1;
+        range.layerCount = 1;
+
+        for (uint32_t clear = 0; clear < CLEAR_COUNT; clear++) {
+            const float value = static_cast<float>(clear) / CLEAR_COUNT;
+            const VkClearColorValue color { { value, 1.0f - value, 0.5f, 1.0f } };
+            vkCmdClearColorImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &color, 1, &range);
+        }
+        const VkImageMemoryBarrier toRead = TextureSupports::createImageMemoryBarrier(
+            image, 0, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT
+        );
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toRead);
+    }
+
+    void recordCopy(VkCommandBuffer commandBuffer, const Frame& frame) {
+        VkBufferImageCopy region {};
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent = { IMAGE_EXTENT.width, IMAGE_EXTENT.height, 1 };
+        vkCmdCopyImageToBuffer(commandBuffer, frame.image.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, frame.buffer.buffer, 1, &region);
+    }
+
+    Frame createFrame(const Device& device, PresentSharing sharing) {
+        Frame frame {};
+        const uint32_t sharedFamilies[] { device.graphicsFamily, device.consumerFamily.value_or(device.graphicsFamily) };
+
+        VkImageCreateInfo imageCreateInfo = MemorySupports::createImageCreateInfo(
+            IMAGE_EXTENT, 1, IMAGE_FORMAT, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+        );
+        if (sharing == PresentSharing::CONCURRENT) {
+            imageCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+            imageCreateInfo.queueFamilyIndexCount = 2;
+            imageCreateInfo.pQueueFamilyIndices = sharedFamilies;
+        }
+        frame.image = MemorySupports::createImage(device.physicalDevice, device.device, imageCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        frame.buffer = MemorySupports::createBuffer(
+            device.physicalDevice, device.device, VkDeviceSize { IMAGE_EXTENT.width } * IMAGE_EXTENT.height * 4,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        );
+
+        VkSemaphoreCreateInfo semaphoreCreateInfo {};
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        vkCreateSemaphore(device.device, &semaphoreCreateInfo, nullptr, &frame.renderFinished);
+
+        VkFenceCreateInfo fenceCreateInfo {};
+        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        vkCreateFence(device.device, &fenceCreateInfo, nullptr, &frame.fence);
+
+        // command buffer 는 한 번 기록하고 매 frame 다시 submit (frame 마다 fence 를 기다리므로 겹치지 않음)
+        frame.graphicsCommands = createCommandBuffer(device.device, frame.graphicsPool, device.graphicsFamily);
+        recordClears(frame.graphicsCommands, frame.image.image);
+
+        if (sharing == PresentSharing::UNIFIED) {
+            recordCopy(frame.graphicsCommands, frame);
+            vkEndCommandBuffer(frame.graphicsCommands);
+            return frame;
+        }
+        frame.consumerCommands = createCommandBuffer(device.device, frame.consumerPool, *device.consumerFamily);
+
+        if (sharing == PresentSharing::OWNERSHIP_TRANSFER) {
+            // WindowSurface 와 같은 release / acquire 쌍. layout 은 위에서 바꿔 둔 TRANSFER_SRC 그대로
+            const VkImageMemoryBarrier release = QueueFactory::createOwnershipTransferBarrier(
+                frame.image.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, device.graphicsFamily, *device.consumerFamily, VK_ACCESS_TRANSFER_WRITE_BIT
+            );
+            vkCmdPipelineBarrier(frame.graphicsCommands, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &release);
+
+            VkImageMemoryBarrier acquire = release;
+            acquire.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            vkCmdPipelineBarrier(frame.consumerCommands, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &acquire);
+        }
+        vkEndCommandBuffer(frame.graphicsCommands);
+        recordCopy(frame.consumerCommands, frame);
+        vkEndCommandBuffer(frame.consumerCommands);
+        return frame;
+    }
+
+    void destroyFrame(const Device& device, const Frame& frame) {
+        vkDestroyFence(device.device, frame.fence, nullptr);
+        vkDestroySemaphore(device.device, frame.renderFinished, nullptr);
+        vkDestroyCommandPool(device.device, frame.graphicsPool, nullptr);
+
+        if (frame.consumerPool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(device.device, frame.consumerPool, nullptr);
+        }
+        MemorySupports::destroyBuffer(device.device, frame.buffer);
+        MemorySupports::destroyImage(device.device, frame.image);
+    }
+
+    void submitFrame(const Device& device, const Frame& frame) {
+        VkSubmitInfo graphicsSubmit {};
+        graphicsSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        graphicsSubmit.commandBufferCount = 1;
+        graphicsSubmit.pCommandBuffers = &frame.graphicsCommands;
+
+        if (frame.consumerCommands == VK_NULL_HANDLE) {
+            vkQueueSubmit(device.graphicsQueue, 1, &graphicsSubmit, frame.fence);
+            return;
+        }
+        graphicsSubmit.signalSemaphoreCount = 1;
+        graphicsSubmit.pSignalSemaphores = &frame.renderFinished;
+        vkQueueSubmit(device.graphicsQueue, 1, &graphicsSubmit, VK_NULL_HANDLE);
+
+        constexpr VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        VkSubmitInfo consumerSubmit {};
+        consumerSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        consumerSubmit.waitSemaphoreCount = 1;
+        consumerSubmit.pWaitSemaphores = &frame.renderFinished;
+        consumerSubmit.pWaitDstStageMask = &waitStage;
+        consumerSubmit.commandBufferCount = 1;
+        consumerSubmit.pCommandBuffers = &frame.consumerCommands;
+        vkQueueSubmit(device.consumerQueue, 1, &consumerSubmit, frame.fence);
+    }
+
+    // frame 당 ms. 두 queue 의 일이 모두 끝날 때까지 기다리는 시간
+    double measure(const Device& device, PresentSharing sharing) {
+        const Frame frame = createFrame(device, sharing);
+        double milliseconds = 0.0;
+
+        for (uint32_t frameIndex = 0; frameIndex <= FRAME_COUNT; frameIndex++) {
+            const auto start = std::chrono::steady_clock::now();
+            submitFrame(device, frame);
+            vkWaitForFences(device.device, 1, &frame.fence, VK_TRUE, UINT64_MAX);
+            vkResetFences(device.device, 1, &frame.fence);
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+            // 첫 frame 은 driver 준비 비용이 섞이므로 제외
+            if (frameIndex > 0) {
+                milliseconds += elapsed.count();
+            }
+        }
+        destroyFrame(device, frame);
+        return milliseconds / FRAME_COUNT;
+    }
+}
+
+int main() {
+    const Device device = createDevice();
+    VkPhysicalDeviceProperties properties {};
+    vkGetPhysicalDeviceProperties(device.physicalDevice, &properties);
+
+    std::cout << "device: " << properties.deviceName << ", image: " << IMAGE_EXTENT.width << "x" << IMAGE_EXTENT.height
+              << ", clears per frame: " << CLEAR_COUNT << std::endl;
+    std::cout << "unified (family " << device.graphicsFamily << "): " << measure(device, PresentSharing::UNIFIED) << " ms/frame" << std::endl;
+
+    if (!device.consumerFamily) {
+        std::cout << "no second queue family that can record barriers, skipping exclusive / concurrent" << std::endl;
+    } else {
+        std::cout << "exclusive + ownership transfer (family " << device.graphicsFamily << " -> " << *device.consumerFamily << "): "
+                  << measure(device, PresentSharing::OWNERSHIP_TRANSFER) << " ms/frame" << std::endl;
+        std::cout << "concurrent (family " << device.graphicsFamily << " + " << *device.consumerFamily << "): "
+                  << measure(device, PresentSharing::CONCURRENT) << " ms/frame" << std::endl;
+    }
+    vkDestroyDevice(device.device, nullptr);
+    vkDestroyInstance(device.instance, nullptr);
+    return 0;
+}
@@ -0,0 +1,227 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "../engine/sprite/glyph_atlas.h"
+#include "../engine/sprite/sprite_atlas.h"
+#include "../engine/sprite/sprite_batch.h"
+
+// HUD 한 frame 을 batch 로 기록할 때와 sprite 마다 draw 를 기록할 때의 quads/ms 와 command 수 비교
+// GPU 없이 돌도록 vkCmd* 는 command buffer 에 넣는 것처럼 작은 record 로 대신함 (driver 비용은 포함되지 않음)
+namespace {
+    constexpr uint32_t SPRITE_IMAGE_COUNT = 64;
+    constexpr uint32_t SPRITE_COUNT = 16384;
+    constexpr uint32_t TEXT_LINE_COUNT = 256;
+    constexpr uint32_t GLYPH_WIDTH = 8;
+    constexpr uint32_t GLYPH_HEIGHT = 12;
+    constexpr uint32_t ITERATION_COUNT = 50;
+
+    enum class CommandType : uint32_t {
+        BIND_PIPELINE,
+        BIND_DESCRIPTOR_SET,
+        PUSH_CONSTANTS,
+        DRAW_INDEXED,
+    };
+
+    struct RecordedCommand {
+        CommandType type;
+        uint32_t arguments[3];
+    };
+
+    struct SpriteInstance {
+        uint32_t image;
+        glm::vec2 position;
+        glm::vec2 size;
+        glm::vec4 color;
+        SpriteBlend blend;
+    };
+
+    // 한 frame 의 HUD: 아이콘과 점수 같은 짧은 문자열이 섞임
+    struct Scene {
+        std::vector<SpriteInstance> sprites;
+        std::vector<std::string> lines;
+    };
+
+    std::vector<AtlasRegion> createSpriteImages(SpriteAtlas& atlas, std::mt19937& random) {
+        std::uniform_int_distribution sizeDistribution(16u, 48u);
+        std::vector<AtlasRegion> regions;
+
+        for (uint32_t image = 0; image < SPRITE_IMAGE_COUNT; image++) {
+            const uint32_t width = sizeDistribution(random);
+            const uint32_t height = sizeDistribution(random);
+            const std::vector<uint8_t> pixels(size_t { width } * height * SpriteAtlas::CHANNEL_COUNT, static_cast<uint8_t>(image * 4));
+            regions.push_back(*atlas.add(width, height, pixels));
+        }
+        return regions;
+    }
+
+    void addAsciiGlyphs(GlyphAtlas& glyphs) {
+        const std::vector<uint8_t> coverage(GLYPH_WIDTH * GLYPH_HEIGHT, 0xFF);
+
+        for (char32_t codepoint = U' '; codepoint < U'\x7F'; codepoint++) {
+            const bool isSpace = codepoint == U' ';
+            const GlyphMetrics metrics {
+                isSpace ? 0 : GLYPH_WIDTH,
+                isSpace ? 0 : GLYPH_HEIGHT,
+                { 0.0f, -static_cast<float>(GLYPH_HEIGHT) },
+                static_cast<float>(GLYPH_WIDTH + 1),
+            };
+            glyphs.addGlyph(codepoint, metrics, coverage);
+        }
+    }
+
+    Scene createScene(std::mt19937& random) {
+        std::uniform_int_distribution imageDistribution(0u, SPRITE_IMAGE_COUNT - 1);
+        std::uniform_real_distribution positionDistribution(0.0f, 1920.0f);
+        std::uniform_real_distribution unit(0.0f, 1.0f);
+        Scene scene;
+
+        for (uint32_t sprite = 0; sprite < SPRITE_COUNT; sprite++) {
+            // 효과용 일부 sprite 만 additive
+            const SpriteBlend blend = sprite % 64 == 0 ? SpriteBlend::ADDITIVE : SpriteBlend::ALPHA;
+            scene.sprites.push_back({
+                imageDistribution(random),
+                { positionDistribution(random), positionDistribution(random) * 0.5625f },
+                { 24.0f, 24.0f },
+                { unit(random), unit(random), unit(random), 1.0f },
+                blend,
+            });
+        }
+        for (uint32_t line = 0; line < TEXT_LINE_COUNT; line++) {
+            scene.lines.push_back("Score " + std::to_string(line * 1337) + "  HP 100/100");
+        }
+        return scene;
+    }
+
+    void recordBatches(std::span<const SpriteDrawBatch> batches, std::vector<RecordedCommand>& commands) {
+        const SpriteDrawBatch* previous = nullptr;
+
+        for (const SpriteDrawBatch& batch : batches) {
+            if (previous == nullptr || previous->blend != batch.blend) {
+                commands.push_back({ CommandType::BIND_PIPELINE, { static_cast<uint32_t>(batch.blend) } });
+            }
+            if (previous == nullptr) {
+                commands.push_back({ CommandType::PUSH_CONSTANTS, {} });
+            }
+            if (previous == nullptr || previous->page != batch.page) {
+                commands.push_back({ CommandType::BIND_DESCRIPTOR_SET, { batch.page } });
+            }
+            commands.push_back({ CommandType::DRAW_INDEXED, { batch.quadCount * SpriteBatch::INDICES_PER_QUAD, batch.firstQuad * SpriteBatch::INDICES_PER_QUAD } });
+            previous = &batch;
+        }
+    }
+
+    // SpriteRenderer 와 같은 경로: 매핑된 ring 에 쓰고 상태가 바뀔 때만 draw
+    uint32_t drawBatched(
+        const Scene& scene,
+        const std::vector<AtlasRegion>& regions,
+        const GlyphAtlas& glyphs,
+        SpriteBatch& batch,
+        std::vector<SpriteVertex>& ring,
+        std::vector<RecordedCommand>& commands
+    ) {
+        commands.clear();
+        batch.begin(ring);
+
+        for (const SpriteInstance& sprite : scene.sprites) {
+            batch.draw(regions[sprite.image], sprite.position, sprite.size, sprite.color, sprite.blend);
+        }
+        for (size_t line = 0; line < scene.lines.size(); line++) {
+            batch.drawText(glyphs, scene.lines[line], { 16.0f, 32.0f + static_cast<float>(line) * 14.0f });
+        }
+        recordBatches(batch.getBatches(), commands);
+        return batch.getQuadCount();
+    }
+
+    // 비교 대상: sprite 마다 자기 상태를 바인딩하고 draw 하나
+    uint32_t drawNaive(
+        const Scene& scene,
+        const std::vector<AtlasRegion>& regions,
+        const GlyphAtlas& glyphs,
+        SpriteBatch& batch,
+        std::vector<SpriteVertex>& ring,
+        std::vector<RecordedCommand>& commands
+    ) {
+        commands.clear();
+        uint32_t quadCount = 0;
+
+        const auto recordQuad = [&](uint32_t page, SpriteBlend blend) {
+            commands.push_back({ CommandType::BIND_PIPELINE, { static_cast<uint32_t>(blend) } });
+            commands.push_back({ CommandType::PUSH_CONSTANTS, {} });
+            commands.push_back({ CommandType::BIND_DESCRIPTOR_SET, { page } });
+            commands.push_back({ CommandType::DRAW_INDEXED, { SpriteBatch::INDICES_PER_QUAD, quadCount * SpriteBatch::INDICES_PER_QUAD } });
+            quadCount++;
+        };
+        // vertex 는 같은 방식으로 쓰고 draw 만 quad 마다 기록
+        batch.begin(ring);
+
+        for (const SpriteInstance& sprite : scene.sprites) {
+            batch.draw(regions[sprite.image], sprite.position, sprite.size, sprite.color, sprite.blend);
+            recordQuad(regions[sprite.image].page, sprite.blend);
+        }
+        for (size_t line = 0; line < scene.lines.size(); line++) {
+            const uint32_t firstQuad = batch.getQuadCount();
+            batch.drawText(glyphs, scene.lines[line], { 16.0f, 32.0f + static_cast<float>(line) * 14.0f });
+
+            for (uint32_t quad = firstQuad; quad < batch.getQuadCount(); quad++) {
+                recordQuad(0, SpriteBlend::ALPHA);
+            }
+        }
+        return quadCount;
+    }
+
+    template<typename Function>
+    double measure(Function&& function) {
+        function();
+        const auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t iteration = 0; iteration < ITERATION_COUNT; iteration++) {
+            function();
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / ITERATION_COUNT;
+    }
+
+    uint32_t countDraws(const std::vector<RecordedCommand>& commands) {
+        uint32_t drawCount = 0;
+
+        for (const RecordedCommand& command : commands) {
+            drawCount += command.type == CommandType::DRAW_INDEXED ? 1 : 0;
+        }
+        return drawCount;
+    }
+}
+
+int main() {
+    std::mt19937 random(1234);
+    SpriteAtlas atlas;
+    const std::vector<AtlasRegion> regions = createSpriteImages(atlas, random);
+    GlyphAtlas glyphs { atlas, static_cast<float>(GLYPH_HEIGHT + 2) };
+    addAsciiGlyphs(glyphs);
+    const Scene scene = createScene(random);
+
+    std::vector<SpriteVertex> ring(size_t { SPRITE_COUNT + TEXT_LINE_COUNT * 64 } * SpriteBatch::VERTICES_PER_QUAD);
+    std::vector<RecordedCommand> commands;
+    commands.reserve(size_t { SPRITE_COUNT + TEXT_LINE_COUNT * 64 } * 4);
+    SpriteBatch batch;
+
+    uint32_t quadCount = 0;
+    const double batchedTime = measure([&]() { quadCount = drawBatched(scene, regions, glyphs, batch, ring, commands); });
+    const size_t batchedCommandCount = commands.size();
+    const uint32_t batchedDrawCount = countDraws(commands);
+
+    const double naiveTime = measure([&]() { drawNaive(scene, regions, glyphs, batch, ring, commands); });
+    const size_t naiveCommandCount = commands.size();
+    const uint32_t naiveDrawCount = countDraws(commands);
+
+    std::cout << "atlas: " << atlas.getPageCount() << " page(s), quads per frame: " << quadCount << std::endl;
+    std::cout << "batched: " << batchedTime << " ms, " << quadCount / batchedTime << " quads/ms, "
+              << batchedDrawCount << " draws, " << batchedCommandCount << " commands" << std::endl;
+    std::cout << "per-sprite: " << naiveTime << " ms, " << quadCount / naiveTime << " quads/ms, "
+              << naiveDrawCount << " draws, " << naiveCommandCount << " commands" << std::endl;
+    return 0;
+}
@@ -0,0 +1,71 @@
+# 성능 비교용 microbenchmark (기본 비활성)
+option(ENGINE_BUILD_BENCHMARKS "Build microbenchmarks" OFF)
+
+if (NOT ENGINE_BUILD_BENCHMARKS)
+    return()
+endif ()
+
+# 1. SoA SIMD 컬링 vs glm scalar
+add_executable(CullingBenchmark
+        bench/culling_benchmark.cpp
+        engine/culling/frustum.h
+        engine/culling/frustum.cpp
+        engine/culling/culling_bounds.h
+        engine/culling/culling_bounds.cpp
+        engine/culling/culling_kernels.h
+        engine/culling/culling_kernels.cpp
+        engine/culling/frustum_culler.h
+        engine/culling/frustum_culler.cpp
+        engine/thread/job_system.h
+        engine/thread/job_system.cpp
+)
+target_link_libraries(CullingBenchmark PRIVATE glm::glm)
+engine_enable_simd(CullingBenchmark)
+
+# 2. job system 스레드 수 별 scaling
+add_executable(JobSystemBenchmark
+        bench/job_system_benchmark.cpp
+        engine/thread/job_system.h
+        engine/thread/job_system.cpp
+)
+
+# 3. mesh LOD 선택 전후의 triangle 수와 vertex 변환 시간
+add_executable(LodBenchmark
+        bench/lod_benchmark.cpp
+        engine/mesh/mesh_data.h
+        engine/mesh/mesh_optimizer.h
+        engine/mesh/mesh_optimizer.cpp
+        engine/mesh/mesh_simplifier.h
+        engine/mesh/mesh_simplifier.cpp
+        engine/mesh/mesh_lod.h
+        engine/mesh/mesh_lod.cpp
+)
+target_link_libraries(LodBenchmark PRIVATE glm::glm)
+
+# 4. 2D sprite batch vs sprite 마다 draw
+add_executable(SpriteBenchmark
+        bench/sprite_benchmark.cpp
+        engine/sprite/sprite_atlas.h
+        engine/sprite/sprite_atlas.cpp
+        engine/sprite/glyph_atlas.h
+        engine/sprite/glyph_atlas.cpp
+        engine/sprite/sprite_batch.h
+        engine/sprite/sprite_batch.cpp
+)
+target_link_libraries(SpriteBenchmark PRIVATE glm::glm)
+
+# 5. 다른 queue family 로 image 넘기기: EXCLUSIVE + 소유권 이동 vs CONCURRENT (GPU 필요)
+add_executable(PresentSharingBenchmark
+        bench/present_sharing_benchmark.cpp
+        engine/queue/queue_factory.h
+        engine/queue/queue_factory.cpp
+        engine/texture/texture_supports.h
+        engine/texture/texture_supports.cpp
+        engine/memory/memory_supports.h
+        engine/memory/memory_supports.cpp
+        engine/memory/memory_budget.h
+        engine/memory/memory_budget.cpp
+        engine/memory/host_allocator.h
+        engine/memory/host_allocator.cpp
+)
+target_link_libraries(PresentSharingBenchmark PRIVATE Vulkan::Vulkan glfw)
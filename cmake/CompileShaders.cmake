@@ -5,18 +5,31 @@ if (NOT GLSLC_EXECUTABLE)
     message(FATAL_ERROR "Could not find glslc executable!")
 endif()
 
+# reflection 결과를 SPIR-V 옆에 저장하는 도구 (엔진과 파서를 공유)
+add_executable(ShaderReflector
+        tools/shader_reflector.cpp
+        engine/shader/spirv_reflection.h
+        engine/shader/spirv_reflection.cpp
+        engine/util/binary_file_utils.h
+        engine/util/binary_file_utils.cpp
+)
+target_link_libraries(ShaderReflector PRIVATE Vulkan::Headers)
+
 # 2. 쉐이더 소스 및 출력 경로 설정
 set(SHADER_SOURCE_DIR "${CMAKE_SOURCE_DIR}/shaders")
 set(SHADER_BINARY_DIR "${CMAKE_BINARY_DIR}/shaders")
 # 바이너리 출력 디렉토리가 없으면 생성
 file(MAKE_DIRECTORY ${SHADER_BINARY_DIR})
 
-# 3. 컴파일할 쉐이더 파일 목록 찾기 (.vert, .frag)
+# 3. 컴파일할 쉐이더 파일 목록 찾기 (.vert, .frag, .geom, .comp)
 file(GLOB SHADER_SOURCES
         "${SHADER_SOURCE_DIR}/*.vert"
         "${SHADER_SOURCE_DIR}/*.frag"
+        "${SHADER_SOURCE_DIR}/*.geom"
+        "${SHADER_SOURCE_DIR}/*.comp"
 )
 set(ALL_SPV_FILES "")
+set(ALL_REFLECTION_FILES "")
 
 # 4. 각 쉐이더 파일에 대해 Custom Command 생성
 foreach(SOURCE_FILE ${SHADER_SOURCES})
@@ -28,6 +41,12 @@ foreach(SOURCE_FILE ${SHADER_SOURCES})
     elseif (${FILE_NAME} MATCHES "\\.frag$")
         string(REPLACE ".frag" "" BASE_NAME ${FILE_NAME})
         set(OUTPUT_NAME "${BASE_NAME}.frag.spv")
+    elseif (${FILE_NAME} MATCHES "\\.geom$")
+        string(REPLACE ".geom" "" BASE_NAME ${FILE_NAME})
+        set(OUTPUT_NAME "${BASE_NAME}.geom.spv")
+    elseif (${FILE_NAME} MATCHES "\\.comp$")
+        string(REPLACE ".comp" "" BASE_NAME ${FILE_NAME})
+        set(OUTPUT_NAME "${BASE_NAME}.comp.spv")
     else()
         set(OUTPUT_NAME "${FILE_NAME}.spv")
     endif()
@@ -38,8 +57,17 @@ foreach(SOURCE_FILE ${SHADER_SOURCES})
             DEPENDS ${SOURCE_FILE}
             COMMENT "Compiling shader: ${FILE_NAME} -> ${OUTPUT_NAME}"
     )
+    # 실행 시 다시 파싱하지 않도록 reflection 결과를 미리 생성
+    set(REFLECTION_FILE "${SPV_FILE}.refl")
+    add_custom_command(
+            OUTPUT ${REFLECTION_FILE}
+            COMMAND ShaderReflector ${SPV_FILE} ${REFLECTION_FILE}
+            DEPENDS ShaderReflector ${SPV_FILE}
+            COMMENT "Reflecting shader: ${OUTPUT_NAME}"
+    )
     list(APPEND ALL_SPV_FILES ${SPV_FILE})
+    list(APPEND ALL_REFLECTION_FILES ${REFLECTION_FILE})
 endforeach()
 
 # 5. 쉐이더 타겟 생성 및 메인 타겟에 의존성 추가
-add_custom_target(Shaders ALL DEPENDS ${ALL_SPV_FILES})
+add_custom_target(Shaders ALL DEPENDS ${ALL_SPV_FILES} ${ALL_REFLECTION_FILES})
@@ -0,0 +1,46 @@
+# 1. mesh 쿠커 실행 파일 (런타임 import 와 같은 코드 사용)
+add_executable(MeshCooker
+        tools/mesh_cooker.cpp
+        engine/util/binary_file_utils.h
+        engine/util/binary_file_utils.cpp
+        engine/util/alignment.h
+        engine/util/json.h
+        engine/util/json.cpp
+        engine/mesh/mesh_data.h
+        engine/mesh/mesh_importer.h
+        engine/mesh/mesh_importer.cpp
+        engine/mesh/mesh_optimizer.h
+        engine/mesh/mesh_optimizer.cpp
+        engine/mesh/mesh_simplifier.h
+        engine/mesh/mesh_simplifier.cpp
+        engine/mesh/mesh_cooker.h
+        engine/mesh/mesh_cooker.cpp
+)
+target_link_libraries(MeshCooker PRIVATE glm::glm)
+
+# 2. assets/meshes 의 원본을 .mesh 로 변환
+set(MESH_SOURCE_DIR "${CMAKE_SOURCE_DIR}/assets/meshes")
+set(MESH_BINARY_DIR "${CMAKE_BINARY_DIR}/meshes")
+file(MAKE_DIRECTORY ${MESH_BINARY_DIR})
+
+file(GLOB MESH_SOURCES CONFIGURE_DEPENDS
+        "${MESH_SOURCE_DIR}/*.obj"
+        "${MESH_SOURCE_DIR}/*.gltf"
+        "${MESH_SOURCE_DIR}/*.glb"
+)
+set(ALL_MESH_FILES "")
+
+foreach(SOURCE_FILE ${MESH_SOURCES})
+    get_filename_component(BASE_NAME ${SOURCE_FILE} NAME_WE)
+    set(MESH_FILE "${MESH_BINARY_DIR}/${BASE_NAME}.mesh")
+
+    add_custom_command(
+            OUTPUT ${MESH_FILE}
+            COMMAND MeshCooker ${SOURCE_FILE} ${MESH_FILE}
+            DEPENDS MeshCooker ${SOURCE_FILE}
+            COMMENT "Cooking mesh: ${BASE_NAME}"
+    )
+    list(APPEND ALL_MESH_FILES ${MESH_FILE})
+endforeach()
+
+add_custom_target(Meshes ALL DEPENDS ${ALL_MESH_FILES})
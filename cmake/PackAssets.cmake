@@ -0,0 +1,32 @@
+# 1. 패커 실행 파일 (엔진과 포맷/압축 코드를 공유)
+add_executable(AssetPacker
+        tools/asset_packer.cpp
+        engine/asset/asset_pack_format.h
+        engine/asset/asset_pack_writer.h
+        engine/asset/asset_pack_writer.cpp
+        engine/asset/lz4.h
+        engine/asset/lz4.cpp
+        engine/util/alignment.h
+)
+
+# 2. 패킹 대상: 컴파일된 쉐이더와 reflection, cooked mesh (zero-copy 를 위해 비압축) + 나머지 assets (LZ4)
+set(ASSET_SOURCE_DIR "${CMAKE_SOURCE_DIR}/assets")
+set(ASSET_PACK_FILE "${CMAKE_BINARY_DIR}/assets.pak")
+
+file(GLOB_RECURSE ASSET_SOURCES CONFIGURE_DEPENDS "${ASSET_SOURCE_DIR}/*")
+# mesh 원본은 cook 결과로 대체
+list(FILTER ASSET_SOURCES EXCLUDE REGEX "^${MESH_SOURCE_DIR}/")
+set(ASSET_PACK_INPUTS --store ${ALL_SPV_FILES} ${ALL_REFLECTION_FILES} ${ALL_MESH_FILES})
+
+if (ASSET_SOURCES)
+    list(APPEND ASSET_PACK_INPUTS --lz4 --root ${ASSET_SOURCE_DIR} ${ASSET_SOURCES})
+endif()
+
+# 3. 쉐이더나 에셋이 바뀌면 pack 을 다시 생성
+add_custom_command(
+        OUTPUT ${ASSET_PACK_FILE}
+        COMMAND AssetPacker ${ASSET_PACK_FILE} ${ASSET_PACK_INPUTS}
+        DEPENDS AssetPacker ${ALL_SPV_FILES} ${ALL_REFLECTION_FILES} ${ALL_MESH_FILES} ${ASSET_SOURCES}
+        COMMENT "Packing assets -> assets.pak"
+)
+add_custom_target(AssetPack ALL DEPENDS ${ASSET_PACK_FILE})
@@ -0,0 +1,93 @@
+#include "asset_pack.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "lz4.h"
+
+namespace {
+    // offset + length 는 조작된 pack 에서 overflow 할 수 있으므로 뺄셈으로 비교
+    bool isRangeInside(uint64_t offset, uint64_t length, uint64_t size) {
+        return offset <= size && length <= size - offset;
+    }
+}
+
+AssetPack AssetPack::open(const char* filePath) {
+    using namespace AssetPackFormat;
+
+    AssetPack assetPack {};
+    assetPack.m_file = MappedFile::open(filePath);
+
+    const char* data = assetPack.m_file.data();
+    const size_t size = assetPack.m_file.size();
+
+    if (size < sizeof(Header)) {
+        throw std::runtime_error("Invalid asset pack: " + std::string { filePath });
+    }
+    const auto* header = reinterpret_cast<const Header*>(data);
+
+    if (header->magic != MAGIC || header->version != VERSION || header->fileSize != size) {
+        throw std::runtime_error("Invalid asset pack header: " + std::string { filePath });
+    }
+    if (!isRangeInside(header->tocOffset, uint64_t { header->entryCount } * sizeof(TocEntry), size)
+        || !isRangeInside(header->namesOffset, header->namesSize, size)) {
+        throw std::runtime_error("Corrupted asset pack: " + std::string { filePath });
+    }
+    assetPack.m_entries = { reinterpret_cast<const TocEntry*>(data + header->tocOffset), header->entryCount };
+    assetPack.m_names = { data + header->namesOffset, header->namesSize };
+
+    for (const AssetEntry& entry : assetPack.m_entries) {
+        if (!isRangeInside(entry.offset, entry.storedSize, size) || !isRangeInside(entry.nameOffset, entry.nameLength, header->namesSize)) {
+            throw std::runtime_error("Corrupted asset pack entry: " + std::string { filePath });
+        }
+    }
+    return assetPack;
+}
+
+const AssetEntry* AssetPack::find(std::string_view name) const {
+    const uint64_t nameHash = AssetPackFormat::hashName(name);
+    auto entry = std::ranges::lower_bound(m_entries, nameHash, {}, &AssetEntry::nameHash);
+
+    // hash 충돌 시 같은 hash 의 entry 가 연속되므로 이름까지 비교
+    for (; entry != m_entries.end() && entry->nameHash == nameHash; ++entry) {
+        if (getName(*entry) == name) {
+            return &*entry;
+        }
+    }
+    return nullptr;
+}
+
+std::string_view AssetPack::getName(const AssetEntry& entry) const {
+    return m_names.substr(entry.nameOffset, entry.nameLength);
+}
+
+std::span<const char> AssetPack::view(const AssetEntry& entry) const {
+    if (isCompressed(entry)) {
+        return {};
+    }
+    return { m_file.data() + entry.offset, entry.storedSize };
+}
+
+std::vector<char> AssetPack::read(const AssetEntry& entry) const {
+    const std::span<const char> stored { m_file.data() + entry.offset, entry.storedSize };
+
+    if (!isCompressed(entry)) {
+        return { stored.begin(), stored.end() };
+    }
+    std::vector<char> contents(entry.originalSize);
+
+    if (!Lz4::decompress(stored, contents)) {
+        throw std::runtime_error("Failed to decompress asset: " + std::string { getName(entry) });
+    }
+    return contents;
+}
+
+BinaryFile AssetPack::readBinaryFile(std::string_view name) const {
+    const AssetEntry* entry = find(name);
+
+    if (!entry) {
+        throw std::runtime_error("Asset not found: " + std::string { name });
+    }
+    return { std::string { name }, read(*entry) };
+}
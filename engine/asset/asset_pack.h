@@ -0,0 +1,68 @@
+#pragma once
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "asset_pack_format.h"
+#include "../util/binary_file_utils.h"
+#include "../util/mapped_file.h"
+
+using AssetEntry = AssetPackFormat::TocEntry;
+
+// mmap 된 asset pack. 열 때 한 번만 파일을 매핑하고 이후 조회/읽기에 syscall 없음
+// 읽기 전용이므로 여러 스레드에서 동시에 사용 가능
+class AssetPack {
+public:
+    AssetPack() = default;
+
+    static AssetPack open(const char* filePath);
+
+    // hash 로 이진 탐색 (O(log n)). 없으면 nullptr
+    [[nodiscard]]
+    const AssetEntry* find(std::string_view name) const;
+
+    [[nodiscard]]
+    bool contains(std::string_view name) const {
+        return find(name) != nullptr;
+    }
+
+    [[nodiscard]]
+    std::string_view getName(const AssetEntry& entry) const;
+
+    [[nodiscard]]
+    static bool isCompressed(const AssetEntry& entry) {
+        return entry.flags & AssetPackFormat::ENTRY_COMPRESSED_LZ4;
+    }
+
+    // 비압축 blob 은 매핑된 영역을 그대로 반환 (zero-copy). 압축된 blob 이면 빈 span
+    [[nodiscard]]
+    std::span<const char> view(const AssetEntry& entry) const;
+
+    // 압축 여부와 관계없이 원본 내용을 복사
+    [[nodiscard]]
+    std::vector<char> read(const AssetEntry& entry) const;
+
+    // BinaryFile 을 받는 기존 로더용
+    [[nodiscard]]
+    BinaryFile readBinaryFile(std::string_view name) const;
+
+    [[nodiscard]]
+    std::span<const AssetEntry> entries() const {
+        return m_entries;
+    }
+
+    [[nodiscard]]
+    bool isOpen() const {
+        return m_file.isOpen();
+    }
+
+private:
+    MappedFile                  m_file;
+    std::span<const AssetEntry> m_entries;
+    std::string_view            m_names;
+};
+
+namespace AssetPacks {
+    constexpr auto DEFAULT_PACK_PATH { "./assets.pak" };
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// 파일 레이아웃: Header | TocEntry[entryCount] (nameHash 정렬) | 이름 테이블 | blob (BLOB_ALIGNMENT 정렬)
+// 모든 값은 little endian
+namespace AssetPackFormat {
+
+    // "EPAK"
+    constexpr uint32_t MAGIC = 0x4B415045;
+    constexpr uint32_t VERSION = 1;
+    // SPIR-V (uint32_t) 와 SIMD 로드를 그대로 할 수 있도록 정렬
+    constexpr uint64_t BLOB_ALIGNMENT = 16;
+
+    enum EntryFlags : uint32_t {
+        ENTRY_COMPRESSED_LZ4 = 1 << 0,
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t reserved;
+        uint64_t tocOffset;
+        uint64_t namesOffset;
+        uint64_t namesSize;
+        uint64_t fileSize;
+    };
+
+    struct TocEntry {
+        uint64_t nameHash;
+        uint64_t offset;
+        uint64_t storedSize;
+        uint64_t originalSize;
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 48);
+    static_assert(sizeof(TocEntry) == 48);
+
+    // FNV-1a 64bit
+    constexpr uint64_t hashName(std::string_view name) {
+        uint64_t hash = 0xCBF29CE484222325ull;
+
+        for (const char character : name) {
+            hash ^= static_cast<uint8_t>(character);
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,111 @@
+#include "asset_pack_writer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#include "asset_pack_format.h"
+#include "lz4.h"
+#include "../util/alignment.h"
+
+void AssetPackWriter::add(std::string name, std::vector<char> contents, bool compress) {
+    m_entries.push_back({ std::move(name), std::move(contents), compress });
+}
+
+void AssetPackWriter::write(const char* filePath) const {
+    using namespace AssetPackFormat;
+
+    struct Blob {
+        const PendingEntry* source;
+        TocEntry entry;
+        std::vector<char> compressed;
+    };
+    std::vector<Blob> blobs {};
+    blobs.reserve(m_entries.size());
+
+    for (const PendingEntry& pendingEntry : m_entries) {
+        Blob blob { &pendingEntry, {}, {} };
+        blob.entry.nameHash = hashName(pendingEntry.name);
+        blob.entry.originalSize = pendingEntry.contents.size();
+        blob.entry.storedSize = pendingEntry.contents.size();
+
+        if (pendingEntry.compress && !pendingEntry.contents.empty()) {
+            std::vector<char> compressed = Lz4::compress(pendingEntry.contents);
+
+            // 1/16 이상 줄어들지 않으면 zero-copy 를 위해 그대로 저장
+            if (compressed.size() < pendingEntry.contents.size() - pendingEntry.contents.size() / 16) {
+                blob.entry.storedSize = compressed.size();
+                blob.entry.flags = ENTRY_COMPRESSED_LZ4;
+                blob.compressed = std::move(compressed);
+            }
+        }
+        blobs.push_back(std::move(blob));
+    }
+
+    std::ranges::sort(blobs, [](const Blob& lhs, const Blob& rhs) {
+        if (lhs.entry.nameHash != rhs.entry.nameHash) {
+            return lhs.entry.nameHash < rhs.entry.nameHash;
+        }
+        return lhs.source->name < rhs.source->name;
+    });
+
+    const auto duplicate = std::ranges::adjacent_find(blobs, [](const Blob& lhs, const Blob& rhs) {
+        return lhs.source->name == rhs.source->name;
+    });
+
+    if (duplicate != blobs.end()) {
+        throw std::runtime_error("Duplicate asset name: " + duplicate->source->name);
+    }
+
+    Header header {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.entryCount = static_cast<uint32_t>(blobs.size());
+    header.tocOffset = sizeof(Header);
+    header.namesOffset = header.tocOffset + blobs.size() * sizeof(TocEntry);
+
+    std::string names {};
+
+    for (Blob& blob : blobs) {
+        blob.entry.nameOffset = static_cast<uint32_t>(names.size());
+        blob.entry.nameLength = static_cast<uint32_t>(blob.source->name.size());
+        names += blob.source->name;
+    }
+    header.namesSize = names.size();
+
+    uint64_t offset = Alignments::alignUp(header.namesOffset + header.namesSize, BLOB_ALIGNMENT);
+
+    for (Blob& blob : blobs) {
+        blob.entry.offset = offset;
+        offset = Alignments::alignUp(offset + blob.entry.storedSize, BLOB_ALIGNMENT);
+    }
+    header.fileSize = offset;
+
+    std::ofstream fileStream { filePath, std::ios::binary | std::ios::trunc };
+
+    if (!fileStream.is_open()) {
+        throw std::runtime_error("Failed to create asset pack: " + std::string { filePath });
+    }
+    fileStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const Blob& blob : blobs) {
+        fileStream.write(reinterpret_cast<const char*>(&blob.entry), sizeof(TocEntry));
+    }
+    fileStream.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    const char padding[BLOB_ALIGNMENT] {};
+
+    for (const Blob& blob : blobs) {
+        const auto position = static_cast<uint64_t>(fileStream.tellp());
+        fileStream.write(padding, static_cast<std::streamsize>(blob.entry.offset - position));
+
+        const std::vector<char>& stored = blob.compressed.empty() ? blob.source->contents : blob.compressed;
+        fileStream.write(stored.data(), static_cast<std::streamsize>(stored.size()));
+    }
+    const auto position = static_cast<uint64_t>(fileStream.tellp());
+    fileStream.write(padding, static_cast<std::streamsize>(header.fileSize - position));
+
+    if (!fileStream) {
+        throw std::runtime_error("Failed to write asset pack: " + std::string { filePath });
+    }
+}
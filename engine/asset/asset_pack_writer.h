@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// 빌드 시 asset pack 을 만드는 writer (AssetPacker 도구에서 사용)
+class AssetPackWriter {
+public:
+    // compress 이면 LZ4 로 줄어드는 경우에만 압축해서 저장
+    void add(std::string name, std::vector<char> contents, bool compress);
+
+    void write(const char* filePath) const;
+
+    [[nodiscard]]
+    size_t size() const {
+        return m_entries.size();
+    }
+
+private:
+    struct PendingEntry {
+        std::string name;
+        std::vector<char> contents;
+        bool compress;
+    };
+
+    std::vector<PendingEntry> m_entries;
+};
@@ -0,0 +1,179 @@
+#include "lz4.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    constexpr size_t MIN_MATCH = 4;
+    // 블록의 마지막 5 byte 는 항상 literal, 마지막 match 는 끝에서 12 byte 이전에 시작
+    constexpr size_t LAST_LITERALS = 5;
+    constexpr size_t MATCH_FIND_LIMIT = 12;
+    constexpr size_t MAX_OFFSET = 65535;
+    constexpr uint32_t HASH_BITS = 16;
+    constexpr uint8_t RUN_MASK = 15;
+
+    uint32_t read32(const uint8_t* source) {
+        uint32_t value;
+        std::memcpy(&value, source, sizeof(value));
+        return value;
+    }
+
+    uint32_t hash(uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    void writeLength(std::vector<char>& output, size_t length) {
+        while (length >= 255) {
+            output.push_back(static_cast<char>(255));
+            length -= 255;
+        }
+        output.push_back(static_cast<char>(length));
+    }
+
+    // matchLength 가 0 이면 literal 만 있는 마지막 sequence
+    void writeSequence(std::vector<char>& output, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength) {
+        const size_t matchCode = matchLength == 0 ? 0 : matchLength - MIN_MATCH;
+        const uint8_t token = static_cast<uint8_t>(
+            (literalLength < RUN_MASK ? literalLength : RUN_MASK) << 4 | (matchCode < RUN_MASK ? matchCode : RUN_MASK)
+        );
+        output.push_back(static_cast<char>(token));
+
+        if (literalLength >= RUN_MASK) {
+            writeLength(output, literalLength - RUN_MASK);
+        }
+        output.insert(output.end(), literals, literals + literalLength);
+
+        if (matchLength == 0) {
+            return;
+        }
+        output.push_back(static_cast<char>(offset & 0xFF));
+        output.push_back(static_cast<char>(offset >> 8));
+
+        if (matchCode >= RUN_MASK) {
+            writeLength(output, matchCode - RUN_MASK);
+        }
+    }
+
+    bool readLength(const uint8_t*& input, const uint8_t* inputEnd, size_t& length) {
+        uint8_t value;
+        do {
+            if (input >= inputEnd) {
+                return false;
+            }
+            value = *input++;
+            length += value;
+        } while (value == 255);
+        return true;
+    }
+}
+
+size_t Lz4::getMaxCompressedSize(size_t sourceSize) {
+    return sourceSize + sourceSize / 255 + 16;
+}
+
+std::vector<char> Lz4::compress(std::span<const char> source) {
+    const auto* input = reinterpret_cast<const uint8_t*>(source.data());
+    const size_t size = source.size();
+
+    std::vector<char> output {};
+    output.reserve(getMaxCompressedSize(size));
+
+    size_t anchor = 0;
+
+    if (size > MATCH_FIND_LIMIT) {
+        // 위치 + 1 을 저장 (0 은 빈 칸)
+        std::vector<uint32_t> hashTable(size_t { 1 } << HASH_BITS, 0);
+        const size_t matchLimit = size - LAST_LITERALS;
+        size_t position = 0;
+
+        while (position + MATCH_FIND_LIMIT < size) {
+            const uint32_t sequence = read32(input + position);
+            uint32_t& slot = hashTable[hash(sequence)];
+            const size_t candidate = slot;
+            slot = static_cast<uint32_t>(position + 1);
+
+            if (candidate == 0 || position - (candidate - 1) > MAX_OFFSET || read32(input + candidate - 1) != sequence) {
+                position++;
+                continue;
+            }
+            size_t match = candidate - 1;
+            size_t matchLength = MIN_MATCH;
+
+            while (position + matchLength < matchLimit && input[match + matchLength] == input[position + matchLength]) {
+                matchLength++;
+            }
+            while (position > anchor && match > 0 && input[position - 1] == input[match - 1]) {
+                position--;
+                match--;
+                matchLength++;
+            }
+            writeSequence(output, input + anchor, position - anchor, position - match, matchLength);
+
+            position += matchLength;
+            anchor = position;
+        }
+    }
+    writeSequence(output, input + anchor, size - anchor, 0, 0);
+    return output;
+}
+
+bool Lz4::decompress(std::span<const char> source, std::span<char> destination) {
+    const auto* input = reinterpret_cast<const uint8_t*>(source.data());
+    const uint8_t* inputEnd = input + source.size();
+    auto* outputBegin = reinterpret_cast<uint8_t*>(destination.data());
+    uint8_t* output = outputBegin;
+    uint8_t* outputEnd = outputBegin + destination.size();
+
+    while (input < inputEnd) {
+        const uint8_t token = *input++;
+        size_t literalLength = token >> 4;
+
+        if (literalLength == RUN_MASK && !readLength(input, inputEnd, literalLength)) {
+            return false;
+        }
+        if (literalLength > static_cast<size_t>(inputEnd - input) || literalLength > static_cast<size_t>(outputEnd - output)) {
+            return false;
+        }
+        if (literalLength > 0) {
+            std::memcpy(output, input, literalLength);
+        }
+        input += literalLength;
+        output += literalLength;
+
+        // 마지막 sequence 는 literal 로 끝남
+        if (input == inputEnd) {
+            break;
+        }
+        if (inputEnd - input < 2) {
+            return false;
+        }
+        const size_t offset = input[0] | input[1] << 8;
+        input += 2;
+
+        if (offset == 0 || offset > static_cast<size_t>(output - outputBegin)) {
+            return false;
+        }
+        size_t matchLength = token & RUN_MASK;
+
+        if (matchLength == RUN_MASK && !readLength(input, inputEnd, matchLength)) {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+
+        if (matchLength > static_cast<size_t>(outputEnd - output)) {
+            return false;
+        }
+        const uint8_t* match = output - offset;
+
+        if (offset >= matchLength) {
+            std::memcpy(output, match, matchLength);
+        } else {
+            // 겹치는 구간은 반복 패턴이므로 byte 단위 복사
+            for (size_t index = 0; index < matchLength; index++) {
+                output[index] = match[index];
+            }
+        }
+        output += matchLength;
+    }
+    return output == outputEnd;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// LZ4 block 포맷 (frame header 없음). 원본 크기는 호출자가 따로 저장
+namespace Lz4 {
+
+    size_t getMaxCompressedSize(size_t sourceSize);
+
+    std::vector<char> compress(std::span<const char> source);
+
+    // destination 은 정확히 원본 크기여야 함. 손상된 입력이면 false
+    bool decompress(std::span<const char> source, std::span<char> destination);
+}
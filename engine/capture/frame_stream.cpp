@@ -0,0 +1,93 @@
+#include "frame_stream.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "../util/binary_file_utils.h"
+
+namespace {
+    constexpr uint32_t STREAM_MAGIC = 0x50414346; // "FCAP"
+    constexpr uint32_t STREAM_VERSION = 1;
+
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t frameCount;
+        uint32_t reserved;
+    };
+
+    // struct padding 없이 5 byte
+    constexpr size_t COMMAND_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint32_t);
+}
+
+FrameStreamWriter::FrameStreamWriter(const std::filesystem::path& path)
+    : m_file(path, std::ios::binary | std::ios::trunc) {
+    if (!m_file) {
+        throw std::runtime_error("failed to open frame capture file: " + path.string());
+    }
+    const FileHeader header { STREAM_MAGIC, STREAM_VERSION, 0, 0 };
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+}
+
+FrameStreamWriter::~FrameStreamWriter() {
+    const FileHeader header { STREAM_MAGIC, STREAM_VERSION, m_frameCount, 0 };
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+}
+
+void FrameStreamWriter::write(FrameCommandType type, std::span<const char> payload) {
+    m_frame.push_back(static_cast<char>(type));
+    ByteStreams::write(m_frame, static_cast<uint32_t>(payload.size()));
+    m_frame.insert(m_frame.end(), payload.begin(), payload.end());
+}
+
+void FrameStreamWriter::writeIfChanged(FrameCommandType type, std::span<const char> payload) {
+    std::vector<char>& lastPayload = m_lastPayloads[static_cast<size_t>(type)];
+
+    if (std::ranges::equal(lastPayload, payload)) {
+        return;
+    }
+    lastPayload.assign(payload.begin(), payload.end());
+    write(type, payload);
+}
+
+void FrameStreamWriter::endFrame() {
+    write(FrameCommandType::END_FRAME);
+    m_file.write(m_frame.data(), static_cast<std::streamsize>(m_frame.size()));
+    m_frame.clear();
+
+    if (!m_file) {
+        throw std::runtime_error("failed to write frame capture!");
+    }
+    m_frameCount++;
+}
+
+FrameStreamReader::FrameStreamReader(const std::filesystem::path& path) {
+    m_contents = BinaryFileUtils::readBinaryFile(path.string().c_str()).contents;
+    std::span<const char> input { m_contents };
+    FileHeader header {};
+
+    if (!ByteStreams::read(input, header) || header.magic != STREAM_MAGIC || header.version != STREAM_VERSION) {
+        throw std::runtime_error("invalid frame capture file: " + path.string());
+    }
+    m_commands.reserve(input.size() / COMMAND_HEADER_SIZE);
+
+    while (input.size() >= COMMAND_HEADER_SIZE) {
+        uint8_t type = 0;
+        uint32_t size = 0;
+        ByteStreams::read(input, type);
+        ByteStreams::read(input, size);
+
+        if (type >= static_cast<uint8_t>(FrameCommandType::COUNT) || size > input.size()) {
+            throw std::runtime_error("corrupted frame capture file: " + path.string());
+        }
+        m_commands.push_back({ static_cast<FrameCommandType>(type), input.first(size) });
+        input = input.subspan(size);
+
+        if (m_commands.back().type == FrameCommandType::END_FRAME) {
+            m_frameOffsets.push_back(static_cast<uint32_t>(m_commands.size()));
+        }
+    }
+    // 캡처 도중 종료되어 끝나지 않은 frame 은 버림
+    m_commands.resize(m_frameOffsets.back());
+}
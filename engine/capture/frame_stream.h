@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+#include "../util/byte_streams.h"
+
+// render backend 가 frame 마다 application / scene 에서 받는 입력. 재생은 이것만으로 같은 작업을 다시 만듦
+enum class FrameCommandType : uint8_t {
+    // FrameBegin
+    BEGIN_FRAME,
+    // CullingView
+    SET_VIEW,
+    // glm::mat4[] (SceneGraph 의 instance 순서)
+    UPLOAD_INSTANCES,
+    // OcclusionCuller::serializeObjects
+    SET_OCCLUDERS,
+    // ParticleSystem::serializeState
+    SET_PARTICLES,
+    // AtlasUploadHeader + RGBA8 pixels
+    UPLOAD_ATLAS,
+    // uint32_t batchCount + SpriteDrawBatch[] + SpriteVertex[]
+    DRAW_SPRITES,
+    END_FRAME,
+    COUNT,
+};
+
+struct FrameBegin {
+    float deltaTime;
+    // 재생해도 같은 입자가 생성되도록 frame 시작 시점의 seed
+    uint32_t particleSeed;
+};
+
+struct AtlasUploadHeader {
+    uint32_t page;
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+};
+
+struct FrameCommand {
+    FrameCommandType type;
+    // reader 가 가진 파일 내용을 가리킴
+    std::span<const char> payload;
+};
+
+// 재생 결과. frame 시간은 이전 frame 시작부터의 간격 (GPU 가 밀리면 fence 대기 시간이 포함됨)
+struct FrameReplayStats {
+    uint32_t frameCount;
+    double totalMilliseconds;
+    double averageFrameMilliseconds;
+    double minFrameMilliseconds;
+    double maxFrameMilliseconds;
+    // command 기록과 submit 에 쓴 CPU 시간
+    double averageRecordMilliseconds;
+};
+
+// frame 단위로 command 를 모아 파일에 씀. 파일 포맷: FileHeader, 이어서 [type u8 | size u32 | payload] 반복
+// render thread 에서만 사용
+class FrameStreamWriter {
+public:
+    explicit FrameStreamWriter(const std::filesystem::path& path);
+
+    FrameStreamWriter(const FrameStreamWriter&) = delete;
+    FrameStreamWriter& operator=(const FrameStreamWriter&) = delete;
+
+    // header 의 frame 수를 채우고 닫음
+    ~FrameStreamWriter();
+
+    void write(FrameCommandType type, std::span<const char> payload = {});
+
+    template<typename T>
+    void writeValue(FrameCommandType type, const T& value) {
+        m_scratch.clear();
+        ByteStreams::write(m_scratch, value);
+        write(type, m_scratch);
+    }
+
+    // 같은 type 의 직전 payload 와 같으면 생략 (camera, emitter 처럼 대부분의 frame 에서 그대로인 상태)
+    void writeIfChanged(FrameCommandType type, std::span<const char> payload);
+
+    template<typename T>
+    void writeValueIfChanged(FrameCommandType type, const T& value) {
+        m_scratch.clear();
+        ByteStreams::write(m_scratch, value);
+        writeIfChanged(type, m_scratch);
+    }
+
+    // END_FRAME 을 붙여 frame 을 파일로 내보냄
+    void endFrame();
+
+    [[nodiscard]]
+    uint32_t getFrameCount() const {
+        return m_frameCount;
+    }
+
+private:
+    std::ofstream               m_file;
+    // 이번 frame 의 command. endFrame 에서 한 번에 씀
+    std::vector<char>           m_frame;
+    std::vector<char>           m_scratch;
+    std::array<std::vector<char>, static_cast<size_t>(FrameCommandType::COUNT)> m_lastPayloads;
+    uint32_t                    m_frameCount = 0;
+};
+
+// 파일 전체를 읽어 frame 별 command 목록으로 나눠 둠. 재생 loop 는 파싱하지 않음
+class FrameStreamReader {
+public:
+    explicit FrameStreamReader(const std::filesystem::path& path);
+
+    [[nodiscard]]
+    uint32_t getFrameCount() const {
+        return static_cast<uint32_t>(m_frameOffsets.size()) - 1;
+    }
+
+    // BEGIN_FRAME 부터 END_FRAME 까지
+    [[nodiscard]]
+    std::span<const FrameCommand> getFrame(uint32_t index) const {
+        return std::span { m_commands }.subspan(m_frameOffsets[index], m_frameOffsets[index + 1] - m_frameOffsets[index]);
+    }
+
+private:
+    std::vector<char>           m_contents;
+    std::vector<FrameCommand>   m_commands;
+    // frame i 의 command 는 [m_frameOffsets[i], m_frameOffsets[i + 1])
+    std::vector<uint32_t>       m_frameOffsets { 0 };
+};
@@ -0,0 +1,282 @@
+#include "readback_ring.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "../texture/texture_supports.h"
+
+ReadbackRing::ReadbackRing(
+    VkPhysicalDevice physicalDevice,
+    VkDevice device,
+    DeletionQueue& deletionQueue,
+    JobSystem& jobSystem,
+    ReadbackConfig config
+) : m_physicalDevice(physicalDevice), m_device(device), m_deletionQueue(deletionQueue), m_jobSystem(jobSystem),
+    m_slots(std::make_unique<Slot[]>(std::max(config.slotCount, 1u))), m_slotCount(std::max(config.slotCount, 1u)) {}
+
+ReadbackRing::~ReadbackRing() {
+    m_jobSystem.wait(m_callbackCounter);
+
+    for (uint32_t i = 0; i < m_slotCount; i++) {
+        destroy(m_slots[i]);
+    }
+}
+
+uint32_t ReadbackRing::getTexelSize(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+            return 4;
+        case VK_FORMAT_R16G16B16A16_SFLOAT:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+bool ReadbackRing::record(
+    VkCommandBuffer commandBuffer,
+    VkImage image,
+    VkImageLayout layout,
+    VkFormat format,
+    VkExtent2D extent,
+    uint64_t frame,
+    ReadbackCallback callback
+) {
+    const uint32_t texelSize = getTexelSize(format);
+
+    if (texelSize == 0 || extent.width == 0 || extent.height == 0) {
+        return false;
+    }
+    Slot* freeSlot = nullptr;
+
+    // callback 은 완료 순서가 제각각이므로 ring 순서대로 비어 있는 slot 을 찾음
+    for (uint32_t i = 0; i < m_slotCount; i++) {
+        Slot& slot = m_slots[(m_nextSlot + i) % m_slotCount];
+
+        if (slot.state.load(std::memory_order_acquire) == SlotState::FREE) {
+            freeSlot = &slot;
+            m_nextSlot = (m_nextSlot + i + 1) % m_slotCount;
+            break;
+        }
+    }
+    // render loop 를 막지 않도록 기다리지 않고 건너뜀
+    if (freeSlot == nullptr) {
+        m_droppedCount++;
+        return false;
+    }
+    Slot& slot = *freeSlot;
+    const VkDeviceSize size = VkDeviceSize { extent.width } * extent.height * texelSize;
+    reserve(slot, size);
+
+    // image 는 color attachment 로 마지막에 쓰였다고 가정
+    TextureSupports::recordImageBarrier(
+        commandBuffer,
+        TextureSupports::createImageMemoryBarrier(
+            image, 0, 1, layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT
+        ),
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT
+    );
+    const VkBufferImageCopy region = TextureSupports::createBufferImageCopy(0, 0, extent);
+    vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, slot.allocation.buffer, 1, &region);
+
+    // present 등 이후 사용은 semaphore 로 동기화되므로 layout 만 되돌림
+    TextureSupports::recordImageBarrier(
+        commandBuffer,
+        TextureSupports::createImageMemoryBarrier(
+            image, 0, 1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, layout,
+            VK_ACCESS_TRANSFER_READ_BIT, 0
+        ),
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+    );
+    // fence 대기 후 host 에서 읽을 수 있도록 transfer write 를 가시화
+    VkBufferMemoryBarrier bufferBarrier {};
+    bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufferBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.buffer = slot.allocation.buffer;
+    bufferBarrier.offset = 0;
+    bufferBarrier.size = size;
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        0, nullptr,
+        1, &bufferBarrier,
+        0, nullptr
+    );
+    slot.frame = frame;
+    slot.extent = extent;
+    slot.format = format;
+    slot.size = size;
+    slot.callback = std::move(callback);
+    slot.state.store(SlotState::COPYING, std::memory_order_relaxed);
+    m_pendingCount++;
+    return true;
+}
+
+void ReadbackRing::collect(uint64_t completedFrame) {
+    if (m_pendingCount == 0) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < m_slotCount; i++) {
+        Slot& slot = m_slots[i];
+
+        if (slot.state.load(std::memory_order_relaxed) != SlotState::COPYING || slot.frame > completedFrame) {
+            continue;
+        }
+        // HOST_CACHED 이면서 coherent 가 아닐 수 있으므로 항상 invalidate (coherent 이면 무시됨)
+        VkMappedMemoryRange range {};
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.memory = slot.allocation.memory;
+        range.offset = 0;
+        range.size = VK_WHOLE_SIZE;
+
+        if (vkInvalidateMappedMemoryRanges(m_device, 1, &range) != VK_SUCCESS) {
+            throw std::runtime_error("failed to invalidate readback memory!");
+        }
+        slot.state.store(SlotState::PROCESSING, std::memory_order_relaxed);
+        m_pendingCount--;
+
+        m_jobSystem.run([&slot]() {
+            const ReadbackImage image {
+                slot.frame,
+                slot.extent,
+                slot.format,
+                std::span<const uint8_t>(slot.mapped, static_cast<size_t>(slot.size)),
+            };
+
+            try {
+                slot.callback(image);
+            } catch (const std::exception& ex) {
+                std::cerr << "readback callback failed: " << ex.what() << std::endl;
+            }
+            slot.callback = nullptr;
+            slot.state.store(SlotState::FREE, std::memory_order_release);
+        }, &m_callbackCounter);
+    }
+}
+
+void ReadbackRing::reserve(Slot& slot, VkDeviceSize size) {
+    if (size <= slot.allocation.size) {
+        return;
+    }
+    // 이전 buffer 는 마지막 복사가 collect 된 뒤라 GPU 가 더 이상 쓰지 않음
+    destroy(slot);
+
+    constexpr VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    // CPU 가 읽는 memory 는 cached 가 훨씬 빠름. 없으면 coherent 로 대체
+    try {
+        slot.allocation = MemorySupports::createBuffer(
+            m_physicalDevice, m_device, size, usage,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+            m_deletionQueue.getMemoryBudget(), MemoryCategory::TRANSIENT
+        );
+    } catch (const std::runtime_error&) {
+        slot.allocation = MemorySupports::createBuffer(
+            m_physicalDevice, m_device, size, usage,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            m_deletionQueue.getMemoryBudget(), MemoryCategory::TRANSIENT
+        );
+    }
+    void* mapped = nullptr;
+
+    if (vkMapMemory(m_device, slot.allocation.memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+        throw std::runtime_error("failed to map readback buffer!");
+    }
+    slot.mapped = static_cast<uint8_t*>(mapped);
+}
+
+void ReadbackRing::destroy(Slot& slot) {
+    if (slot.allocation.buffer == VK_NULL_HANDLE) {
+        return;
+    }
+    // 매핑은 vkFreeMemory 에서 함께 해제됨
+    m_deletionQueue.retire(slot.allocation.buffer);
+    m_deletionQueue.retire(slot.allocation.memory);
+    slot.allocation = {};
+    slot.mapped = nullptr;
+}
+
+namespace ReadbackWriters {
+
+    void writeTga(const std::string& path, const ReadbackImage& image) {
+        bool isBgra;
+
+        switch (image.format) {
+            case VK_FORMAT_B8G8R8A8_UNORM:
+            case VK_FORMAT_B8G8R8A8_SRGB:
+                isBgra = true;
+                break;
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+                isBgra = false;
+                break;
+            default:
+                throw std::runtime_error("unsupported readback format for tga: " + path);
+        }
+        const uint32_t width = image.extent.width;
+        const uint32_t height = image.extent.height;
+
+        if (width > 0xFFFF || height > 0xFFFF || image.pixels.size() < size_t { width } * height * 4) {
+            throw std::runtime_error("invalid readback image for tga: " + path);
+        }
+        // swapchain alpha 는 의미가 없으므로 24bit 로 저장
+        uint8_t header[18] {};
+        header[2] = 2;
+        header[12] = static_cast<uint8_t>(width);
+        header[13] = static_cast<uint8_t>(width >> 8);
+        header[14] = static_cast<uint8_t>(height);
+        header[15] = static_cast<uint8_t>(height >> 8);
+        header[16] = 24;
+        // 좌상단 원점
+        header[17] = 0x20;
+
+        std::vector<char> row(size_t { width } * 3);
+        std::ofstream file(path, std::ios::binary);
+
+        if (!file) {
+            throw std::runtime_error("failed to open file: " + path);
+        }
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+        for (uint32_t y = 0; y < height; y++) {
+            const uint8_t* source = image.pixels.data() + size_t { y } * width * 4;
+
+            for (uint32_t x = 0; x < width; x++) {
+                const uint8_t* texel = source + x * 4;
+                row[x * 3 + 0] = static_cast<char>(isBgra ? texel[0] : texel[2]);
+                row[x * 3 + 1] = static_cast<char>(texel[1]);
+                row[x * 3 + 2] = static_cast<char>(isBgra ? texel[2] : texel[0]);
+            }
+            file.write(row.data(), static_cast<std::streamsize>(row.size()));
+        }
+
+        if (!file) {
+            throw std::runtime_error("failed to write file: " + path);
+        }
+    }
+
+    ReadbackCallback createTgaWriter(std::string directory, std::string prefix) {
+        return [directory = std::move(directory), prefix = std::move(prefix)](const ReadbackImage& image) {
+            std::filesystem::create_directories(directory);
+            const std::filesystem::path path = std::filesystem::path(directory) / (prefix + std::to_string(image.frame) + ".tga");
+            writeTga(path.string(), image);
+        };
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vulkan/vulkan_core.h>
+
+#include "../memory/memory_supports.h"
+#include "../resource/deletion_queue.h"
+#include "../thread/job_system.h"
+
+struct ReadbackImage {
+    uint64_t frame;
+    VkExtent2D extent;
+    VkFormat format;
+    // row 사이 padding 없는 픽셀. callback 이 반환되면 무효
+    std::span<const uint8_t> pixels;
+};
+
+// worker 스레드에서 호출됨
+using ReadbackCallback = std::function<void(const ReadbackImage& image)>;
+
+struct ReadbackConfig {
+    // 동시에 진행 가능한 readback 수. 모두 사용 중이면 새 요청은 건너뜀
+    uint32_t slotCount = 4;
+};
+
+// image 를 persistent mapped host buffer ring 으로 복사하고, GPU 가 해당 frame 을 끝낸 뒤
+// job system 에서 callback 을 호출. render loop 는 복사 완료를 기다리지 않음
+class ReadbackRing {
+public:
+    ReadbackRing(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        DeletionQueue& deletionQueue,
+        JobSystem& jobSystem,
+        ReadbackConfig config = {}
+    );
+
+    ReadbackRing(const ReadbackRing&) = delete;
+    ReadbackRing& operator=(const ReadbackRing&) = delete;
+
+    // 진행 중인 callback 이 끝날 때까지 대기
+    ~ReadbackRing();
+
+    // layout 상태의 image 를 비어 있는 slot 으로 복사하는 명령을 기록하고 원래 layout 으로 되돌림
+    // 남는 slot 이 없거나 지원하지 않는 format 이면 false
+    bool record(
+        VkCommandBuffer commandBuffer,
+        VkImage image,
+        VkImageLayout layout,
+        VkFormat format,
+        VkExtent2D extent,
+        uint64_t frame,
+        ReadbackCallback callback
+    );
+
+    // completedFrame 이하에서 기록된 복사의 callback 을 worker 로 넘김 (render thread 에서 frame 마다 호출)
+    void collect(uint64_t completedFrame);
+
+    [[nodiscard]]
+    uint32_t getPendingCount() const {
+        return m_pendingCount;
+    }
+
+    // slot 이 부족해 건너뛴 요청 수
+    [[nodiscard]]
+    uint64_t getDroppedCount() const {
+        return m_droppedCount;
+    }
+
+    // 지원하지 않는 format 이면 0
+    static uint32_t getTexelSize(VkFormat format);
+
+private:
+    enum class SlotState : uint8_t {
+        FREE,
+        // GPU 복사 대기
+        COPYING,
+        // worker 가 callback 실행 중
+        PROCESSING,
+    };
+
+    struct Slot {
+        BufferAllocation allocation;
+        uint8_t* mapped = nullptr;
+        std::atomic<SlotState> state = SlotState::FREE;
+        uint64_t frame = 0;
+        VkExtent2D extent {};
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        VkDeviceSize size = 0;
+        ReadbackCallback callback;
+    };
+
+    void reserve(Slot& slot, VkDeviceSize size);
+    void destroy(Slot& slot);
+
+    VkPhysicalDevice            m_physicalDevice;
+    VkDevice                    m_device;
+    DeletionQueue&              m_deletionQueue;
+    JobSystem&                  m_jobSystem;
+
+    std::unique_ptr<Slot[]>     m_slots;
+    uint32_t                    m_slotCount;
+    uint32_t                    m_nextSlot = 0;
+    uint32_t                    m_pendingCount = 0;
+    uint64_t                    m_droppedCount = 0;
+    JobCounter                  m_callbackCounter;
+};
+
+namespace ReadbackWriters {
+
+    // 24bit BGR 비압축 TGA (좌상단 원점) 로 저장
+    void writeTga(const std::string& path, const ReadbackImage& image);
+
+    // directory/<prefix><frame>.tga 로 저장하는 callback
+    ReadbackCallback createTgaWriter(std::string directory, std::string prefix = "frame_");
+}
@@ -0,0 +1,58 @@
+#include "culling_bounds.h"
+
+namespace {
+    template<typename Function>
+    void forEachComponent(CullingBounds& bounds, Function&& function) {
+        for (std::vector<float>* component : {
+            &bounds.centerX, &bounds.centerY, &bounds.centerZ, &bounds.radius,
+            &bounds.minX, &bounds.minY, &bounds.minZ, &bounds.maxX, &bounds.maxY, &bounds.maxZ,
+        }) {
+            function(*component);
+        }
+    }
+}
+
+void CullingBounds::reserve(size_t capacity) {
+    forEachComponent(*this, [&](std::vector<float>& component) {
+        component.reserve(capacity);
+    });
+}
+
+uint32_t CullingBounds::add(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    const auto index = static_cast<uint32_t>(size());
+
+    forEachComponent(*this, [](std::vector<float>& component) {
+        component.push_back(0.0f);
+    });
+    set(index, boundsMin, boundsMax);
+    return index;
+}
+
+void CullingBounds::set(uint32_t index, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    const glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+
+    centerX[index] = center.x;
+    centerY[index] = center.y;
+    centerZ[index] = center.z;
+    radius[index] = glm::length(boundsMax - center);
+
+    minX[index] = boundsMin.x;
+    minY[index] = boundsMin.y;
+    minZ[index] = boundsMin.z;
+    maxX[index] = boundsMax.x;
+    maxY[index] = boundsMax.y;
+    maxZ[index] = boundsMax.z;
+}
+
+void CullingBounds::swapRemove(uint32_t index) {
+    forEachComponent(*this, [&](std::vector<float>& component) {
+        component[index] = component.back();
+        component.pop_back();
+    });
+}
+
+void CullingBounds::clear() {
+    forEachComponent(*this, [](std::vector<float>& component) {
+        component.clear();
+    });
+}
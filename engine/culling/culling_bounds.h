@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// 컬링 대상의 bounding sphere / AABB 를 성분별 배열 (SoA) 로 저장
+// SIMD 커널이 4~8 개 객체를 한 번에 로드할 수 있도록 성분마다 연속 메모리
+struct CullingBounds {
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> radius;
+
+    std::vector<float> minX;
+    std::vector<float> minY;
+    std::vector<float> minZ;
+    std::vector<float> maxX;
+    std::vector<float> maxY;
+    std::vector<float> maxZ;
+
+    void reserve(size_t capacity);
+
+    // AABB 로부터 외접 sphere 를 계산해 함께 저장
+    uint32_t add(const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+    void set(uint32_t index, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+    // 마지막 요소를 index 로 옮김 (호출자가 index 매핑 갱신)
+    void swapRemove(uint32_t index);
+
+    void clear();
+
+    [[nodiscard]]
+    size_t size() const {
+        return radius.size();
+    }
+};
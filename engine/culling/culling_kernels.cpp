@@ -0,0 +1,285 @@
+#include "culling_kernels.h"
+
+#include <bit>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define CULLING_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CULLING_SSE 1
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define CULLING_NEON 1
+#endif
+
+namespace {
+    // 평면 normal 부호에 따라 AABB 에서 평면 쪽으로 가장 먼 꼭짓점 (positive vertex) 의 성분 배열 선택
+    struct PlaneVertex {
+        const float* x;
+        const float* y;
+        const float* z;
+    };
+
+    PlaneVertex getPositiveVertex(const glm::vec4& plane, const CullingBounds& bounds) {
+        return {
+            plane.x >= 0.0f ? bounds.maxX.data() : bounds.minX.data(),
+            plane.y >= 0.0f ? bounds.maxY.data() : bounds.minY.data(),
+            plane.z >= 0.0f ? bounds.maxZ.data() : bounds.minZ.data(),
+        };
+    }
+
+    // mask 의 set bit 마다 base + bit 를 기록
+    uint32_t writeVisible(uint32_t mask, uint32_t base, uint32_t* output) {
+        uint32_t count = 0;
+
+        while (mask) {
+            output[count++] = base + static_cast<uint32_t>(std::countr_zero(mask));
+            mask &= mask - 1;
+        }
+        return count;
+    }
+}
+
+uint32_t CullingKernels::cullSpheresScalar(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output) {
+    uint32_t count = 0;
+
+    for (uint32_t index = begin; index < end; index++) {
+        bool isVisible = true;
+
+        for (const glm::vec4& plane : frustum.planes) {
+            const float distance = plane.x * bounds.centerX[index] + plane.y * bounds.centerY[index] + plane.z * bounds.centerZ[index] + plane.w;
+            isVisible &= distance >= -bounds.radius[index];
+        }
+        output[count] = index;
+        count += isVisible;
+    }
+    return count;
+}
+
+uint32_t CullingKernels::cullAabbsScalar(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output) {
+    PlaneVertex vertices[Frustum::PLANE_COUNT];
+
+    for (uint32_t plane = 0; plane < Frustum::PLANE_COUNT; plane++) {
+        vertices[plane] = getPositiveVertex(frustum.planes[plane], bounds);
+    }
+    uint32_t count = 0;
+
+    for (uint32_t index = begin; index < end; index++) {
+        bool isVisible = true;
+
+        for (uint32_t plane = 0; plane < Frustum::PLANE_COUNT; plane++) {
+            const glm::vec4& p = frustum.planes[plane];
+            const PlaneVertex& vertex = vertices[plane];
+            isVisible &= p.x * vertex.x[index] + p.y * vertex.y[index] + p.z * vertex.z[index] + p.w >= 0.0f;
+        }
+        output[count] = index;
+        count += isVisible;
+    }
+    return count;
+}
+
+#if defined(CULLING_AVX2)
+
+uint32_t CullingKernels::getSimdWidth() {
+    return 8;
+}
+
+const char* CullingKernels::getSimdName() {
+    return "AVX2";
+}
+
+uint32_t CullingKernels::cullSpheres(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output) {
+    uint32_t count = 0;
+    uint32_t index = begin;
+
+    for (; index + 8 <= end; index += 8) {
+        const __m256 x = _mm256_loadu_ps(&bounds.centerX[index]);
+        const __m256 y = _mm256_loadu_ps(&bounds.centerY[index]);
+        const __m256 z = _mm256_loadu_ps(&bounds.centerZ[index]);
+        const __m256 negativeRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&bounds.radius[index]));
+
+        __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (const glm::vec4& plane : frustum.planes) {
+            __m256 distance = _mm256_fmadd_ps(x, _mm256_set1_ps(plane.x), _mm256_set1_ps(plane.w));
+            distance = _mm256_fmadd_ps(y, _mm256_set1_ps(plane.y), distance);
+            distance = _mm256_fmadd_ps(z, _mm256_set1_ps(plane.z), distance);
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, negativeRadius, _CMP_GE_OQ));
+        }
+        count += writeVisible(static_cast<uint32_t>(_mm256_movemask_ps(visible)), index, output + count);
+    }
+    return count + cullSpheresScalar(frustum, bounds, index, end, output + count);
+}
+
+uint32_t CullingKernels::cullAabbs(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output) {
+    PlaneVertex vertices[Frustum::PLANE_COUNT];
+
+    for (uint32_t plane = 0; plane < Frustum::PLANE_COUNT; plane++) {
+        vertices[plane] = getPositiveVertex(frustum.planes[plane], bounds);
+    }
+    uint32_t count = 0;
+    uint32_t index = begin;
+
+    for (; index + 8 <= end; index += 8) {
+        __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (uint32_t plane = 0; plane < Frustum::PLANE_COUNT; plane++) {
+            const glm::vec4& p = frustum.planes[plane];
+            const PlaneVertex& vertex = vertices[plane];
+
+            __m256 distance = _mm256_fmadd_ps(_mm256_loadu_ps(vertex.x + index), _mm256_set1_ps(p.x), _mm256_set1_ps(p.w));
+            distance = _mm256_fmadd_ps(_mm256_loadu_ps(vertex.y + index), _mm256_set1_ps(p.y), distance);
+            distance = _mm256_fmadd_ps(_mm256_loadu_ps(vertex.z + index), _mm256_set1_ps(p.z), distance);
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        count += writeVisible(static_cast<uint32_t>(_mm256_movemask_ps(visible)), index, output + count);
+    }
+    return count + cullAabbsScalar(frustum, bounds, index, end, output + count);
+}
+
+#elif defined(CULLING_SSE)
+
+uint32_t CullingKernels::getSimdWidth() {
+    return 4;
+}
+
+const char* CullingKernels::getSimdName() {
+    return "SSE2";
+}
+
+uint32_t CullingKernels::cullSpheres(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output) {
+    uint32_t count = 0;
+    uint32_t index = begin;
+
+    for (; index + 4 <= end; index += 4) {
+        const __m128 x = _mm_loadu_ps(&bounds.centerX[index]);
+        const __m128 y = _mm_loadu_ps(&bounds.centerY[index]);
+        const __m128 z = _mm_loadu_ps(&bounds.centerZ[index]);
+        const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&bounds.radius[index]));
+
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (const glm::vec4& plane : frustum.planes) {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+            distance = _mm_add_ps(_mm_mul_ps(y, _mm_set1_ps(plane.y)), distance);
+            distance = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane.z)), distance);
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, negativeRadius));
+        }
+        count += writeVisible(static_cast<uint32_t>(_mm_movemask_ps(visible)), index, output + count);
+    }
+    return count + cullSpheresScalar(frustum, bounds, index, end, output + count);
+}
+
+uint32_t CullingKernels::cullAabbs(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output) {
+    PlaneVertex vertices[Frustum::PLANE_COUNT];
+
+    for (uint32_t plane = 0; plane < Frustum::PLANE_COUNT; plane++) {
+        vertices[plane] = getPositiveVertex(frustum.planes[plane], bounds);
+    }
+    uint32_t count = 0;
+    uint32_t index = begin;
+
+    for (; index + 4 <= end; index += 4) {
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (uint32_t plane = 0; plane < Frustum::PLANE_COUNT; plane++) {
+            const glm::vec4& p = frustum.planes[plane];
+            const PlaneVertex& vertex = vertices[plane];
+
+            __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vertex.x + index), _mm_set1_ps(p.x)), _mm_set1_ps(p.w));
+            distance = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vertex.y + index), _mm_set1_ps(p.y)), distance);
+            distance = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vertex.z + index), _mm_set1_ps(p.z)), distance);
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+        }
+        count += writeVisible(static_cast<uint32_t>(_mm_movemask_ps(visible)), index, output + count);
+    }
+    return count + cullAabbsScalar(frustum, bounds, index, end, output + count);
+}
+
+#elif defined(CULLING_NEON)
+
+namespace {
+    // NEON 에는 movemask 가 없으므로 lane 별 bit 를 더해서 만듦
+    uint32_t getLaneMask(uint32x4_t visible) {
+        static constexpr uint32_t LANE_BITS[4] = { 1, 2, 4, 8 };
+        return vaddvq_u32(vandq_u32(visible, vld1q_u32(LANE_BITS)));
+    }
+}
+
+uint32_t CullingKernels::getSimdWidth() {
+    return 4;
+}
+
+const char* CullingKernels::getSimdName() {
+    return "NEON";
+}
+
+uint32_t CullingKernels::cullSpheres(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output) {
+    uint32_t count = 0;
+    uint32_t index = begin;
+
+    for (; index + 4 <= end; index += 4) {
+        const float32x4_t x = vld1q_f32(&bounds.centerX[index]);
+        const float32x4_t y = vld1q_f32(&bounds.centerY[index]);
+        const float32x4_t z = vld1q_f32(&bounds.centerZ[index]);
+        const float32x4_t negativeRadius = vnegq_f32(vld1q_f32(&bounds.radius[index]));
+
+        uint32x4_t visible = vdupq_n_u32(UINT32_MAX);
+
+        for (const glm::vec4& plane : frustum.planes) {
+            float32x4_t distance = vfmaq_n_f32(vdupq_n_f32(plane.w), x, plane.x);
+            distance = vfmaq_n_f32(distance, y, plane.y);
+            distance = vfmaq_n_f32(distance, z, plane.z);
+            visible = vandq_u32(visible, vcgeq_f32(distance, negativeRadius));
+        }
+        count += writeVisible(getLaneMask(visible), index, output + count);
+    }
+    return count + cullSpheresScalar(frustum, bounds, index, end, output + count);
+}
+
+uint32_t CullingKernels::cullAabbs(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output) {
+    PlaneVertex vertices[Frustum::PLANE_COUNT];
+
+    for (uint32_t plane = 0; plane < Frustum::PLANE_COUNT; plane++) {
+        vertices[plane] = getPositiveVertex(frustum.planes[plane], bounds);
+    }
+    uint32_t count = 0;
+    uint32_t index = begin;
+
+    for (; index + 4 <= end; index += 4) {
+        uint32x4_t visible = vdupq_n_u32(UINT32_MAX);
+
+        for (uint32_t plane = 0; plane < Frustum::PLANE_COUNT; plane++) {
+            const glm::vec4& p = frustum.planes[plane];
+            const PlaneVertex& vertex = vertices[plane];
+
+            float32x4_t distance = vfmaq_n_f32(vdupq_n_f32(p.w), vld1q_f32(vertex.x + index), p.x);
+            distance = vfmaq_n_f32(distance, vld1q_f32(vertex.y + index), p.y);
+            distance = vfmaq_n_f32(distance, vld1q_f32(vertex.z + index), p.z);
+            visible = vandq_u32(visible, vcgeq_f32(distance, vdupq_n_f32(0.0f)));
+        }
+        count += writeVisible(getLaneMask(visible), index, output + count);
+    }
+    return count + cullAabbsScalar(frustum, bounds, index, end, output + count);
+}
+
+#else
+
+uint32_t CullingKernels::getSimdWidth() {
+    return 1;
+}
+
+const char* CullingKernels::getSimdName() {
+    return "Scalar";
+}
+
+uint32_t CullingKernels::cullSpheres(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output) {
+    return cullSpheresScalar(frustum, bounds, begin, end, output);
+}
+
+uint32_t CullingKernels::cullAabbs(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output) {
+    return cullAabbsScalar(frustum, bounds, begin, end, output);
+}
+
+#endif
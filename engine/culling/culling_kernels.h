@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+#include "culling_bounds.h"
+#include "frustum.h"
+
+// [begin, end) 범위의 객체를 frustum 에 대해 테스트하고 보이는 index 를 output 에 기록
+// output 은 end - begin 개 이상이어야 하며, 반환값은 기록한 개수
+namespace CullingKernels {
+
+    using Kernel = uint32_t (*)(const Frustum&, const CullingBounds&, uint32_t begin, uint32_t end, uint32_t* output);
+
+    // 컴파일 시 선택된 SIMD 폭 (scalar 면 1)
+    uint32_t getSimdWidth();
+    const char* getSimdName();
+
+    uint32_t cullSpheresScalar(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output);
+    uint32_t cullAabbsScalar(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output);
+
+    // SSE / AVX2 / NEON 중 빌드 대상에서 사용 가능한 것. 없으면 scalar
+    uint32_t cullSpheres(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output);
+    uint32_t cullAabbs(const Frustum& frustum, const CullingBounds& bounds, uint32_t begin, uint32_t end, uint32_t* output);
+}
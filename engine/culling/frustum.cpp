@@ -0,0 +1,25 @@
+#include "frustum.h"
+
+Frustum Frustum::fromMatrix(const glm::mat4& viewProjection) {
+    // glm 은 column-major 이므로 row 를 직접 구성
+    auto row = [&](int index) {
+        return glm::vec4 { viewProjection[0][index], viewProjection[1][index], viewProjection[2][index], viewProjection[3][index] };
+    };
+    const glm::vec4 row0 = row(0);
+    const glm::vec4 row1 = row(1);
+    const glm::vec4 row2 = row(2);
+    const glm::vec4 row3 = row(3);
+
+    Frustum frustum {};
+    frustum.planes[LEFT_PLANE] = row3 + row0;
+    frustum.planes[RIGHT_PLANE] = row3 - row0;
+    frustum.planes[BOTTOM_PLANE] = row3 + row1;
+    frustum.planes[TOP_PLANE] = row3 - row1;
+    frustum.planes[NEAR_PLANE] = row2;
+    frustum.planes[FAR_PLANE] = row3 - row2;
+
+    for (glm::vec4& plane : frustum.planes) {
+        plane /= glm::length(glm::vec3 { plane });
+    }
+    return frustum;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <array>
+#include <glm/glm.hpp>
+
+// xyz: 안쪽을 향하는 정규화된 normal, w: 거리. dot(n, p) + w >= 0 이면 안쪽
+struct Frustum {
+    enum Plane { LEFT_PLANE, RIGHT_PLANE, BOTTOM_PLANE, TOP_PLANE, NEAR_PLANE, FAR_PLANE, PLANE_COUNT };
+
+    std::array<glm::vec4, PLANE_COUNT> planes;
+
+    // Gribb-Hartmann. Vulkan clip space (z: 0 ~ 1) 기준
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+};
@@ -0,0 +1,49 @@
+#include "frustum_culler.h"
+
+#include <algorithm>
+#include <cstring>
+
+std::span<const uint32_t> FrustumCuller::cullSpheres(const Frustum& frustum, const CullingBounds& bounds) {
+    return cull(CullingKernels::cullSpheres, frustum, bounds);
+}
+
+std::span<const uint32_t> FrustumCuller::cullAabbs(const Frustum& frustum, const CullingBounds& bounds) {
+    return cull(CullingKernels::cullAabbs, frustum, bounds);
+}
+
+std::span<const uint32_t> FrustumCuller::cull(CullingKernels::Kernel kernel, const Frustum& frustum, const CullingBounds& bounds) {
+    const auto objectCount = static_cast<uint32_t>(bounds.size());
+    const uint32_t participantCount = m_jobSystem.getWorkerCount() + 1;
+    m_visible.resize(objectCount);
+
+    if (objectCount < m_config.minBatchPerWorker * 2 || participantCount == 1) {
+        const uint32_t count = kernel(frustum, bounds, 0, objectCount, m_visible.data());
+        return { m_visible.data(), count };
+    }
+    // SIMD 폭의 배수로 나눠 chunk 경계에서 scalar tail 이 생기지 않게 함
+    const uint32_t simdWidth = CullingKernels::getSimdWidth();
+    const uint32_t chunkCount = std::min(participantCount * 4, objectCount / m_config.minBatchPerWorker);
+    const uint32_t chunkSize = ((objectCount + chunkCount - 1) / chunkCount + simdWidth - 1) / simdWidth * simdWidth;
+
+    m_scratch.resize(objectCount);
+    m_chunkCounts.assign(chunkCount, 0);
+
+    m_jobSystem.parallelFor(chunkCount, 1, [&](uint32_t firstChunk, uint32_t lastChunk) {
+        for (uint32_t chunk = firstChunk; chunk < lastChunk; chunk++) {
+            const uint32_t begin = chunk * chunkSize;
+            const uint32_t end = std::min(begin + chunkSize, objectCount);
+
+            m_chunkCounts[chunk] = begin < end ? kernel(frustum, bounds, begin, end, m_scratch.data() + begin) : 0;
+        }
+    });
+
+    // chunk 순서대로 이어붙여 index 오름차순 유지
+    uint32_t count = 0;
+
+    for (uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+        const uint32_t chunkVisibleCount = m_chunkCounts[chunk];
+        std::memcpy(m_visible.data() + count, m_scratch.data() + size_t { chunk } * chunkSize, chunkVisibleCount * sizeof(uint32_t));
+        count += chunkVisibleCount;
+    }
+    return { m_visible.data(), count };
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "culling_bounds.h"
+#include "culling_kernels.h"
+#include "frustum.h"
+#include "../thread/job_system.h"
+
+struct FrustumCullingConfig {
+    // 이보다 작은 batch 는 호출 스레드에서만 처리
+    uint32_t minBatchPerWorker = 4096;
+};
+
+// 큰 batch 를 chunk job 으로 나눠 job system 에서 컬링하고
+// 보이는 객체의 index 를 오름차순으로 압축해 반환. 결과는 다음 호출 전까지 유효
+// engine 이 그리는 mesh 는 OcclusionCuller 가 GPU 에서 frustum 을 검사하므로 여기를 거치지 않음
+// application 이 CPU 에서 가시성을 알아야 하는 곳 (직접 만드는 draw list, picking, gameplay 등) 에서 사용
+class FrustumCuller {
+public:
+    explicit FrustumCuller(JobSystem& jobSystem, FrustumCullingConfig config = {})
+        : m_jobSystem(jobSystem), m_config(config) {}
+
+    std::span<const uint32_t> cullSpheres(const Frustum& frustum, const CullingBounds& bounds);
+
+    std::span<const uint32_t> cullAabbs(const Frustum& frustum, const CullingBounds& bounds);
+
+private:
+    std::span<const uint32_t> cull(CullingKernels::Kernel kernel, const Frustum& frustum, const CullingBounds& bounds);
+
+    JobSystem&                  m_jobSystem;
+    FrustumCullingConfig        m_config;
+    std::vector<uint32_t>       m_scratch;
+    std::vector<uint32_t>       m_chunkCounts;
+    std::vector<uint32_t>       m_visible;
+};
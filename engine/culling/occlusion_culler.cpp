@@ -0,0 +1,606 @@
+#include "occlusion_culler.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+#include "../engine_component_factory.h"
+#include "../memory/host_allocator.h"
+#include "../pipeline/graphics_pipeline_supports.h"
+#include "../texture/texture_supports.h"
+#include "../util/byte_streams.h"
+
+namespace {
+    constexpr auto CULL_SHADER_NAME { "occlusion_cull.comp.spv" };
+    constexpr auto PYRAMID_SHADER_NAME { "hiz_downsample.comp.spv" };
+
+    // 각 shader 의 local_size 와 같아야 함
+    constexpr uint32_t CULL_GROUP_SIZE = 64;
+    constexpr uint32_t PYRAMID_GROUP_SIZE = 8;
+
+    // 64 이상의 2 의 거듭제곱이면 모든 구간의 offset 이 256 (minStorageBufferOffsetAlignment 최대값) 의 배수
+    constexpr uint32_t MIN_CAPACITY = 64;
+    constexpr uint32_t MIN_LOD_CAPACITY = 16;
+
+    // occlusion_cull.comp 의 push constant
+    struct CullPushConstants {
+        glm::mat4 viewProjection;
+        glm::vec2 pyramidSize;
+        uint32_t objectCount;
+        uint32_t pass;
+        // xyz: camera 위치, w: lodScale
+        glm::vec4 camera;
+    };
+
+    // hiz_downsample.comp 의 push constant
+    struct PyramidPushConstants {
+        glm::ivec2 inputSize;
+        glm::ivec2 outputSize;
+    };
+
+    VkDescriptorBufferInfo createBufferInfo(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+        return { buffer, offset, range };
+    }
+
+    VkWriteDescriptorSet createWrite(VkDescriptorSet descriptorSet, uint32_t binding, VkDescriptorType descriptorType) {
+        VkWriteDescriptorSet write {};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = descriptorSet;
+        write.dstBinding = binding;
+        write.descriptorCount = 1;
+        write.descriptorType = descriptorType;
+        return write;
+    }
+
+    uint32_t getGroupCount(uint32_t count, uint32_t groupSize) {
+        return (count + groupSize - 1) / groupSize;
+    }
+}
+
+OcclusionCuller::OcclusionCuller(
+    VkPhysicalDevice physicalDevice,
+    VkDevice device,
+    DeletionQueue& deletionQueue,
+    ResourceRegistry& resources,
+    PipelineLayoutCache& pipelineLayoutCache,
+    VkImageView depthView,
+    VkExtent2D depthExtent,
+    uint32_t framesInFlight
+) : m_physicalDevice(physicalDevice), m_device(device), m_deletionQueue(deletionQueue), m_resources(resources),
+    m_pipelineLayoutCache(pipelineLayoutCache), m_slots(std::max(framesInFlight, 1u)), m_depthExtent(depthExtent) {
+    VkPhysicalDeviceFeatures features;
+    vkGetPhysicalDeviceFeatures(physicalDevice, &features);
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    // createPhysicalDeviceFeatures 가 지원하는 경우 켜 둠
+    m_supportsMultiDraw = features.multiDrawIndirect == VK_TRUE;
+    m_supportsFirstInstance = features.drawIndirectFirstInstance == VK_TRUE;
+    m_maxDrawIndirectCount = m_supportsMultiDraw ? std::max(properties.limits.maxDrawIndirectCount, 1u) : 1;
+
+    createPyramid();
+    createPipelines();
+    createDescriptorSets(depthView);
+}
+
+OcclusionCuller::~OcclusionCuller() {
+    // descriptor set 은 pool 과 함께 해제
+    m_deletionQueue.retire(m_descriptorPool);
+
+    for (Slot& slot : m_slots) {
+        m_deletionQueue.retire(slot.allocation.buffer);
+        m_deletionQueue.retire(slot.allocation.memory);
+    }
+    m_deletionQueue.retire(m_deviceBuffer.buffer);
+    m_deletionQueue.retire(m_deviceBuffer.memory);
+
+    destroyPyramid();
+
+    // pipeline layout 은 PipelineLayoutCache 가 공유하므로 pipeline 만 제거
+    ResourceRegistry::release(m_resources.pipelines, m_cullPipeline, m_deletionQueue);
+    ResourceRegistry::release(m_resources.pipelines, m_pyramidPipeline, m_deletionQueue);
+}
+
+void OcclusionCuller::resize(VkImageView depthView, VkExtent2D depthExtent) {
+    // 이전 pyramid 와 descriptor set 은 마지막으로 쓴 frame 이 끝난 뒤 파괴 (set 은 pool 과 함께 해제)
+    m_deletionQueue.retire(m_descriptorPool);
+    destroyPyramid();
+
+    m_depthExtent = depthExtent;
+    createPyramid();
+    createDescriptorSets(depthView);
+
+    // slot 의 set 이 새로 할당되었으므로 다음 prepare 에서 다시 기록
+    for (Slot& slot : m_slots) {
+        slot.boundGeneration = 0;
+    }
+    // 이전 크기의 가시성은 새 Hi-Z 와 맞지 않으므로 모두 보이는 것으로 시작
+    m_isPyramidInitialized = false;
+    m_needsVisibilityReset = true;
+}
+
+uint32_t OcclusionCuller::add(
+    const glm::vec3& boundsMin,
+    const glm::vec3& boundsMax,
+    const VkDrawIndexedIndirectCommand& command,
+    const OccluderLod& lod
+) {
+    if (command.firstInstance != 0 && !m_supportsFirstInstance) {
+        throw std::runtime_error("indirect draw firstInstance is not supported!");
+    }
+    if (uint64_t { lod.first } + lod.count > m_lods.size()) {
+        throw std::runtime_error("occluder LOD range is out of bounds!");
+    }
+    m_bounds.push_back({ glm::vec4 { boundsMin, 1.0f }, glm::vec4 { boundsMax, 1.0f } });
+    m_commands.push_back(command);
+    m_objectLods.push_back(lod);
+    m_version++;
+    return static_cast<uint32_t>(m_bounds.size() - 1);
+}
+
+uint32_t OcclusionCuller::addLods(std::span<const MeshLod> lods) {
+    const auto first = static_cast<uint32_t>(m_lods.size());
+    m_lods.insert(m_lods.end(), lods.begin(), lods.end());
+    m_version++;
+    return first;
+}
+
+void OcclusionCuller::set(uint32_t index, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    m_bounds[index] = { glm::vec4 { boundsMin, 1.0f }, glm::vec4 { boundsMax, 1.0f } };
+    m_version++;
+}
+
+void OcclusionCuller::swapRemove(uint32_t index) {
+    m_bounds[index] = m_bounds.back();
+    m_commands[index] = m_commands.back();
+    m_objectLods[index] = m_objectLods.back();
+    m_bounds.pop_back();
+    m_commands.pop_back();
+    m_objectLods.pop_back();
+    m_version++;
+}
+
+void OcclusionCuller::clear() {
+    m_bounds.clear();
+    m_commands.clear();
+    m_objectLods.clear();
+    m_lods.clear();
+    m_version++;
+}
+
+std::vector<char> OcclusionCuller::serializeObjects() const {
+    std::vector<char> output;
+    ByteStreams::write(output, static_cast<uint32_t>(m_bounds.size()));
+    ByteStreams::write(output, static_cast<uint32_t>(m_lods.size()));
+    ByteStreams::writeArray<ObjectBounds>(output, m_bounds);
+    ByteStreams::writeArray<VkDrawIndexedIndirectCommand>(output, m_commands);
+    ByteStreams::writeArray<OccluderLod>(output, m_objectLods);
+    ByteStreams::writeArray<MeshLod>(output, m_lods);
+    return output;
+}
+
+bool OcclusionCuller::deserializeObjects(std::span<const char> objects) {
+    uint32_t objectCount = 0;
+    uint32_t lodCount = 0;
+    std::vector<ObjectBounds> bounds;
+    std::vector<VkDrawIndexedIndirectCommand> commands;
+    std::vector<OccluderLod> objectLods;
+    std::vector<MeshLod> lods;
+
+    if (!ByteStreams::read(objects, objectCount) || !ByteStreams::read(objects, lodCount)
+        || !ByteStreams::readArray(objects, bounds, objectCount)
+        || !ByteStreams::readArray(objects, commands, objectCount)
+        || !ByteStreams::readArray(objects, objectLods, objectCount)
+        || !ByteStreams::readArray(objects, lods, lodCount)) {
+        return false;
+    }
+    // add 와 같은 조건. 다른 GPU 에서 캡처한 파일일 수 있음
+    for (uint32_t index = 0; index < objectCount; index++) {
+        if ((commands[index].firstInstance != 0 && !m_supportsFirstInstance) || uint64_t { objectLods[index].first } + objectLods[index].count > lodCount) {
+            return false;
+        }
+    }
+    m_bounds = std::move(bounds);
+    m_commands = std::move(commands);
+    m_objectLods = std::move(objectLods);
+    m_lods = std::move(lods);
+    m_version++;
+    return true;
+}
+
+void OcclusionCuller::prepare(uint64_t frame, const CullingView& view) {
+    Slot& slot = m_slots[frame % m_slots.size()];
+
+    // 이 slot 을 마지막으로 쓴 frame 은 fence 로 끝난 것이 확인됨
+    if (slot.mapped != nullptr && slot.frame != 0) {
+        StatsCounters counters;
+        std::memcpy(&counters, slot.mapped + getSlotStatsOffset(slot), sizeof(StatsCounters));
+
+        m_stats = {
+            slot.frame,
+            slot.objectCount,
+            counters.earlyDrawCount,
+            counters.lateDrawCount,
+            counters.frustumCulledCount,
+            counters.occlusionCulledCount,
+            counters.drawnTriangleCount,
+        };
+    }
+    const auto objectCount = static_cast<uint32_t>(m_bounds.size());
+
+    reserveSlot(slot, objectCount, static_cast<uint32_t>(m_lods.size()));
+    reserveDeviceBuffer(objectCount);
+
+    if (slot.writtenVersion != m_version) {
+        std::memcpy(slot.mapped, m_bounds.data(), m_bounds.size() * sizeof(ObjectBounds));
+        std::memcpy(
+            slot.mapped + VkDeviceSize { slot.capacity } * sizeof(ObjectBounds),
+            m_commands.data(),
+            m_commands.size() * sizeof(VkDrawIndexedIndirectCommand)
+        );
+        std::memcpy(
+            slot.mapped + VkDeviceSize { slot.capacity } * (sizeof(ObjectBounds) + sizeof(VkDrawIndexedIndirectCommand)),
+            m_objectLods.data(),
+            m_objectLods.size() * sizeof(OccluderLod)
+        );
+        std::memcpy(slot.mapped + getSlotLodOffset(slot), m_lods.data(), m_lods.size() * sizeof(MeshLod));
+        slot.writtenVersion = m_version;
+    }
+    // GPU 가 누적하므로 submit 전에 host 에서 비움 (coherent memory)
+    std::memset(slot.mapped + getSlotStatsOffset(slot), 0, sizeof(StatsCounters));
+
+    if (slot.boundGeneration != m_deviceGeneration) {
+        writeSlotDescriptorSet(slot);
+        slot.boundGeneration = m_deviceGeneration;
+    }
+    slot.frame = frame;
+    slot.objectCount = objectCount;
+    m_currentSlot = &slot;
+    m_view = view;
+}
+
+void OcclusionCuller::recordEarlyCull(VkCommandBuffer commandBuffer) {
+    if (m_currentSlot == nullptr || m_currentSlot->objectCount == 0) {
+        return;
+    }
+    // 처음 쓰는 pyramid 는 layout 만 정하고, 새 visibility 는 모두 보이는 것으로 시작
+    if (!m_isPyramidInitialized) {
+        TextureSupports::recordImageBarrier(
+            commandBuffer,
+            TextureSupports::createImageMemoryBarrier(
+                m_pyramid.image, 0, m_pyramidLevelCount, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                0, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+            ),
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+        );
+        m_isPyramidInitialized = true;
+    }
+    if (m_needsVisibilityReset) {
+        vkCmdFillBuffer(commandBuffer, m_deviceBuffer.buffer, getVisibilityOffset(), VkDeviceSize { m_deviceCapacity } * sizeof(uint32_t), 1);
+        m_needsVisibilityReset = false;
+    }
+    // 지난 frame 의 visibility 쓰기와 indirect 읽기 이후에 덮어씀
+    MemorySupports::recordMemoryBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+    );
+    recordCull(commandBuffer, OcclusionPass::EARLY);
+
+    // LATE 판정은 EARLY 에서 그렸는지를 다시 읽음
+    MemorySupports::recordMemoryBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT
+    );
+}
+
+void OcclusionCuller::recordPyramid(VkCommandBuffer commandBuffer) {
+    if (m_currentSlot == nullptr || m_currentSlot->objectCount == 0) {
+        return;
+    }
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, *m_resources.pipelines.get(m_pyramidPipeline));
+    VkPipelineLayout pipelineLayout = *m_resources.pipelineLayouts.get(m_pyramidPipelineLayout);
+
+    // depth 는 render pass 의 external dependency 로 compute 에서 읽을 수 있음
+    VkExtent2D inputExtent = m_depthExtent;
+
+    for (uint32_t level = 0; level < m_pyramidLevelCount; level++) {
+        const VkExtent2D outputExtent = TextureSupports::getMipExtent(m_pyramidExtent, level);
+        const PyramidPushConstants pushConstants {
+            { static_cast<int32_t>(inputExtent.width), static_cast<int32_t>(inputExtent.height) },
+            { static_cast<int32_t>(outputExtent.width), static_cast<int32_t>(outputExtent.height) },
+        };
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &m_pyramidDescriptorSets[level], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PyramidPushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, getGroupCount(outputExtent.width, PYRAMID_GROUP_SIZE), getGroupCount(outputExtent.height, PYRAMID_GROUP_SIZE), 1);
+
+        // 다음 level 과 LATE 컬링이 이 level 을 읽음
+        TextureSupports::recordImageBarrier(
+            commandBuffer,
+            TextureSupports::createImageMemoryBarrier(
+                m_pyramid.image, level, 1, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+                VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT
+            ),
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+        );
+        inputExtent = outputExtent;
+    }
+}
+
+void OcclusionCuller::recordLateCull(VkCommandBuffer commandBuffer) {
+    if (m_currentSlot == nullptr || m_currentSlot->objectCount == 0) {
+        return;
+    }
+    recordCull(commandBuffer, OcclusionPass::LATE);
+
+    // LATE draw 와 fence 이후 host 의 통계 읽기
+    MemorySupports::recordMemoryBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_HOST_READ_BIT
+    );
+}
+
+void OcclusionCuller::recordDraws(VkCommandBuffer commandBuffer, OcclusionPass pass, VkBuffer instanceBuffer) const {
+    if (m_currentSlot == nullptr || m_currentSlot->objectCount == 0 || m_geometry.pipeline == VK_NULL_HANDLE) {
+        return;
+    }
+    const VkBuffer vertexBuffers[] { m_geometry.vertexBuffer, instanceBuffer };
+    constexpr VkDeviceSize offsets[] { 0, 0 };
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_geometry.pipeline);
+    vkCmdBindVertexBuffers(commandBuffer, 0, 2, vertexBuffers, offsets);
+    vkCmdBindIndexBuffer(commandBuffer, m_geometry.indexBuffer, 0, m_geometry.indexType);
+
+    constexpr uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+    const VkDeviceSize drawOffset = getDrawOffset(pass);
+
+    // multiDrawIndirect 가 없으면 draw 하나씩. 컬링된 command 는 instanceCount 0 이라 GPU 가 건너뜀
+    for (uint32_t first = 0; first < m_currentSlot->objectCount; first += m_maxDrawIndirectCount) {
+        const uint32_t drawCount = std::min(m_maxDrawIndirectCount, m_currentSlot->objectCount - first);
+        vkCmdDrawIndexedIndirect(commandBuffer, m_deviceBuffer.buffer, drawOffset + VkDeviceSize { first } * stride, drawCount, stride);
+    }
+}
+
+void OcclusionCuller::createPyramid() {
+    // 홀수 크기는 마지막 texel 이 남는 열 / 행까지 덮으므로 내림
+    m_pyramidExtent = { std::max(m_depthExtent.width / 2, 1u), std::max(m_depthExtent.height / 2, 1u) };
+    m_pyramidLevelCount = std::min(
+        static_cast<uint32_t>(std::bit_width(std::max(m_pyramidExtent.width, m_pyramidExtent.height))),
+        MAX_PYRAMID_LEVELS
+    );
+    m_pyramid = MemorySupports::createImage(
+        m_physicalDevice,
+        m_device,
+        MemorySupports::createImageCreateInfo(m_pyramidExtent, m_pyramidLevelCount, VK_FORMAT_R32_SFLOAT, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT),
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        m_deletionQueue.getMemoryBudget()
+    );
+    VkImageViewCreateInfo viewCreateInfo = EngineComponentFactory::createImageViewCreateInfo(VK_FORMAT_R32_SFLOAT, m_pyramid.image);
+
+    // 컬링은 전체 mip, downsample 은 level 하나씩 읽고 씀
+    for (uint32_t level = 0; level <= m_pyramidLevelCount; level++) {
+        const bool isWholeView = level == m_pyramidLevelCount;
+        viewCreateInfo.subresourceRange.baseMipLevel = isWholeView ? 0 : level;
+        viewCreateInfo.subresourceRange.levelCount = isWholeView ? m_pyramidLevelCount : 1;
+        VkImageView view;
+
+        if (vkCreateImageView(m_device, &viewCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_IMAGE_VIEW), &view) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create Hi-Z image view!");
+        }
+        if (isWholeView) {
+            m_pyramidView = view;
+        } else {
+            m_pyramidLevelViews.push_back(view);
+        }
+    }
+    // max 를 직접 구하므로 filter 없이 texel 그대로 읽음
+    VkSamplerCreateInfo samplerCreateInfo = TextureSupports::createSamplerCreateInfo(static_cast<float>(m_pyramidLevelCount));
+    samplerCreateInfo.magFilter = VK_FILTER_NEAREST;
+    samplerCreateInfo.minFilter = VK_FILTER_NEAREST;
+    samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+
+    if (vkCreateSampler(m_device, &samplerCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_SAMPLER), &m_sampler) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create Hi-Z sampler!");
+    }
+}
+
+void OcclusionCuller::destroyPyramid() {
+    for (VkImageView view : m_pyramidLevelViews) {
+        m_deletionQueue.retire(view);
+    }
+    m_deletionQueue.retire(m_pyramidView);
+    m_deletionQueue.retire(m_sampler);
+    m_deletionQueue.retire(m_pyramid.image);
+    m_deletionQueue.retire(m_pyramid.memory);
+
+    m_pyramidLevelViews.clear();
+    m_pyramidView = VK_NULL_HANDLE;
+    m_sampler = VK_NULL_HANDLE;
+    m_pyramid = {};
+}
+
+void OcclusionCuller::createPipelines() {
+    const auto createPipeline = [&](const char* shaderName, PipelineLayoutHandle& pipelineLayout, PipelineHandle& pipeline) {
+        const ShaderModule& shaderModule = m_resources.getShader(shaderName);
+        const ShaderReflection* stages[] { &shaderModule.reflection };
+        pipelineLayout = m_pipelineLayoutCache.getPipelineLayout(m_resources, stages);
+
+        const VkPipelineShaderStageCreateInfo stage = GraphicsPipelineSupports::createPipelineShaderStageCreateInfo(
+            VK_SHADER_STAGE_COMPUTE_BIT, shaderModule.module
+        );
+        pipeline = m_resources.pipelines.create(
+            EngineComponentFactory::createComputePipeline(m_device, *m_resources.pipelineLayouts.get(pipelineLayout), stage)
+        );
+    };
+    createPipeline(CULL_SHADER_NAME, m_cullPipelineLayout, m_cullPipeline);
+    createPipeline(PYRAMID_SHADER_NAME, m_pyramidPipelineLayout, m_pyramidPipeline);
+}
+
+void OcclusionCuller::createDescriptorSets(VkImageView depthView) {
+    const auto slotCount = static_cast<uint32_t>(m_slots.size());
+
+    // slot 마다 storage buffer 8 + pyramid sampler 1, level 마다 입력 sampler 1 + 출력 storage image 1
+    const VkDescriptorPoolSize poolSizes[] {
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, slotCount * 8 },
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, slotCount + m_pyramidLevelCount },
+        { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, m_pyramidLevelCount },
+    };
+    m_descriptorPool = EngineComponentFactory::createDescriptorPool(m_device, poolSizes, slotCount + m_pyramidLevelCount);
+
+    const auto allocate = [&](PipelineLayoutHandle pipelineLayout, uint32_t count) {
+        std::span<const DescriptorSetLayoutHandle> setLayouts = m_pipelineLayoutCache.getSetLayouts(pipelineLayout);
+
+        if (setLayouts.empty()) {
+            throw std::runtime_error("compute shader has no descriptor set!");
+        }
+        std::vector<VkDescriptorSetLayout> layouts(count, *m_resources.descriptorSetLayouts.get(setLayouts[0]));
+        std::vector<VkDescriptorSet> descriptorSets(count);
+
+        VkDescriptorSetAllocateInfo allocateInfo {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.descriptorPool = m_descriptorPool;
+        allocateInfo.descriptorSetCount = count;
+        allocateInfo.pSetLayouts = layouts.data();
+
+        if (vkAllocateDescriptorSets(m_device, &allocateInfo, descriptorSets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate descriptor sets!");
+        }
+        return descriptorSets;
+    };
+    std::vector<VkDescriptorSet> slotDescriptorSets = allocate(m_cullPipelineLayout, slotCount);
+
+    for (uint32_t i = 0; i < slotCount; i++) {
+        m_slots[i].descriptorSet = slotDescriptorSets[i];
+    }
+    m_pyramidDescriptorSets = allocate(m_pyramidPipelineLayout, m_pyramidLevelCount);
+
+    // pyramid 는 depth 크기가 바뀌지 않는 한 그대로이므로 한 번만 기록
+    for (uint32_t level = 0; level < m_pyramidLevelCount; level++) {
+        const VkDescriptorImageInfo inputInfo = level == 0
+            ? VkDescriptorImageInfo { m_sampler, depthView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL }
+            : VkDescriptorImageInfo { m_sampler, m_pyramidLevelViews[level - 1], VK_IMAGE_LAYOUT_GENERAL };
+        const VkDescriptorImageInfo outputInfo { VK_NULL_HANDLE, m_pyramidLevelViews[level], VK_IMAGE_LAYOUT_GENERAL };
+
+        VkWriteDescriptorSet writes[] {
+            createWrite(m_pyramidDescriptorSets[level], 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER),
+            createWrite(m_pyramidDescriptorSets[level], 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE),
+        };
+        writes[0].pImageInfo = &inputInfo;
+        writes[1].pImageInfo = &outputInfo;
+
+        vkUpdateDescriptorSets(m_device, 2, writes, 0, nullptr);
+    }
+}
+
+void OcclusionCuller::reserveSlot(Slot& slot, uint32_t objectCount, uint32_t lodCount) {
+    if (slot.mapped != nullptr && objectCount <= slot.capacity && lodCount <= slot.lodCapacity) {
+        return;
+    }
+    // 이전 buffer 는 이 slot 을 마지막으로 쓴 frame 이 끝난 뒤 파괴
+    m_deletionQueue.retire(slot.allocation.buffer);
+    m_deletionQueue.retire(slot.allocation.memory);
+
+    slot.capacity = std::bit_ceil(std::max(objectCount, MIN_CAPACITY));
+    slot.lodCapacity = std::bit_ceil(std::max(lodCount, MIN_LOD_CAPACITY));
+    slot.allocation = MemorySupports::createBuffer(
+        m_physicalDevice,
+        m_device,
+        getSlotLodOffset(slot) + VkDeviceSize { slot.lodCapacity } * sizeof(MeshLod),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        m_deletionQueue.getMemoryBudget(),
+        MemoryCategory::TRANSIENT
+    );
+    void* mapped = nullptr;
+
+    if (vkMapMemory(m_device, slot.allocation.memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+        throw std::runtime_error("failed to map occlusion culling buffer!");
+    }
+    slot.mapped = static_cast<std::byte*>(mapped);
+    slot.writtenVersion = 0;
+    // buffer 가 바뀌었으므로 descriptor 를 다시 기록
+    slot.boundGeneration = 0;
+}
+
+void OcclusionCuller::reserveDeviceBuffer(uint32_t objectCount) {
+    if (m_deviceBuffer.buffer != VK_NULL_HANDLE && objectCount <= m_deviceCapacity) {
+        return;
+    }
+    m_deletionQueue.retire(m_deviceBuffer.buffer);
+    m_deletionQueue.retire(m_deviceBuffer.memory);
+
+    m_deviceCapacity = std::bit_ceil(std::max(objectCount, MIN_CAPACITY));
+    m_deviceBuffer = MemorySupports::createBuffer(
+        m_physicalDevice,
+        m_device,
+        getVisibilityOffset() + VkDeviceSize { m_deviceCapacity } * sizeof(uint32_t),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        m_deletionQueue.getMemoryBudget()
+    );
+    // 모든 slot 의 descriptor 가 새 buffer 를 가리켜야 함. 가시성 기록은 잃으므로 모두 보이는 것으로 시작
+    m_deviceGeneration++;
+    m_needsVisibilityReset = true;
+}
+
+void OcclusionCuller::writeSlotDescriptorSet(Slot& slot) const {
+    const VkDeviceSize boundsSize = VkDeviceSize { slot.capacity } * sizeof(ObjectBounds);
+    const VkDeviceSize commandSize = VkDeviceSize { slot.capacity } * sizeof(VkDrawIndexedIndirectCommand);
+    const VkDeviceSize drawSize = VkDeviceSize { m_deviceCapacity } * sizeof(VkDrawIndexedIndirectCommand);
+
+    // occlusion_cull.comp 의 binding 순서. binding 6 은 pyramid
+    constexpr uint32_t PYRAMID_BINDING = 6;
+    const VkDescriptorBufferInfo bufferInfos[] {
+        createBufferInfo(slot.allocation.buffer, 0, boundsSize),
+        createBufferInfo(slot.allocation.buffer, boundsSize, commandSize),
+        createBufferInfo(m_deviceBuffer.buffer, getVisibilityOffset(), VkDeviceSize { m_deviceCapacity } * sizeof(uint32_t)),
+        createBufferInfo(m_deviceBuffer.buffer, getDrawOffset(OcclusionPass::EARLY), drawSize),
+        createBufferInfo(m_deviceBuffer.buffer, getDrawOffset(OcclusionPass::LATE), drawSize),
+        createBufferInfo(slot.allocation.buffer, getSlotStatsOffset(slot), sizeof(StatsCounters)),
+        createBufferInfo(slot.allocation.buffer, boundsSize + commandSize, VkDeviceSize { slot.capacity } * sizeof(OccluderLod)),
+        createBufferInfo(slot.allocation.buffer, getSlotLodOffset(slot), VkDeviceSize { slot.lodCapacity } * sizeof(MeshLod)),
+    };
+    const VkDescriptorImageInfo pyramidInfo { m_sampler, m_pyramidView, VK_IMAGE_LAYOUT_GENERAL };
+
+    VkWriteDescriptorSet writes[std::size(bufferInfos) + 1];
+
+    for (uint32_t buffer = 0; buffer < std::size(bufferInfos); buffer++) {
+        const uint32_t binding = buffer < PYRAMID_BINDING ? buffer : buffer + 1;
+        writes[buffer] = createWrite(slot.descriptorSet, binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+        writes[buffer].pBufferInfo = &bufferInfos[buffer];
+    }
+    writes[std::size(bufferInfos)] = createWrite(slot.descriptorSet, PYRAMID_BINDING, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+    writes[std::size(bufferInfos)].pImageInfo = &pyramidInfo;
+
+    vkUpdateDescriptorSets(m_device, static_cast<uint32_t>(std::size(writes)), writes, 0, nullptr);
+}
+
+void OcclusionCuller::recordCull(VkCommandBuffer commandBuffer, OcclusionPass pass) {
+    VkPipelineLayout pipelineLayout = *m_resources.pipelineLayouts.get(m_cullPipelineLayout);
+
+    const CullPushConstants pushConstants {
+        m_view.viewProjection,
+        { static_cast<float>(m_pyramidExtent.width), static_cast<float>(m_pyramidExtent.height) },
+        m_currentSlot->objectCount,
+        pass == OcclusionPass::EARLY ? 0u : 1u,
+        { m_view.position, m_view.lodScale },
+    };
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, *m_resources.pipelines.get(m_cullPipeline));
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &m_currentSlot->descriptorSet, 0, nullptr);
+    vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &pushConstants);
+    vkCmdDispatch(commandBuffer, getGroupCount(m_currentSlot->objectCount, CULL_GROUP_SIZE), 1, 1);
+}
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan_core.h>
+
+#include "../memory/memory_supports.h"
+#include "../mesh/mesh_data.h"
+#include "../pipeline/pipeline_layout_cache.h"
+#include "../resource/deletion_queue.h"
+#include "../resource/resource_registry.h"
+
+// 한 frame 을 두 번에 나눠 그림
+enum class OcclusionPass {
+    // 지난 frame 에 보였던 객체. 이 depth 로 Hi-Z 를 만듦
+    EARLY,
+    // Hi-Z 검사로 새로 보이게 된 객체
+    LATE,
+};
+
+// GPU 가 판정한 한 frame 의 결과. frame 의 fence 이후에 읽음
+struct OcclusionCullingStats {
+    uint64_t frame;
+    uint32_t objectCount;
+    uint32_t earlyDrawCount;
+    uint32_t lateDrawCount;
+    uint32_t frustumCulledCount;
+    uint32_t occlusionCulledCount;
+    // 두 pass 에서 그린 triangle 수 (LOD 적용 후)
+    uint32_t drawnTriangleCount;
+};
+
+// 컬링과 LOD 선택에 쓰는 camera
+struct CullingView {
+    glm::mat4 viewProjection { 1.0f };
+    glm::vec3 position { 0.0f };
+    // MeshLods::getLodScale. 0 이면 항상 LOD 0
+    float lodScale = 0.0f;
+};
+
+// 객체가 사용할 LOD 표 구간. count 가 0 이면 command 를 그대로 그림
+struct OccluderLod {
+    // addLods 의 반환값
+    uint32_t first = 0;
+    uint32_t count = 0;
+    // 객체의 world scale. object space 오차에 곱함
+    float worldScale = 1.0f;
+    uint32_t reserved = 0;
+};
+
+// indirect draw 가 사용할 mesh. vertex binding 0 은 정점, 1 은 instance buffer
+struct OccludedGeometry {
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkBuffer vertexBuffer = VK_NULL_HANDLE;
+    VkBuffer indexBuffer = VK_NULL_HANDLE;
+    VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+};
+
+// 2-phase Hi-Z occlusion culling
+// 1. 지난 frame 의 가시 집합 중 frustum 안의 객체를 EARLY pass 에서 그림
+// 2. 그 depth 로 compute downsample chain 을 돌려 max depth pyramid 를 만듦
+// 3. 모든 객체의 AABB 를 pyramid 와 비교해 가시 집합을 갱신하고, 새로 보이는 객체를 LATE pass 에서 그림
+// Vulkan 1.0 에는 draw count buffer 가 없으므로 컬링된 객체는 instanceCount 0 인 command 로 남김
+// LOD 가 있는 객체는 같은 dispatch 에서 투영 오차로 LOD 를 골라 command 의 index 구간을 바꿈
+class OcclusionCuller {
+public:
+    // Hi-Z level 0 은 depth 의 절반 해상도
+    static constexpr uint32_t MAX_PYRAMID_LEVELS = 16;
+
+    OcclusionCuller(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        DeletionQueue& deletionQueue,
+        ResourceRegistry& resources,
+        PipelineLayoutCache& pipelineLayoutCache,
+        VkImageView depthView,
+        VkExtent2D depthExtent,
+        uint32_t framesInFlight
+    );
+
+    OcclusionCuller(const OcclusionCuller&) = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+    ~OcclusionCuller();
+
+    // world space AABB 와 draw command. drawIndirectFirstInstance 가 없으면 firstInstance 는 0 이어야 함
+    // LOD 가 있으면 command.firstIndex 는 mesh 의 index 시작 위치이고 indexCount 는 GPU 가 채움
+    uint32_t add(
+        const glm::vec3& boundsMin,
+        const glm::vec3& boundsMax,
+        const VkDrawIndexedIndirectCommand& command,
+        const OccluderLod& lod = {}
+    );
+
+    // 같은 mesh 를 쓰는 객체가 공유하는 LOD 표 (CookedMesh::lods). 반환값을 OccluderLod::first 로 사용
+    uint32_t addLods(std::span<const MeshLod> lods);
+
+    void set(uint32_t index, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+    // 마지막 요소를 index 로 옮김 (호출자가 index 매핑 갱신)
+    // 옮겨진 객체는 한 frame 동안 이전 객체의 가시성을 물려받지만 결과 화면은 같음
+    void swapRemove(uint32_t index);
+
+    // LOD 표도 함께 비움
+    void clear();
+
+    // frame capture 용. 객체 목록과 LOD 표 (geometry 는 application 의 buffer 라 제외)
+    [[nodiscard]]
+    std::vector<char> serializeObjects() const;
+
+    // 객체 목록과 LOD 표를 통째로 바꿈. 형식이 맞지 않으면 false
+    bool deserializeObjects(std::span<const char> objects);
+
+    // 다음 cull 에서 모든 객체를 보이는 것으로 시작 (재생을 같은 상태에서 반복하기 위해)
+    void resetVisibility() {
+        m_needsVisibilityReset = true;
+    }
+
+    // 객체나 LOD 표가 바뀔 때마다 증가
+    [[nodiscard]]
+    uint64_t getVersion() const {
+        return m_version;
+    }
+
+    void setGeometry(const OccludedGeometry& geometry) {
+        m_geometry = geometry;
+    }
+
+    // depth target 이 다시 만들어졌을 때 (swapchain 재생성) Hi-Z pyramid 를 새 크기로 만듦
+    // depthView 를 쓰던 frame 이 모두 끝난 뒤 호출. 가시성은 모두 보이는 것으로 다시 시작
+    void resize(VkImageView depthView, VkExtent2D depthExtent);
+
+    // frame 의 fence 대기 후 호출. 이 slot 의 지난 결과를 읽고 객체와 descriptor 를 갱신
+    void prepare(uint64_t frame, const CullingView& view);
+
+    // render pass 밖에서 기록
+    void recordEarlyCull(VkCommandBuffer commandBuffer);
+    void recordPyramid(VkCommandBuffer commandBuffer);
+    void recordLateCull(VkCommandBuffer commandBuffer);
+
+    // render pass 안에서 기록. geometry 가 없거나 객체가 없으면 아무것도 하지 않음
+    void recordDraws(VkCommandBuffer commandBuffer, OcclusionPass pass, VkBuffer instanceBuffer) const;
+
+    [[nodiscard]]
+    size_t size() const {
+        return m_bounds.size();
+    }
+
+    // GPU 가 끝낸 가장 최근 frame 의 결과
+    [[nodiscard]]
+    const OcclusionCullingStats& getStats() const {
+        return m_stats;
+    }
+
+private:
+    struct ObjectBounds {
+        glm::vec4 boundsMin;
+        glm::vec4 boundsMax;
+    };
+
+    // occlusion_cull.comp 의 Stats 와 같은 순서
+    struct StatsCounters {
+        uint32_t earlyDrawCount;
+        uint32_t lateDrawCount;
+        uint32_t frustumCulledCount;
+        uint32_t occlusionCulledCount;
+        uint32_t drawnTriangleCount;
+    };
+
+    // frame in flight 마다 하나. [bounds | commands | object LODs | stats | LOD 표] 를 하나의 host-visible buffer 에 둠
+    struct Slot {
+        BufferAllocation allocation;
+        std::byte* mapped = nullptr;
+        uint32_t capacity = 0;
+        uint32_t lodCapacity = 0;
+        uint64_t writtenVersion = 0;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        // descriptor 가 가리키는 device buffer 의 generation
+        uint64_t boundGeneration = 0;
+        uint64_t frame = 0;
+        uint32_t objectCount = 0;
+    };
+
+    // m_depthExtent 에 맞춰 level 수를 정하고 생성
+    void createPyramid();
+    void destroyPyramid();
+    void createPipelines();
+    void createDescriptorSets(VkImageView depthView);
+
+    void reserveSlot(Slot& slot, uint32_t objectCount, uint32_t lodCount);
+    void reserveDeviceBuffer(uint32_t objectCount);
+    void writeSlotDescriptorSet(Slot& slot) const;
+    void recordCull(VkCommandBuffer commandBuffer, OcclusionPass pass);
+
+    [[nodiscard]]
+    VkDeviceSize getSlotStatsOffset(const Slot& slot) const {
+        return VkDeviceSize { slot.capacity } * (sizeof(ObjectBounds) + sizeof(VkDrawIndexedIndirectCommand) + sizeof(OccluderLod));
+    }
+
+    // stats 뒤를 storage buffer offset 정렬 최대값만큼 띄움
+    [[nodiscard]]
+    VkDeviceSize getSlotLodOffset(const Slot& slot) const {
+        return getSlotStatsOffset(slot) + 256;
+    }
+
+    [[nodiscard]]
+    VkDeviceSize getDrawOffset(OcclusionPass pass) const {
+        return pass == OcclusionPass::EARLY ? 0 : VkDeviceSize { m_deviceCapacity } * sizeof(VkDrawIndexedIndirectCommand);
+    }
+
+    [[nodiscard]]
+    VkDeviceSize getVisibilityOffset() const {
+        return VkDeviceSize { m_deviceCapacity } * sizeof(VkDrawIndexedIndirectCommand) * 2;
+    }
+
+    VkPhysicalDevice            m_physicalDevice;
+    VkDevice                    m_device;
+    DeletionQueue&              m_deletionQueue;
+    ResourceRegistry&           m_resources;
+    PipelineLayoutCache&        m_pipelineLayoutCache;
+    bool                        m_supportsMultiDraw = false;
+    bool                        m_supportsFirstInstance = false;
+    uint32_t                    m_maxDrawIndirectCount = 1;
+
+    // CPU 쪽 객체 목록. 바뀔 때마다 version 을 올려 slot 에 다시 기록
+    std::vector<ObjectBounds>   m_bounds;
+    std::vector<VkDrawIndexedIndirectCommand> m_commands;
+    std::vector<OccluderLod>    m_objectLods;
+    std::vector<MeshLod>        m_lods;
+    uint64_t                    m_version = 1;
+    OccludedGeometry            m_geometry {};
+
+    std::vector<Slot>           m_slots;
+    Slot*                       m_currentSlot = nullptr;
+    CullingView                 m_view {};
+    OcclusionCullingStats       m_stats {};
+
+    // frame 사이에 이어지는 GPU 상태. [early draws | late draws | visibility]
+    BufferAllocation            m_deviceBuffer;
+    uint32_t                    m_deviceCapacity = 0;
+    uint64_t                    m_deviceGeneration = 0;
+    bool                        m_needsVisibilityReset = false;
+
+    // R32F max depth pyramid. 항상 GENERAL layout
+    VkExtent2D                  m_depthExtent;
+    ImageAllocation             m_pyramid;
+    VkExtent2D                  m_pyramidExtent {};
+    uint32_t                    m_pyramidLevelCount = 0;
+    VkImageView                 m_pyramidView = VK_NULL_HANDLE;
+    std::vector<VkImageView>    m_pyramidLevelViews;
+    VkSampler                   m_sampler = VK_NULL_HANDLE;
+    bool                        m_isPyramidInitialized = false;
+
+    PipelineLayoutHandle        m_cullPipelineLayout;
+    PipelineHandle              m_cullPipeline;
+    PipelineLayoutHandle        m_pyramidPipelineLayout;
+    PipelineHandle              m_pyramidPipeline;
+    VkDescriptorPool            m_descriptorPool = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> m_pyramidDescriptorSets;
+};
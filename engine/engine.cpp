@@ -2,17 +2,31 @@
 
 #include <GLFW/glfw3.h>
 #include <iostream>
-#include <ranges>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <thread>
+
+#include "loop/cpu_usage_meter.h"
+#include "loop/frame_pacer.h"
 
 #include "engine_component_factory.h"
+#include "memory/host_allocator.h"
+#include "memory/memory_supports.h"
+#include "mesh/mesh_supports.h"
 #include "util/validations.h"
 #include "queue/queue_factory.h"
 #include "util/binary_file_utils.h"
 
-Engine Engine::createEngine() {
+Engine Engine::createEngine(bool isHeadless) {
     EngineLoader::checkGlfwInit();
 
-    GLFWwindow* window = EngineComponentFactory::createWindow();
+    // 생성한 스레드 (main thread) 가 GLFW 호출을 담당
+    auto jobSystem = std::make_unique<JobSystem>();
+
+    GLFWwindow* window = EngineComponentFactory::createWindow(800, 600, "Vulkan!", !isHeadless);
 
     EngineLoader::checkValidationLayerSupport();
     EngineLoader::checkVkExtensions();
@@ -26,26 +40,63 @@ Engine Engine::createEngine() {
 
     constexpr float queuePriority = 1.0f;
     std::vector queueCreateInfos = QueueFactory::createQueueCreateInfos(physicalDevice, surface, &queuePriority);
-    VkDevice device = EngineComponentFactory::createDevice(physicalDevice, queueCreateInfos);
+    // 없으면 PipelineStateCache 가 monolithic pipeline 을 만듦
+    const bool supportsPipelineLibrary = PipelineStateCache::isPipelineLibrarySupported(instance, physicalDevice);
+    VkDevice device = EngineComponentFactory::createDevice(physicalDevice, queueCreateInfos, supportsPipelineLibrary);
+    VkQueue graphicsQueue = QueueFactory::getDeviceQueue(device, queueFamilyIndices.graphicsFamily.value());
+    VkQueue presentQueue = QueueFactory::getDeviceQueue(device, queueFamilyIndices.presentFamily.value());
+
+    ResourceRegistry resources {};
+    auto primaryWindow = std::make_unique<WindowSurface>(
+        window, surface, physicalDevice, device, resources, queueFamilyIndices, MAX_FRAMES_IN_FLIGHT
+    );
+    AssetPack assetPack = AssetPack::open(AssetPacks::DEFAULT_PACK_PATH);
+    resources.shaderModules = EngineLoader::getShaderModules(device, assetPack, *jobSystem);
+
+    const VkFormat swapchainImageFormat = primaryWindow->getFormat();
+    const VkFormat depthFormat = primaryWindow->getDepthTarget().format;
+    VkRenderPass renderPass = EngineComponentFactory::createRenderPass(device, swapchainImageFormat, depthFormat, RenderPassLoad::CLEAR);
+    VkRenderPass continueRenderPass = EngineComponentFactory::createRenderPass(device, swapchainImageFormat, depthFormat, RenderPassLoad::LOAD);
 
-    SwapchainSupportDetails swapchainSupportDetails = SwapchainSupports::getSwapchainSupportDetails(physicalDevice, surface);
-    VkSwapchainKHR swapchain = EngineComponentFactory::createSwapchain(device, surface, swapchainSupportDetails, queueCreateInfos.size() == 1);
-    VkSurfaceFormatKHR surfaceFormat = swapchainSupportDetails.getProperSurfaceFormat();
-    VkFormat swapchainImageFormat = surfaceFormat.format;
+    ShaderVariantCache shaderVariants {};
+    std::vector<const ShaderReflection*> stageReflections {};
 
-    std::vector<VkImageView> imageViews = EngineLoader::getImageViews(device, swapchain, swapchainImageFormat);
-    ShaderMap shaderModules = EngineLoader::getShaderModules(device);
+    for (const ShaderModule& shaderModule : resources.shaderModules) {
+        shaderVariants.setDefaults(shaderModule.module, shaderModule.reflection.specializationDefaults);
 
-    VkRenderPass renderPass = EngineComponentFactory::createRenderPass(device, swapchainImageFormat);
-    VkPipelineLayout pipelineLayout = EngineComponentFactory::createPipelineLayout(device);
-    VkExtent2D swapchainExtent = swapchainSupportDetails.getProperExtent();
+        if (shaderModule.type == COMPUTE_SHADER || Shaders::getProgramName(shaderModule.name) != Shaders::DEFAULT_PROGRAM) {
+            continue;
+        }
+        stageReflections.push_back(&shaderModule.reflection);
+    }
+    // 같은 binding 구성을 쓰는 pipeline 은 layout 을 공유
+    PipelineLayoutCache pipelineLayoutCache { device };
+    PipelineLayoutHandle pipelineLayoutHandle = pipelineLayoutCache.getPipelineLayout(resources, stageReflections);
+    VkPipelineLayout pipelineLayout = *resources.pipelineLayouts.get(pipelineLayoutHandle);
 
-    VkPipeline graphicsPipeline = EngineComponentFactory::createGraphicsPipeline(device, renderPass, pipelineLayout, shaderModules, swapchainExtent);
+    constexpr SpecializationConstant pipelineFeatures[] { { ShaderFeatures::VERTEX_COLOR, VK_TRUE } };
+    std::vector shaders = EngineComponentFactory::getProgramVariants(
+        resources.shaderModules, Shaders::DEFAULT_PROGRAM, shaderVariants, pipelineFeatures
+    );
 
-    VkFramebuffer framebuffer = EngineComponentFactory::createFramebuffer(device, renderPass, imageViews, swapchainExtent);
+    // viewport 가 dynamic state 라 창 크기와 무관하게 모든 창이 공유
+    // 나머지 상태는 GraphicsPipelineState 의 기본값 (back-face culling, blend 없음, 1 sample)
+    auto pipelineStateCache = std::make_unique<PipelineStateCache>(device, *jobSystem, supportsPipelineLibrary);
+    GraphicsPipelineState pipelineState {};
+    pipelineState.setShaders(shaders);
+    // cooked mesh 의 packed format 은 reflection 의 float 입력과 달라 MeshSupports 의 layout 을 씀
+    pipelineState.setVertexInput(MeshSupports::createInstancedVertexInputLayout());
+    pipelineState.layout = pipelineLayout;
+    pipelineState.renderPass = renderPass;
+    PipelineHandle pipelineHandle = pipelineStateCache->getPipeline(resources, pipelineState);
+
+    // 두 render pass 가 호환되므로 framebuffer 를 같이 사용
+    primaryWindow->createFramebuffers(resources, renderPass);
     VkCommandPool commandPool = EngineComponentFactory::createCommandPool(device, queueFamilyIndices.graphicsFamily.value());
 
-    return { window, instance, device, surface, swapchain, imageViews, shaderModules, renderPass, pipelineLayout, graphicsPipeline };
+    return {
+        instance, physicalDevice, device, queueFamilyIndices, graphicsQueue, presentQueue, std::move(primaryWindow), std::move(assetPack), std::move(jobSystem), std::move(resources), std::move(shaderVariants), std::move(pipelineLayoutCache), std::move(pipelineStateCache), renderPass, continueRenderPass, pipelineLayoutHandle, pipelineHandle, commandPool
+    };
 }
 
 
@@ -83,56 +134,926 @@ void EngineLoader::checkVkExtensions() {
     std::cout << "Vulkan extensions supported: " << extensionCount << std::endl;
 }
 
-std::vector<VkImageView> EngineLoader::getImageViews(VkDevice device, VkSwapchainKHR swapchain, VkFormat swapchainImageFormat) {
-    std::vector<VkImageView> imageViews {};
+ShaderMap EngineLoader::getShaderModules(VkDevice device, const AssetPack& assetPack, JobSystem& jobSystem) {
+    std::vector<const AssetEntry*> entries {};
 
-    for (VkImage image : EngineComponentFactory::getSwapchainImages(device, swapchain)) {
-        VkImageView imageView = EngineComponentFactory::createImageView(device, swapchainImageFormat, image);
-        imageViews.push_back(imageView);
+    for (const AssetEntry& entry : assetPack.entries()) {
+        if (assetPack.getName(entry).ends_with(".spv")) {
+            entries.push_back(&entry);
+        }
     }
-    return imageViews;
-}
+    // 압축 해제, reflection, vkCreateShaderModule 은 스레드 간 동기화가 필요 없으므로 병렬로 생성
+    std::vector<VkShaderModule> createdModules(entries.size());
+    std::vector<ShaderReflection> reflections(entries.size());
+
+    try {
+        jobSystem.parallelFor(static_cast<uint32_t>(entries.size()), 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t index = begin; index < end; index++) {
+                const AssetEntry& entry = *entries[index];
 
-ShaderMap EngineLoader::getShaderModules(VkDevice device) {
+                // 비압축 SPIR-V 는 매핑된 영역에서 바로 module 생성
+                std::vector<char> decompressed = AssetPack::isCompressed(entry) ? assetPack.read(entry) : std::vector<char> {};
+                std::span<const char> code = AssetPack::isCompressed(entry) ? std::span<const char> { decompressed } : assetPack.view(entry);
+
+                reflections[index] = getShaderReflection(assetPack, assetPack.getName(entry), code);
+                createdModules[index] = EngineComponentFactory::createShaderModule(device, code);
+            }
+        });
+    } catch (...) {
+        // parallelFor 는 모든 range 가 끝난 뒤 던지므로 다른 job 이 이미 만든 module 을 정리
+        for (VkShaderModule shaderModule : createdModules) {
+            if (shaderModule != VK_NULL_HANDLE) {
+                vkDestroyShaderModule(device, shaderModule, HostAllocators::getCallbacks(VK_OBJECT_TYPE_SHADER_MODULE));
+            }
+        }
+        throw;
+    }
     ShaderMap shaderModules {};
 
-    for (BinaryFile& binaryFile : BinaryFileUtils::getAllFiles()) {
-        ShaderType shaderType = Shaders::getShaderType(binaryFile.fileName);
-        VkShaderModule shaderModule = EngineComponentFactory::createShaderModule(device, binaryFile);
-        shaderModules[shaderType] = shaderModule;
+    for (size_t index = 0; index < entries.size(); index++) {
+        std::string name { assetPack.getName(*entries[index]) };
+        ShaderType shaderType = Shaders::getShaderType(name);
+        VkShaderModule shaderModule = createdModules[index];
+
+        // 이름별로 하나씩 유지. graphics stage 는 program 이름으로 묶어 pipeline 을 만듦
+        auto existing = std::ranges::find(shaderModules, name, &ShaderModule::name);
+
+        if (existing != shaderModules.end()) {
+            vkDestroyShaderModule(device, existing->module, HostAllocators::getCallbacks(VK_OBJECT_TYPE_SHADER_MODULE));
+            existing->name = std::move(name);
+            existing->module = shaderModule;
+            existing->reflection = std::move(reflections[index]);
+            continue;
+        }
+        shaderModules.create({ std::move(name), shaderType, shaderModule, std::move(reflections[index]) });
     }
     return shaderModules;
 }
 
+ShaderReflection EngineLoader::getShaderReflection(const AssetPack& assetPack, std::string_view name, std::span<const char> code) {
+    // 빌드 시 생성한 reflection 이 있고 SPIR-V 와 일치하면 파싱 생략
+    const std::string cacheName = std::string { name } + SpirvReflection::CACHE_EXTENSION;
+
+    if (const AssetEntry* cacheEntry = assetPack.find(cacheName)) {
+        const std::vector<char> cache = assetPack.read(*cacheEntry);
+
+        if (std::optional reflection = SpirvReflection::deserialize(cache, code)) {
+            return std::move(*reflection);
+        }
+    }
+    return SpirvReflection::reflect(code);
+}
+
 Engine::~Engine() {
-    // Destroy Pipeline
-    vkDestroyPipeline(m_device, m_pipeline, nullptr);
-    vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
-    vkDestroyRenderPass(m_device, m_renderPass, nullptr);
+    // 실행 중 retire 된 handle 은 GPU 작업이 끝난 뒤 일괄 파괴
+    vkDeviceWaitIdle(m_device);
+
+    // 아직 callback 을 받지 못한 캡처까지 전달한 뒤 정리
+    m_readbackRing->collect(m_frameNumber);
+    m_readbackRing.reset();
+    m_textureStreamer.reset();
+    m_meshBuffer.reset();
+    m_instanceBuffer.reset();
+    m_frustumCuller.reset();
+    m_occlusionCuller.reset();
+    m_particleSystem.reset();
+    m_spriteRenderer.reset();
+    m_frameBufferAllocator.reset();
+    m_frameDescriptorPool.reset();
 
-    // Destroy Shader
-    for (const auto& shaderModule: m_shaderModules | std::views::values) {
-        vkDestroyShaderModule(m_device, shaderModule, nullptr);
+    // command buffer 는 pool 과 함께 해제
+    for (const FrameContext& frame : m_frames) {
+        m_deletionQueue.retire(frame.inFlightFence);
     }
+    m_deletionQueue.retire(m_commandPool);
 
-    // Destroy Swapchain
-    for (auto& imageView : m_imageViews) {
-        vkDestroyImageView(m_device, imageView, nullptr);
+    // Destroy Swapchain, Framebuffer, Image View, Depth
+    for (const auto& window : m_windows) {
+        window->destroy(m_resources, m_deletionQueue);
     }
-    vkDestroySwapchainKHR(m_device, m_swapchain, nullptr);
+
+    // Destroy Pipeline, Layout, Shader
+    m_resources.releaseAll(m_deletionQueue);
+    m_pipelineLayoutCache.clear();
+    m_pipelineStateCache->clear();
+    m_deletionQueue.flush();
+
+    vkDestroyRenderPass(m_device, m_renderPass, HostAllocators::getCallbacks(VK_OBJECT_TYPE_RENDER_PASS));
+    vkDestroyRenderPass(m_device, m_continueRenderPass, HostAllocators::getCallbacks(VK_OBJECT_TYPE_RENDER_PASS));
+    vkDestroyRenderPass(m_device, m_mirrorRenderPass, HostAllocators::getCallbacks(VK_OBJECT_TYPE_RENDER_PASS));
 
     // Destroy Device, Surface, Instance
-    vkDestroyDevice(m_device, nullptr);
-    vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
-    vkDestroyInstance(m_instance, nullptr);
+    vkDestroyDevice(m_device, HostAllocators::getCallbacks(VK_OBJECT_TYPE_DEVICE));
+
+    for (const auto& window : m_windows) {
+        vkDestroySurfaceKHR(m_instance, window->getSurface(), HostAllocators::getCallbacks(VK_OBJECT_TYPE_SURFACE_KHR));
+    }
+    vkDestroyInstance(m_instance, HostAllocators::getCallbacks(VK_OBJECT_TYPE_INSTANCE));
 
     // Destroy Window
-    glfwDestroyWindow(m_window);
+    for (const auto& window : m_windows) {
+        glfwDestroyWindow(window->getWindow());
+    }
     glfwTerminate();
 }
 
-void Engine::waitEventsUntilExit() const {
-    while (!glfwWindowShouldClose(m_window)) {
-        glfwPollEvents();
+void Engine::run(const LoopConfig& config) {
+    registerInputCallbacks();
+
+    m_isRenderStopping = false;
+    m_isRenderThreadDone = false;
+    std::exception_ptr renderException {};
+
+    // frame 기록, submit, present 는 render thread 가 전담
+    std::thread renderThread { [&] {
+        try {
+            runRenderLoop(config);
+        } catch (...) {
+            renderException = std::current_exception();
+        }
+        m_isRenderThreadDone.store(true, std::memory_order_release);
+        // glfwWaitEvents 중인 main thread 를 깨움
+        glfwPostEmptyEvent();
+    } };
+
+    // main thread 는 OS event 만 처리. 창 드래그 등으로 막혀도 render thread 는 계속 진행
+    // render thread 가 끝날 때까지 main thread job 을 계속 처리해야 대기 중인 job 이 막히지 않음
+    while (!m_isRenderThreadDone.load(std::memory_order_acquire)) {
+        glfwWaitEvents();
+        m_jobSystem->processMainThreadJobs();
+
+        if (glfwWindowShouldClose(getWindow()) && !m_isRenderStopping.exchange(true)) {
+            wakeRenderThread();
+        }
+        // 보조 창은 닫아도 engine 이 멈추지 않도록 숨기고 더 그리지 않음 (swapchain 은 종료 시 정리)
+        for (size_t index = 1; index < m_windows.size(); index++) {
+            WindowSurface& window = *m_windows[index];
+
+            if (!window.isClosed() && glfwWindowShouldClose(window.getWindow())) {
+                glfwHideWindow(window.getWindow());
+                window.close();
+            }
+        }
+    }
+    renderThread.join();
+
+    if (renderException) {
+        std::rethrow_exception(renderException);
+    }
+}
+
+void Engine::createFrameContexts() {
+    for (FrameContext& frame : m_frames) {
+        frame.commandBuffer = EngineComponentFactory::createCommandBuffer(m_device, m_commandPool);
+        // 첫 frame 이 대기하지 않도록 signaled 로 생성
+        frame.inFlightFence = EngineComponentFactory::createFence(m_device, true);
+    }
+}
+
+void Engine::createReadbackRing() {
+    const WindowSurface& primaryWindow = *m_windows.front();
+
+    m_supportsCapture = primaryWindow.supportsCapture() && ReadbackRing::getTexelSize(primaryWindow.getFormat()) != 0;
+    // frame in flight 보다 많아야 callback 이 느려도 매 frame 캡처 가능
+    m_readbackRing = std::make_unique<ReadbackRing>(
+        m_physicalDevice, m_device, m_deletionQueue, *m_jobSystem, ReadbackConfig { MAX_FRAMES_IN_FLIGHT + 2 }
+    );
+}
+
+WindowSurface& Engine::addWindow(int width, int height, const char* title) {
+    GLFWwindow* window = EngineComponentFactory::createWindow(width, height, title);
+    VkSurfaceKHR surface = EngineComponentFactory::createSurface(m_instance, window);
+
+    VkBool32 supportsPresent = VK_FALSE;
+    vkGetPhysicalDeviceSurfaceSupportKHR(m_physicalDevice, m_queueFamilyIndices.presentFamily.value(), surface, &supportsPresent);
+
+    // render pass 와 pipeline 을 공유하려면 swapchain format 이 주 창과 같아야 함
+    const SwapchainSupportDetails swapchainSupportDetails = SwapchainSupports::getSwapchainSupportDetails(m_physicalDevice, surface);
+    const bool isFormatCompatible = !swapchainSupportDetails.surfaceFormats.empty()
+        && swapchainSupportDetails.getProperSurfaceFormat().format == m_windows.front()->getFormat();
+
+    if (!supportsPresent || !isFormatCompatible) {
+        vkDestroySurfaceKHR(m_instance, surface, HostAllocators::getCallbacks(VK_OBJECT_TYPE_SURFACE_KHR));
+        glfwDestroyWindow(window);
+        throw std::runtime_error("window surface is not compatible with the primary swapchain!");
+    }
+    auto windowSurface = std::make_unique<WindowSurface>(
+        window, surface, m_physicalDevice, m_device, m_resources, m_queueFamilyIndices, MAX_FRAMES_IN_FLIGHT, m_memoryBudget.get()
+    );
+    // 보조 창은 pass 하나로 끝나므로 지우면서 시작해 바로 present layout 으로 끝내는 pass 를 씀 (framebuffer 는 호환되는 m_renderPass 로 생성)
+    if (m_mirrorRenderPass == VK_NULL_HANDLE) {
+        m_mirrorRenderPass = EngineComponentFactory::createRenderPass(
+            m_device, m_windows.front()->getFormat(), windowSurface->getDepthTarget().format, RenderPassLoad::CLEAR, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+        );
+    }
+    windowSurface->createFramebuffers(m_resources, m_renderPass);
+    m_windows.push_back(std::move(windowSurface));
+    return *m_windows.back();
+}
+
+void Engine::createFrameAllocators() {
+    m_frameBufferAllocator = std::make_unique<LinearBufferAllocator>(m_physicalDevice, m_device, m_deletionQueue, MAX_FRAMES_IN_FLIGHT);
+
+    // 부족하면 같은 크기의 pool 이 더 생김
+    constexpr VkDescriptorPoolSize poolSizes[] {
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 256 },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 256 },
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 256 },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 256 },
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 256 },
+    };
+    m_frameDescriptorPool = std::make_unique<FrameDescriptorPool>(m_device, m_deletionQueue, MAX_FRAMES_IN_FLIGHT, poolSizes, 256);
+}
+
+void Engine::registerEvictionCallbacks() {
+    // 압박이 풀리면 되돌릴 값
+    m_textureMemoryBudget = m_textureStreamer->getMemoryBudget();
+
+    // device local heap 이 부족하면 스트리밍 텍스처의 높은 mip 부터 내려 driver paging 을 피함
+    m_memoryBudget->addEvictionCallback([this](const MemoryPressure& pressure) {
+        if ((pressure.heapFlags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) == 0 || pressure.usage == 0) {
+            return;
+        }
+        // usage 에는 particle pool, instance buffer, depth 등도 들어 있으므로 텍스처가 차지하는 비율만큼만 줄임
+        const VkDeviceSize residentBytes = m_textureStreamer->getResidentBytes();
+        const auto textureShare = static_cast<double>(std::min(residentBytes, pressure.usage)) / static_cast<double>(pressure.usage);
+        const auto textureBytesToFree = static_cast<VkDeviceSize>(static_cast<double>(pressure.bytesToFree) * textureShare);
+        const VkDeviceSize targetBytes = residentBytes > textureBytesToFree ? residentBytes - textureBytesToFree : 0;
+
+        m_textureStreamer->setMemoryBudget(std::min(m_textureStreamer->getMemoryBudget(), targetBytes));
+    });
+}
+
+void Engine::restoreTextureBudget() {
+    if (m_textureStreamer->getMemoryBudget() >= m_textureMemoryBudget) {
+        return;
+    }
+    // 모든 device local heap 이 targetRatio 아래로 내려간 뒤에 원래 budget 으로 되돌림
+    for (uint32_t heapIndex = 0; heapIndex < m_memoryBudget->getHeapCount(); heapIndex++) {
+        const HeapBudget heap = m_memoryBudget->getHeapBudget(heapIndex);
+
+        if ((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0 && m_memoryBudget->isOverBudget(heapIndex)) {
+            return;
+        }
+    }
+    m_textureStreamer->setMemoryBudget(m_textureMemoryBudget);
+}
+
+void Engine::requestCapture(ReadbackCallback callback) {
+    if (!m_supportsCapture) {
+        throw std::runtime_error("swapchain does not support capture!");
+    }
+    {
+        std::lock_guard lock { m_captureMutex };
+        m_captureRequests.push_back(std::move(callback));
+    }
+    requestRedraw();
+}
+
+void Engine::setContinuousCapture(ReadbackCallback callback) {
+    if (callback && !m_supportsCapture) {
+        throw std::runtime_error("swapchain does not support capture!");
+    }
+    {
+        std::lock_guard lock { m_captureMutex };
+        m_continuousCapture = std::move(callback);
+    }
+    requestRedraw();
+}
+
+void Engine::startFrameCapture(std::filesystem::path path, uint32_t frameCount) {
+    {
+        std::lock_guard lock { m_captureMutex };
+        m_pendingFrameCapturePath = std::move(path);
+        m_pendingFrameCaptureCount = frameCount;
+    }
+    requestRedraw();
+}
+
+void Engine::registerInputCallbacks() {
+    GLFWwindow* primaryWindow = getWindow();
+    glfwSetWindowUserPointer(primaryWindow, this);
+
+    static constexpr auto push = [](GLFWwindow* window, const InputEvent& event) {
+        static_cast<Engine*>(glfwGetWindowUserPointer(window))->pushInputEvent(event);
+    };
+    glfwSetKeyCallback(primaryWindow, [](GLFWwindow* window, int key, int, int action, int mods) {
+        push(window, { InputEventType::KEY, key, action, mods, 0.0, 0.0, glfwGetTime() });
+    });
+    glfwSetMouseButtonCallback(primaryWindow, [](GLFWwindow* window, int button, int action, int mods) {
+        push(window, { InputEventType::MOUSE_BUTTON, button, action, mods, 0.0, 0.0, glfwGetTime() });
+    });
+    glfwSetCursorPosCallback(primaryWindow, [](GLFWwindow* window, double x, double y) {
+        push(window, { InputEventType::CURSOR_POSITION, 0, 0, 0, x, y, glfwGetTime() });
+    });
+    glfwSetScrollCallback(primaryWindow, [](GLFWwindow* window, double x, double y) {
+        push(window, { InputEventType::SCROLL, 0, 0, 0, x, y, glfwGetTime() });
+    });
+    glfwSetFramebufferSizeCallback(primaryWindow, [](GLFWwindow* window, int width, int height) {
+        push(window, { InputEventType::FRAMEBUFFER_SIZE, 0, 0, 0, static_cast<double>(width), static_cast<double>(height), glfwGetTime() });
+    });
+    glfwSetWindowRefreshCallback(primaryWindow, [](GLFWwindow* window) {
+        push(window, { InputEventType::WINDOW_REFRESH, 0, 0, 0, 0.0, 0.0, glfwGetTime() });
+    });
+}
+
+void Engine::pushInputEvent(const InputEvent& event) {
+    // 가득 차면 render thread 가 비울 때까지 잠시 양보 (입력 유실보다 지연이 나음)
+    while (!m_inputEvents.tryPush(event)) {
+        if (m_isRenderThreadDone.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+    wakeRenderThread();
+}
+
+void Engine::wakeRenderThread() {
+    {
+        std::lock_guard lock { m_renderWakeupMutex };
+        m_hasRenderWakeup = true;
+    }
+    m_renderWakeupCondition.notify_one();
+}
+
+void Engine::runRenderLoop(const LoopConfig& config) {
+    using Clock = std::chrono::steady_clock;
+
+    // FRAME_CAP 일 때만 targetFrameRate 를 사용하고 검사
+    std::optional<FramePacer> framePacer {};
+
+    if (config.mode == LoopMode::FRAME_CAP) {
+        framePacer.emplace(config.targetFrameRate);
+    }
+    CpuUsageMeter cpuUsageMeter {};
+    Clock::time_point lastFrameTime = Clock::now();
+    Clock::time_point lastReportTime = lastFrameTime;
+    uint64_t reportFrameNumber = m_frameNumber;
+
+    m_needsRedraw = true;
+
+    while (!m_isRenderStopping.load(std::memory_order_acquire)) {
+        bool shouldDraw = true;
+
+        if (config.mode == LoopMode::ON_DEMAND) {
+            const bool hasIdleRedraw = config.idleRedrawInterval.count() > 0.0;
+
+            // 변화가 없으면 입력이나 redraw 요청이 올 때까지 잠들어 CPU 를 쓰지 않음
+            if (!needsRedraw() && !hasIdleRedraw) {
+                waitForRenderWakeup(std::nullopt);
+            } else if (!needsRedraw()) {
+                waitForRenderWakeup(lastFrameTime + config.idleRedrawInterval - Clock::now());
+            }
+            applyInputEvents();
+            shouldDraw = needsRedraw() || (hasIdleRedraw && Clock::now() - lastFrameTime >= config.idleRedrawInterval);
+        } else {
+            applyInputEvents();
+        }
+        if (shouldDraw && !m_isRenderStopping.load(std::memory_order_acquire)) {
+            drawFrame();
+            lastFrameTime = Clock::now();
+        }
+        if (framePacer) {
+            framePacer->wait();
+        }
+        if (config.reportInterval.count() > 0.0) {
+            const std::chrono::duration<double> elapsed = Clock::now() - lastReportTime;
+
+            if (elapsed >= config.reportInterval) {
+                uint64_t hostAllocatedBytes = 0;
+
+                for (uint32_t scope = VK_SYSTEM_ALLOCATION_SCOPE_COMMAND; scope <= VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE; scope++) {
+                    hostAllocatedBytes += HostAllocators::get().getScopeCounters(static_cast<VkSystemAllocationScope>(scope)).liveBytes;
+                }
+                const OcclusionCullingStats& cullingStats = m_occlusionCuller->getStats();
+
+                m_loopStats = {
+                    cpuUsageMeter.sample(),
+                    static_cast<double>(m_frameNumber - reportFrameNumber) / elapsed.count(),
+                    m_frameNumber,
+                    hostAllocatedBytes,
+                    cullingStats.frustumCulledCount,
+                    cullingStats.occlusionCulledCount,
+                    cullingStats.drawnTriangleCount,
+                };
+                std::cout << "CPU " << m_loopStats.cpuUtilization * 100.0 << "%, " << m_loopStats.framesPerSecond << " fps, host "
+                    << (m_loopStats.hostAllocatedBytes >> 10) << " KiB, culled " << m_loopStats.frustumCulledCount << " frustum / "
+                    << m_loopStats.occlusionCulledCount << " occluded, " << m_loopStats.drawnTriangleCount << " triangles" << std::endl;
+
+                lastReportTime = Clock::now();
+                reportFrameNumber = m_frameNumber;
+            }
+        }
+    }
+    vkDeviceWaitIdle(m_device);
+}
+
+void Engine::waitForRenderWakeup(std::optional<std::chrono::duration<double>> timeout) {
+    std::unique_lock lock { m_renderWakeupMutex };
+
+    const auto isWoken = [&] {
+        return m_hasRenderWakeup || m_isRenderStopping.load(std::memory_order_acquire);
+    };
+    if (!timeout) {
+        m_renderWakeupCondition.wait(lock, isWoken);
+    } else if (timeout->count() > 0.0) {
+        m_renderWakeupCondition.wait_for(lock, *timeout, isWoken);
+    }
+    m_hasRenderWakeup = false;
+}
+
+void Engine::applyInputEvents() {
+    m_input.beginFrame();
+
+    InputEvent event;
+
+    while (m_inputEvents.tryPop(event)) {
+        m_input.apply(event);
     }
-}
\ No newline at end of file
+    // 입력과 창 노출은 화면을 바꿀 수 있으므로 다시 그림
+    if (m_input.eventCount > 0) {
+        m_needsRedraw.store(true, std::memory_order_relaxed);
+    }
+}
+
+bool Engine::needsRedraw() const {
+    return m_needsRedraw.load(std::memory_order_relaxed) || m_sceneGraph.hasChanges() || m_textureStreamer->hasPendingWork()
+        || m_particleSystem->isActive();
+}
+
+FrameContext& Engine::beginFrame(uint64_t frame) {
+    FrameContext& context = m_frames[frame % MAX_FRAMES_IN_FLIGHT];
+
+    // 이 context 를 마지막으로 쓴 frame 이 끝나야 재사용 가능
+    vkWaitForFences(m_device, 1, &context.inFlightFence, VK_TRUE, UINT64_MAX);
+    const uint64_t completedFrame = frame > MAX_FRAMES_IN_FLIGHT ? frame - MAX_FRAMES_IN_FLIGHT : 0;
+    m_deletionQueue.advance(frame, completedFrame);
+    // fence 로 끝난 것이 확인된 frame 의 캡처만 worker 로 넘기므로 GPU 를 기다리지 않음
+    m_readbackRing->collect(completedFrame);
+    // budget 에 가까우면 이번 frame 의 스트리밍 전에 eviction 이 먼저 일어남
+    m_memoryBudget->update(frame);
+    restoreTextureBudget();
+    // 이 context 의 GPU 작업이 끝났으므로 지난번 이 frame 에 할당한 것을 한 번에 버림
+    m_frameBufferAllocator->begin(frame);
+    m_frameDescriptorPool->begin(frame);
+    // 최적화 link 가 끝난 pipeline 을 이번 frame 의 record 전에 교체
+    m_pipelineStateCache->collect(m_resources, m_deletionQueue);
+
+    // collect 가 pipeline 을 바꿀 수 있으므로 handle 에서 매 frame 다시 가져옴
+    if (!m_meshBuffer->empty()) {
+        m_occlusionCuller->setGeometry({
+            *m_resources.pipelines.get(m_pipeline), m_meshBuffer->getVertexBuffer(), m_meshBuffer->getIndexBuffer(), VK_INDEX_TYPE_UINT32
+        });
+    }
+    return context;
+}
+
+void Engine::recreateSwapchains() {
+    const bool needsRecreate = std::ranges::any_of(m_windows, [](const auto& window) {
+        return !window->isClosed() && window->needsRecreate();
+    });
+    if (!needsRecreate) {
+        return;
+    }
+    // 이전 image 와 depth target 을 쓰는 frame 이 모두 끝나야 함. 창 크기가 바뀔 때만이라 기다려도 됨
+    vkDeviceWaitIdle(m_device);
+
+    for (const auto& window : m_windows) {
+        if (window->isClosed() || !window->needsRecreate() || !window->recreate(m_resources, m_deletionQueue)) {
+            continue;
+        }
+        // Hi-Z 는 주 창의 depth 로 만듦
+        if (window == m_windows.front()) {
+            m_occlusionCuller->resize(window->getDepthTarget().view, window->getExtent());
+            m_supportsCapture = window->supportsCapture() && ReadbackRing::getTexelSize(window->getFormat()) != 0;
+        }
+    }
+}
+
+void Engine::drawFrame() {
+    const uint64_t frame = ++m_frameNumber;
+    FrameContext& context = beginFrame(frame);
+    recreateSwapchains();
+
+    // 주 창의 image 가 없으면 컬링과 장면을 기록할 곳이 없으므로 이번 frame 은 건너뜀
+    WindowSurface& primaryWindow = *m_windows.front();
+    const bool wasOutOfDate = primaryWindow.needsRecreate();
+
+    if (!primaryWindow.acquire(frame)) {
+        // 방금 OUT_OF_DATE 가 되었으면 다음 frame 에 재생성해서 그림
+        // 최소화되어 재생성하지 못한 것이면 복원될 때의 FRAMEBUFFER_SIZE 입력이 깨움
+        m_needsRedraw.store(!wasOutOfDate && primaryWindow.needsRecreate(), std::memory_order_relaxed);
+        return;
+    }
+    m_needsRedraw.store(false, std::memory_order_relaxed);
+    m_textureStreamer->update(frame);
+    m_sceneGraph.update(*m_jobSystem, *m_instanceBuffer, frame);
+    // 이 context 의 지난 컬링 결과를 읽고 이번 frame 의 객체를 올림
+    m_occlusionCuller->prepare(frame, m_cullingView);
+
+    const auto frameTime = std::chrono::steady_clock::now();
+    const std::chrono::duration<float> deltaTime = frameTime - m_lastFrameTime;
+    m_lastFrameTime = frameTime;
+
+    // 이 context 의 fence 를 기다렸으므로 같은 번호의 ring 구간에 바로 씀
+    SpriteBatch& spriteBatch = m_spriteRenderer->begin(frame);
+    // 캡처할 frame 이면 ring 을 다시 읽지 않도록 sprite 를 CPU 쪽에도 남김
+    beginFrameCapture();
+    spriteBatch.setRecording(m_frameWriter != nullptr);
+
+    if (m_spriteCallback) {
+        m_spriteCallback(spriteBatch);
+    }
+
+    // 열린 창의 image 를 모두 받아 submit 과 present 를 한 번씩만 함. image 를 받지 못한 보조 창은 이번 frame 에서 뺌
+    m_presentBatch.clear();
+    m_presentBatch.add(primaryWindow, frame);
+
+    for (size_t index = 1; index < m_windows.size(); index++) {
+        if (m_windows[index]->acquire(frame)) {
+            m_presentBatch.add(*m_windows[index], frame);
+        }
+    }
+    vkResetFences(m_device, 1, &context.inFlightFence);
+    vkResetCommandBuffer(context.commandBuffer, 0);
+
+    VkFramebuffer framebuffer = *m_resources.framebuffers.get(primaryWindow.getFramebuffer());
+    VkBuffer instanceBuffer = m_instanceBuffer->getBuffer(frame);
+    // 시뮬레이션이 seed 를 진행시키기 전의 값
+    const uint32_t particleSeed = m_particleSystem->getSeed();
+
+    EngineComponentFactory::beginCommandBuffer(context.commandBuffer);
+    recordScene(context.commandBuffer, frame, framebuffer, m_continueRenderPass, primaryWindow.getExtent(), deltaTime.count());
+
+    for (const WindowSurface* window : m_presentBatch.getWindows()) {
+        if (window != &primaryWindow) {
+            recordMirrorPass(context.commandBuffer, *window, instanceBuffer);
+        }
+    }
+    recordCaptures(context.commandBuffer, frame);
+    // present family 가 다르면 캡처 복사까지 끝난 image 를 넘김
+    m_presentBatch.recordOwnershipReleases(context.commandBuffer);
+    EngineComponentFactory::endCommandBuffer(context.commandBuffer);
+
+    // 모든 창의 image 를 기다리고, 끝나면 창마다 present 용 semaphore 를 signal
+    const VkSubmitInfo submitInfo = m_presentBatch.createSubmitInfo(&context.commandBuffer);
+
+    if (vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, context.inFlightFence) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit draw command buffer!");
+    }
+    m_presentBatch.present(m_presentQueue);
+    captureFrame(deltaTime.count(), particleSeed);
+}
+
+void Engine::recordScene(
+    VkCommandBuffer commandBuffer, uint64_t frame, VkFramebuffer framebuffer, VkRenderPass continueRenderPass, VkExtent2D extent, float deltaTime
+) {
+    VkBuffer instanceBuffer = m_instanceBuffer->getBuffer(frame);
+
+    m_meshBuffer->recordUpload(commandBuffer);
+    m_occlusionCuller->recordEarlyCull(commandBuffer);
+    m_particleSystem->recordSimulation(commandBuffer, deltaTime);
+    m_spriteRenderer->recordUploads(commandBuffer);
+
+    // EARLY: 지난 frame 에 보였던 객체로 depth 를 채움
+    EngineComponentFactory::beginRenderPass(commandBuffer, m_renderPass, framebuffer, extent);
+    recordMeshConstants(commandBuffer);
+    m_occlusionCuller->recordDraws(commandBuffer, OcclusionPass::EARLY, instanceBuffer);
+    vkCmdEndRenderPass(commandBuffer);
+
+    // 그 depth 로 Hi-Z 를 만들고 나머지 객체를 검사
+    m_occlusionCuller->recordPyramid(commandBuffer);
+    m_occlusionCuller->recordLateCull(commandBuffer);
+
+    // LATE: 새로 보이게 된 객체를 이어 그리고 continueRenderPass 의 final layout 으로 끝냄
+    EngineComponentFactory::beginRenderPass(commandBuffer, continueRenderPass, framebuffer, extent);
+    recordMeshConstants(commandBuffer);
+    m_occlusionCuller->recordDraws(commandBuffer, OcclusionPass::LATE, instanceBuffer);
+    m_particleSystem->recordDraw(commandBuffer);
+    m_spriteRenderer->recordDraw(commandBuffer, extent);
+    vkCmdEndRenderPass(commandBuffer);
+}
+
+void Engine::recordMirrorPass(VkCommandBuffer commandBuffer, const WindowSurface& window, VkBuffer instanceBuffer) {
+    const VkExtent2D extent = window.getExtent();
+    VkFramebuffer framebuffer = *m_resources.framebuffers.get(window.getFramebuffer());
+
+    // 컬링 결과는 EARLY 와 LATE 로 나뉘어 있으므로 둘 다 그리면 주 창에 보인 객체 전체가 됨
+    EngineComponentFactory::beginRenderPass(commandBuffer, m_mirrorRenderPass, framebuffer, extent);
+    recordMeshConstants(commandBuffer);
+    m_occlusionCuller->recordDraws(commandBuffer, OcclusionPass::EARLY, instanceBuffer);
+    m_occlusionCuller->recordDraws(commandBuffer, OcclusionPass::LATE, instanceBuffer);
+    m_particleSystem->recordDraw(commandBuffer);
+    m_spriteRenderer->recordDraw(commandBuffer, extent);
+    vkCmdEndRenderPass(commandBuffer);
+}
+
+void Engine::recordMeshConstants(VkCommandBuffer commandBuffer) const {
+    // 입자와 sprite 가 다른 layout 의 push constant 를 쓰므로 pass 마다 다시 기록
+    vkCmdPushConstants(
+        commandBuffer, *m_resources.pipelineLayouts.get(m_pipelineLayout), VK_SHADER_STAGE_VERTEX_BIT,
+        0, sizeof(glm::mat4), &m_cullingView.viewProjection
+    );
+}
+
+void Engine::recordCaptures(VkCommandBuffer commandBuffer, uint64_t frame) {
+    if (!m_supportsCapture) {
+        return;
+    }
+    std::vector<ReadbackCallback> requests;
+    ReadbackCallback continuousCapture;
+    {
+        std::lock_guard lock { m_captureMutex };
+        requests.swap(m_captureRequests);
+        continuousCapture = m_continuousCapture;
+    }
+    const WindowSurface& primaryWindow = *m_windows.front();
+    VkImage image = primaryWindow.getImage();
+
+    // render pass 가 PRESENT_SRC 로 끝나므로 복사 후 같은 layout 으로 되돌림
+    const auto record = [&](ReadbackCallback& callback) {
+        return m_readbackRing->record(
+            commandBuffer, image, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, primaryWindow.getFormat(), primaryWindow.getExtent(), frame, std::move(callback)
+        );
+    };
+    std::vector<ReadbackCallback> deferred;
+
+    for (ReadbackCallback& callback : requests) {
+        if (!record(callback)) {
+            deferred.push_back(std::move(callback));
+        }
+    }
+    if (continuousCapture) {
+        record(continuousCapture);
+    }
+    // 한 번만 요청한 캡처는 잃지 않도록 다음 frame 에 다시 시도
+    if (!deferred.empty()) {
+        std::lock_guard lock { m_captureMutex };
+        m_captureRequests.insert(m_captureRequests.begin(), std::make_move_iterator(deferred.begin()), std::make_move_iterator(deferred.end()));
+        m_needsRedraw.store(true, std::memory_order_relaxed);
+    }
+}
+
+void Engine::beginFrameCapture() {
+    // 새 캡처는 frame 경계에서만 시작
+    if (m_frameWriter) {
+        return;
+    }
+    std::filesystem::path path;
+    {
+        std::lock_guard lock { m_captureMutex };
+
+        if (m_pendingFrameCaptureCount == 0) {
+            return;
+        }
+        path = std::move(m_pendingFrameCapturePath);
+        m_frameCaptureCount = std::exchange(m_pendingFrameCaptureCount, 0);
+    }
+    m_frameWriter = std::make_unique<FrameStreamWriter>(path);
+    // 첫 frame 에는 모든 상태를 씀
+    m_capturedSceneVersion = std::numeric_limits<uint64_t>::max();
+    m_capturedCullerVersion = std::numeric_limits<uint64_t>::max();
+}
+
+void Engine::captureFrame(float deltaTime, uint32_t particleSeed) {
+    if (!m_frameWriter) {
+        return;
+    }
+    FrameStreamWriter& writer = *m_frameWriter;
+    writer.writeValue(FrameCommandType::BEGIN_FRAME, FrameBegin { deltaTime, particleSeed });
+    writer.writeValueIfChanged(FrameCommandType::SET_VIEW, m_cullingView);
+
+    // instance buffer 는 write-combined 라 SceneGraph 가 가진 world 행렬을 씀
+    if (m_sceneGraph.getVersion() != m_capturedSceneVersion) {
+        const std::span<const glm::mat4> worlds = m_sceneGraph.getWorldMatrices();
+        writer.write(FrameCommandType::UPLOAD_INSTANCES, { reinterpret_cast<const char*>(worlds.data()), worlds.size_bytes() });
+        m_capturedSceneVersion = m_sceneGraph.getVersion();
+    }
+    if (m_occlusionCuller->getVersion() != m_capturedCullerVersion) {
+        writer.write(FrameCommandType::SET_OCCLUDERS, m_occlusionCuller->serializeObjects());
+        m_capturedCullerVersion = m_occlusionCuller->getVersion();
+    }
+    writer.writeIfChanged(FrameCommandType::SET_PARTICLES, m_particleSystem->serializeState());
+
+    std::vector<char> payload;
+
+    for (const AtlasUpload& upload : m_spriteRenderer->getRecordedUploads()) {
+        payload.clear();
+        ByteStreams::write(payload, AtlasUploadHeader { upload.page, upload.x, upload.y, upload.width, upload.height });
+        ByteStreams::writeArray<uint8_t>(payload, upload.pixels);
+        writer.write(FrameCommandType::UPLOAD_ATLAS, payload);
+    }
+    // ring 은 write-combined 라 SpriteBatch 가 남긴 CPU 사본을 씀 (beginFrameCapture 뒤 setRecording)
+    const SpriteBatch& spriteBatch = m_spriteRenderer->getBatch();
+    const std::span<const SpriteDrawBatch> spriteBatches = spriteBatch.getBatches();
+    payload.clear();
+    ByteStreams::write(payload, static_cast<uint32_t>(spriteBatches.size()));
+    ByteStreams::writeArray(payload, spriteBatches);
+    ByteStreams::writeArray(payload, spriteBatch.getVertices());
+    writer.write(FrameCommandType::DRAW_SPRITES, payload);
+
+    writer.endFrame();
+
+    if (writer.getFrameCount() >= m_frameCaptureCount) {
+        std::cout << "frame capture finished: " << writer.getFrameCount() << " frames" << std::endl;
+        m_frameWriter.reset();
+    }
+}
+
+float Engine::applyFrameCommands(std::span<const FrameCommand> commands, uint64_t frame) {
+    SpriteBatch& spriteBatch = m_spriteRenderer->begin(frame);
+    spriteBatch.setRecording(false);
+    float deltaTime = 0.0f;
+    bool isValid = true;
+
+    for (const FrameCommand& command : commands) {
+        std::span<const char> payload = command.payload;
+
+        switch (command.type) {
+            case FrameCommandType::BEGIN_FRAME: {
+                FrameBegin begin {};
+                isValid = ByteStreams::read(payload, begin);
+                deltaTime = begin.deltaTime;
+                m_particleSystem->setSeed(begin.particleSeed);
+                break;
+            }
+            case FrameCommandType::SET_VIEW:
+                isValid = ByteStreams::read(payload, m_cullingView);
+                break;
+            case FrameCommandType::UPLOAD_INSTANCES:
+                isValid = payload.size() % sizeof(glm::mat4) == 0
+                    && ByteStreams::readArray(payload, m_replayInstances, payload.size() / sizeof(glm::mat4));
+                m_replayInstanceVersion++;
+                break;
+            case FrameCommandType::SET_OCCLUDERS:
+                isValid = m_occlusionCuller->deserializeObjects(payload);
+                break;
+            case FrameCommandType::SET_PARTICLES:
+                isValid = m_particleSystem->deserializeState(payload);
+                break;
+            case FrameCommandType::UPLOAD_ATLAS: {
+                AtlasUploadHeader header {};
+
+                if (!ByteStreams::read(payload, header)) {
+                    isValid = false;
+                    break;
+                }
+                m_spriteRenderer->queueUpload({
+                    header.page, header.x, header.y, header.width, header.height, std::vector<uint8_t>(payload.begin(), payload.end())
+                });
+                break;
+            }
+            case FrameCommandType::DRAW_SPRITES: {
+                uint32_t batchCount = 0;
+                isValid = ByteStreams::read(payload, batchCount) && ByteStreams::readArray(payload, m_replaySpriteBatches, batchCount)
+                    && payload.size() % sizeof(SpriteVertex) == 0
+                    && ByteStreams::readArray(payload, m_replaySpriteVertices, payload.size() / sizeof(SpriteVertex));
+
+                if (!isValid) {
+                    break;
+                }
+                const size_t quadCount = m_replaySpriteVertices.size() / SpriteBatch::VERTICES_PER_QUAD;
+                uint32_t pageCount = 0;
+
+                for (const SpriteDrawBatch& batch : m_replaySpriteBatches) {
+                    isValid = isValid && size_t { batch.firstQuad } + batch.quadCount <= quadCount;
+                    pageCount = std::max(pageCount, batch.page + 1);
+                }
+                // 캡처 전에 올라간 atlas 영역은 기록에 없으므로 빈 page 로 그림
+                m_spriteRenderer->reservePages(pageCount);
+
+                if (isValid) {
+                    spriteBatch.append(m_replaySpriteVertices, m_replaySpriteBatches);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        if (!isValid) {
+            throw std::runtime_error("corrupted frame capture!");
+        }
+    }
+    // SceneGraph::update 처럼 slot 에 기록된 version 이 다를 때만 씀
+    InstanceBuffer::Slot& slot = m_instanceBuffer->acquire(frame, static_cast<uint32_t>(m_replayInstances.size()));
+
+    if (slot.writtenVersion != m_replayInstanceVersion) {
+        std::ranges::copy(m_replayInstances, slot.instances);
+        slot.writtenVersion = m_replayInstanceVersion;
+    }
+    return deltaTime;
+}
+
+FrameReplayStats Engine::replay(const FrameStreamReader& reader, uint32_t repeatCount) {
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    const uint32_t frameCount = reader.getFrameCount();
+
+    if (frameCount == 0) {
+        throw std::runtime_error("frame capture has no frame!");
+    }
+    repeatCount = std::max(repeatCount, 1u);
+
+    // swapchain 대신 같은 format 의 image 에 그림. depth 는 OcclusionCuller 가 Hi-Z 를 만드는 주 창의 것을 사용
+    const WindowSurface& primaryWindow = *m_windows.front();
+    const VkExtent2D extent = primaryWindow.getExtent();
+    const ImageAllocation colorImage = MemorySupports::createImage(
+        m_physicalDevice,
+        m_device,
+        MemorySupports::createImageCreateInfo(
+            extent, 1, primaryWindow.getFormat(), VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+        ),
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        m_memoryBudget.get(),
+        MemoryCategory::IMAGE
+    );
+    // 재생 중 예외가 나도 retire 되도록 감쌈 (선언의 역순으로 retire)
+    const UniqueHandle<VkDeviceMemory> colorMemory { &m_deletionQueue, colorImage.memory };
+    const UniqueHandle<VkImage> colorImageHandle { &m_deletionQueue, colorImage.image };
+    const UniqueHandle<VkImageView> colorView {
+        &m_deletionQueue, EngineComponentFactory::createImageView(m_device, primaryWindow.getFormat(), colorImage.image)
+    };
+    const VkImageView attachments[] { colorView.get(), primaryWindow.getDepthTarget().view };
+    const UniqueHandle<VkFramebuffer> framebuffer {
+        &m_deletionQueue, EngineComponentFactory::createFramebuffer(m_device, m_renderPass, attachments, extent)
+    };
+    // 창에 내보내지 않으므로 PRESENT_SRC 가 아니라 결과를 복사해 갈 수 있는 layout 으로 끝냄 (m_continueRenderPass 와 호환)
+    const UniqueHandle<VkRenderPass> continueRenderPass {
+        &m_deletionQueue,
+        EngineComponentFactory::createRenderPass(
+            m_device, primaryWindow.getFormat(), primaryWindow.getDepthTarget().format, RenderPassLoad::LOAD, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+        )
+    };
+
+    // scene 이 기록한 version 과 재생 version 이 섞이지 않도록 slot 을 비움
+    const auto invalidateInstanceSlots = [&] {
+        for (uint64_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; frame++) {
+            m_instanceBuffer->acquire(frame, 0).writtenVersion = 0;
+        }
+    };
+    invalidateInstanceSlots();
+    m_replayInstanceVersion = 0;
+
+    FrameReplayStats stats { frameCount * repeatCount, 0.0, 0.0, std::numeric_limits<double>::max(), 0.0, 0.0 };
+    double recordMilliseconds = 0.0;
+
+    const auto addFrameTime = [&](Clock::duration frameTime) {
+        const double milliseconds = Milliseconds { frameTime }.count();
+        stats.minFrameMilliseconds = std::min(stats.minFrameMilliseconds, milliseconds);
+        stats.maxFrameMilliseconds = std::max(stats.maxFrameMilliseconds, milliseconds);
+    };
+    const Clock::time_point replayStart = Clock::now();
+    Clock::time_point frameStart = replayStart;
+
+    for (uint32_t repeat = 0; repeat < repeatCount; repeat++) {
+        // 반복마다 같은 GPU 상태에서 시작
+        m_particleSystem->reset();
+        m_occlusionCuller->resetVisibility();
+
+        for (uint32_t frameIndex = 0; frameIndex < frameCount; frameIndex++) {
+            const Clock::time_point now = Clock::now();
+
+            if (repeat > 0 || frameIndex > 0) {
+                addFrameTime(now - frameStart);
+            }
+            frameStart = now;
+
+            const uint64_t frame = ++m_frameNumber;
+            FrameContext& context = beginFrame(frame);
+            const Clock::time_point recordStart = Clock::now();
+
+            const float deltaTime = applyFrameCommands(reader.getFrame(frameIndex), frame);
+            m_occlusionCuller->prepare(frame, m_cullingView);
+
+            vkResetFences(m_device, 1, &context.inFlightFence);
+            vkResetCommandBuffer(context.commandBuffer, 0);
+
+            EngineComponentFactory::beginCommandBuffer(context.commandBuffer);
+            recordScene(context.commandBuffer, frame, framebuffer.get(), continueRenderPass.get(), extent, deltaTime);
+            EngineComponentFactory::endCommandBuffer(context.commandBuffer);
+
+            // 창에 내보내지 않으므로 기다리거나 signal 할 semaphore 가 없음
+            VkSubmitInfo submitInfo {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &context.commandBuffer;
+
+            if (vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, context.inFlightFence) != VK_SUCCESS) {
+                throw std::runtime_error("failed to submit replay command buffer!");
+            }
+            recordMilliseconds += Milliseconds { Clock::now() - recordStart }.count();
+        }
+    }
+    // 마지막 frame 은 GPU 가 끝날 때까지
+    vkDeviceWaitIdle(m_device);
+    const Clock::time_point replayEnd = Clock::now();
+    addFrameTime(replayEnd - frameStart);
+
+    stats.totalMilliseconds = Milliseconds { replayEnd - replayStart }.count();
+    stats.averageFrameMilliseconds = stats.totalMilliseconds / stats.frameCount;
+    stats.averageRecordMilliseconds = recordMilliseconds / stats.frameCount;
+
+    invalidateInstanceSlots();
+    return stats;
+}
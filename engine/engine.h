@@ -1,13 +1,46 @@
 #pragma once
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <GLFW/glfw3.h>
 
-#include "shader/shaders.h"
-
-using ShaderMap = std::map<ShaderType, VkShaderModule>;
+#include "asset/asset_pack.h"
+#include "capture/frame_stream.h"
+#include "capture/readback_ring.h"
+#include "culling/frustum_culler.h"
+#include "culling/occlusion_culler.h"
+#include "input/input_state.h"
+#include "loop/loop_config.h"
+#include "memory/linear_buffer_allocator.h"
+#include "memory/memory_budget.h"
+#include "mesh/mesh_buffer.h"
+#include "particle/particle_system.h"
+#include "pipeline/frame_descriptor_pool.h"
+#include "pipeline/pipeline_layout_cache.h"
+#include "pipeline/pipeline_state_cache.h"
+#include "queue/queue_factory.h"
+#include "resource/deletion_queue.h"
+#include "resource/resource_registry.h"
+#include "shader/shader_variants.h"
+#include "shader/spirv_reflection.h"
+#include "sprite/sprite_renderer.h"
+#include "swapchain/present_batch.h"
+#include "swapchain/window_surface.h"
+#include "scene/instance_buffer.h"
+#include "scene/scene_graph.h"
+#include "texture/texture_streamer.h"
+#include "thread/job_system.h"
+#include "thread/spsc_queue.h"
 
 namespace EngineLoader {
 
@@ -17,18 +50,30 @@ namespace EngineLoader {
 
     void checkVkExtensions();
 
-    std::vector<VkImageView> getImageViews(VkDevice device, VkSwapchainKHR swapchain, VkFormat swapchainImageFormat);
+    ShaderMap getShaderModules(VkDevice device, const AssetPack& assetPack, JobSystem& jobSystem);
 
-    ShaderMap getShaderModules(VkDevice device);
+    // pack 에 <name>.refl 이 있으면 그대로 사용하고, 없거나 SPIR-V 와 맞지 않으면 직접 파싱
+    ShaderReflection getShaderReflection(const AssetPack& assetPack, std::string_view name, std::span<const char> code);
 }
 
+// frame in flight 마다 따로 두는 기록/동기화 객체. image 를 받는 semaphore 는 창마다 WindowSurface 가 가짐
+struct FrameContext {
+    VkCommandBuffer commandBuffer;
+    VkFence inFlightFence;
+};
+
 class Engine {
 public:
-    static Engine createEngine();
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 2;
+    static constexpr uint32_t PARTICLE_CAPACITY = 1 << 20;
+
+    // isHeadless 면 주 창을 띄우지 않음 (frame 재생용. swapchain 은 만들지만 present 하지 않음)
+    static Engine createEngine(bool isHeadless = false);
 
+    // 입력과 캡처를 받는 주 창
     [[nodiscard]]
     GLFWwindow* getWindow() const {
-        return m_window;
+        return m_windows.front()->getWindow();
     }
 
     [[nodiscard]]
@@ -36,63 +81,406 @@ public:
         return m_instance;
     }
 
+    [[nodiscard]]
+    VkPhysicalDevice getPhysicalDevice() const {
+        return m_physicalDevice;
+    }
+
     [[nodiscard]]
     VkDevice getDevice() const {
         return m_device;
     }
 
+    [[nodiscard]]
+    const QueueFamilyIndices& getQueueFamilyIndices() const {
+        return m_queueFamilyIndices;
+    }
+
+    [[nodiscard]]
+    VkQueue getGraphicsQueue() const {
+        return m_graphicsQueue;
+    }
+
+    [[nodiscard]]
+    VkQueue getPresentQueue() const {
+        return m_presentQueue;
+    }
+
     [[nodiscard]]
     VkSurfaceKHR getSurface() const {
-        return m_surface;
+        return m_windows.front()->getSurface();
+    }
+
+    // 0 번이 주 창
+    [[nodiscard]]
+    WindowSurface& getWindowSurface(size_t index) {
+        return *m_windows[index];
+    }
+
+    [[nodiscard]]
+    size_t getWindowCount() const {
+        return m_windows.size();
+    }
+
+    // 같은 device 로 그리는 창을 추가. pipeline 과 resource 를 공유하고 swapchain 만 따로 가짐
+    // 주 창의 장면을 그대로 비추며 입력과 캡처는 주 창만 받음. run 전에 main thread 에서 호출
+    WindowSurface& addWindow(int width, int height, const char* title);
+
+    [[nodiscard]]
+    const AssetPack& getAssetPack() const {
+        return m_assetPack;
+    }
+
+    [[nodiscard]]
+    const ShaderMap& getShaderModules() const {
+        return m_resources.shaderModules;
+    }
+
+    [[nodiscard]]
+    ShaderVariantCache& getShaderVariants() {
+        return m_shaderVariants;
+    }
+
+    [[nodiscard]]
+    PipelineLayoutCache& getPipelineLayoutCache() {
+        return m_pipelineLayoutCache;
+    }
+
+    // render thread 에서만 사용
+    [[nodiscard]]
+    PipelineStateCache& getPipelineStateCache() {
+        return *m_pipelineStateCache;
+    }
+
+    [[nodiscard]]
+    const ResourceRegistry& getResources() const {
+        return m_resources;
     }
 
     [[nodiscard]]
-    std::vector<VkImageView> getImageViews() const {
-        return m_imageViews;
+    ResourceRegistry& getResources() {
+        return m_resources;
     }
 
     [[nodiscard]]
-    ShaderMap getShaderModules() const {
-        return m_shaderModules;
+    MemoryBudget& getMemoryBudget() {
+        return *m_memoryBudget;
     }
 
+    [[nodiscard]]
+    DeletionQueue& getDeletionQueue() {
+        return m_deletionQueue;
+    }
+
+    [[nodiscard]]
+    TextureStreamer& getTextureStreamer() {
+        return *m_textureStreamer;
+    }
+
+    [[nodiscard]]
+    JobSystem& getJobSystem() const {
+        return *m_jobSystem;
+    }
+
+    // 이번 frame 에만 쓰는 uniform / storage 데이터. frame 마다 비워짐 (render thread 에서만 접근)
+    [[nodiscard]]
+    LinearBufferAllocator& getFrameBufferAllocator() {
+        return *m_frameBufferAllocator;
+    }
+
+    // 이번 frame 에만 쓰는 descriptor set. frame 마다 pool 째 reset 됨 (render thread 에서만 접근)
+    [[nodiscard]]
+    FrameDescriptorPool& getFrameDescriptorPool() {
+        return *m_frameDescriptorPool;
+    }
+
+    [[nodiscard]]
+    SceneGraph& getSceneGraph() {
+        return m_sceneGraph;
+    }
+
+    // pack 의 cooked mesh. MeshRange 의 command 와 LOD 로 OcclusionCuller 에 객체를 추가
+    // LOD 표는 시작 시 culler 에 등록됨 (culler 를 clear 하면 registerLods 를 다시 호출)
+    [[nodiscard]]
+    MeshBuffer& getMeshBuffer() {
+        return *m_meshBuffer;
+    }
+
+    [[nodiscard]]
+    InstanceBuffer& getInstanceBuffer() {
+        return *m_instanceBuffer;
+    }
+
+    // 마지막 reportInterval 동안의 통계 (render thread 에서만 접근)
+    [[nodiscard]]
+    const LoopStats& getLoopStats() const {
+        return m_loopStats;
+    }
+
+    // 이번 frame 시작 시점의 입력 (render thread 에서만 접근)
+    [[nodiscard]]
+    const InputSnapshot& getInput() const {
+        return m_input;
+    }
+
+    [[nodiscard]]
+    OcclusionCuller& getOcclusionCuller() {
+        return *m_occlusionCuller;
+    }
+
+    // engine 의 job system 을 쓰는 CPU 컬링 (render thread 에서만 접근)
+    [[nodiscard]]
+    FrustumCuller& getFrustumCuller() {
+        return *m_frustumCuller;
+    }
+
+    [[nodiscard]]
+    ParticleSystem& getParticleSystem() {
+        return *m_particleSystem;
+    }
+
+    [[nodiscard]]
+    SpriteRenderer& getSpriteRenderer() {
+        return *m_spriteRenderer;
+    }
+
+    // 매 frame scene 위에 그릴 2D quad 를 채움 (render thread 에서만 호출)
+    void setSpriteCallback(SpriteCallback callback) {
+        m_spriteCallback = std::move(callback);
+    }
+
+    // GPU 컬링과 LOD 선택에 쓰는 camera. 다음 drawFrame 부터 반영 (render thread 에서만 호출)
+    void setCullingView(const CullingView& view) {
+        m_cullingView = view;
+    }
+
+    [[nodiscard]]
+    ReadbackRing& getReadbackRing() {
+        return *m_readbackRing;
+    }
+
+    // 주 창의 swapchain image 를 transfer source 로 쓸 수 있는지
+    [[nodiscard]]
+    bool supportsCapture() const {
+        return m_supportsCapture;
+    }
+
+    // ON_DEMAND 에서 다음 loop 에 다시 그리도록 요청. 어느 스레드에서나 호출 가능
+    void requestRedraw() {
+        m_needsRedraw.store(true, std::memory_order_relaxed);
+        wakeRenderThread();
+    }
+
+    // 다음에 그리는 frame 을 한 번 캡처. slot 이 없으면 다음 frame 으로 미룸
+    // callback 은 GPU 가 frame 을 끝낸 뒤 worker 에서 호출됨. 어느 스레드에서나 호출 가능
+    void requestCapture(ReadbackCallback callback);
+
+    // 매 frame 캡처 (영상 녹화 등). slot 이 부족한 frame 은 건너뜀. nullptr 이면 중지
+    void setContinuousCapture(ReadbackCallback callback);
+
+    // 다음 frame 부터 frameCount 개 frame 의 render 입력을 path 에 기록. 어느 스레드에서나 호출 가능
+    void startFrameCapture(std::filesystem::path path, uint32_t frameCount);
+
+    // 기록한 frame 을 application 과 scene 갱신 없이 offscreen target 에 repeatCount 번 다시 그리고 시간을 잼
+    // run 대신 main thread 에서 호출. 끝나면 scene 상태는 캡처 내용으로 바뀌어 있음
+    FrameReplayStats replay(const FrameStreamReader& reader, uint32_t repeatCount = 1);
+
     Engine(
-        GLFWwindow *window,
         VkInstance instance,
+        VkPhysicalDevice physicalDevice,
         VkDevice device,
-        VkSurfaceKHR surface,
-        VkSwapchainKHR swapchain,
-        std::vector<VkImageView> imageViews,
-        ShaderMap shaderModules,
+        QueueFamilyIndices queueFamilyIndices,
+        VkQueue graphicsQueue,
+        VkQueue presentQueue,
+        std::unique_ptr<WindowSurface> primaryWindow,
+        AssetPack assetPack,
+        std::unique_ptr<JobSystem> jobSystem,
+        ResourceRegistry resources,
+        ShaderVariantCache shaderVariants,
+        PipelineLayoutCache pipelineLayoutCache,
+        std::unique_ptr<PipelineStateCache> pipelineStateCache,
         VkRenderPass renderPass,
-        VkPipelineLayout pipelineLayout,
-        VkPipeline pipeline
-    ) {
-        m_window = window;
+        VkRenderPass continueRenderPass,
+        PipelineLayoutHandle pipelineLayout,
+        PipelineHandle pipeline,
+        VkCommandPool commandPool
+    ) : m_pipelineLayoutCache(std::move(pipelineLayoutCache)), m_deletionQueue(device) {
         m_instance = instance;
+        m_physicalDevice = physicalDevice;
         m_device = device;
-        m_surface = surface;
-        m_swapchain = swapchain;
-        m_imageViews = std::move(imageViews);
-        m_shaderModules = std::move(shaderModules);
+        m_queueFamilyIndices = queueFamilyIndices;
+        m_graphicsQueue = graphicsQueue;
+        m_presentQueue = presentQueue;
+        m_windows.push_back(std::move(primaryWindow));
+        m_assetPack = std::move(assetPack);
+        m_jobSystem = std::move(jobSystem);
+        m_resources = std::move(resources);
+        m_shaderVariants = std::move(shaderVariants);
+        m_pipelineStateCache = std::move(pipelineStateCache);
         m_renderPass = renderPass;
+        m_continueRenderPass = continueRenderPass;
         m_pipelineLayout = pipelineLayout;
         m_pipeline = pipeline;
+        m_commandPool = commandPool;
+        // 이후 생성되는 시스템의 할당이 집계되도록 먼저 연결
+        m_memoryBudget = std::make_unique<MemoryBudget>(instance, physicalDevice);
+        m_deletionQueue.setMemoryBudget(m_memoryBudget.get());
+        createFrameContexts();
+        // 워커가 보낸 main thread job 이 glfwWaitEvents 에 막히지 않도록 깨움
+        m_jobSystem->setMainThreadWakeup(glfwPostEmptyEvent);
+        m_textureStreamer = std::make_unique<TextureStreamer>(
+            physicalDevice, device, graphicsQueue, queueFamilyIndices.graphicsFamily.value(), m_deletionQueue, *m_jobSystem, &m_assetPack
+        );
+        m_instanceBuffer = std::make_unique<InstanceBuffer>(physicalDevice, device, m_deletionQueue, MAX_FRAMES_IN_FLIGHT);
+        m_frustumCuller = std::make_unique<FrustumCuller>(*m_jobSystem);
+        m_occlusionCuller = std::make_unique<OcclusionCuller>(
+            physicalDevice, device, m_deletionQueue, m_resources, m_pipelineLayoutCache, m_windows.front()->getDepthTarget().view,
+            m_windows.front()->getExtent(), MAX_FRAMES_IN_FLIGHT
+        );
+        // 불투명 객체를 다 그린 LATE pass 에 이어 그림
+        m_particleSystem = std::make_unique<ParticleSystem>(
+            physicalDevice, device, m_deletionQueue, m_resources, m_pipelineLayoutCache, continueRenderPass, PARTICLE_CAPACITY
+        );
+        // 기본 program 이 pack 의 cooked mesh 를 occlusion culler 의 indirect draw 로 그림 (geometry 는 beginFrame 에서 연결)
+        m_meshBuffer = std::make_unique<MeshBuffer>(physicalDevice, device, m_deletionQueue, m_assetPack);
+        m_meshBuffer->registerLods(*m_occlusionCuller);
+        m_spriteRenderer = std::make_unique<SpriteRenderer>(
+            physicalDevice, device, m_deletionQueue, m_resources, m_pipelineLayoutCache, continueRenderPass, MAX_FRAMES_IN_FLIGHT
+        );
+        createReadbackRing();
+        createFrameAllocators();
+        registerEvictionCallbacks();
     };
 
     ~Engine();
 
-    void waitEventsUntilExit() const;
+    // 주 창이 닫힐 때까지 main thread 는 GLFW event 만 처리하고,
+    // render thread 가 config.mode 에 따라 그림
+    void run(const LoopConfig& config = {});
 
 private:
-    GLFWwindow*                 m_window;
+    static constexpr size_t INPUT_QUEUE_CAPACITY = 1024;
+
+    void createFrameContexts();
+    void createReadbackRing();
+    void createFrameAllocators();
+    void registerEvictionCallbacks();
+    // eviction 으로 줄인 텍스처 budget 을 압박이 풀리면 되돌림
+    void restoreTextureBudget();
+    void registerInputCallbacks();
+
+    // main thread 에서 GLFW callback 이 호출
+    void pushInputEvent(const InputEvent& event);
+    void wakeRenderThread();
+
+    void runRenderLoop(const LoopConfig& config);
+    // nullopt 이면 깨울 때까지 대기
+    void waitForRenderWakeup(std::optional<std::chrono::duration<double>> timeout);
+    void applyInputEvents();
+
+    [[nodiscard]]
+    bool needsRedraw() const;
+
+    // context 의 이전 frame 이 끝나길 기다리고 frame 단위 정리를 함
+    FrameContext& beginFrame(uint64_t frame);
+    // OUT_OF_DATE 나 SUBOPTIMAL 을 받은 창의 swapchain 을 새 크기로 다시 만듦. 주 창이면 Hi-Z 도 맞춤
+    void recreateSwapchains();
+    void drawFrame();
+    // 컬링, 입자, sprite 를 포함한 주 장면. drawFrame 과 replay 가 공유
+    // continueRenderPass 는 m_continueRenderPass 와 호환되는 LATE pass. 창이면 present, 재생이면 transfer layout 으로 끝남
+    void recordScene(
+        VkCommandBuffer commandBuffer, uint64_t frame, VkFramebuffer framebuffer, VkRenderPass continueRenderPass, VkExtent2D extent, float deltaTime
+    );
+    // 보조 창에 주 창의 컬링 결과로 같은 장면을 pass 하나로 그림
+    void recordMirrorPass(VkCommandBuffer commandBuffer, const WindowSurface& window, VkBuffer instanceBuffer);
+    // 기본 program 의 viewProjection. render pass 를 시작한 뒤 mesh draw 전에 기록
+    void recordMeshConstants(VkCommandBuffer commandBuffer) const;
+    void recordCaptures(VkCommandBuffer commandBuffer, uint64_t frame);
+    // 요청된 frame 캡처가 있으면 m_frameWriter 를 만듦. sprite 를 기록하기 전에 호출
+    void beginFrameCapture();
+    // recordScene 이후 이번 frame 의 입력을 m_frameWriter 에 씀
+    void captureFrame(float deltaTime, uint32_t particleSeed);
+    // 반환값은 기록된 deltaTime
+    float applyFrameCommands(std::span<const FrameCommand> commands, uint64_t frame);
+
     VkInstance                  m_instance;
+    VkPhysicalDevice            m_physicalDevice;
     VkDevice                    m_device;
-    VkSurfaceKHR                m_surface;
-    VkSwapchainKHR              m_swapchain;
-    std::vector<VkImageView>    m_imageViews;
-    ShaderMap                   m_shaderModules;
+    QueueFamilyIndices          m_queueFamilyIndices;
+    VkQueue                     m_graphicsQueue;
+    VkQueue                     m_presentQueue;
+    // 0 번이 주 창. 모든 창이 render pass 와 pipeline 을 공유하므로 swapchain format 이 같음
+    std::vector<std::unique_ptr<WindowSurface>> m_windows;
+    PresentBatch                m_presentBatch;
+    bool                        m_supportsCapture = false;
+    AssetPack                   m_assetPack;
+    // 다른 시스템보다 늦게 파괴되도록 앞에 둠
+    std::unique_ptr<JobSystem>  m_jobSystem;
+    ResourceRegistry            m_resources;
+    ShaderVariantCache          m_shaderVariants;
+    PipelineLayoutCache         m_pipelineLayoutCache;
+    // job 을 기다려야 하므로 m_jobSystem 보다 뒤에 둠
+    std::unique_ptr<PipelineStateCache> m_pipelineStateCache;
+    // 같은 framebuffer 에 EARLY 는 m_renderPass (clear), LATE 는 m_continueRenderPass (load) 로 그림
+    // 보조 창은 clear 로 시작해 PRESENT_SRC 로 끝나는 m_mirrorRenderPass 하나로 그림 (첫 addWindow 에서 생성)
     VkRenderPass                m_renderPass;
-    VkPipelineLayout            m_pipelineLayout;
-    VkPipeline                  m_pipeline;
+    VkRenderPass                m_continueRenderPass;
+    VkRenderPass                m_mirrorRenderPass = VK_NULL_HANDLE;
+    PipelineLayoutHandle        m_pipelineLayout;
+    PipelineHandle              m_pipeline;
+    VkCommandPool               m_commandPool;
+    std::array<FrameContext, MAX_FRAMES_IN_FLIGHT> m_frames;
+    // 1 부터 시작. DeletionQueue 의 frame value 로도 사용
+    uint64_t                    m_frameNumber = 0;
+    LoopStats                   m_loopStats {};
+    CullingView                 m_cullingView {};
+    SpriteCallback              m_spriteCallback;
+    // 입자 시뮬레이션의 deltaTime 기준
+    std::chrono::steady_clock::time_point m_lastFrameTime = std::chrono::steady_clock::now();
+
+    // main thread -> render thread 입력 전달
+    SpscQueue<InputEvent, INPUT_QUEUE_CAPACITY> m_inputEvents;
+    InputSnapshot               m_input {};
+    std::atomic<bool>           m_needsRedraw = true;
+    std::atomic<bool>           m_isRenderStopping = false;
+    std::atomic<bool>           m_isRenderThreadDone = false;
+    // ON_DEMAND 에서 render thread 를 재우고 깨우는 용도 (입력 전달 자체는 lock 없음)
+    std::mutex                  m_renderWakeupMutex;
+    std::condition_variable     m_renderWakeupCondition;
+    bool                        m_hasRenderWakeup = false;
+    // 다른 스레드에서 요청한 캡처. render thread 가 frame 마다 가져감
+    std::mutex                  m_captureMutex;
+    std::vector<ReadbackCallback> m_captureRequests;
+    ReadbackCallback            m_continuousCapture;
+    // startFrameCapture 요청. render thread 가 다음 frame 에 writer 를 만듦
+    std::filesystem::path       m_pendingFrameCapturePath;
+    uint32_t                    m_pendingFrameCaptureCount = 0;
+    // 아래는 render thread 전용
+    std::unique_ptr<FrameStreamWriter> m_frameWriter;
+    uint32_t                    m_frameCaptureCount = 0;
+    // 마지막으로 기록한 SceneGraph / OcclusionCuller version. 바뀐 frame 에만 다시 씀
+    uint64_t                    m_capturedSceneVersion = 0;
+    uint64_t                    m_capturedCullerVersion = 0;
+    // 재생 중 instance 행렬과 그 version
+    std::vector<glm::mat4>      m_replayInstances;
+    uint64_t                    m_replayInstanceVersion = 0;
+    std::vector<SpriteDrawBatch> m_replaySpriteBatches;
+    std::vector<SpriteVertex>   m_replaySpriteVertices;
+    // DeletionQueue 가 파괴하는 memory 를 집계하므로 더 오래 살아야 함
+    std::unique_ptr<MemoryBudget> m_memoryBudget;
+    DeletionQueue               m_deletionQueue;
+    SceneGraph                  m_sceneGraph;
+    // device 파괴 전에 워커와 업로드를 정리해야 하므로 명시적으로 해제
+    std::unique_ptr<TextureStreamer> m_textureStreamer;
+    // 설정된 텍스처 budget. eviction 중에는 streamer 의 budget 이 이보다 작음
+    VkDeviceSize                m_textureMemoryBudget = 0;
+    std::unique_ptr<MeshBuffer>      m_meshBuffer;
+    std::unique_ptr<InstanceBuffer>  m_instanceBuffer;
+    std::unique_ptr<FrustumCuller>   m_frustumCuller;
+    std::unique_ptr<OcclusionCuller> m_occlusionCuller;
+    std::unique_ptr<ParticleSystem>  m_particleSystem;
+    std::unique_ptr<SpriteRenderer>  m_spriteRenderer;
+    std::unique_ptr<ReadbackRing>    m_readbackRing;
+    std::unique_ptr<LinearBufferAllocator> m_frameBufferAllocator;
+    std::unique_ptr<FrameDescriptorPool>   m_frameDescriptorPool;
 };
@@ -1,6 +1,11 @@
 #include "engine_component_factory.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "engine.h"
+#include "memory/host_allocator.h"
+#include "memory/memory_budget.h"
 #include "pipeline/graphics_pipeline_supports.h"
 #include "util/platform.h"
 #include "util/validations.h"
@@ -10,12 +15,13 @@
 #include "swapchain/swapchain_supports.h"
 #include "util/binary_file_utils.h"
 
-GLFWwindow *EngineComponentFactory::createWindow() {
+GLFWwindow *EngineComponentFactory::createWindow(int width, int height, const char* title, bool isVisible) {
     // OpenGL 컨텍스트 생성 방지 (Vulkan 사용 시 필수)
     glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
     glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_VISIBLE, isVisible ? GLFW_TRUE : GLFW_FALSE);
 
-    GLFWwindow *window = glfwCreateWindow(800, 600, "Vulkan!", nullptr, nullptr);
+    GLFWwindow *window = glfwCreateWindow(width, height, title, nullptr, nullptr);
 
     if (!window) {
         glfwTerminate();
@@ -68,15 +74,39 @@ VkInstanceCreateInfo EngineComponentFactory::createInstanceCreateInfo(VkApplicat
     return createInfo;
 }
 
+bool EngineComponentFactory::isInstanceExtensionAvailable(const char* extensionName) {
+    uint32_t extensionCount = 0;
+    vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, nullptr);
+
+    std::vector<VkExtensionProperties> extensions(extensionCount);
+    vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, extensions.data());
+
+    return std::ranges::any_of(extensions, [extensionName](const VkExtensionProperties& extension) {
+        return std::strcmp(extension.extensionName, extensionName) == 0;
+    });
+}
+
+bool EngineComponentFactory::isPhysicalDeviceProperties2Enabled() {
+    // Mac 은 portability 때문에 항상 켬
+    return Platform::isMac || isInstanceExtensionAvailable(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+}
+
 VkInstance EngineComponentFactory::createVkInstance() {
     VkApplicationInfo appInfo = createApplicationInfo();
 
     std::vector extensions = getRequiredGlfwExtensions();
+
+    // Vulkan 1.0 에서 memory budget 질의에 필요 (Mac 은 createInstanceCreateInfo 에서 추가)
+    if constexpr (!Platform::isMac) {
+        if (isPhysicalDeviceProperties2Enabled()) {
+            extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+        }
+    }
     VkInstanceCreateInfo instanceCreateInfo = createInstanceCreateInfo(appInfo, extensions);
 
     VkInstance instance;
 
-    if (vkCreateInstance(&instanceCreateInfo, nullptr, &instance) != VK_SUCCESS) {
+    if (vkCreateInstance(&instanceCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_INSTANCE), &instance) != VK_SUCCESS) {
         throw std::runtime_error("failed to create instance!");
     }
     return instance;
@@ -85,7 +115,8 @@ VkInstance EngineComponentFactory::createVkInstance() {
 VkSwapchainCreateInfoKHR EngineComponentFactory::createSwapchainCreateInfo(
     VkSurfaceKHR surface,
     const SwapchainSupportDetails& swapchainInfo,
-    const bool useSameQueueFamily
+    std::span<const uint32_t> sharedQueueFamilies,
+    VkSwapchainKHR oldSwapchain
 ) {
     VkSwapchainCreateInfoKHR swapchainCreateInfo{};
     VkSurfaceCapabilitiesKHR capabilities = swapchainInfo.surfaceCapabilities;
@@ -102,28 +133,53 @@ VkSwapchainCreateInfoKHR EngineComponentFactory::createSwapchainCreateInfo(
     swapchainCreateInfo.imageExtent = swapchainInfo.getProperExtent();
     swapchainCreateInfo.imageArrayLayers = 1;
 
-    swapchainCreateInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-    swapchainCreateInfo.imageSharingMode = useSameQueueFamily ? VK_SHARING_MODE_EXCLUSIVE : VK_SHARING_MODE_CONCURRENT;
+    swapchainCreateInfo.imageUsage = getSwapchainImageUsage(capabilities);
+    swapchainCreateInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (!sharedQueueFamilies.empty()) {
+        swapchainCreateInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
+        swapchainCreateInfo.queueFamilyIndexCount = static_cast<uint32_t>(sharedQueueFamilies.size());
+        swapchainCreateInfo.pQueueFamilyIndices = sharedQueueFamilies.data();
+    }
 
     swapchainCreateInfo.preTransform = capabilities.currentTransform;
     swapchainCreateInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     swapchainCreateInfo.presentMode = presentMode;
     swapchainCreateInfo.clipped = VK_TRUE;
-    swapchainCreateInfo.oldSwapchain = VK_NULL_HANDLE;
+    swapchainCreateInfo.oldSwapchain = oldSwapchain;
 
     return swapchainCreateInfo;
 }
 
+VkImageUsageFlags EngineComponentFactory::getSwapchainImageUsage(const VkSurfaceCapabilitiesKHR& capabilities) {
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+    // 지원하면 readback 으로 화면을 캡처할 수 있도록 transfer source 로도 사용
+    if (capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) {
+        usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+    return usage;
+}
+
 VkSwapchainKHR EngineComponentFactory::createSwapchain(
     VkDevice device,
     VkSurfaceKHR surface,
     SwapchainSupportDetails &swapchainInfo,
-    bool useSameQueueFamily
+    const QueueFamilyIndices& queueFamilyIndices,
+    PresentSharing presentSharing,
+    VkSwapchainKHR oldSwapchain
 ) {
-    VkSwapchainCreateInfoKHR swapchainCreateInfo = createSwapchainCreateInfo(surface, swapchainInfo, useSameQueueFamily);
+    // UNIFIED 와 OWNERSHIP_TRANSFER 는 EXCLUSIVE. 소유권은 barrier 로 넘김
+    const uint32_t sharedQueueFamilies[] { queueFamilyIndices.graphicsFamily.value(), queueFamilyIndices.presentFamily.value() };
+    std::span<const uint32_t> concurrentQueueFamilies {};
+
+    if (presentSharing == PresentSharing::CONCURRENT) {
+        concurrentQueueFamilies = sharedQueueFamilies;
+    }
+    VkSwapchainCreateInfoKHR swapchainCreateInfo = createSwapchainCreateInfo(surface, swapchainInfo, concurrentQueueFamilies, oldSwapchain);
     VkSwapchainKHR swapchain;
 
-    if (vkCreateSwapchainKHR(device, &swapchainCreateInfo, nullptr, &swapchain) != VK_SUCCESS) {
+    if (vkCreateSwapchainKHR(device, &swapchainCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_SWAPCHAIN_KHR), &swapchain) != VK_SUCCESS) {
         glfwTerminate();
         throw std::runtime_error("failed to create swapchain!");
     }
@@ -140,7 +196,7 @@ std::vector<VkImage> EngineComponentFactory::getSwapchainImages(VkDevice device,
     return swapchainImages;
 }
 
-VkImageViewCreateInfo EngineComponentFactory::createImageViewCreateInfo(VkFormat format, VkImage image) {
+VkImageViewCreateInfo EngineComponentFactory::createImageViewCreateInfo(VkFormat format, VkImage image, VkImageAspectFlags aspectMask) {
     VkImageViewCreateInfo imageViewCreateInfo{};
 
     imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -153,7 +209,7 @@ VkImageViewCreateInfo EngineComponentFactory::createImageViewCreateInfo(VkFormat
         VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY
     };
 
-    imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    imageViewCreateInfo.subresourceRange.aspectMask = aspectMask;
     imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
     imageViewCreateInfo.subresourceRange.levelCount = 1;
     imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
@@ -162,11 +218,11 @@ VkImageViewCreateInfo EngineComponentFactory::createImageViewCreateInfo(VkFormat
     return imageViewCreateInfo;
 }
 
-VkImageView EngineComponentFactory::createImageView(VkDevice device, VkFormat format, VkImage image) {
-    VkImageViewCreateInfo imageViewCreateInfo = createImageViewCreateInfo(format, image);
+VkImageView EngineComponentFactory::createImageView(VkDevice device, VkFormat format, VkImage image, VkImageAspectFlags aspectMask) {
+    VkImageViewCreateInfo imageViewCreateInfo = createImageViewCreateInfo(format, image, aspectMask);
     VkImageView imageView;
 
-    if (vkCreateImageView(device, &imageViewCreateInfo, nullptr, &imageView) != VK_SUCCESS) {
+    if (vkCreateImageView(device, &imageViewCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_IMAGE_VIEW), &imageView) != VK_SUCCESS) {
         glfwTerminate();
         throw std::runtime_error("failed to create image view!");
     }
@@ -176,7 +232,7 @@ VkImageView EngineComponentFactory::createImageView(VkDevice device, VkFormat fo
 VkSurfaceKHR EngineComponentFactory::createSurface(VkInstance instance, GLFWwindow *window) {
     VkSurfaceKHR surface;
 
-    if (glfwCreateWindowSurface(instance, window, nullptr, &surface) != VK_SUCCESS) {
+    if (glfwCreateWindowSurface(instance, window, HostAllocators::getCallbacks(VK_OBJECT_TYPE_SURFACE_KHR), &surface) != VK_SUCCESS) {
         throw std::runtime_error("failed to create window surface!");
     }
     return surface;
@@ -216,15 +272,31 @@ VkPhysicalDevice EngineComponentFactory::getProperPhysicalDevice(std::vector<VkP
     throw std::runtime_error("Failed to find physical device!");
 }
 
-VkPhysicalDeviceFeatures EngineComponentFactory::createPhysicalDeviceFeatures() {
+VkPhysicalDeviceFeatures EngineComponentFactory::createPhysicalDeviceFeatures(VkPhysicalDevice physicalDevice) {
+  VkPhysicalDeviceFeatures supportedFeatures;
+  vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
   VkPhysicalDeviceFeatures physicalDeviceFeatures{};
   // physicalDeviceFeatures.samplerAnisotropy = VK_TRUE;
+  // GPU 가 만든 indirect draw 를 한 번에 제출. 없으면 OcclusionCuller 가 draw 를 나눠 기록
+  physicalDeviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+  physicalDeviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
   return physicalDeviceFeatures;
 }
 
-std::vector<const char*> EngineComponentFactory::getDeviceExtensions() {
+std::vector<const char*> EngineComponentFactory::getDeviceExtensions(VkPhysicalDevice physicalDevice, bool enablePipelineLibrary) {
     std::vector deviceExtensions{VK_KHR_SWAPCHAIN_EXTENSION_NAME};
 
+    // VK_EXT_memory_budget 은 instance 의 VK_KHR_get_physical_device_properties2 에 의존
+    if (isPhysicalDeviceProperties2Enabled() && MemoryBudget::isExtensionSupported(physicalDevice)) {
+        deviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+
+    if (enablePipelineLibrary) {
+        deviceExtensions.push_back(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+        deviceExtensions.push_back(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+    }
+
     if constexpr (Platform::isMac) {
         deviceExtensions.push_back("VK_KHR_portability_subset");
     }
@@ -255,85 +327,100 @@ VkDeviceCreateInfo EngineComponentFactory::createDeviceCreateInfo(
     return deviceCreateInfo;
 }
 
-VkDevice EngineComponentFactory::createDevice(VkPhysicalDevice physicalDevice, std::vector<VkDeviceQueueCreateInfo>& queueCreateInfoList) {
-    VkPhysicalDeviceFeatures physicalDeviceFeatures = createPhysicalDeviceFeatures();
+VkDevice EngineComponentFactory::createDevice(
+    VkPhysicalDevice physicalDevice,
+    std::vector<VkDeviceQueueCreateInfo>& queueCreateInfoList,
+    bool enablePipelineLibrary
+) {
+    VkPhysicalDeviceFeatures physicalDeviceFeatures = createPhysicalDeviceFeatures(physicalDevice);
 
-    std::vector deviceExtensions = getDeviceExtensions();
+    std::vector deviceExtensions = getDeviceExtensions(physicalDevice, enablePipelineLibrary);
     VkDeviceCreateInfo deviceCreateInfo = createDeviceCreateInfo(queueCreateInfoList, physicalDeviceFeatures, deviceExtensions);
 
+    // extension 과 함께 feature 도 켜야 library 를 만들 수 있음
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT pipelineLibraryFeatures {};
+
+    if (enablePipelineLibrary) {
+        pipelineLibraryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+        pipelineLibraryFeatures.graphicsPipelineLibrary = VK_TRUE;
+        deviceCreateInfo.pNext = &pipelineLibraryFeatures;
+    }
+
     VkDevice device;
 
-    if (vkCreateDevice(physicalDevice, &deviceCreateInfo, nullptr, &device) != VK_SUCCESS) {
+    if (vkCreateDevice(physicalDevice, &deviceCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_DEVICE), &device) != VK_SUCCESS) {
         glfwTerminate();
         throw std::runtime_error("Failed to create logical device!");
     }
     return device;
 }
 
-VkShaderModuleCreateInfo EngineComponentFactory::createShaderModuleCreateInfo(const BinaryFile& binary) {
+VkShaderModuleCreateInfo EngineComponentFactory::createShaderModuleCreateInfo(std::span<const char> code) {
     VkShaderModuleCreateInfo createInfo {};
 
     createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = binary.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(binary.data());
+    createInfo.codeSize = code.size();
+    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
 
     return createInfo;
 }
 
-VkShaderModule EngineComponentFactory::createShaderModule(VkDevice device, const BinaryFile& binary) {
-    VkShaderModuleCreateInfo createInfo = createShaderModuleCreateInfo(binary);
+VkShaderModule EngineComponentFactory::createShaderModule(VkDevice device, std::span<const char> code) {
+    VkShaderModuleCreateInfo createInfo = createShaderModuleCreateInfo(code);
     VkShaderModule shaderModule;
 
-    if (vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
+    if (vkCreateShaderModule(device, &createInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_SHADER_MODULE), &shaderModule) != VK_SUCCESS) {
         throw std::runtime_error("failed to create shader module!");
     }
     return shaderModule;
 }
 
 VkRenderPassCreateInfo EngineComponentFactory::createRenderPassCreateInfo(
-    const VkSubpassDependency& subpassDependency,
-    const VkAttachmentDescription& attachmentDescription,
+    std::span<const VkSubpassDependency> subpassDependencies,
+    std::span<const VkAttachmentDescription> attachmentDescriptions,
     const VkSubpassDescription& subpassDescription
 ) {
     VkRenderPassCreateInfo renderPassCreateInfo {};
 
     renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    renderPassCreateInfo.pDependencies = &subpassDependency;
-    renderPassCreateInfo.dependencyCount = 1;
-    renderPassCreateInfo.pAttachments = &attachmentDescription;
-    renderPassCreateInfo.attachmentCount = 1;
+    renderPassCreateInfo.pDependencies = subpassDependencies.data();
+    renderPassCreateInfo.dependencyCount = static_cast<uint32_t>(subpassDependencies.size());
+    renderPassCreateInfo.pAttachments = attachmentDescriptions.data();
+    renderPassCreateInfo.attachmentCount = static_cast<uint32_t>(attachmentDescriptions.size());
     renderPassCreateInfo.pSubpasses = &subpassDescription;
     renderPassCreateInfo.subpassCount = 1;
     return renderPassCreateInfo;
 }
 
-VkRenderPass EngineComponentFactory::createRenderPass(VkDevice device, VkFormat format) {
-    VkRenderPass renderPass;
+VkRenderPass EngineComponentFactory::createRenderPass(VkDevice device, VkFormat format, VkFormat depthFormat, RenderPassLoad load) {
+    return createRenderPass(device, format, depthFormat, load, RenderPassSupports::createAttachmentDescription(format, load).finalLayout);
+}
 
-    VkSubpassDependency subpassDependency = RenderPassSupports::createSubpassDependency();
-    VkAttachmentDescription attachmentDescription = RenderPassSupports::createAttachmentDescription(format);
+VkRenderPass EngineComponentFactory::createRenderPass(
+    VkDevice device, VkFormat format, VkFormat depthFormat, RenderPassLoad load, VkImageLayout colorFinalLayout
+) {
+    VkRenderPass renderPass;
 
+    VkSubpassDependency subpassDependencies[] {
+        RenderPassSupports::createSubpassDependency(),
+        RenderPassSupports::createExternalSubpassDependency()
+    };
+    VkAttachmentDescription attachmentDescriptions[] {
+        RenderPassSupports::createAttachmentDescription(format, load, colorFinalLayout),
+        RenderPassSupports::createDepthAttachmentDescription(depthFormat, load)
+    };
     VkAttachmentReference attachmentReference = RenderPassSupports::createAttachmentReference();
-    VkSubpassDescription subpassDescription = RenderPassSupports::createSubpassDescription(&attachmentReference);
+    VkAttachmentReference depthAttachmentReference = RenderPassSupports::createDepthAttachmentReference();
+    VkSubpassDescription subpassDescription = RenderPassSupports::createSubpassDescription(&attachmentReference, &depthAttachmentReference);
 
-    VkRenderPassCreateInfo renderPassCreateInfo = createRenderPassCreateInfo(subpassDependency, attachmentDescription, subpassDescription);
+    VkRenderPassCreateInfo renderPassCreateInfo = createRenderPassCreateInfo(subpassDependencies, attachmentDescriptions, subpassDescription);
 
-    if (vkCreateRenderPass(device, &renderPassCreateInfo, nullptr, &renderPass) != VK_SUCCESS) {
+    if (vkCreateRenderPass(device, &renderPassCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_RENDER_PASS), &renderPass) != VK_SUCCESS) {
         throw std::runtime_error("failed to create render pass!");
     }
     return renderPass;
 }
 
-VkPipelineLayout EngineComponentFactory::createPipelineLayout(VkDevice device) {
-    VkPipelineLayoutCreateInfo pipelineLayoutInfo = GraphicsPipelineSupports::createPipelineLayoutCreateInfo();
-    VkPipelineLayout pipelineLayout;
-
-    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create pipeline layout!");
-    }
-    return pipelineLayout;
-}
-
 VkViewport EngineComponentFactory::createViewport(const VkExtent2D& swapchainExtent) {
     VkViewport viewport {};
     viewport.x = 0.0f;
@@ -345,27 +432,32 @@ VkViewport EngineComponentFactory::createViewport(const VkExtent2D& swapchainExt
     return viewport;
 }
 
-std::vector<VkPipelineShaderStageCreateInfo> EngineComponentFactory::createShaderStages(const ShaderMap& shaderModules) {
-    std::vector<VkPipelineShaderStageCreateInfo> shaderStages {};
-
-    shaderStages.reserve(shaderModules.size());
+std::vector<const ShaderVariant*> EngineComponentFactory::getProgramVariants(
+    const ShaderMap& shaderModules,
+    std::string_view program,
+    ShaderVariantCache& shaderVariants,
+    std::span<const SpecializationConstant> constants
+) {
+    std::vector<const ShaderVariant*> variants {};
 
-    for (auto& [shaderType, shaderModule] : shaderModules) {
-        shaderStages.push_back(GraphicsPipelineSupports::createPipelineShaderStageCreateInfo(
-            static_cast<VkShaderStageFlagBits>(shaderType),
-            shaderModule
-        ));
+    for (const ShaderModule& shaderModule : shaderModules) {
+        // compute shader 는 각자 compute pipeline 을 만듦
+        if (shaderModule.type == COMPUTE_SHADER || Shaders::getProgramName(shaderModule.name) != program) {
+            continue;
+        }
+        variants.push_back(&shaderVariants.get(shaderModule.type, shaderModule.module, constants));
     }
-    return shaderStages;
+    return variants;
 }
 
 VkGraphicsPipelineCreateInfo EngineComponentFactory::createGraphicsPipelineCreateInfo(
-    const std::vector<VkPipelineShaderStageCreateInfo>& shaderStages,
+    std::span<const VkPipelineShaderStageCreateInfo> shaderStages,
     const VkPipelineViewportStateCreateInfo& viewportState,
     const VkPipelineVertexInputStateCreateInfo& vertexInputState,
     const VkPipelineInputAssemblyStateCreateInfo& inputAssemblyState,
     const VkPipelineRasterizationStateCreateInfo& rasterizationState,
     const VkPipelineMultisampleStateCreateInfo& multisampleState,
+    const VkPipelineDepthStencilStateCreateInfo& depthStencilState,
     const VkPipelineColorBlendStateCreateInfo& colorBlendState,
     VkPipelineLayout pipelineLayout,
     VkRenderPass renderPass
@@ -373,39 +465,54 @@ VkGraphicsPipelineCreateInfo EngineComponentFactory::createGraphicsPipelineCreat
     VkGraphicsPipelineCreateInfo pipelineInfo {};
 
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipelineInfo.stageCount = 2;
+    pipelineInfo.stageCount = static_cast<uint32_t>(shaderStages.size());
     pipelineInfo.pStages = shaderStages.data();
     pipelineInfo.pVertexInputState = &vertexInputState;
     pipelineInfo.pInputAssemblyState = &inputAssemblyState;
     pipelineInfo.pViewportState = &viewportState;
     pipelineInfo.pRasterizationState = &rasterizationState;
     pipelineInfo.pMultisampleState = &multisampleState;
+    pipelineInfo.pDepthStencilState = &depthStencilState;
     pipelineInfo.pColorBlendState = &colorBlendState;
+    pipelineInfo.pDynamicState = &GraphicsPipelineSupports::getViewportDynamicState();
     pipelineInfo.layout = pipelineLayout;
     pipelineInfo.renderPass = renderPass;
     pipelineInfo.subpass = 0;
     return pipelineInfo;
 }
 
-VkPipeline EngineComponentFactory::createGraphicsPipeline(
-    VkDevice device,
-    VkRenderPass renderPass,
-    VkPipelineLayout pipelineLayout,
-    const ShaderMap& shaderModules,
-    const VkExtent2D& swapchainExtent
-) {
-    auto vertexInputState = GraphicsPipelineSupports::createPipelineVertexInputStateCreateInfo();
+VkPipeline EngineComponentFactory::createGraphicsPipeline(VkDevice device, const GraphicsPipelineState& state, VkGraphicsPipelineLibraryFlagsEXT libraryParts) {
+    std::vector<VkPipelineShaderStageCreateInfo> shaderStages {};
+
+    for (const ShaderVariant* variant : state.shaders) {
+        if (variant == nullptr) {
+            break;
+        }
+        shaderStages.push_back(variant->getStageCreateInfo());
+    }
+    auto vertexInputState = GraphicsPipelineSupports::createPipelineVertexInputStateCreateInfo(state.getVertexBindings(), state.getVertexAttributes());
+
     auto inputAssemblyState = GraphicsPipelineSupports::createPipelineInputAssemblyStateCreateInfo();
+    inputAssemblyState.topology = state.topology;
+
     auto rasterizationState = GraphicsPipelineSupports::createPipelineRasterizationStateCreateInfo();
+    rasterizationState.polygonMode = state.polygonMode;
+    rasterizationState.cullMode = state.cullMode;
+    rasterizationState.frontFace = state.frontFace;
+
     auto multisampleState = GraphicsPipelineSupports::createPipelineMultisampleStateCreateInfo();
-    auto colorBlendAttachment = GraphicsPipelineSupports::createPipelineColorBlendAttachmentState();
-    auto colorBlendState = GraphicsPipelineSupports::createPipelineColorBlendStateCreateInfo(&colorBlendAttachment);
+    multisampleState.rasterizationSamples = state.sampleCount;
 
-    VkViewport viewport = createViewport(swapchainExtent);
-    VkRect2D scissor { {0, 0}, swapchainExtent };
+    auto depthStencilState = GraphicsPipelineSupports::createPipelineDepthStencilStateCreateInfo();
+    depthStencilState.depthTestEnable = state.depthTest;
+    depthStencilState.depthWriteEnable = state.depthWrite;
+    depthStencilState.depthCompareOp = state.depthCompareOp;
 
-    auto viewportState = GraphicsPipelineSupports::createPipelineViewportStateCreateInfo(&viewport, &scissor);
-    auto shaderStages = createShaderStages(shaderModules);
+    const std::vector colorBlendAttachments(state.colorAttachmentCount, state.createColorBlendAttachment());
+    auto colorBlendState = GraphicsPipelineSupports::createPipelineColorBlendStateCreateInfo(colorBlendAttachments.data());
+    colorBlendState.attachmentCount = state.colorAttachmentCount;
+
+    auto viewportState = GraphicsPipelineSupports::createPipelineViewportStateCreateInfo();
 
     VkGraphicsPipelineCreateInfo pipelineCreateInfo = createGraphicsPipelineCreateInfo(
         shaderStages,
@@ -414,23 +521,109 @@ VkPipeline EngineComponentFactory::createGraphicsPipeline(
         inputAssemblyState,
         rasterizationState,
         multisampleState,
+        depthStencilState,
         colorBlendState,
-        pipelineLayout,
-        renderPass
+        state.layout,
+        state.renderPass
     );
+    pipelineCreateInfo.subpass = state.subpass;
+
+    // library 는 libraryParts 에 속하지 않는 state 를 무시함
+    VkGraphicsPipelineLibraryCreateInfoEXT libraryCreateInfo {};
 
+    if (libraryParts != 0) {
+        libraryCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+        libraryCreateInfo.flags = libraryParts;
+        pipelineCreateInfo.pNext = &libraryCreateInfo;
+        // 최적화 link 가 쓸 수 있도록 link time optimization 정보를 남김
+        pipelineCreateInfo.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR | VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+    }
     constexpr uint32_t createInfoCount = 1;
     VkPipeline graphicsPipeline;
 
-    if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, createInfoCount, &pipelineCreateInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, createInfoCount, &pipelineCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_PIPELINE), &graphicsPipeline) != VK_SUCCESS) {
         throw std::runtime_error("failed to create graphics pipeline!");
     }
     return graphicsPipeline;
 }
 
+VkPipeline EngineComponentFactory::linkGraphicsPipeline(
+    VkDevice device,
+    VkPipelineLayout pipelineLayout,
+    std::span<const VkPipeline> libraries,
+    bool isOptimized
+) {
+    VkPipelineLibraryCreateInfoKHR libraryCreateInfo {};
+    libraryCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+    libraryCreateInfo.libraryCount = static_cast<uint32_t>(libraries.size());
+    libraryCreateInfo.pLibraries = libraries.data();
+
+    // 나머지 state 는 모두 library 에 들어 있음
+    VkGraphicsPipelineCreateInfo pipelineCreateInfo {};
+    pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineCreateInfo.pNext = &libraryCreateInfo;
+    pipelineCreateInfo.layout = pipelineLayout;
+
+    if (isOptimized) {
+        pipelineCreateInfo.flags = VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT;
+    }
+
+    VkPipeline graphicsPipeline;
+
+    if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_PIPELINE), &graphicsPipeline) != VK_SUCCESS) {
+        throw std::runtime_error("failed to link graphics pipeline!");
+    }
+    return graphicsPipeline;
+}
+
+VkComputePipelineCreateInfo EngineComponentFactory::createComputePipelineCreateInfo(
+    const VkPipelineShaderStageCreateInfo& shaderStage,
+    VkPipelineLayout pipelineLayout
+) {
+    VkComputePipelineCreateInfo pipelineInfo {};
+
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage = shaderStage;
+    pipelineInfo.layout = pipelineLayout;
+    return pipelineInfo;
+}
+
+VkPipeline EngineComponentFactory::createComputePipeline(
+    VkDevice device,
+    VkPipelineLayout pipelineLayout,
+    const VkPipelineShaderStageCreateInfo& shaderStage
+) {
+    VkComputePipelineCreateInfo pipelineCreateInfo = createComputePipelineCreateInfo(shaderStage, pipelineLayout);
+    VkPipeline computePipeline;
+
+    if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_PIPELINE), &computePipeline) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create compute pipeline!");
+    }
+    return computePipeline;
+}
+
+VkDescriptorPoolCreateInfo EngineComponentFactory::createDescriptorPoolCreateInfo(std::span<const VkDescriptorPoolSize> poolSizes, uint32_t maxSets) {
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo {};
+    descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptorPoolCreateInfo.maxSets = maxSets;
+    descriptorPoolCreateInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    descriptorPoolCreateInfo.pPoolSizes = poolSizes.data();
+    return descriptorPoolCreateInfo;
+}
+
+VkDescriptorPool EngineComponentFactory::createDescriptorPool(VkDevice device, std::span<const VkDescriptorPoolSize> poolSizes, uint32_t maxSets) {
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = createDescriptorPoolCreateInfo(poolSizes, maxSets);
+    VkDescriptorPool descriptorPool;
+
+    if (vkCreateDescriptorPool(device, &descriptorPoolCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_DESCRIPTOR_POOL), &descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create descriptor pool!");
+    }
+    return descriptorPool;
+}
+
 VkFramebufferCreateInfo EngineComponentFactory::createFramebufferCreateInfo(
     VkRenderPass renderPass,
-    const std::vector<VkImageView> &imageViews,
+    std::span<const VkImageView> imageViews,
     const VkExtent2D& swapchainExtent
 ) {
     VkFramebufferCreateInfo framebufferCreateInfo {};
@@ -447,13 +640,13 @@ VkFramebufferCreateInfo EngineComponentFactory::createFramebufferCreateInfo(
 VkFramebuffer EngineComponentFactory::createFramebuffer(
     VkDevice device,
     VkRenderPass renderPass,
-    const std::vector<VkImageView> &imageViews,
+    std::span<const VkImageView> imageViews,
     const VkExtent2D& swapchainExtent
 ) {
     VkFramebufferCreateInfo framebufferCreateInfo = createFramebufferCreateInfo(renderPass, imageViews, swapchainExtent);
     VkFramebuffer framebuffer;
 
-    if (vkCreateFramebuffer(device, &framebufferCreateInfo, nullptr, &framebuffer) != VK_SUCCESS) {
+    if (vkCreateFramebuffer(device, &framebufferCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_FRAMEBUFFER), &framebuffer) != VK_SUCCESS) {
         throw std::runtime_error("failed to create framebuffer!");
     }
     return framebuffer;
@@ -471,7 +664,7 @@ VkCommandPool EngineComponentFactory::createCommandPool(VkDevice device, const u
     VkCommandPoolCreateInfo commandPoolCreateInfo = createCommandPoolCreateInfo(queueFamilyIndex);
     VkCommandPool commandPool;
 
-    if (vkCreateCommandPool(device, &commandPoolCreateInfo, nullptr, &commandPool) != VK_SUCCESS) {
+    if (vkCreateCommandPool(device, &commandPoolCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_COMMAND_POOL), &commandPool) != VK_SUCCESS) {
         throw std::runtime_error("failed to create command pool!");
     }
     return commandPool;
@@ -488,11 +681,79 @@ VkCommandBufferAllocateInfo EngineComponentFactory::createCommandBufferAllocateI
 
 VkCommandBuffer EngineComponentFactory::createCommandBuffer(VkDevice device, VkCommandPool commandPool) {
     VkCommandBufferAllocateInfo commandBufferAllocateInfo = createCommandBufferAllocateInfo(commandPool);
-
     VkCommandBuffer commandBuffer;
 
-    vkCmdBeginRenderPass(commandBuffer, );
-    vkCmdBindPipeline();
-    vkCmdDraw();
-    vkCmdEndRenderPass();
+    if (vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate command buffer!");
+    }
+    return commandBuffer;
+}
+
+void EngineComponentFactory::beginCommandBuffer(VkCommandBuffer commandBuffer, VkCommandBufferUsageFlags flags) {
+    VkCommandBufferBeginInfo commandBufferBeginInfo {};
+    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    commandBufferBeginInfo.flags = flags;
+
+    if (vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("failed to begin recording command buffer!");
+    }
+}
+
+void EngineComponentFactory::beginRenderPass(
+    VkCommandBuffer commandBuffer,
+    VkRenderPass renderPass,
+    VkFramebuffer framebuffer,
+    const VkExtent2D& swapchainExtent
+) {
+    VkClearValue clearValues[2] {};
+    clearValues[0].color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
+    clearValues[1].depthStencil = { 1.0f, 0 };
+
+    VkRenderPassBeginInfo renderPassBeginInfo {};
+    renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassBeginInfo.renderPass = renderPass;
+    renderPassBeginInfo.framebuffer = framebuffer;
+    renderPassBeginInfo.renderArea = { { 0, 0 }, swapchainExtent };
+    renderPassBeginInfo.clearValueCount = 2;
+    renderPassBeginInfo.pClearValues = clearValues;
+
+    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+    // pipeline 의 viewport / scissor 는 dynamic state 이므로 framebuffer 크기로 지정
+    const VkViewport viewport = createViewport(swapchainExtent);
+    const VkRect2D scissor { { 0, 0 }, swapchainExtent };
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+}
+
+void EngineComponentFactory::endCommandBuffer(VkCommandBuffer commandBuffer) {
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to record command buffer!");
+    }
+}
+
+VkSemaphore EngineComponentFactory::createSemaphore(VkDevice device) {
+    VkSemaphoreCreateInfo semaphoreCreateInfo {};
+    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    VkSemaphore semaphore;
+
+    if (vkCreateSemaphore(device, &semaphoreCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_SEMAPHORE), &semaphore) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create semaphore!");
+    }
+    return semaphore;
+}
+
+VkFence EngineComponentFactory::createFence(VkDevice device, bool isSignaled) {
+    VkFenceCreateInfo fenceCreateInfo {};
+    fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VkFence fence;
+
+    if (isSignaled) {
+        fenceCreateInfo.flags |= VK_FENCE_CREATE_SIGNALED_BIT;
+    }
+
+    if (vkCreateFence(device, &fenceCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_FENCE), &fence) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create fence!");
+    }
+    return fence;
 }
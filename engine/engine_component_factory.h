@@ -1,30 +1,55 @@
 #pragma once
 
+#include <span>
+#include <string_view>
 #include <vector>
 #include <GLFW/glfw3.h>
 
 #include "engine.h"
+#include "pipeline/graphics_pipeline_state.h"
+#include "queue/queue_factory.h"
+#include "shader/render_pass_supports.h"
+#include "shader/shader_variants.h"
 #include "swapchain/swapchain_supports.h"
 #include "util/binary_file_utils.h"
 
 namespace EngineComponentFactory {
     // Create Window
-    GLFWwindow *createWindow();
+    // isVisible 가 false 면 화면에 띄우지 않음 (surface 와 swapchain 은 그대로 만들 수 있음)
+    GLFWwindow *createWindow(int width = 800, int height = 600, const char* title = "Vulkan!", bool isVisible = true);
 
     // Create Instance
     // Get
     std::vector<const char*> getRequiredGlfwExtensions();
     VkApplicationInfo createApplicationInfo();
+    bool isInstanceExtensionAvailable(const char* extensionName);
+    // createVkInstance 가 VK_KHR_get_physical_device_properties2 를 켜는지
+    bool isPhysicalDeviceProperties2Enabled();
     VkInstanceCreateInfo createInstanceCreateInfo(VkApplicationInfo appInfo, std::vector<const char*>& extensions);
     VkInstance createVkInstance();
 
     // Create Surface
-    VkSwapchainCreateInfoKHR createSwapchainCreateInfo(VkSurfaceKHR surface, const SwapchainSupportDetails& swapchainInfo, bool useSameQueueFamily);
-    VkSwapchainKHR createSwapchain(VkDevice device, VkSurfaceKHR surface, SwapchainSupportDetails& swapchainInfo, bool useSameQueueFamily);
+    VkImageUsageFlags getSwapchainImageUsage(const VkSurfaceCapabilitiesKHR& capabilities);
+    // sharedQueueFamilies 가 비어 있으면 EXCLUSIVE, 아니면 그 family 들이 CONCURRENT 로 공유 (pointer 를 그대로 담음)
+    // oldSwapchain 은 재생성할 때 이전 swapchain. 새 swapchain 을 만든 뒤에도 파괴는 호출자가 함
+    VkSwapchainCreateInfoKHR createSwapchainCreateInfo(
+        VkSurfaceKHR surface,
+        const SwapchainSupportDetails& swapchainInfo,
+        std::span<const uint32_t> sharedQueueFamilies = {},
+        VkSwapchainKHR oldSwapchain = VK_NULL_HANDLE
+    );
+    VkSwapchainKHR createSwapchain(
+        VkDevice device,
+        VkSurfaceKHR surface,
+        SwapchainSupportDetails& swapchainInfo,
+        const QueueFamilyIndices& queueFamilyIndices,
+        PresentSharing presentSharing,
+        VkSwapchainKHR oldSwapchain = VK_NULL_HANDLE
+    );
     // Get
     std::vector<VkImage> getSwapchainImages(VkDevice device, VkSwapchainKHR swapchain);
-    VkImageViewCreateInfo createImageViewCreateInfo(VkFormat format, VkImage image);
-    VkImageView createImageView(VkDevice device, VkFormat format, VkImage image);
+    VkImageViewCreateInfo createImageViewCreateInfo(VkFormat format, VkImage image, VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT);
+    VkImageView createImageView(VkDevice device, VkFormat format, VkImage image, VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT);
     VkSurfaceKHR createSurface(VkInstance instance, GLFWwindow* window);
 
     // Create Device
@@ -32,9 +57,10 @@ namespace EngineComponentFactory {
     std::vector<VkPhysicalDevice> getPhysicalDevices(VkInstance instance);
     // Resolve
     VkPhysicalDevice getProperPhysicalDevice(std::vector<VkPhysicalDevice>& physicalDevices, VkSurfaceKHR surface);
-    VkPhysicalDeviceFeatures createPhysicalDeviceFeatures();
+    // 지원하는 경우에만 켜는 optional feature 포함
+    VkPhysicalDeviceFeatures createPhysicalDeviceFeatures(VkPhysicalDevice physicalDevice);
     // Get
-    std::vector<const char*> getDeviceExtensions();
+    std::vector<const char*> getDeviceExtensions(VkPhysicalDevice physicalDevice, bool enablePipelineLibrary = false);
 
     VkDeviceCreateInfo createDeviceCreateInfo(
         const std::vector<VkDeviceQueueCreateInfo>& queueCreateInfoList,
@@ -42,56 +68,75 @@ namespace EngineComponentFactory {
         const std::vector<const char*>& deviceExtensions
     );
 
-    VkDevice createDevice(VkPhysicalDevice physicalDevice, std::vector<VkDeviceQueueCreateInfo>& queueCreateInfoList);
+    // enablePipelineLibrary 는 PipelineStateCache::isPipelineLibrarySupported 일 때만
+    VkDevice createDevice(VkPhysicalDevice physicalDevice, std::vector<VkDeviceQueueCreateInfo>& queueCreateInfoList, bool enablePipelineLibrary = false);
 
     // Create Shaders
-    VkShaderModuleCreateInfo createShaderModuleCreateInfo(const BinaryFile& binary);
-    VkShaderModule createShaderModule(VkDevice device, const BinaryFile& binary);
+    // code 는 4byte 정렬된 SPIR-V (asset pack 의 매핑 영역을 그대로 전달 가능)
+    VkShaderModuleCreateInfo createShaderModuleCreateInfo(std::span<const char> code);
+    VkShaderModule createShaderModule(VkDevice device, std::span<const char> code);
 
     // Create Render Pass
     VkRenderPassCreateInfo createRenderPassCreateInfo(
-        const VkSubpassDependency& subpassDependency,
-        const VkAttachmentDescription& attachmentDescription,
+        std::span<const VkSubpassDependency> subpassDependencies,
+        std::span<const VkAttachmentDescription> attachmentDescriptions,
         const VkSubpassDescription& subpassDescription
     );
-    VkRenderPass createRenderPass(VkDevice device, VkFormat swapchainImageFormat);
+    // color (attachment 0) + depth (attachment 1). load 만 다른 pass 끼리는 호환되므로 framebuffer / pipeline 공유 가능
+    VkRenderPass createRenderPass(VkDevice device, VkFormat swapchainImageFormat, VkFormat depthFormat, RenderPassLoad load);
+    // color 를 load 의 기본 layout 대신 colorFinalLayout 으로 끝냄 (layout 만 다르므로 위 pass 와 호환)
+    VkRenderPass createRenderPass(
+        VkDevice device, VkFormat swapchainImageFormat, VkFormat depthFormat, RenderPassLoad load, VkImageLayout colorFinalLayout
+    );
 
     // Create Pipeline
-    VkPipelineLayout createPipelineLayout(VkDevice device);
+    // pipeline layout 은 PipelineLayoutCache 가 shader reflection 으로 생성
     VkViewport createViewport(const VkExtent2D& swapchainExtent);
-    std::vector<VkPipelineShaderStageCreateInfo> createShaderStages(const ShaderMap& shaderModules);
+    // program 의 stage 마다 constants 에 맞는 variant 를 cache 에서 가져옴 (stage 가 선언하지 않은 id 는 무시됨)
+    std::vector<const ShaderVariant*> getProgramVariants(
+        const ShaderMap& shaderModules,
+        std::string_view program,
+        ShaderVariantCache& shaderVariants,
+        std::span<const SpecializationConstant> constants = {}
+    );
 
     VkGraphicsPipelineCreateInfo createGraphicsPipelineCreateInfo(
-        const std::vector<VkPipelineShaderStageCreateInfo>& shaderStages,
+        std::span<const VkPipelineShaderStageCreateInfo> shaderStages,
         const VkPipelineViewportStateCreateInfo& viewportState,
         const VkPipelineVertexInputStateCreateInfo& vertexInputState,
         const VkPipelineInputAssemblyStateCreateInfo& inputAssemblyState,
         const VkPipelineRasterizationStateCreateInfo& rasterizationState,
         const VkPipelineMultisampleStateCreateInfo& multisampleState,
+        const VkPipelineDepthStencilStateCreateInfo& depthStencilState,
         const VkPipelineColorBlendStateCreateInfo& colorBlendState,
         VkPipelineLayout pipelineLayout,
         VkRenderPass renderPass
     );
 
-    VkPipeline createGraphicsPipeline(
-        VkDevice device,
-        VkRenderPass renderPass,
-        VkPipelineLayout pipelineLayout,
-        const ShaderMap& shaderModules,
-        const VkExtent2D& swapchainExtent
-    );
+    // state 에 없는 값은 GraphicsPipelineSupports 의 기본값. 보통 PipelineStateCache 를 통해 호출
+    // libraryParts 를 주면 그 부분만 담은 graphics pipeline library 를 만듦 (VK_EXT_graphics_pipeline_library)
+    VkPipeline createGraphicsPipeline(VkDevice device, const GraphicsPipelineState& state, VkGraphicsPipelineLibraryFlagsEXT libraryParts = 0);
+    // 네 부분의 library 를 link. isOptimized 면 link time optimization 을 해서 느리지만 monolithic 과 같은 수준
+    VkPipeline linkGraphicsPipeline(VkDevice device, VkPipelineLayout pipelineLayout, std::span<const VkPipeline> libraries, bool isOptimized);
+
+    VkComputePipelineCreateInfo createComputePipelineCreateInfo(const VkPipelineShaderStageCreateInfo& shaderStage, VkPipelineLayout pipelineLayout);
+    VkPipeline createComputePipeline(VkDevice device, VkPipelineLayout pipelineLayout, const VkPipelineShaderStageCreateInfo& shaderStage);
+
+    // Create Descriptor Pool
+    VkDescriptorPoolCreateInfo createDescriptorPoolCreateInfo(std::span<const VkDescriptorPoolSize> poolSizes, uint32_t maxSets);
+    VkDescriptorPool createDescriptorPool(VkDevice device, std::span<const VkDescriptorPoolSize> poolSizes, uint32_t maxSets);
 
     // Create Framebuffer
     VkFramebufferCreateInfo createFramebufferCreateInfo(
         VkRenderPass renderPass,
-        const std::vector<VkImageView>& imageViews,
+        std::span<const VkImageView> imageViews,
         const VkExtent2D& swapchainExtent
     );
 
     VkFramebuffer createFramebuffer(
         VkDevice device,
         VkRenderPass renderPass,
-        const std::vector<VkImageView> &imageViews,
+        std::span<const VkImageView> imageViews,
         const VkExtent2D& swapchainExtent
     );
 
@@ -102,4 +147,18 @@ namespace EngineComponentFactory {
     // Create Command Buffers
     VkCommandBufferAllocateInfo createCommandBufferAllocateInfo(VkCommandPool commandPool);
     VkCommandBuffer createCommandBuffer(VkDevice device, VkCommandPool commandPool);
+    // 매 frame 다시 기록하는 command buffer 가 기본. 한 번 기록해 두고 재사용하면 flags 를 바꿈
+    void beginCommandBuffer(VkCommandBuffer commandBuffer, VkCommandBufferUsageFlags flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    // color 는 검정, depth 는 1.0 으로 지움 (LOAD pass 에서는 무시됨). viewport / scissor 도 extent 로 지정. begin / end 사이에서 호출
+    void beginRenderPass(
+        VkCommandBuffer commandBuffer,
+        VkRenderPass renderPass,
+        VkFramebuffer framebuffer,
+        const VkExtent2D& swapchainExtent
+    );
+    void endCommandBuffer(VkCommandBuffer commandBuffer);
+
+    // Create Synchronization
+    VkSemaphore createSemaphore(VkDevice device);
+    VkFence createFence(VkDevice device, bool isSignaled);
 }
@@ -0,0 +1,43 @@
+#include "input_state.h"
+
+void InputSnapshot::beginFrame() {
+    cursorDeltaX = 0.0;
+    cursorDeltaY = 0.0;
+    scrollX = 0.0;
+    scrollY = 0.0;
+    eventCount = 0;
+}
+
+void InputSnapshot::apply(const InputEvent& event) {
+    switch (event.type) {
+        case InputEventType::KEY:
+            // GLFW_KEY_UNKNOWN 은 상태를 추적하지 않음
+            if (event.code >= 0 && event.code <= GLFW_KEY_LAST) {
+                keys.set(event.code, event.action != GLFW_RELEASE);
+            }
+            break;
+        case InputEventType::MOUSE_BUTTON:
+            if (event.code >= 0 && event.code <= GLFW_MOUSE_BUTTON_LAST) {
+                mouseButtons.set(event.code, event.action != GLFW_RELEASE);
+            }
+            break;
+        case InputEventType::CURSOR_POSITION:
+            cursorDeltaX += event.x - cursorX;
+            cursorDeltaY += event.y - cursorY;
+            cursorX = event.x;
+            cursorY = event.y;
+            break;
+        case InputEventType::SCROLL:
+            scrollX += event.x;
+            scrollY += event.y;
+            break;
+        case InputEventType::FRAMEBUFFER_SIZE:
+            framebufferWidth = static_cast<int32_t>(event.x);
+            framebufferHeight = static_cast<int32_t>(event.y);
+            break;
+        case InputEventType::WINDOW_REFRESH:
+            break;
+    }
+    eventCount++;
+    lastEventTime = event.time;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <GLFW/glfw3.h>
+
+enum class InputEventType : uint8_t {
+    KEY,
+    MOUSE_BUTTON,
+    CURSOR_POSITION,
+    SCROLL,
+    FRAMEBUFFER_SIZE,
+    WINDOW_REFRESH,
+};
+
+// GLFW callback 하나를 그대로 옮긴 값. main thread 에서 render thread 로 전달
+struct InputEvent {
+    InputEventType type;
+    // KEY / MOUSE_BUTTON: GLFW key 또는 button, action, mods
+    int32_t code;
+    int32_t action;
+    int32_t mods;
+    // CURSOR_POSITION / SCROLL / FRAMEBUFFER_SIZE
+    double x;
+    double y;
+    // glfwGetTime 기준
+    double time;
+};
+
+// render thread 가 frame 시작 시점에 보는 입력 상태
+struct InputSnapshot {
+    std::bitset<GLFW_KEY_LAST + 1> keys;
+    std::bitset<GLFW_MOUSE_BUTTON_LAST + 1> mouseButtons;
+    double cursorX = 0.0;
+    double cursorY = 0.0;
+    // 마지막 beginFrame 이후 누적
+    double cursorDeltaX = 0.0;
+    double cursorDeltaY = 0.0;
+    double scrollX = 0.0;
+    double scrollY = 0.0;
+    int32_t framebufferWidth = 0;
+    int32_t framebufferHeight = 0;
+    uint32_t eventCount = 0;
+    double lastEventTime = 0.0;
+
+    // frame 단위 누적값 초기화
+    void beginFrame();
+
+    void apply(const InputEvent& event);
+
+    [[nodiscard]]
+    bool isKeyDown(int32_t key) const {
+        return key >= 0 && key <= GLFW_KEY_LAST && keys.test(key);
+    }
+
+    [[nodiscard]]
+    bool isMouseButtonDown(int32_t button) const {
+        return button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST && mouseButtons.test(button);
+    }
+};
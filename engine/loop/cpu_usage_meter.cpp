@@ -0,0 +1,49 @@
+#include "cpu_usage_meter.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+CpuUsageMeter::CpuUsageMeter()
+    : m_lastWallTime(std::chrono::steady_clock::now()), m_lastCpuTime(getProcessCpuTime()) {}
+
+double CpuUsageMeter::sample() {
+    const std::chrono::steady_clock::time_point wallTime = std::chrono::steady_clock::now();
+    const std::chrono::nanoseconds cpuTime = getProcessCpuTime();
+
+    const std::chrono::duration<double> elapsedWall = wallTime - m_lastWallTime;
+    const std::chrono::duration<double> elapsedCpu = cpuTime - m_lastCpuTime;
+
+    m_lastWallTime = wallTime;
+    m_lastCpuTime = cpuTime;
+    return elapsedWall.count() > 0.0 ? elapsedCpu.count() / elapsedWall.count() : 0.0;
+}
+
+std::chrono::nanoseconds CpuUsageMeter::getProcessCpuTime() {
+#if defined(_WIN32)
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return std::chrono::nanoseconds { 0 };
+    }
+    // FILETIME 은 100ns 단위
+    auto toTicks = [](const FILETIME& fileTime) {
+        return static_cast<int64_t>(ULARGE_INTEGER { { fileTime.dwLowDateTime, fileTime.dwHighDateTime } }.QuadPart);
+    };
+    return std::chrono::nanoseconds { (toTicks(kernelTime) + toTicks(userTime)) * 100 };
+#else
+    rusage usage {};
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return std::chrono::nanoseconds { 0 };
+    }
+    auto toNanoseconds = [](const timeval& time) {
+        return std::chrono::seconds { time.tv_sec } + std::chrono::microseconds { time.tv_usec };
+    };
+    return toNanoseconds(usage.ru_utime) + toNanoseconds(usage.ru_stime);
+#endif
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <chrono>
+
+// 두 sample 사이의 process CPU 시간 (모든 스레드 합) 을 경과 시간으로 나눈 값
+class CpuUsageMeter {
+public:
+    CpuUsageMeter();
+
+    // 마지막 sample 이후의 사용률. 1.0 이 core 하나를 가득 쓴 상태
+    double sample();
+
+    static std::chrono::nanoseconds getProcessCpuTime();
+
+private:
+    std::chrono::steady_clock::time_point   m_lastWallTime;
+    std::chrono::nanoseconds                m_lastCpuTime;
+};
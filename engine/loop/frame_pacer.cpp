@@ -0,0 +1,54 @@
+#include "frame_pacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    constexpr std::chrono::microseconds INITIAL_SPIN_THRESHOLD { 1000 };
+    constexpr std::chrono::microseconds MIN_SPIN_THRESHOLD { 50 };
+    // 이보다 긴 간격은 frame cap 으로 의미가 없고 duration_cast 가 넘칠 수 있음
+    constexpr std::chrono::hours MAX_PERIOD { 1 };
+
+    FramePacer::Clock::duration getPeriod(double targetFrameRate) {
+        if (!std::isfinite(targetFrameRate) || targetFrameRate <= 0.0
+            || 1.0 / targetFrameRate > std::chrono::duration<double> { MAX_PERIOD }.count()) {
+            throw std::runtime_error("frame pacer target frame rate must be positive!");
+        }
+        return std::chrono::duration_cast<FramePacer::Clock::duration>(std::chrono::duration<double> { 1.0 / targetFrameRate });
+    }
+}
+
+FramePacer::FramePacer(double targetFrameRate)
+    : m_period(getPeriod(targetFrameRate)),
+      m_deadline(Clock::now()),
+      m_spinThreshold(INITIAL_SPIN_THRESHOLD) {}
+
+void FramePacer::wait() {
+    m_deadline += m_period;
+    Clock::time_point now = Clock::now();
+
+    if (now >= m_deadline) {
+        m_deadline = now;
+        return;
+    }
+    while (m_deadline - now > m_spinThreshold) {
+        const Clock::duration request = m_deadline - now - m_spinThreshold;
+        std::this_thread::sleep_for(request);
+
+        const Clock::time_point woken = Clock::now();
+        const Clock::duration overshoot = woken - now - request;
+
+        // 오차가 커지면 바로 반영하고 작아지면 천천히 줄임
+        m_spinThreshold = std::clamp<Clock::duration>(
+            std::max(overshoot, m_spinThreshold - m_spinThreshold / 16),
+            MIN_SPIN_THRESHOLD,
+            std::max<Clock::duration>(m_period, MIN_SPIN_THRESHOLD)
+        );
+        now = woken;
+    }
+    while (Clock::now() < m_deadline) {
+        std::this_thread::yield();
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+
+// frame 시작 시각을 일정한 간격으로 맞춤
+// OS sleep 은 늦게 깨어날 수 있으므로 예상 오차만큼 일찍 깨어나 나머지는 spin 으로 대기
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // targetFrameRate 가 양수가 아니거나 간격이 1 시간을 넘으면 예외
+    explicit FramePacer(double targetFrameRate);
+
+    // 다음 frame 시작 시각까지 대기. 한 frame 이상 밀렸으면 따라잡지 않고 현재 시각부터 다시 맞춤
+    void wait();
+
+    // 현재 sleep 오차 추정값 (이 시간만큼은 spin)
+    [[nodiscard]]
+    Clock::duration getSpinThreshold() const {
+        return m_spinThreshold;
+    }
+
+private:
+    Clock::duration     m_period;
+    Clock::time_point   m_deadline;
+    Clock::duration     m_spinThreshold;
+};
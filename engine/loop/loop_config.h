@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+enum class LoopMode {
+    // 매 loop 마다 event 를 poll 하고 그림 (present mode 가 속도를 제한)
+    CONTINUOUS,
+    // scene, 입력, 스트리밍이 바뀔 때만 그림. 그 외에는 event 가 올 때까지 잠듦
+    ON_DEMAND,
+    // targetFrameRate 에 맞춰 그리고 남는 시간은 sleep + spin 으로 대기
+    FRAME_CAP,
+};
+
+struct LoopConfig {
+    LoopMode mode = LoopMode::CONTINUOUS;
+    // FRAME_CAP 의 목표 frame rate. 양수여야 하며 다른 mode 에서는 무시
+    double targetFrameRate = 60.0;
+    // ON_DEMAND 에서 변화가 없어도 이 간격마다 다시 그림 (0 이면 변화가 있을 때만)
+    std::chrono::duration<double> idleRedrawInterval { 0.0 };
+    // 이 간격마다 LoopStats 를 갱신하고 출력 (0 이면 출력하지 않음)
+    std::chrono::duration<double> reportInterval { 0.0 };
+};
+
+struct LoopStats {
+    // process 전체 CPU 시간 / 경과 시간. 1.0 이 core 하나를 가득 쓴 상태
+    double cpuUtilization;
+    double framesPerSecond;
+    uint64_t frameCount;
+    // driver 가 engine callbacks 로 할당한 host memory (모든 scope 합)
+    uint64_t hostAllocatedBytes;
+    // GPU 가 끝낸 가장 최근 frame 에서 occlusion culling 으로 걸러진 객체 수
+    uint32_t frustumCulledCount;
+    uint32_t occlusionCulledCount;
+    // 같은 frame 에서 LOD 선택 후 그린 triangle 수
+    uint32_t drawnTriangleCount;
+};
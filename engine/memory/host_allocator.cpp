@@ -0,0 +1,268 @@
+#include "host_allocator.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <new>
+
+namespace {
+
+    constexpr std::array<VkObjectType, 28> TRACKED_OBJECT_TYPES {
+        VK_OBJECT_TYPE_UNKNOWN,
+        VK_OBJECT_TYPE_INSTANCE,
+        VK_OBJECT_TYPE_PHYSICAL_DEVICE,
+        VK_OBJECT_TYPE_DEVICE,
+        VK_OBJECT_TYPE_QUEUE,
+        VK_OBJECT_TYPE_SEMAPHORE,
+        VK_OBJECT_TYPE_COMMAND_BUFFER,
+        VK_OBJECT_TYPE_FENCE,
+        VK_OBJECT_TYPE_DEVICE_MEMORY,
+        VK_OBJECT_TYPE_BUFFER,
+        VK_OBJECT_TYPE_IMAGE,
+        VK_OBJECT_TYPE_EVENT,
+        VK_OBJECT_TYPE_QUERY_POOL,
+        VK_OBJECT_TYPE_BUFFER_VIEW,
+        VK_OBJECT_TYPE_IMAGE_VIEW,
+        VK_OBJECT_TYPE_SHADER_MODULE,
+        VK_OBJECT_TYPE_PIPELINE_CACHE,
+        VK_OBJECT_TYPE_PIPELINE_LAYOUT,
+        VK_OBJECT_TYPE_RENDER_PASS,
+        VK_OBJECT_TYPE_PIPELINE,
+        VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT,
+        VK_OBJECT_TYPE_SAMPLER,
+        VK_OBJECT_TYPE_DESCRIPTOR_POOL,
+        VK_OBJECT_TYPE_DESCRIPTOR_SET,
+        VK_OBJECT_TYPE_FRAMEBUFFER,
+        VK_OBJECT_TYPE_COMMAND_POOL,
+        VK_OBJECT_TYPE_SURFACE_KHR,
+        VK_OBJECT_TYPE_SWAPCHAIN_KHR,
+    };
+}
+
+HostAllocator::HostAllocator() {
+    static_assert(TRACKED_OBJECT_TYPES.size() == OBJECT_TYPE_COUNT);
+    static_assert(sizeof(BlockHeader) == HEADER_SIZE);
+    static_assert(MIN_BLOCK_SIZE << (SIZE_CLASS_COUNT - 1) == MAX_BLOCK_SIZE);
+
+    for (uint16_t typeSlot = 0; typeSlot < OBJECT_TYPE_COUNT; typeSlot++) {
+        m_contexts[typeSlot] = { this, typeSlot };
+
+        VkAllocationCallbacks& callbacks = m_callbacks[typeSlot];
+        callbacks.pUserData = &m_contexts[typeSlot];
+        callbacks.pfnAllocation = allocateCallback;
+        callbacks.pfnReallocation = reallocateCallback;
+        callbacks.pfnFree = freeCallback;
+        callbacks.pfnInternalAllocation = internalAllocationCallback;
+        callbacks.pfnInternalFree = internalFreeCallback;
+    }
+}
+
+HostAllocator::~HostAllocator() {
+    for (Arena& arena : m_arenas) {
+        for (void* chunk : arena.chunks) {
+            ::operator delete(chunk, std::align_val_t { HEADER_SIZE });
+        }
+    }
+}
+
+const VkAllocationCallbacks* HostAllocator::getCallbacks(VkObjectType objectType) const {
+    return &m_callbacks[getTypeSlot(objectType)];
+}
+
+HostAllocationCounters HostAllocator::getScopeCounters(VkSystemAllocationScope scope) const {
+    return load(m_scopeCounters[static_cast<size_t>(scope)]);
+}
+
+HostAllocationCounters HostAllocator::getObjectTypeCounters(VkObjectType objectType) const {
+    return load(m_typeCounters[getTypeSlot(objectType)]);
+}
+
+uint16_t HostAllocator::getTypeSlot(VkObjectType objectType) {
+    const auto found = std::ranges::find(TRACKED_OBJECT_TYPES, objectType);
+    return found == TRACKED_OBJECT_TYPES.end() ? 0 : static_cast<uint16_t>(found - TRACKED_OBJECT_TYPES.begin());
+}
+
+HostAllocationCounters HostAllocator::load(const Counters& counters) {
+    return {
+        counters.allocationCount.load(std::memory_order_relaxed),
+        counters.totalAllocationCount.load(std::memory_order_relaxed),
+        counters.liveBytes.load(std::memory_order_relaxed),
+        counters.peakBytes.load(std::memory_order_relaxed),
+        counters.internalBytes.load(std::memory_order_relaxed),
+    };
+}
+
+void HostAllocator::onAllocate(Counters& counters, uint64_t size) {
+    counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+    counters.totalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    const uint64_t liveBytes = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    uint64_t peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+
+    while (liveBytes > peakBytes && !counters.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed)) {}
+}
+
+void HostAllocator::onFree(Counters& counters, uint64_t size) {
+    counters.allocationCount.fetch_sub(1, std::memory_order_relaxed);
+    counters.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+void* HostAllocator::allocateCallback(void* userData, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+    const auto* context = static_cast<const CallbackContext*>(userData);
+    return context->allocator->allocate(size, alignment, scope, context->typeSlot);
+}
+
+void* HostAllocator::reallocateCallback(void* userData, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+    const auto* context = static_cast<const CallbackContext*>(userData);
+    return context->allocator->reallocate(original, size, alignment, scope, context->typeSlot);
+}
+
+void HostAllocator::freeCallback(void* userData, void* memory) {
+    static_cast<const CallbackContext*>(userData)->allocator->free(memory);
+}
+
+void HostAllocator::internalAllocationCallback(void* userData, size_t size, VkInternalAllocationType, VkSystemAllocationScope scope) {
+    const auto* context = static_cast<const CallbackContext*>(userData);
+    context->allocator->m_scopeCounters[static_cast<size_t>(scope)].internalBytes.fetch_add(size, std::memory_order_relaxed);
+    context->allocator->m_typeCounters[context->typeSlot].internalBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void HostAllocator::internalFreeCallback(void* userData, size_t size, VkInternalAllocationType, VkSystemAllocationScope scope) {
+    const auto* context = static_cast<const CallbackContext*>(userData);
+    context->allocator->m_scopeCounters[static_cast<size_t>(scope)].internalBytes.fetch_sub(size, std::memory_order_relaxed);
+    context->allocator->m_typeCounters[context->typeSlot].internalBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+void* HostAllocator::allocate(size_t size, size_t alignment, VkSystemAllocationScope scope, uint16_t typeSlot) {
+    if (size == 0) {
+        return nullptr;
+    }
+    const auto scopeIndex = static_cast<uint8_t>(scope);
+    std::byte* memory;
+    uint32_t offset;
+    uint8_t sizeClass;
+
+    // block 은 HEADER_SIZE 로 정렬되므로 그 이상의 정렬은 큰 할당으로 처리
+    if (alignment <= HEADER_SIZE && size <= MAX_BLOCK_SIZE - HEADER_SIZE) {
+        sizeClass = static_cast<uint8_t>(std::countr_zero(std::bit_ceil(std::max(size + HEADER_SIZE, MIN_BLOCK_SIZE))) - std::countr_zero(MIN_BLOCK_SIZE));
+        void* block = allocateBlock(m_arenas[scopeIndex], sizeClass);
+
+        if (block == nullptr) {
+            return nullptr;
+        }
+        memory = static_cast<std::byte*>(block) + HEADER_SIZE;
+        offset = HEADER_SIZE;
+    } else {
+        offset = static_cast<uint32_t>(std::max(alignment, HEADER_SIZE));
+        sizeClass = LARGE_SIZE_CLASS;
+        void* base = ::operator new(offset + size, std::align_val_t { offset }, std::nothrow);
+
+        if (base == nullptr) {
+            return nullptr;
+        }
+        memory = static_cast<std::byte*>(base) + offset;
+    }
+    new (memory - HEADER_SIZE) BlockHeader { size, offset, sizeClass, scopeIndex, typeSlot };
+
+    onAllocate(m_scopeCounters[scopeIndex], size);
+    onAllocate(m_typeCounters[typeSlot], size);
+    return memory;
+}
+
+void* HostAllocator::reallocate(void* original, size_t size, size_t alignment, VkSystemAllocationScope scope, uint16_t typeSlot) {
+    if (original == nullptr) {
+        return allocate(size, alignment, scope, typeSlot);
+    }
+    if (size == 0) {
+        free(original);
+        return nullptr;
+    }
+    auto* header = reinterpret_cast<BlockHeader*>(static_cast<std::byte*>(original) - HEADER_SIZE);
+
+    // 같은 block 에 들어가면 그대로 사용
+    if (
+        header->sizeClass != LARGE_SIZE_CLASS
+        && alignment <= HEADER_SIZE
+        && size + HEADER_SIZE <= MIN_BLOCK_SIZE << header->sizeClass
+    ) {
+        const uint64_t previousSize = header->size;
+        header->size = size;
+
+        m_scopeCounters[header->scope].liveBytes.fetch_add(size - previousSize, std::memory_order_relaxed);
+        m_typeCounters[header->typeSlot].liveBytes.fetch_add(size - previousSize, std::memory_order_relaxed);
+        return original;
+    }
+    // 실패하면 원래 할당은 유지해야 함
+    void* memory = allocate(size, alignment, scope, typeSlot);
+
+    if (memory == nullptr) {
+        return nullptr;
+    }
+    std::memcpy(memory, original, std::min<size_t>(size, header->size));
+    free(original);
+    return memory;
+}
+
+void HostAllocator::free(void* memory) {
+    if (memory == nullptr) {
+        return;
+    }
+    auto* bytes = static_cast<std::byte*>(memory);
+    const BlockHeader header = *reinterpret_cast<const BlockHeader*>(bytes - HEADER_SIZE);
+
+    onFree(m_scopeCounters[header.scope], header.size);
+    onFree(m_typeCounters[header.typeSlot], header.size);
+
+    if (header.sizeClass == LARGE_SIZE_CLASS) {
+        ::operator delete(bytes - header.offset, std::align_val_t { header.offset });
+        return;
+    }
+    freeBlock(m_arenas[header.scope], header.sizeClass, bytes - HEADER_SIZE);
+}
+
+void* HostAllocator::allocateBlock(Arena& arena, uint8_t sizeClass) {
+    std::lock_guard lock { arena.mutex };
+    FreeBlock*& freeList = arena.freeLists[sizeClass];
+
+    if (freeList == nullptr) {
+        void* chunk = ::operator new(CHUNK_SIZE, std::align_val_t { HEADER_SIZE }, std::nothrow);
+
+        if (chunk == nullptr) {
+            return nullptr;
+        }
+        arena.chunks.push_back(chunk);
+        m_reservedBytes.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+
+        // chunk 를 같은 크기의 block 으로 나눠 free list 에 연결
+        const size_t blockSize = MIN_BLOCK_SIZE << sizeClass;
+
+        for (size_t offset = CHUNK_SIZE; offset >= blockSize; offset -= blockSize) {
+            auto* block = reinterpret_cast<FreeBlock*>(static_cast<std::byte*>(chunk) + offset - blockSize);
+            block->next = freeList;
+            freeList = block;
+        }
+    }
+    FreeBlock* block = freeList;
+    freeList = block->next;
+    return block;
+}
+
+void HostAllocator::freeBlock(Arena& arena, uint8_t sizeClass, void* block) {
+    std::lock_guard lock { arena.mutex };
+    auto* freeBlock = static_cast<FreeBlock*>(block);
+
+    freeBlock->next = arena.freeLists[sizeClass];
+    arena.freeLists[sizeClass] = freeBlock;
+}
+
+namespace HostAllocators {
+
+    HostAllocator& get() {
+        static HostAllocator allocator {};
+        return allocator;
+    }
+
+    const VkAllocationCallbacks* getCallbacks(VkObjectType objectType) {
+        return get().getCallbacks(objectType);
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+struct HostAllocationCounters {
+    // 해제되지 않은 할당 수
+    uint64_t allocationCount;
+    uint64_t totalAllocationCount;
+    uint64_t liveBytes;
+    uint64_t peakBytes;
+    // driver 가 직접 할당하고 알려준 양 (실행 코드 등)
+    uint64_t internalBytes;
+};
+
+// driver 의 host 할당을 받는 VkAllocationCallbacks 구현
+// 작은 할당은 allocation scope 별 arena 의 size class free list 에서 꺼내고, 큰 할당만 operator new 로 보냄
+// object type 마다 pUserData 가 다른 callbacks 를 두어 생성한 object 의 이후 할당까지 type 별로 집계
+class HostAllocator {
+public:
+    HostAllocator();
+
+    HostAllocator(const HostAllocator&) = delete;
+    HostAllocator& operator=(const HostAllocator&) = delete;
+
+    ~HostAllocator();
+
+    // 생성과 파괴에 같은 type 의 callbacks 를 넘김 (모든 callbacks 는 서로 호환됨)
+    [[nodiscard]]
+    const VkAllocationCallbacks* getCallbacks(VkObjectType objectType) const;
+
+    [[nodiscard]]
+    HostAllocationCounters getScopeCounters(VkSystemAllocationScope scope) const;
+
+    [[nodiscard]]
+    HostAllocationCounters getObjectTypeCounters(VkObjectType objectType) const;
+
+    // size class arena 가 확보해 둔 chunk 크기 합
+    [[nodiscard]]
+    uint64_t getReservedBytes() const {
+        return m_reservedBytes.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t SCOPE_COUNT = 5;
+    // core object type 과 surface, swapchain. 그 외는 UNKNOWN 으로 집계
+    static constexpr size_t OBJECT_TYPE_COUNT = 28;
+    static constexpr size_t MIN_BLOCK_SIZE = 32;
+    static constexpr size_t MAX_BLOCK_SIZE = 4096;
+    static constexpr size_t SIZE_CLASS_COUNT = 8;
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+    // 반환 주소 앞의 header 크기이자 size class block 의 정렬
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr uint8_t LARGE_SIZE_CLASS = 0xFF;
+
+    struct alignas(HEADER_SIZE) BlockHeader {
+        uint64_t size;
+        // 큰 할당에서 operator new 가 준 주소까지의 거리 (= 정렬)
+        uint32_t offset;
+        uint8_t sizeClass;
+        uint8_t scope;
+        uint16_t typeSlot;
+    };
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct Arena {
+        std::mutex mutex;
+        std::array<FreeBlock*, SIZE_CLASS_COUNT> freeLists {};
+        std::vector<void*> chunks;
+    };
+
+    struct Counters {
+        std::atomic<uint64_t> allocationCount = 0;
+        std::atomic<uint64_t> totalAllocationCount = 0;
+        std::atomic<uint64_t> liveBytes = 0;
+        std::atomic<uint64_t> peakBytes = 0;
+        std::atomic<uint64_t> internalBytes = 0;
+    };
+
+    struct CallbackContext {
+        HostAllocator* allocator;
+        uint16_t typeSlot;
+    };
+
+    static uint16_t getTypeSlot(VkObjectType objectType);
+    static HostAllocationCounters load(const Counters& counters);
+    static void onAllocate(Counters& counters, uint64_t size);
+    static void onFree(Counters& counters, uint64_t size);
+
+    static VKAPI_ATTR void* VKAPI_CALL allocateCallback(void* userData, size_t size, size_t alignment, VkSystemAllocationScope scope);
+    static VKAPI_ATTR void* VKAPI_CALL reallocateCallback(void* userData, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+    static VKAPI_ATTR void VKAPI_CALL freeCallback(void* userData, void* memory);
+    static VKAPI_ATTR void VKAPI_CALL internalAllocationCallback(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+    static VKAPI_ATTR void VKAPI_CALL internalFreeCallback(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+
+    void* allocate(size_t size, size_t alignment, VkSystemAllocationScope scope, uint16_t typeSlot);
+    void* reallocate(void* original, size_t size, size_t alignment, VkSystemAllocationScope scope, uint16_t typeSlot);
+    void free(void* memory);
+
+    void* allocateBlock(Arena& arena, uint8_t sizeClass);
+    void freeBlock(Arena& arena, uint8_t sizeClass, void* block);
+
+    std::array<Arena, SCOPE_COUNT>                                  m_arenas;
+    std::array<Counters, SCOPE_COUNT>                               m_scopeCounters;
+    std::array<Counters, OBJECT_TYPE_COUNT>                         m_typeCounters;
+    std::array<CallbackContext, OBJECT_TYPE_COUNT>                  m_contexts;
+    std::array<VkAllocationCallbacks, OBJECT_TYPE_COUNT>            m_callbacks;
+    std::atomic<uint64_t>                                           m_reservedBytes = 0;
+};
+
+namespace HostAllocators {
+
+    // instance 가 파괴될 때까지 살아 있어야 하므로 프로세스 전체에서 하나를 사용
+    HostAllocator& get();
+
+    const VkAllocationCallbacks* getCallbacks(VkObjectType objectType);
+}
@@ -0,0 +1,73 @@
+#include "linear_buffer_allocator.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace {
+    // binding 하나가 읽는 최대 크기. 대부분의 GPU 의 maxUniformBufferRange (최소 보장값은 16 KiB)
+    constexpr VkDeviceSize MAX_BINDING_RANGE = 64 * 1024;
+}
+
+LinearBufferAllocator::LinearBufferAllocator(
+    VkPhysicalDevice physicalDevice,
+    VkDevice device,
+    DeletionQueue& deletionQueue,
+    uint32_t framesInFlight,
+    VkDeviceSize frameCapacity
+) : m_physicalDevice(physicalDevice), m_device(device), m_deletionQueue(deletionQueue), m_framesInFlight(std::max(framesInFlight, 1u)) {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    m_uniformAlignment = std::max<VkDeviceSize>(properties.limits.minUniformBufferOffsetAlignment, 1);
+    m_storageAlignment = std::max<VkDeviceSize>(properties.limits.minStorageBufferOffsetAlignment, 1);
+    m_maxRange = std::min<VkDeviceSize>(properties.limits.maxUniformBufferRange, MAX_BINDING_RANGE);
+    createBuffer(frameCapacity);
+}
+
+LinearBufferAllocator::~LinearBufferAllocator() {
+    destroyBuffer();
+}
+
+void LinearBufferAllocator::begin(uint64_t frame) {
+    const VkDeviceSize requiredBytes = m_offset + m_droppedBytes;
+
+    if (requiredBytes > m_frameCapacity) {
+        destroyBuffer();
+        createBuffer(std::bit_ceil(requiredBytes));
+    }
+    m_frameBase = (frame % m_framesInFlight) * m_frameCapacity;
+    m_offset = 0;
+    m_droppedBytes = 0;
+}
+
+void LinearBufferAllocator::createBuffer(VkDeviceSize frameCapacity) {
+    // 모든 구간의 시작이 두 alignment 에 맞도록 (둘 다 2 의 거듭제곱)
+    const VkDeviceSize alignment = std::max(m_uniformAlignment, m_storageAlignment);
+    m_frameCapacity = Alignments::alignUp(std::max(frameCapacity, alignment), alignment);
+
+    m_buffer = MemorySupports::createBuffer(
+        m_physicalDevice,
+        m_device,
+        m_frameCapacity * m_framesInFlight + m_maxRange,
+        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        m_deletionQueue.getMemoryBudget(),
+        MemoryCategory::TRANSIENT
+    );
+    void* mapped = nullptr;
+
+    if (vkMapMemory(m_device, m_buffer.memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+        throw std::runtime_error("failed to map linear buffer!");
+    }
+    m_mapped = static_cast<char*>(mapped);
+    m_generation++;
+}
+
+void LinearBufferAllocator::destroyBuffer() {
+    // 매핑은 vkFreeMemory 에서 함께 해제됨
+    m_deletionQueue.retire(m_buffer.buffer);
+    m_deletionQueue.retire(m_buffer.memory);
+    m_buffer = {};
+    m_mapped = nullptr;
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vulkan/vulkan_core.h>
+
+#include "memory_supports.h"
+#include "../resource/deletion_queue.h"
+#include "../util/alignment.h"
+
+// data 에 바로 쓰고, descriptor 는 buffer 에 offset 0 으로 묶어 dynamicOffset 으로 바인딩
+struct LinearAllocation {
+    // nullptr 이면 이번 frame 의 구간이 가득 참 (다음 frame 부터 커짐)
+    void* data = nullptr;
+    VkBuffer buffer = VK_NULL_HANDLE;
+    uint32_t dynamicOffset = 0;
+};
+
+// frame in flight 마다 구간을 나눈 persistently mapped uniform / storage buffer 위의 bump allocator
+// 할당은 offset 을 올리기만 하고 Vulkan 호출이 없음. begin 에서 frame 구간 전체를 한 번에 버림
+class LinearBufferAllocator {
+public:
+    static constexpr VkDeviceSize DEFAULT_FRAME_CAPACITY = 1 << 20;
+
+    LinearBufferAllocator(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        DeletionQueue& deletionQueue,
+        uint32_t framesInFlight,
+        VkDeviceSize frameCapacity = DEFAULT_FRAME_CAPACITY
+    );
+
+    LinearBufferAllocator(const LinearBufferAllocator&) = delete;
+    LinearBufferAllocator& operator=(const LinearBufferAllocator&) = delete;
+
+    ~LinearBufferAllocator();
+
+    // frame 의 구간을 비움. 지난 frame 에 넘쳤으면 buffer 를 키움 (이전 buffer 는 GPU 가 끝낸 뒤 파괴)
+    void begin(uint64_t frame);
+
+    [[nodiscard]]
+    LinearAllocation allocateUniform(VkDeviceSize size) {
+        return allocate(size, m_uniformAlignment);
+    }
+
+    [[nodiscard]]
+    LinearAllocation allocateStorage(VkDeviceSize size) {
+        return allocate(size, m_storageAlignment);
+    }
+
+    // draw 마다 바뀌는 상수를 복사
+    template<typename T>
+    LinearAllocation pushUniform(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const LinearAllocation allocation = allocateUniform(sizeof(T));
+
+        if (allocation.data != nullptr) {
+            std::memcpy(allocation.data, &value, sizeof(T));
+        }
+        return allocation;
+    }
+
+    // dynamic descriptor 용. range 는 binding 이 한 번에 읽는 크기 (getMaxRange 이하)
+    [[nodiscard]]
+    VkDescriptorBufferInfo createDescriptorBufferInfo(VkDeviceSize range) const {
+        return { m_buffer.buffer, 0, range };
+    }
+
+    [[nodiscard]]
+    VkDeviceSize getMaxRange() const {
+        return m_maxRange;
+    }
+
+    // buffer 를 다시 만들 때마다 증가. 이 buffer 를 가리키는 오래 사는 descriptor set 은 다시 써야 함
+    [[nodiscard]]
+    uint64_t getGeneration() const {
+        return m_generation;
+    }
+
+    [[nodiscard]]
+    VkDeviceSize getFrameCapacity() const {
+        return m_frameCapacity;
+    }
+
+    // 이번 frame 에 할당한 크기 (alignment 포함)
+    [[nodiscard]]
+    VkDeviceSize getUsedBytes() const {
+        return m_offset;
+    }
+
+    // 구간이 부족해 실패한 할당의 크기. 다음 begin 에서 buffer 크기를 정하는 데 씀
+    [[nodiscard]]
+    VkDeviceSize getDroppedBytes() const {
+        return m_droppedBytes;
+    }
+
+private:
+    LinearAllocation allocate(VkDeviceSize size, VkDeviceSize alignment) {
+        const VkDeviceSize offset = Alignments::alignUp(m_offset, alignment);
+
+        if (offset + size > m_frameCapacity) {
+            m_droppedBytes += size;
+            return {};
+        }
+        m_offset = offset + size;
+
+        const VkDeviceSize bufferOffset = m_frameBase + offset;
+        return { m_mapped + bufferOffset, m_buffer.buffer, static_cast<uint32_t>(bufferOffset) };
+    }
+
+    void createBuffer(VkDeviceSize frameCapacity);
+    void destroyBuffer();
+
+    VkPhysicalDevice            m_physicalDevice;
+    VkDevice                    m_device;
+    DeletionQueue&              m_deletionQueue;
+    uint32_t                    m_framesInFlight;
+    VkDeviceSize                m_uniformAlignment = 1;
+    VkDeviceSize                m_storageAlignment = 1;
+    // 마지막 구간 끝에서도 dynamicOffset + range 가 buffer 안에 들도록 뒤에 두는 여유
+    VkDeviceSize                m_maxRange = 0;
+
+    // [frame 0 | frame 1 | ... | m_maxRange]
+    BufferAllocation            m_buffer;
+    char*                       m_mapped = nullptr;
+    VkDeviceSize                m_frameCapacity = 0;
+    uint64_t                    m_generation = 0;
+
+    // 이번 frame 구간의 시작과 그 안의 다음 할당 위치
+    VkDeviceSize                m_frameBase = 0;
+    VkDeviceSize                m_offset = 0;
+    VkDeviceSize                m_droppedBytes = 0;
+};
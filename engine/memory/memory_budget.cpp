@@ -0,0 +1,193 @@
+#include "memory_budget.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+
+namespace {
+    // createVkInstance 는 있으면 켜므로 instance 에 있는지로 판단
+    bool isPhysicalDeviceProperties2Available() {
+        uint32_t extensionCount = 0;
+        vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, nullptr);
+
+        std::vector<VkExtensionProperties> extensions(extensionCount);
+        vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, extensions.data());
+
+        return std::ranges::any_of(extensions, [](const VkExtensionProperties& extension) {
+            return std::strcmp(extension.extensionName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0;
+        });
+    }
+}
+
+MemoryBudget::MemoryBudget(VkInstance instance, VkPhysicalDevice physicalDevice, MemoryBudgetConfig config)
+    : m_physicalDevice(physicalDevice), m_config(config) {
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_memoryProperties);
+
+    // Vulkan 1.0 이므로 VK_KHR_get_physical_device_properties2 의 함수로 질의
+    // getDeviceExtensions 와 같은 조건이어야 device 에 VK_EXT_memory_budget 이 켜져 있음
+    if (isPhysicalDeviceProperties2Available() && isExtensionSupported(physicalDevice)) {
+        m_getMemoryProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceMemoryProperties2KHR")
+        );
+    }
+    for (uint32_t heapIndex = 0; heapIndex < m_memoryProperties.memoryHeapCount; heapIndex++) {
+        m_heaps[heapIndex].flags = m_memoryProperties.memoryHeaps[heapIndex].flags;
+        m_heaps[heapIndex].size = m_memoryProperties.memoryHeaps[heapIndex].size;
+    }
+    refresh();
+}
+
+bool MemoryBudget::isExtensionSupported(VkPhysicalDevice physicalDevice) {
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+
+    std::vector<VkExtensionProperties> extensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensions.data());
+
+    return std::ranges::any_of(extensions, [](const VkExtensionProperties& extension) {
+        return std::strcmp(extension.extensionName, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0;
+    });
+}
+
+void MemoryBudget::onAllocate(VkDeviceMemory memory, uint32_t memoryTypeIndex, VkDeviceSize size, MemoryCategory category) {
+    const uint32_t heapIndex = getHeapIndex(memoryTypeIndex);
+    std::lock_guard lock { m_mutex };
+
+    m_allocations.emplace(memory, Allocation { heapIndex, category, size });
+
+    HeapBudget& heap = m_heaps[heapIndex];
+    heap.allocatedBytes += size;
+    heap.categoryBytes[static_cast<size_t>(category)] += size;
+    heap.allocationCount++;
+
+    // 다음 질의 전까지는 직접 할당한 양만큼 driver usage 도 늘었다고 봄
+    heap.usage += size;
+}
+
+void MemoryBudget::onFree(VkDeviceMemory memory) {
+    std::lock_guard lock { m_mutex };
+    const auto allocation = m_allocations.find(memory);
+
+    // 추적하지 않는 할당 (swapchain 등) 은 무시
+    if (allocation == m_allocations.end()) {
+        return;
+    }
+    const auto [heapIndex, category, size] = allocation->second;
+    m_allocations.erase(allocation);
+
+    HeapBudget& heap = m_heaps[heapIndex];
+    heap.allocatedBytes -= size;
+    heap.categoryBytes[static_cast<size_t>(category)] -= size;
+    heap.allocationCount--;
+    heap.usage -= std::min(heap.usage, size);
+}
+
+void MemoryBudget::update(uint64_t frame) {
+    if (m_config.updateInterval > 1 && frame % m_config.updateInterval != 0) {
+        return;
+    }
+    std::vector<MemoryPressure> pressures {};
+    {
+        std::lock_guard lock { m_mutex };
+        refreshLocked();
+
+        for (uint32_t heapIndex = 0; heapIndex < m_memoryProperties.memoryHeapCount; heapIndex++) {
+            const HeapBudget& heap = m_heaps[heapIndex];
+            const auto warningBytes = static_cast<VkDeviceSize>(static_cast<double>(heap.budget) * m_config.warningRatio);
+            const auto targetBytes = static_cast<VkDeviceSize>(static_cast<double>(heap.budget) * m_config.targetRatio);
+
+            if (heap.usage < targetBytes) {
+                m_isOverBudget[heapIndex] = false;
+                continue;
+            }
+            if (heap.usage < warningBytes) {
+                continue;
+            }
+            if (!m_isOverBudget[heapIndex]) {
+                m_isOverBudget[heapIndex] = true;
+                std::cerr << "memory heap " << heapIndex << " is near its budget: "
+                    << (heap.usage >> 20) << " / " << (heap.budget >> 20) << " MiB" << std::endl;
+            }
+            // 내려갈 때까지 update 마다 다시 요청
+            pressures.push_back({ heapIndex, heap.flags, heap.budget, heap.usage, heap.usage - targetBytes });
+        }
+    }
+    for (const MemoryPressure& pressure : pressures) {
+        for (const auto& [id, callback] : m_evictionCallbacks) {
+            callback(pressure);
+        }
+    }
+}
+
+void MemoryBudget::refresh() {
+    std::lock_guard lock { m_mutex };
+    refreshLocked();
+}
+
+void MemoryBudget::refreshLocked() {
+    if (m_getMemoryProperties2 == nullptr) {
+        for (uint32_t heapIndex = 0; heapIndex < m_memoryProperties.memoryHeapCount; heapIndex++) {
+            HeapBudget& heap = m_heaps[heapIndex];
+            heap.budget = static_cast<VkDeviceSize>(static_cast<double>(heap.size) * m_config.fallbackBudgetRatio);
+            heap.usage = heap.allocatedBytes;
+        }
+        return;
+    }
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties {};
+    budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    VkPhysicalDeviceMemoryProperties2KHR memoryProperties {};
+    memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2_KHR;
+    memoryProperties.pNext = &budgetProperties;
+
+    m_getMemoryProperties2(m_physicalDevice, &memoryProperties);
+
+    for (uint32_t heapIndex = 0; heapIndex < m_memoryProperties.memoryHeapCount; heapIndex++) {
+        HeapBudget& heap = m_heaps[heapIndex];
+        // budget 은 heap 크기를 넘지 않아야 하지만 0 을 보고하는 driver 도 있음
+        heap.budget = budgetProperties.heapBudget[heapIndex] > 0 ? std::min(budgetProperties.heapBudget[heapIndex], heap.size) : heap.size;
+        heap.usage = std::max(budgetProperties.heapUsage[heapIndex], heap.allocatedBytes);
+    }
+}
+
+uint32_t MemoryBudget::addEvictionCallback(EvictionCallback callback) {
+    const uint32_t id = m_nextCallbackId++;
+    m_evictionCallbacks.emplace_back(id, std::move(callback));
+    return id;
+}
+
+void MemoryBudget::removeEvictionCallback(uint32_t id) {
+    std::erase_if(m_evictionCallbacks, [id](const auto& entry) { return entry.first == id; });
+}
+
+HeapBudget MemoryBudget::getHeapBudget(uint32_t heapIndex) const {
+    std::lock_guard lock { m_mutex };
+    return m_heaps[heapIndex];
+}
+
+std::vector<HeapBudget> MemoryBudget::getHeapBudgets() const {
+    std::lock_guard lock { m_mutex };
+    return { m_heaps.begin(), m_heaps.begin() + m_memoryProperties.memoryHeapCount };
+}
+
+VkDeviceSize MemoryBudget::getCategoryBytes(MemoryCategory category) const {
+    std::lock_guard lock { m_mutex };
+
+    return std::accumulate(m_heaps.begin(), m_heaps.begin() + m_memoryProperties.memoryHeapCount, VkDeviceSize { 0 },
+        [category](VkDeviceSize total, const HeapBudget& heap) {
+            return total + heap.categoryBytes[static_cast<size_t>(category)];
+        }
+    );
+}
+
+bool MemoryBudget::isOverBudget(uint32_t heapIndex) const {
+    std::lock_guard lock { m_mutex };
+    return m_isOverBudget[heapIndex];
+}
+
+VkDeviceSize MemoryBudget::getAvailableBytes(uint32_t heapIndex) const {
+    std::lock_guard lock { m_mutex };
+    const HeapBudget& heap = m_heaps[heapIndex];
+    return heap.budget > heap.usage ? heap.budget - heap.usage : 0;
+}
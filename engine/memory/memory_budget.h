@@ -0,0 +1,138 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+enum class MemoryCategory : uint8_t {
+    BUFFER,
+    IMAGE,
+    // staging, readback, frame 마다 다시 쓰는 ring 등
+    TRANSIENT,
+};
+
+inline constexpr size_t MEMORY_CATEGORY_COUNT = 3;
+
+struct HeapBudget {
+    VkMemoryHeapFlags flags;
+    VkDeviceSize size;
+    // 이 프로세스가 paging 없이 쓸 수 있는 양 (extension 이 없으면 heap 크기로 추정)
+    VkDeviceSize budget;
+    // driver 가 보고한 프로세스 전체 사용량 (extension 이 없으면 allocatedBytes)
+    VkDeviceSize usage;
+    // engine 이 직접 할당한 양
+    VkDeviceSize allocatedBytes;
+    std::array<VkDeviceSize, MEMORY_CATEGORY_COUNT> categoryBytes;
+    uint32_t allocationCount;
+};
+
+struct MemoryPressure {
+    uint32_t heapIndex;
+    VkMemoryHeapFlags heapFlags;
+    VkDeviceSize budget;
+    VkDeviceSize usage;
+    // targetRatio 까지 내려가려면 해제해야 하는 양
+    VkDeviceSize bytesToFree;
+};
+
+// update 를 호출한 스레드 (render thread) 에서 호출됨
+using EvictionCallback = std::function<void(const MemoryPressure& pressure)>;
+
+struct MemoryBudgetConfig {
+    // usage 가 budget 의 이 비율을 넘으면 경고하고 eviction callback 호출
+    float warningRatio = 0.9f;
+    // eviction 이 목표로 하는 비율. 이 아래로 내려가면 다시 경고 가능
+    float targetRatio = 0.8f;
+    // extension 이 없을 때 heap 크기 중 budget 으로 보는 비율
+    float fallbackBudgetRatio = 0.8f;
+    // driver 에 budget 을 다시 질의하는 frame 간격
+    uint32_t updateInterval = 16;
+};
+
+// VK_EXT_memory_budget 으로 heap 별 budget / usage 를 받아오고,
+// engine 의 할당을 heap, category 별로 집계
+class MemoryBudget {
+public:
+    MemoryBudget(VkInstance instance, VkPhysicalDevice physicalDevice, MemoryBudgetConfig config = {});
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    // device 생성 시 VK_EXT_memory_budget 을 켤 수 있는지
+    static bool isExtensionSupported(VkPhysicalDevice physicalDevice);
+
+    // 어느 스레드에서나 호출 가능
+    void onAllocate(VkDeviceMemory memory, uint32_t memoryTypeIndex, VkDeviceSize size, MemoryCategory category);
+    void onFree(VkDeviceMemory memory);
+
+    // frame 마다 호출. updateInterval 마다 budget 을 갱신하고 초과 시 callback 호출
+    void update(uint64_t frame);
+
+    // driver 에 budget 을 즉시 다시 질의
+    void refresh();
+
+    uint32_t addEvictionCallback(EvictionCallback callback);
+    void removeEvictionCallback(uint32_t id);
+
+    [[nodiscard]]
+    HeapBudget getHeapBudget(uint32_t heapIndex) const;
+
+    [[nodiscard]]
+    std::vector<HeapBudget> getHeapBudgets() const;
+
+    // 모든 heap 합계
+    [[nodiscard]]
+    VkDeviceSize getCategoryBytes(MemoryCategory category) const;
+
+    // budget 까지 남은 양
+    [[nodiscard]]
+    VkDeviceSize getAvailableBytes(uint32_t heapIndex) const;
+
+    // warningRatio 를 넘은 뒤 아직 targetRatio 아래로 내려가지 않았는지
+    [[nodiscard]]
+    bool isOverBudget(uint32_t heapIndex) const;
+
+    [[nodiscard]]
+    uint32_t getHeapIndex(uint32_t memoryTypeIndex) const {
+        return m_memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+    }
+
+    [[nodiscard]]
+    uint32_t getHeapCount() const {
+        return m_memoryProperties.memoryHeapCount;
+    }
+
+    [[nodiscard]]
+    bool hasBudgetExtension() const {
+        return m_getMemoryProperties2 != nullptr;
+    }
+
+private:
+    struct Allocation {
+        uint32_t heapIndex;
+        MemoryCategory category;
+        VkDeviceSize size;
+    };
+
+    void refreshLocked();
+
+    VkPhysicalDevice            m_physicalDevice;
+    MemoryBudgetConfig          m_config;
+    VkPhysicalDeviceMemoryProperties m_memoryProperties {};
+    // extension 이 없으면 nullptr
+    PFN_vkGetPhysicalDeviceMemoryProperties2KHR m_getMemoryProperties2 = nullptr;
+
+    mutable std::mutex          m_mutex;
+    std::array<HeapBudget, VK_MAX_MEMORY_HEAPS> m_heaps {};
+    std::unordered_map<VkDeviceMemory, Allocation> m_allocations;
+    // 경고 후 targetRatio 아래로 내려가기 전까지 다시 경고하지 않음
+    std::array<bool, VK_MAX_MEMORY_HEAPS> m_isOverBudget {};
+
+    // update 와 같은 스레드에서만 접근
+    std::vector<std::pair<uint32_t, EvictionCallback>> m_evictionCallbacks;
+    uint32_t                    m_nextCallbackId = 0;
+};
@@ -0,0 +1,166 @@
+#include "memory_supports.h"
+
+#include <stdexcept>
+
+#include "host_allocator.h"
+
+uint32_t MemorySupports::findMemoryType(VkPhysicalDevice physicalDevice, uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) {
+    VkPhysicalDeviceMemoryProperties memoryProperties {};
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+    for (uint32_t index = 0; index < memoryProperties.memoryTypeCount; index++) {
+        if (
+            (memoryTypeBits & (1u << index))
+            && (memoryProperties.memoryTypes[index].propertyFlags & properties) == properties
+        ) {
+            return index;
+        }
+    }
+    throw std::runtime_error("failed to find suitable memory type!");
+}
+
+VkMemoryAllocateInfo MemorySupports::createMemoryAllocateInfo(VkDeviceSize size, uint32_t memoryTypeIndex) {
+    VkMemoryAllocateInfo memoryAllocateInfo {};
+    memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryAllocateInfo.allocationSize = size;
+    memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+    return memoryAllocateInfo;
+}
+
+VkDeviceMemory MemorySupports::allocateMemory(
+    VkPhysicalDevice physicalDevice,
+    VkDevice device,
+    const VkMemoryRequirements& memoryRequirements,
+    VkMemoryPropertyFlags properties,
+    MemoryBudget* budget,
+    MemoryCategory category
+) {
+    const uint32_t memoryTypeIndex = findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits, properties);
+    VkMemoryAllocateInfo memoryAllocateInfo = createMemoryAllocateInfo(memoryRequirements.size, memoryTypeIndex);
+    VkDeviceMemory memory;
+
+    if (vkAllocateMemory(device, &memoryAllocateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_DEVICE_MEMORY), &memory) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate device memory!");
+    }
+    if (budget != nullptr) {
+        budget->onAllocate(memory, memoryTypeIndex, memoryRequirements.size, category);
+    }
+    return memory;
+}
+
+VkBufferCreateInfo MemorySupports::createBufferCreateInfo(VkDeviceSize size, VkBufferUsageFlags usage) {
+    VkBufferCreateInfo bufferCreateInfo {};
+    bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCreateInfo.size = size;
+    bufferCreateInfo.usage = usage;
+    bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    return bufferCreateInfo;
+}
+
+BufferAllocation MemorySupports::createBuffer(
+    VkPhysicalDevice physicalDevice,
+    VkDevice device,
+    VkDeviceSize size,
+    VkBufferUsageFlags usage,
+    VkMemoryPropertyFlags properties,
+    MemoryBudget* budget,
+    MemoryCategory category
+) {
+    VkBufferCreateInfo bufferCreateInfo = createBufferCreateInfo(size, usage);
+    BufferAllocation allocation {};
+
+    if (vkCreateBuffer(device, &bufferCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_BUFFER), &allocation.buffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create buffer!");
+    }
+    VkMemoryRequirements memoryRequirements;
+    vkGetBufferMemoryRequirements(device, allocation.buffer, &memoryRequirements);
+
+    // 맞는 memory type 이 없으면 호출자가 다른 속성으로 재시도할 수 있도록 buffer 를 정리하고 던짐
+    try {
+        allocation.memory = allocateMemory(physicalDevice, device, memoryRequirements, properties, budget, category);
+    } catch (...) {
+        vkDestroyBuffer(device, allocation.buffer, HostAllocators::getCallbacks(VK_OBJECT_TYPE_BUFFER));
+        throw;
+    }
+    allocation.size = memoryRequirements.size;
+
+    vkBindBufferMemory(device, allocation.buffer, allocation.memory, 0);
+    return allocation;
+}
+
+VkImageCreateInfo MemorySupports::createImageCreateInfo(VkExtent2D extent, uint32_t mipLevels, VkFormat format, VkImageUsageFlags usage) {
+    VkImageCreateInfo imageCreateInfo {};
+    imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageCreateInfo.extent = { extent.width, extent.height, 1 };
+    imageCreateInfo.mipLevels = mipLevels;
+    imageCreateInfo.arrayLayers = 1;
+    imageCreateInfo.format = format;
+    imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageCreateInfo.usage = usage;
+    imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    return imageCreateInfo;
+}
+
+ImageAllocation MemorySupports::createImage(
+    VkPhysicalDevice physicalDevice,
+    VkDevice device,
+    const VkImageCreateInfo& imageCreateInfo,
+    VkMemoryPropertyFlags properties,
+    MemoryBudget* budget,
+    MemoryCategory category
+) {
+    ImageAllocation allocation {};
+
+    if (vkCreateImage(device, &imageCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_IMAGE), &allocation.image) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create image!");
+    }
+    VkMemoryRequirements memoryRequirements;
+    vkGetImageMemoryRequirements(device, allocation.image, &memoryRequirements);
+
+    try {
+        allocation.memory = allocateMemory(physicalDevice, device, memoryRequirements, properties, budget, category);
+    } catch (...) {
+        vkDestroyImage(device, allocation.image, HostAllocators::getCallbacks(VK_OBJECT_TYPE_IMAGE));
+        throw;
+    }
+    allocation.size = memoryRequirements.size;
+
+    vkBindImageMemory(device, allocation.image, allocation.memory, 0);
+    return allocation;
+}
+
+void MemorySupports::recordMemoryBarrier(
+    VkCommandBuffer commandBuffer,
+    VkPipelineStageFlags srcStageMask,
+    VkAccessFlags srcAccessMask,
+    VkPipelineStageFlags dstStageMask,
+    VkAccessFlags dstAccessMask
+) {
+    VkMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = srcAccessMask;
+    barrier.dstAccessMask = dstAccessMask;
+
+    vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+void MemorySupports::destroyBuffer(VkDevice device, const BufferAllocation& allocation, MemoryBudget* budget) {
+    vkDestroyBuffer(device, allocation.buffer, HostAllocators::getCallbacks(VK_OBJECT_TYPE_BUFFER));
+    vkFreeMemory(device, allocation.memory, HostAllocators::getCallbacks(VK_OBJECT_TYPE_DEVICE_MEMORY));
+
+    if (budget != nullptr) {
+        budget->onFree(allocation.memory);
+    }
+}
+
+void MemorySupports::destroyImage(VkDevice device, const ImageAllocation& allocation, MemoryBudget* budget) {
+    vkDestroyImage(device, allocation.image, HostAllocators::getCallbacks(VK_OBJECT_TYPE_IMAGE));
+    vkFreeMemory(device, allocation.memory, HostAllocators::getCallbacks(VK_OBJECT_TYPE_DEVICE_MEMORY));
+
+    if (budget != nullptr) {
+        budget->onFree(allocation.memory);
+    }
+}
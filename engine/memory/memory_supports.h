@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include "memory_budget.h"
+
+struct BufferAllocation {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize size = 0;
+};
+
+struct ImageAllocation {
+    VkImage image = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize size = 0;
+};
+
+namespace MemorySupports {
+
+    uint32_t findMemoryType(VkPhysicalDevice physicalDevice, uint32_t memoryTypeBits, VkMemoryPropertyFlags properties);
+
+    VkMemoryAllocateInfo createMemoryAllocateInfo(VkDeviceSize size, uint32_t memoryTypeIndex);
+    // budget 이 있으면 할당과 해제를 category 별로 집계
+    VkDeviceMemory allocateMemory(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        const VkMemoryRequirements& memoryRequirements,
+        VkMemoryPropertyFlags properties,
+        MemoryBudget* budget = nullptr,
+        MemoryCategory category = MemoryCategory::BUFFER
+    );
+
+    // Create Buffer
+    VkBufferCreateInfo createBufferCreateInfo(VkDeviceSize size, VkBufferUsageFlags usage);
+    BufferAllocation createBuffer(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        VkDeviceSize size,
+        VkBufferUsageFlags usage,
+        VkMemoryPropertyFlags properties,
+        MemoryBudget* budget = nullptr,
+        MemoryCategory category = MemoryCategory::BUFFER
+    );
+
+    // Create Image
+    VkImageCreateInfo createImageCreateInfo(VkExtent2D extent, uint32_t mipLevels, VkFormat format, VkImageUsageFlags usage);
+    ImageAllocation createImage(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        const VkImageCreateInfo& imageCreateInfo,
+        VkMemoryPropertyFlags properties,
+        MemoryBudget* budget = nullptr,
+        MemoryCategory category = MemoryCategory::IMAGE
+    );
+
+    // buffer 전체를 대상으로 하는 global memory barrier
+    void recordMemoryBarrier(
+        VkCommandBuffer commandBuffer,
+        VkPipelineStageFlags srcStageMask,
+        VkAccessFlags srcAccessMask,
+        VkPipelineStageFlags dstStageMask,
+        VkAccessFlags dstAccessMask
+    );
+
+    void destroyBuffer(VkDevice device, const BufferAllocation& allocation, MemoryBudget* budget = nullptr);
+    void destroyImage(VkDevice device, const ImageAllocation& allocation, MemoryBudget* budget = nullptr);
+}
@@ -0,0 +1,157 @@
+#include "mesh_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "mesh_cooker.h"
+
+MeshBuffer::MeshBuffer(VkPhysicalDevice physicalDevice, VkDevice device, DeletionQueue& deletionQueue, const AssetPack& assetPack)
+    : m_physicalDevice(physicalDevice), m_device(device), m_deletionQueue(deletionQueue) {
+    // cooked mesh 는 zero-copy 를 위해 비압축으로 패킹되지만 압축된 것도 읽을 수 있게 둠
+    std::vector<std::vector<char>> decompressed;
+    std::vector<CookedMesh> cookedMeshes;
+    uint64_t vertexCount = 0;
+    uint64_t indexCount = 0;
+
+    for (const AssetEntry& entry : assetPack.entries()) {
+        const std::string_view name = assetPack.getName(entry);
+
+        if (!name.ends_with(".mesh")) {
+            continue;
+        }
+        std::span<const char> contents = assetPack.view(entry);
+
+        if (AssetPack::isCompressed(entry)) {
+            contents = decompressed.emplace_back(assetPack.read(entry));
+        }
+        const CookedMesh& mesh = cookedMeshes.emplace_back(MeshCooker::load(contents));
+
+        MeshRange range {};
+        range.name = name;
+        range.vertexOffset = static_cast<int32_t>(vertexCount);
+        range.firstIndex = static_cast<uint32_t>(indexCount);
+        range.indexCount = mesh.lods.front().indexCount;
+        range.boundsMin = { mesh.header->boundsMin[0], mesh.header->boundsMin[1], mesh.header->boundsMin[2] };
+        range.boundsMax = { mesh.header->boundsMax[0], mesh.header->boundsMax[1], mesh.header->boundsMax[2] };
+        range.lods.assign(mesh.lods.begin(), mesh.lods.end());
+        m_meshes.push_back(std::move(range));
+
+        vertexCount += mesh.vertices.size();
+        indexCount += mesh.header->indexCount;
+    }
+    if (vertexCount == 0 || indexCount == 0) {
+        m_meshes.clear();
+        return;
+    }
+    if (vertexCount > INT32_MAX || indexCount > UINT32_MAX) {
+        throw std::runtime_error("cooked meshes are too large for a single mesh buffer!");
+    }
+    m_vertexBytes = vertexCount * sizeof(PackedVertex);
+    m_indexBytes = indexCount * sizeof(uint32_t);
+
+    try {
+        m_staging = MemorySupports::createBuffer(
+            m_physicalDevice,
+            m_device,
+            m_vertexBytes + m_indexBytes,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            m_deletionQueue.getMemoryBudget(),
+            MemoryCategory::TRANSIENT
+        );
+        void* mapped;
+
+        if (vkMapMemory(m_device, m_staging.memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+            throw std::runtime_error("failed to map mesh staging buffer!");
+        }
+        auto* vertices = static_cast<char*>(mapped);
+        auto* indices = reinterpret_cast<uint32_t*>(vertices + m_vertexBytes);
+
+        for (const CookedMesh& mesh : cookedMeshes) {
+            std::memcpy(vertices, mesh.vertices.data(), mesh.vertices.size_bytes());
+            vertices += mesh.vertices.size_bytes();
+
+            // 매핑된 파일 안의 index 는 정렬이 보장되지 않으므로 memcpy 로 읽음
+            for (uint32_t index = 0; index < mesh.header->indexCount; index++) {
+                if (mesh.header->indexSize == sizeof(uint16_t)) {
+                    uint16_t value;
+                    std::memcpy(&value, mesh.indices.data() + size_t { index } * sizeof(uint16_t), sizeof(uint16_t));
+                    *indices++ = value;
+                } else {
+                    std::memcpy(indices++, mesh.indices.data() + size_t { index } * sizeof(uint32_t), sizeof(uint32_t));
+                }
+            }
+        }
+        vkUnmapMemory(m_device, m_staging.memory);
+
+        m_vertexBuffer = MemorySupports::createBuffer(
+            m_physicalDevice,
+            m_device,
+            m_vertexBytes,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            m_deletionQueue.getMemoryBudget()
+        );
+        m_indexBuffer = MemorySupports::createBuffer(
+            m_physicalDevice,
+            m_device,
+            m_indexBytes,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            m_deletionQueue.getMemoryBudget()
+        );
+    } catch (...) {
+        // 소멸자가 호출되지 않으므로 이미 만든 buffer 를 정리
+        destroy();
+        throw;
+    }
+}
+
+MeshBuffer::~MeshBuffer() {
+    destroy();
+}
+
+void MeshBuffer::destroy() {
+    for (BufferAllocation* allocation : { &m_staging, &m_vertexBuffer, &m_indexBuffer }) {
+        m_deletionQueue.retire(allocation->buffer);
+        m_deletionQueue.retire(allocation->memory);
+        *allocation = {};
+    }
+}
+
+const MeshRange* MeshBuffer::find(std::string_view name) const {
+    const auto mesh = std::ranges::find(m_meshes, name, &MeshRange::name);
+    return mesh != m_meshes.end() ? &*mesh : nullptr;
+}
+
+void MeshBuffer::registerLods(OcclusionCuller& culler) {
+    for (MeshRange& mesh : m_meshes) {
+        mesh.lodFirst = culler.addLods(mesh.lods);
+    }
+}
+
+void MeshBuffer::recordUpload(VkCommandBuffer commandBuffer) {
+    if (m_staging.buffer == VK_NULL_HANDLE) {
+        return;
+    }
+    VkBufferCopy copy {};
+    copy.size = m_vertexBytes;
+    vkCmdCopyBuffer(commandBuffer, m_staging.buffer, m_vertexBuffer.buffer, 1, &copy);
+
+    copy.srcOffset = m_vertexBytes;
+    copy.size = m_indexBytes;
+    vkCmdCopyBuffer(commandBuffer, m_staging.buffer, m_indexBuffer.buffer, 1, &copy);
+
+    MemorySupports::recordMemoryBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+        VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT
+    );
+    // 복사가 끝난 뒤 파괴되도록 바로 retire
+    m_deletionQueue.retire(m_staging.buffer);
+    m_deletionQueue.retire(m_staging.memory);
+    m_staging = {};
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan_core.h>
+
+#include "mesh_data.h"
+#include "../asset/asset_pack.h"
+#include "../culling/occlusion_culler.h"
+#include "../memory/memory_supports.h"
+#include "../resource/deletion_queue.h"
+
+// MeshBuffer 안에서 cooked mesh 하나가 차지하는 구간
+struct MeshRange {
+    std::string name;
+    int32_t vertexOffset = 0;
+    // mesh 의 index 시작 위치. LOD 0 은 여기서 시작 (MeshSimplifier)
+    uint32_t firstIndex = 0;
+    // LOD 0 의 index 수
+    uint32_t indexCount = 0;
+    glm::vec3 boundsMin { 0.0f };
+    glm::vec3 boundsMax { 0.0f };
+    // indexOffset 은 firstIndex 기준
+    std::vector<MeshLod> lods;
+    // OcclusionCuller 의 LOD 표에서 lods 의 위치 (MeshBuffer::registerLods)
+    uint32_t lodFirst = 0;
+
+    // instance 하나를 그리는 command. firstInstance 는 instance buffer 의 index
+    [[nodiscard]]
+    VkDrawIndexedIndirectCommand createDrawCommand(uint32_t firstInstance) const {
+        return { indexCount, 1, firstIndex, vertexOffset, firstInstance };
+    }
+
+    // createDrawCommand 와 함께 OcclusionCuller::add 에 넘김. GPU 가 거리에 따라 LOD 를 고름
+    [[nodiscard]]
+    OccluderLod createOccluderLod(float worldScale = 1.0f) const {
+        return { lodFirst, static_cast<uint32_t>(lods.size()), worldScale, 0 };
+    }
+};
+
+// asset pack 의 cooked mesh (.mesh) 를 모두 읽어 device local vertex / index buffer 하나씩에 이어 붙임
+// index 는 mesh 마다 16 / 32bit 가 섞일 수 있어 32bit 로 맞춤. 업로드는 첫 frame 의 command buffer 에서 함
+class MeshBuffer {
+public:
+    MeshBuffer(VkPhysicalDevice physicalDevice, VkDevice device, DeletionQueue& deletionQueue, const AssetPack& assetPack);
+
+    MeshBuffer(const MeshBuffer&) = delete;
+    MeshBuffer& operator=(const MeshBuffer&) = delete;
+
+    ~MeshBuffer();
+
+    // 이름은 asset pack 의 entry 이름. 없으면 nullptr
+    [[nodiscard]]
+    const MeshRange* find(std::string_view name) const;
+
+    [[nodiscard]]
+    std::span<const MeshRange> getMeshes() const {
+        return m_meshes;
+    }
+
+    [[nodiscard]]
+    bool empty() const {
+        return m_meshes.empty();
+    }
+
+    [[nodiscard]]
+    VkBuffer getVertexBuffer() const {
+        return m_vertexBuffer.buffer;
+    }
+
+    [[nodiscard]]
+    VkBuffer getIndexBuffer() const {
+        return m_indexBuffer.buffer;
+    }
+
+    // 모든 mesh 의 LOD 표를 culler 에 추가하고 lodFirst 를 갱신. culler 를 clear 한 뒤에는 다시 호출
+    void registerLods(OcclusionCuller& culler);
+
+    // render pass 밖에서 기록. 아직 올리지 않은 내용이 있으면 복사하고 staging 을 retire
+    void recordUpload(VkCommandBuffer commandBuffer);
+
+private:
+    void destroy();
+
+    VkPhysicalDevice            m_physicalDevice;
+    VkDevice                    m_device;
+    DeletionQueue&              m_deletionQueue;
+
+    std::vector<MeshRange>      m_meshes;
+    BufferAllocation            m_vertexBuffer;
+    BufferAllocation            m_indexBuffer;
+    VkDeviceSize                m_vertexBytes = 0;
+    VkDeviceSize                m_indexBytes = 0;
+    // [vertices | indices]. recordUpload 전까지만 유지
+    BufferAllocation            m_staging;
+};
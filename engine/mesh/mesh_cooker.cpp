@@ -0,0 +1,152 @@
+#include "mesh_cooker.h"
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <glm/gtc/packing.hpp>
+
+#include "mesh_importer.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplifier.h"
+#include "../util/alignment.h"
+
+namespace {
+    // 단위 벡터를 팔면체에 투영한 뒤 [-1, 1]^2 로 펼침
+    glm::vec2 encodeOctahedral(const glm::vec3& normal) {
+        const float sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+        glm::vec2 encoded = sum > 0.0f ? glm::vec2 { normal.x, normal.y } / sum : glm::vec2 { 0.0f };
+
+        if (normal.z < 0.0f) {
+            const float signX = encoded.x >= 0.0f ? 1.0f : -1.0f;
+            const float signY = encoded.y >= 0.0f ? 1.0f : -1.0f;
+            encoded = { (1.0f - std::abs(encoded.y)) * signX, (1.0f - std::abs(encoded.x)) * signY };
+        }
+        return encoded;
+    }
+}
+
+PackedVertex MeshCooker::packVertex(const MeshVertex& vertex) {
+    const glm::vec2 octahedral = encodeOctahedral(vertex.normal);
+
+    PackedVertex packedVertex {};
+    packedVertex.position[0] = glm::packHalf1x16(vertex.position.x);
+    packedVertex.position[1] = glm::packHalf1x16(vertex.position.y);
+    packedVertex.position[2] = glm::packHalf1x16(vertex.position.z);
+    packedVertex.position[3] = glm::packHalf1x16(1.0f);
+    packedVertex.normal[0] = static_cast<int16_t>(glm::packSnorm1x16(octahedral.x));
+    packedVertex.normal[1] = static_cast<int16_t>(glm::packSnorm1x16(octahedral.y));
+    packedVertex.uv[0] = glm::packHalf1x16(vertex.uv.x);
+    packedVertex.uv[1] = glm::packHalf1x16(vertex.uv.y);
+
+    return packedVertex;
+}
+
+std::vector<char> MeshCooker::cook(const MeshData& mesh) {
+    using namespace MeshFormat;
+
+    const std::vector<MeshLod> lods = mesh.lods.empty()
+        ? std::vector<MeshLod> { { 0, static_cast<uint32_t>(mesh.indices.size()), 0.0f } }
+        : mesh.lods;
+
+    if (lods.size() > MAX_LODS) {
+        throw std::runtime_error("Too many mesh LODs");
+    }
+    Header header {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    header.vertexStride = sizeof(PackedVertex);
+    header.indexSize = mesh.vertices.size() <= UINT16_MAX ? sizeof(uint16_t) : sizeof(uint32_t);
+
+    glm::vec3 boundsMin { mesh.vertices.empty() ? 0.0f : INFINITY };
+    glm::vec3 boundsMax { mesh.vertices.empty() ? 0.0f : -INFINITY };
+
+    for (const MeshVertex& vertex : mesh.vertices) {
+        boundsMin = glm::min(boundsMin, vertex.position);
+        boundsMax = glm::max(boundsMax, vertex.position);
+    }
+    const glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+    float radius = 0.0f;
+
+    for (const MeshVertex& vertex : mesh.vertices) {
+        radius = std::max(radius, glm::distance(center, vertex.position));
+    }
+    for (int axis = 0; axis < 3; axis++) {
+        header.boundsMin[axis] = boundsMin[axis];
+        header.boundsMax[axis] = boundsMax[axis];
+        header.boundingSphere[axis] = center[axis];
+    }
+    header.boundingSphere[3] = radius;
+
+    header.lodCount = static_cast<uint32_t>(lods.size());
+    header.lodOffset = Alignments::alignUp(sizeof(Header), SECTION_ALIGNMENT);
+    header.vertexOffset = Alignments::alignUp(header.lodOffset + lods.size() * sizeof(MeshLod), SECTION_ALIGNMENT);
+    header.indexOffset = Alignments::alignUp(header.vertexOffset + uint64_t { header.vertexCount } * header.vertexStride, SECTION_ALIGNMENT);
+    header.fileSize = header.indexOffset + uint64_t { header.indexCount } * header.indexSize;
+
+    std::vector<char> contents(header.fileSize, 0);
+    std::memcpy(contents.data(), &header, sizeof(header));
+    std::memcpy(contents.data() + header.lodOffset, lods.data(), lods.size() * sizeof(MeshLod));
+
+    auto* vertices = reinterpret_cast<PackedVertex*>(contents.data() + header.vertexOffset);
+
+    for (size_t vertex = 0; vertex < mesh.vertices.size(); vertex++) {
+        vertices[vertex] = packVertex(mesh.vertices[vertex]);
+    }
+    char* indices = contents.data() + header.indexOffset;
+
+    for (size_t index = 0; index < mesh.indices.size(); index++) {
+        if (header.indexSize == sizeof(uint16_t)) {
+            const auto value = static_cast<uint16_t>(mesh.indices[index]);
+            std::memcpy(indices + index * sizeof(uint16_t), &value, sizeof(value));
+        } else {
+            std::memcpy(indices + index * sizeof(uint32_t), &mesh.indices[index], sizeof(uint32_t));
+        }
+    }
+    return contents;
+}
+
+CookedMesh MeshCooker::load(std::span<const char> contents) {
+    using namespace MeshFormat;
+
+    if (contents.size() < sizeof(Header)) {
+        throw std::runtime_error("Invalid cooked mesh");
+    }
+    const auto* header = reinterpret_cast<const Header*>(contents.data());
+
+    if (header->magic != MAGIC || header->version != VERSION || header->vertexStride != sizeof(PackedVertex)) {
+        throw std::runtime_error("Invalid cooked mesh header");
+    }
+    if ((header->indexSize != sizeof(uint16_t) && header->indexSize != sizeof(uint32_t))
+        || header->fileSize != contents.size()
+        || header->vertexOffset + uint64_t { header->vertexCount } * header->vertexStride > contents.size()
+        || header->indexOffset + uint64_t { header->indexCount } * header->indexSize > contents.size()
+        || header->lodCount == 0 || header->lodCount > MAX_LODS
+        || header->lodOffset + uint64_t { header->lodCount } * sizeof(MeshLod) > contents.size()) {
+        throw std::runtime_error("Corrupted cooked mesh");
+    }
+    const std::span<const MeshLod> lods { reinterpret_cast<const MeshLod*>(contents.data() + header->lodOffset), header->lodCount };
+
+    for (const MeshLod& lod : lods) {
+        if (uint64_t { lod.indexOffset } + lod.indexCount > header->indexCount) {
+            throw std::runtime_error("Corrupted cooked mesh LOD");
+        }
+    }
+    return {
+        header,
+        { reinterpret_cast<const PackedVertex*>(contents.data() + header->vertexOffset), header->vertexCount },
+        contents.subspan(header->indexOffset, uint64_t { header->indexCount } * header->indexSize),
+        lods,
+    };
+}
+
+std::vector<char> MeshCooker::cookFile(const BinaryFile& binaryFile) {
+    if (binaryFile.fileName.ends_with(".mesh")) {
+        return binaryFile.contents;
+    }
+    MeshData mesh = MeshImporter::import(binaryFile);
+    MeshOptimizer::optimize(mesh);
+    MeshSimplifier::generateLods(mesh);
+    return cook(mesh);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "mesh_data.h"
+#include "../util/binary_file_utils.h"
+
+// 파일 레이아웃: Header | MeshLod[lodCount] | PackedVertex[vertexCount] | index[indexCount] (uint16 또는 uint32)
+// 한 번의 read (또는 asset pack 의 매핑) 로 바로 GPU 업로드 가능한 형태
+// 모든 LOD 가 vertex 를 공유하고 index 구간만 다름 (indexCount 는 모든 LOD 의 합)
+namespace MeshFormat {
+
+    // "EMSH"
+    constexpr uint32_t MAGIC = 0x48534D45;
+    constexpr uint32_t VERSION = 2;
+    constexpr uint64_t SECTION_ALIGNMENT = 16;
+    constexpr uint32_t MAX_LODS = 8;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t vertexStride;
+        uint32_t indexSize;
+        float boundsMin[3];
+        float boundsMax[3];
+        // 중심 xyz, 반지름 w
+        float boundingSphere[4];
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        uint64_t fileSize;
+        // 1 이상. LOD 0 이 원본
+        uint32_t lodCount;
+        uint32_t reserved;
+        uint64_t lodOffset;
+    };
+
+    static_assert(sizeof(Header) == 104);
+}
+
+// 매핑된 cooked mesh 를 가리키는 view (복사 없음)
+struct CookedMesh {
+    const MeshFormat::Header* header = nullptr;
+    std::span<const PackedVertex> vertices;
+    // indexSize 에 따라 uint16_t 또는 uint32_t 배열
+    std::span<const char> indices;
+    // 오차가 커지는 순서. indexOffset 은 indices 의 요소 단위
+    std::span<const MeshLod> lods;
+};
+
+namespace MeshCooker {
+
+    PackedVertex packVertex(const MeshVertex& vertex);
+
+    // 65536 개 미만이면 16bit index 사용. mesh.lods 가 비어 있으면 LOD 하나로 기록
+    std::vector<char> cook(const MeshData& mesh);
+
+    // 유효하지 않으면 예외
+    CookedMesh load(std::span<const char> contents);
+
+    // .mesh 면 그대로, 아니면 import + 최적화 + LOD 생성 후 cook (런타임 import 용)
+    std::vector<char> cookFile(const BinaryFile& binaryFile);
+}
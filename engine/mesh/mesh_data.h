@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// import 직후의 full precision vertex
+struct MeshVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 uv;
+};
+
+// 같은 vertex 를 공유하는 LOD 하나의 index 구간
+struct MeshLod {
+    uint32_t indexOffset;
+    uint32_t indexCount;
+    // 원본 대비 object space 기하 오차 (LOD 0 은 0)
+    float error;
+};
+
+static_assert(sizeof(MeshLod) == 12);
+
+struct MeshData {
+    std::vector<MeshVertex> vertices;
+    // LOD 가 있으면 모든 LOD 의 index 를 이어 붙인 배열
+    std::vector<uint32_t> indices;
+    // 비어 있으면 indices 전체가 LOD 0
+    std::vector<MeshLod> lods;
+};
+
+// cooked mesh 의 16byte vertex
+// position: half xyz (w 는 1.0), normal: octahedral snorm16, uv: half
+struct PackedVertex {
+    uint16_t position[4];
+    int16_t normal[2];
+    uint16_t uv[2];
+};
+
+static_assert(sizeof(PackedVertex) == 16);
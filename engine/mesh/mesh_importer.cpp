@@ -0,0 +1,400 @@
+#include "mesh_importer.h"
+
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "mesh_optimizer.h"
+#include "../util/json.h"
+
+namespace {
+    // glTF componentType
+    constexpr uint32_t COMPONENT_UNSIGNED_BYTE = 5121;
+    constexpr uint32_t COMPONENT_UNSIGNED_SHORT = 5123;
+    constexpr uint32_t COMPONENT_UNSIGNED_INT = 5125;
+    constexpr uint32_t COMPONENT_FLOAT = 5126;
+    constexpr uint32_t MODE_TRIANGLES = 4;
+
+    constexpr uint32_t GLB_MAGIC = 0x46546C67;
+    constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+    constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;
+
+    // 정점이 모두 모인 뒤 중복 제거, normal 이 없는 vertex (0 으로 둠) 만 생성
+    MeshData finishImport(MeshData mesh, bool hasNormals) {
+        MeshOptimizer::deduplicate(mesh);
+
+        if (!hasNormals) {
+            MeshOptimizer::generateNormals(mesh, true);
+        }
+        return mesh;
+    }
+
+    float parseFloat(std::string_view token) {
+        float value = 0.0f;
+        std::from_chars(token.data(), token.data() + token.size(), value);
+        return value;
+    }
+
+    // OBJ 인덱스는 1부터, 음수면 끝에서부터
+    int64_t resolveObjIndex(std::string_view token, size_t count) {
+        if (token.empty()) {
+            return -1;
+        }
+        int64_t index = 0;
+        std::from_chars(token.data(), token.data() + token.size(), index);
+
+        const int64_t resolved = index < 0 ? static_cast<int64_t>(count) + index : index - 1;
+
+        if (resolved < 0 || resolved >= static_cast<int64_t>(count)) {
+            throw std::runtime_error("OBJ index out of range");
+        }
+        return resolved;
+    }
+
+    std::vector<std::string_view> splitTokens(std::string_view line) {
+        std::vector<std::string_view> tokens {};
+        size_t position = 0;
+
+        while (position < line.size()) {
+            while (position < line.size() && (line[position] == ' ' || line[position] == '\t')) {
+                position++;
+            }
+            const size_t begin = position;
+
+            while (position < line.size() && line[position] != ' ' && line[position] != '\t') {
+                position++;
+            }
+            if (position > begin) {
+                tokens.push_back(line.substr(begin, position - begin));
+            }
+        }
+        return tokens;
+    }
+
+    std::vector<char> decodeBase64(std::string_view text) {
+        auto decodeCharacter = [](char character) -> int32_t {
+            if (character >= 'A' && character <= 'Z') return character - 'A';
+            if (character >= 'a' && character <= 'z') return character - 'a' + 26;
+            if (character >= '0' && character <= '9') return character - '0' + 52;
+            if (character == '+') return 62;
+            if (character == '/') return 63;
+            return -1;
+        };
+        std::vector<char> bytes {};
+        bytes.reserve(text.size() / 4 * 3);
+
+        uint32_t buffer = 0;
+        int32_t bitCount = 0;
+
+        for (const char character : text) {
+            const int32_t value = decodeCharacter(character);
+
+            if (value < 0) {
+                continue;
+            }
+            buffer = buffer << 6 | static_cast<uint32_t>(value);
+            bitCount += 6;
+
+            if (bitCount >= 8) {
+                bitCount -= 8;
+                bytes.push_back(static_cast<char>(buffer >> bitCount & 0xFF));
+            }
+        }
+        return bytes;
+    }
+
+    class GltfReader {
+    public:
+        GltfReader(const JsonValue& document, std::vector<std::vector<char>> buffers)
+            : m_document(document), m_buffers(std::move(buffers)) {}
+
+        // float 성분 accessor 를 componentCount 개씩 읽음
+        std::vector<float> readFloats(uint32_t accessorIndex, uint32_t componentCount) const {
+            const JsonValue& accessor = getAccessor(accessorIndex);
+
+            if (static_cast<uint32_t>(accessor.getNumber("componentType", 0)) != COMPONENT_FLOAT) {
+                throw std::runtime_error("glTF attribute must be float");
+            }
+            const auto count = static_cast<size_t>(accessor.getNumber("count", 0));
+            std::vector<float> values(count * componentCount);
+
+            forEachElement(accessor, componentCount * sizeof(float), [&](size_t element, const char* source) {
+                std::memcpy(&values[element * componentCount], source, componentCount * sizeof(float));
+            });
+            return values;
+        }
+
+        std::vector<uint32_t> readIndices(uint32_t accessorIndex) const {
+            const JsonValue& accessor = getAccessor(accessorIndex);
+            const auto componentType = static_cast<uint32_t>(accessor.getNumber("componentType", 0));
+            const auto count = static_cast<size_t>(accessor.getNumber("count", 0));
+
+            size_t componentSize;
+
+            switch (componentType) {
+                case COMPONENT_UNSIGNED_BYTE: componentSize = 1; break;
+                case COMPONENT_UNSIGNED_SHORT: componentSize = 2; break;
+                case COMPONENT_UNSIGNED_INT: componentSize = 4; break;
+                default: throw std::runtime_error("Unsupported glTF index type");
+            }
+            std::vector<uint32_t> indices(count);
+
+            forEachElement(accessor, componentSize, [&](size_t element, const char* source) {
+                uint32_t index = 0;
+                std::memcpy(&index, source, componentSize);
+                indices[element] = index;
+            });
+            return indices;
+        }
+
+    private:
+        const JsonValue& getAccessor(uint32_t accessorIndex) const {
+            const JsonValue* accessors = m_document.find("accessors");
+
+            if (!accessors || accessorIndex >= accessors->array.size()) {
+                throw std::runtime_error("glTF accessor out of range");
+            }
+            return accessors->array[accessorIndex];
+        }
+
+        template<typename Function>
+        void forEachElement(const JsonValue& accessor, size_t elementSize, Function&& function) const {
+            const JsonValue* bufferViews = m_document.find("bufferViews");
+            const JsonValue* bufferViewIndex = accessor.find("bufferView");
+
+            // sparse / bufferView 없는 accessor 는 0 으로 남김
+            if (!bufferViews || !bufferViewIndex || !bufferViewIndex->isNumber()) {
+                return;
+            }
+            const JsonValue& bufferView = bufferViews->array.at(static_cast<size_t>(bufferViewIndex->number));
+            const std::vector<char>& buffer = m_buffers.at(static_cast<size_t>(bufferView.getNumber("buffer", 0)));
+
+            const auto count = static_cast<size_t>(accessor.getNumber("count", 0));
+            const auto offset = static_cast<size_t>(bufferView.getNumber("byteOffset", 0) + accessor.getNumber("byteOffset", 0));
+            const auto stride = static_cast<size_t>(bufferView.getNumber("byteStride", static_cast<double>(elementSize)));
+
+            if (count > 0 && offset + (count - 1) * stride + elementSize > buffer.size()) {
+                throw std::runtime_error("glTF accessor exceeds buffer");
+            }
+            for (size_t element = 0; element < count; element++) {
+                function(element, buffer.data() + offset + element * stride);
+            }
+        }
+
+        const JsonValue& m_document;
+        std::vector<std::vector<char>> m_buffers;
+    };
+}
+
+MeshData MeshImporter::import(const BinaryFile& binaryFile, const BufferLoader& bufferLoader) {
+    const std::string& fileName = binaryFile.fileName;
+
+    if (fileName.ends_with(".obj")) {
+        return importObj(binaryFile);
+    }
+    if (fileName.ends_with(".gltf") || fileName.ends_with(".glb")) {
+        return importGltf(binaryFile, bufferLoader);
+    }
+    throw std::runtime_error("Mesh format not supported: " + fileName);
+}
+
+MeshData MeshImporter::importObj(const BinaryFile& binaryFile) {
+    const std::string_view text { binaryFile.data(), binaryFile.size() };
+
+    std::vector<glm::vec3> positions {};
+    std::vector<glm::vec3> normals {};
+    std::vector<glm::vec2> uvs {};
+
+    MeshData mesh {};
+    bool hasNormals = true;
+
+    size_t lineBegin = 0;
+
+    while (lineBegin < text.size()) {
+        size_t lineEnd = text.find('\n', lineBegin);
+        lineEnd = lineEnd == std::string_view::npos ? text.size() : lineEnd;
+
+        std::string_view line = text.substr(lineBegin, lineEnd - lineBegin);
+        lineBegin = lineEnd + 1;
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        const std::vector<std::string_view> tokens = splitTokens(line);
+
+        if (tokens.empty()) {
+            continue;
+        }
+        const std::string_view keyword = tokens[0];
+
+        if (keyword == "v" && tokens.size() >= 4) {
+            positions.push_back({ parseFloat(tokens[1]), parseFloat(tokens[2]), parseFloat(tokens[3]) });
+        } else if (keyword == "vn" && tokens.size() >= 4) {
+            normals.push_back({ parseFloat(tokens[1]), parseFloat(tokens[2]), parseFloat(tokens[3]) });
+        } else if (keyword == "vt" && tokens.size() >= 3) {
+            // OBJ 는 좌하단 원점, Vulkan 은 좌상단
+            uvs.push_back({ parseFloat(tokens[1]), 1.0f - parseFloat(tokens[2]) });
+        } else if (keyword == "f" && tokens.size() >= 4) {
+            std::vector<MeshVertex> polygon {};
+
+            for (size_t token = 1; token < tokens.size(); token++) {
+                // v, v/vt, v//vn, v/vt/vn
+                const std::string_view corner = tokens[token];
+                const size_t firstSlash = corner.find('/');
+                const size_t secondSlash = firstSlash == std::string_view::npos ? firstSlash : corner.find('/', firstSlash + 1);
+
+                const std::string_view positionToken = corner.substr(0, firstSlash);
+                const std::string_view uvToken = firstSlash == std::string_view::npos
+                    ? std::string_view {}
+                    : corner.substr(firstSlash + 1, secondSlash == std::string_view::npos ? std::string_view::npos : secondSlash - firstSlash - 1);
+                const std::string_view normalToken = secondSlash == std::string_view::npos ? std::string_view {} : corner.substr(secondSlash + 1);
+
+                if (positionToken.empty()) {
+                    throw std::runtime_error("OBJ face without position index");
+                }
+                const int64_t positionIndex = resolveObjIndex(positionToken, positions.size());
+                const int64_t uvIndex = resolveObjIndex(uvToken, uvs.size());
+                const int64_t normalIndex = resolveObjIndex(normalToken, normals.size());
+
+                hasNormals &= normalIndex >= 0;
+
+                polygon.push_back({
+                    positions[positionIndex],
+                    normalIndex >= 0 ? normals[normalIndex] : glm::vec3 { 0.0f },
+                    uvIndex >= 0 ? uvs[uvIndex] : glm::vec2 { 0.0f },
+                });
+            }
+            for (size_t corner = 1; corner + 1 < polygon.size(); corner++) {
+                mesh.vertices.push_back(polygon[0]);
+                mesh.vertices.push_back(polygon[corner]);
+                mesh.vertices.push_back(polygon[corner + 1]);
+            }
+        }
+    }
+    return finishImport(std::move(mesh), hasNormals);
+}
+
+MeshData MeshImporter::importGltf(const BinaryFile& binaryFile, const BufferLoader& bufferLoader) {
+    std::string_view jsonText { binaryFile.data(), binaryFile.size() };
+    std::vector<char> binaryChunk {};
+
+    uint32_t magic = 0;
+
+    if (binaryFile.size() >= 12) {
+        std::memcpy(&magic, binaryFile.data(), sizeof(magic));
+    }
+    if (magic == GLB_MAGIC) {
+        // header (12) 이후 [length, type, data] chunk 반복
+        size_t offset = 12;
+        jsonText = {};
+
+        while (offset + 8 <= binaryFile.size()) {
+            uint32_t chunkLength;
+            uint32_t chunkType;
+            std::memcpy(&chunkLength, binaryFile.data() + offset, sizeof(chunkLength));
+            std::memcpy(&chunkType, binaryFile.data() + offset + 4, sizeof(chunkType));
+            offset += 8;
+
+            if (offset + chunkLength > binaryFile.size()) {
+                throw std::runtime_error("Corrupted GLB: " + binaryFile.fileName);
+            }
+            if (chunkType == GLB_CHUNK_JSON) {
+                jsonText = { binaryFile.data() + offset, chunkLength };
+            } else if (chunkType == GLB_CHUNK_BIN) {
+                binaryChunk.assign(binaryFile.data() + offset, binaryFile.data() + offset + chunkLength);
+            }
+            offset += chunkLength;
+        }
+    }
+    const JsonValue document = Json::parse(jsonText);
+
+    std::vector<std::vector<char>> buffers {};
+
+    if (const JsonValue* bufferArray = document.find("buffers")) {
+        for (const JsonValue& buffer : bufferArray->array) {
+            const std::string_view uri = buffer.getString("uri");
+
+            if (uri.empty()) {
+                buffers.push_back(std::move(binaryChunk));
+            } else if (uri.starts_with("data:")) {
+                buffers.push_back(decodeBase64(uri.substr(uri.find(',') + 1)));
+            } else if (bufferLoader) {
+                buffers.push_back(bufferLoader(uri));
+            } else {
+                throw std::runtime_error("External glTF buffer not supported: " + std::string { uri });
+            }
+        }
+    }
+    const GltfReader reader { document, std::move(buffers) };
+
+    MeshData mesh {};
+    bool hasNormals = true;
+
+    const JsonValue* meshes = document.find("meshes");
+
+    if (!meshes) {
+        return mesh;
+    }
+    for (const JsonValue& gltfMesh : meshes->array) {
+        const JsonValue* primitives = gltfMesh.find("primitives");
+
+        if (!primitives) {
+            continue;
+        }
+        for (const JsonValue& primitive : primitives->array) {
+            const JsonValue* attributes = primitive.find("attributes");
+
+            if (!attributes || static_cast<uint32_t>(primitive.getNumber("mode", MODE_TRIANGLES)) != MODE_TRIANGLES) {
+                continue;
+            }
+            const JsonValue* positionAccessor = attributes->find("POSITION");
+
+            if (!positionAccessor) {
+                continue;
+            }
+            const std::vector<float> positions = reader.readFloats(static_cast<uint32_t>(positionAccessor->number), 3);
+            const size_t vertexCount = positions.size() / 3;
+
+            std::vector<float> normals {};
+            std::vector<float> uvs {};
+
+            if (const JsonValue* normalAccessor = attributes->find("NORMAL")) {
+                normals = reader.readFloats(static_cast<uint32_t>(normalAccessor->number), 3);
+            }
+            if (const JsonValue* uvAccessor = attributes->find("TEXCOORD_0")) {
+                uvs = reader.readFloats(static_cast<uint32_t>(uvAccessor->number), 2);
+            }
+            hasNormals &= normals.size() == vertexCount * 3;
+
+            const auto baseVertex = static_cast<uint32_t>(mesh.vertices.size());
+
+            for (size_t vertex = 0; vertex < vertexCount; vertex++) {
+                MeshVertex meshVertex {};
+                meshVertex.position = { positions[vertex * 3], positions[vertex * 3 + 1], positions[vertex * 3 + 2] };
+
+                if (normals.size() == vertexCount * 3) {
+                    meshVertex.normal = { normals[vertex * 3], normals[vertex * 3 + 1], normals[vertex * 3 + 2] };
+                }
+                if (uvs.size() == vertexCount * 2) {
+                    meshVertex.uv = { uvs[vertex * 2], uvs[vertex * 2 + 1] };
+                }
+                mesh.vertices.push_back(meshVertex);
+            }
+
+            if (const JsonValue* indexAccessor = primitive.find("indices")) {
+                for (const uint32_t index : reader.readIndices(static_cast<uint32_t>(indexAccessor->number))) {
+                    if (index >= vertexCount) {
+                        throw std::runtime_error("glTF index out of range");
+                    }
+                    mesh.indices.push_back(baseVertex + index);
+                }
+            } else {
+                for (uint32_t index = 0; index < vertexCount; index++) {
+                    mesh.indices.push_back(baseVertex + index);
+                }
+            }
+        }
+    }
+    return finishImport(std::move(mesh), hasNormals);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#include "mesh_data.h"
+#include "../util/binary_file_utils.h"
+
+namespace MeshImporter {
+
+    // glTF 의 외부 buffer uri 를 읽는 함수 (없으면 data uri / GLB buffer 만 지원)
+    using BufferLoader = std::function<std::vector<char>(std::string_view uri)>;
+
+    // 확장자로 포맷 판별. 결과는 중복 제거된 indexed triangle list
+    MeshData import(const BinaryFile& binaryFile, const BufferLoader& bufferLoader = {});
+
+    // v / vt / vn / f 만 사용, 다각형은 fan 으로 분할
+    MeshData importObj(const BinaryFile& binaryFile);
+
+    // .gltf (JSON) / .glb. 모든 mesh 의 triangle primitive 를 하나로 합침 (node transform 은 무시)
+    MeshData importGltf(const BinaryFile& binaryFile, const BufferLoader& bufferLoader = {});
+}
@@ -0,0 +1,22 @@
+#include "mesh_lod.h"
+
+float MeshLods::getLodScale(const glm::mat4& projection, float viewportHeight, float pixelErrorThreshold) {
+    // projection[1][1] = 1 / tan(fovY / 2). 화면 높이의 절반이 NDC 1 에 대응
+    return projection[1][1] * viewportHeight * 0.5f / pixelErrorThreshold;
+}
+
+uint32_t MeshLods::selectLod(std::span<const MeshLod> lods, float distance, float lodScale) {
+    if (lodScale <= 0.0f) {
+        return 0;
+    }
+    uint32_t selected = 0;
+
+    // 오차는 LOD 순서대로 커지므로 처음 넘는 곳에서 멈춤
+    for (uint32_t lod = 1; lod < lods.size(); lod++) {
+        if (lods[lod].error * lodScale > distance) {
+            break;
+        }
+        selected = lod;
+    }
+    return selected;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <glm/glm.hpp>
+
+#include "mesh_data.h"
+
+// 화면에 투영한 기하 오차로 LOD 를 고름 (occlusion_cull.comp 와 같은 식)
+namespace MeshLods {
+
+    // 거리 1 에서 object space 길이 1 이 차지하는 pixel 수를 허용 pixel 오차로 나눈 값
+    float getLodScale(const glm::mat4& projection, float viewportHeight, float pixelErrorThreshold = 1.0f);
+
+    // error * lodScale <= distance 인 가장 거친 LOD. lodScale 이 0 이하면 LOD 0
+    // distance: camera 에서 bounding sphere 표면까지 거리를 객체의 world scale 로 나눈 값
+    uint32_t selectLod(std::span<const MeshLod> lods, float distance, float lodScale);
+}
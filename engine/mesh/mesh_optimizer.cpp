@@ -0,0 +1,418 @@
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+    // Forsyth 점수 파라미터
+    constexpr uint32_t CACHE_SIZE = 32;
+    constexpr float CACHE_DECAY_POWER = 1.5f;
+    constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+    constexpr float VALENCE_BOOST_SCALE = 2.0f;
+    constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+    // overdraw cluster 분할에 사용하는 FIFO cache
+    constexpr uint32_t OVERDRAW_CACHE_SIZE = 16;
+
+    float getVertexScore(int32_t cachePosition, uint32_t remainingValence) {
+        if (remainingValence == 0) {
+            return -1.0f;
+        }
+        float score = 0.0f;
+
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                // 방금 쓴 triangle 의 vertex 는 같은 점수로 고정 (strip 방향 편향 방지)
+                score = LAST_TRIANGLE_SCORE;
+            } else {
+                const float scaler = 1.0f / (CACHE_SIZE - 3);
+                score = std::pow(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+            }
+        }
+        return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingValence), -VALENCE_BOOST_POWER);
+    }
+
+    struct VertexBits {
+        MeshVertex vertex;
+
+        bool operator==(const VertexBits& other) const {
+            return std::memcmp(&vertex, &other.vertex, sizeof(MeshVertex)) == 0;
+        }
+    };
+
+    struct VertexBitsHash {
+        size_t operator()(const VertexBits& bits) const {
+            return std::hash<std::string_view> {}({ reinterpret_cast<const char*>(&bits.vertex), sizeof(MeshVertex) });
+        }
+    };
+
+    struct PositionHash {
+        size_t operator()(const glm::vec3& position) const {
+            return std::hash<std::string_view> {}({ reinterpret_cast<const char*>(&position), sizeof(glm::vec3) });
+        }
+    };
+
+    // FIFO cache 에서 새로 변환해야 하는 vertex 수
+    uint32_t simulateMisses(
+        std::span<const uint32_t> triangle,
+        std::vector<uint32_t>& timestamps,
+        uint32_t& time,
+        uint32_t cacheSize
+    ) {
+        uint32_t misses = 0;
+
+        for (const uint32_t index : triangle) {
+            if (time - timestamps[index] > cacheSize) {
+                timestamps[index] = time++;
+                misses++;
+            }
+        }
+        return misses;
+    }
+}
+
+void MeshOptimizer::deduplicate(MeshData& mesh) {
+    std::vector<uint32_t> sourceIndices = std::move(mesh.indices);
+
+    if (sourceIndices.empty()) {
+        sourceIndices.resize(mesh.vertices.size());
+        std::iota(sourceIndices.begin(), sourceIndices.end(), 0u);
+    }
+    std::unordered_map<VertexBits, uint32_t, VertexBitsHash> uniqueVertices {};
+    std::vector<MeshVertex> vertices {};
+
+    uniqueVertices.reserve(mesh.vertices.size());
+    mesh.indices.reserve(sourceIndices.size());
+
+    for (const uint32_t sourceIndex : sourceIndices) {
+        const MeshVertex& vertex = mesh.vertices[sourceIndex];
+        const auto [entry, isInserted] = uniqueVertices.try_emplace({ vertex }, static_cast<uint32_t>(vertices.size()));
+
+        if (isInserted) {
+            vertices.push_back(vertex);
+        }
+        mesh.indices.push_back(entry->second);
+    }
+    mesh.vertices = std::move(vertices);
+}
+
+void MeshOptimizer::generateNormals(MeshData& mesh, bool onlyMissing) {
+    std::unordered_map<glm::vec3, glm::vec3, PositionHash> normals {};
+
+    for (size_t index = 0; index + 2 < mesh.indices.size(); index += 3) {
+        const glm::vec3& p0 = mesh.vertices[mesh.indices[index]].position;
+        const glm::vec3& p1 = mesh.vertices[mesh.indices[index + 1]].position;
+        const glm::vec3& p2 = mesh.vertices[mesh.indices[index + 2]].position;
+        // 정규화하지 않은 cross 의 길이가 면적에 비례
+        const glm::vec3 faceNormal = glm::cross(p1 - p0, p2 - p0);
+
+        normals[p0] += faceNormal;
+        normals[p1] += faceNormal;
+        normals[p2] += faceNormal;
+    }
+    for (MeshVertex& vertex : mesh.vertices) {
+        if (onlyMissing && vertex.normal != glm::vec3 { 0.0f }) {
+            continue;
+        }
+        const glm::vec3 normal = normals[vertex.position];
+        const float length = glm::length(normal);
+        vertex.normal = length > 0.0f ? normal / length : glm::vec3 { 0.0f, 0.0f, 1.0f };
+    }
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    const size_t triangleCount = indices.size() / 3;
+
+    if (triangleCount == 0) {
+        return;
+    }
+    // vertex -> triangle 인접 리스트 (CSR)
+    std::vector<uint32_t> valences(vertexCount, 0);
+
+    for (const uint32_t index : indices) {
+        valences[index]++;
+    }
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    std::inclusive_scan(valences.begin(), valences.end(), adjacencyOffsets.begin() + 1);
+
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fillCounts(vertexCount, 0);
+
+    for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+        for (uint32_t corner = 0; corner < 3; corner++) {
+            const uint32_t vertex = indices[triangle * 3 + corner];
+            adjacency[adjacencyOffsets[vertex] + fillCounts[vertex]++] = triangle;
+        }
+    }
+
+    std::vector<int32_t> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+
+    for (size_t vertex = 0; vertex < vertexCount; vertex++) {
+        vertexScores[vertex] = getVertexScore(-1, valences[vertex]);
+    }
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> isEmitted(triangleCount, false);
+
+    for (size_t triangle = 0; triangle < triangleCount; triangle++) {
+        triangleScores[triangle] = vertexScores[indices[triangle * 3]]
+            + vertexScores[indices[triangle * 3 + 1]]
+            + vertexScores[indices[triangle * 3 + 2]];
+    }
+
+    // 새 triangle 3 개의 vertex 가 잠시 더 들어갈 공간
+    uint32_t cache[CACHE_SIZE + 3];
+    uint32_t cacheCount = 0;
+
+    std::vector<uint32_t> result {};
+    result.reserve(indices.size());
+
+    size_t nextUnemitted = 0;
+    int64_t bestTriangle = -1;
+
+    for (size_t emitted = 0; emitted < triangleCount; emitted++) {
+        if (bestTriangle < 0) {
+            // cache 주변에 후보가 없으면 아직 그리지 않은 triangle 중 최고 점수를 찾음
+            float bestScore = -1.0f;
+
+            for (size_t triangle = nextUnemitted; triangle < triangleCount; triangle++) {
+                if (!isEmitted[triangle] && triangleScores[triangle] > bestScore) {
+                    bestScore = triangleScores[triangle];
+                    bestTriangle = static_cast<int64_t>(triangle);
+                }
+            }
+        }
+        const auto triangle = static_cast<uint32_t>(bestTriangle);
+        const uint32_t* corners = &indices[triangle * 3];
+        isEmitted[triangle] = true;
+        result.insert(result.end(), corners, corners + 3);
+
+        while (nextUnemitted < triangleCount && isEmitted[nextUnemitted]) {
+            nextUnemitted++;
+        }
+
+        // 이번 triangle 의 vertex 를 cache 앞으로 이동
+        uint32_t newCache[CACHE_SIZE + 3];
+        uint32_t newCount = 0;
+
+        for (uint32_t corner = 0; corner < 3; corner++) {
+            newCache[newCount++] = corners[corner];
+        }
+        for (uint32_t position = 0; position < cacheCount; position++) {
+            const uint32_t vertex = cache[position];
+
+            if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2]) {
+                newCache[newCount++] = vertex;
+            }
+        }
+
+        // 인접 리스트에서 방금 그린 triangle 제거
+        for (uint32_t corner = 0; corner < 3; corner++) {
+            const uint32_t vertex = corners[corner];
+            uint32_t* begin = &adjacency[adjacencyOffsets[vertex]];
+            uint32_t* end = begin + valences[vertex];
+            uint32_t* found = std::find(begin, end, triangle);
+
+            if (found != end) {
+                *found = *(end - 1);
+                valences[vertex]--;
+            }
+        }
+
+        // cache 에 남거나 밀려난 vertex 의 점수 갱신
+        bestTriangle = -1;
+        float bestScore = -1.0f;
+
+        for (uint32_t position = 0; position < newCount; position++) {
+            const uint32_t vertex = newCache[position];
+            const int32_t cachePosition = position < CACHE_SIZE ? static_cast<int32_t>(position) : -1;
+            cachePositions[vertex] = cachePosition;
+
+            const float newScore = getVertexScore(cachePosition, valences[vertex]);
+            const float delta = newScore - vertexScores[vertex];
+            vertexScores[vertex] = newScore;
+
+            for (uint32_t adjacent = 0; adjacent < valences[vertex]; adjacent++) {
+                const uint32_t adjacentTriangle = adjacency[adjacencyOffsets[vertex] + adjacent];
+                triangleScores[adjacentTriangle] += delta;
+
+                if (triangleScores[adjacentTriangle] > bestScore) {
+                    bestScore = triangleScores[adjacentTriangle];
+                    bestTriangle = adjacentTriangle;
+                }
+            }
+        }
+        cacheCount = std::min(newCount, CACHE_SIZE);
+        std::copy_n(newCache, cacheCount, cache);
+    }
+    indices = std::move(result);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<uint32_t>& indices, std::span<const MeshVertex> vertices, float threshold) {
+    const size_t triangleCount = indices.size() / 3;
+
+    if (triangleCount == 0) {
+        return;
+    }
+    // 1. cache 가 완전히 비워지는 지점 (세 vertex 모두 miss) 을 hard boundary 로 사용
+    std::vector<uint32_t> timestamps(vertices.size(), 0);
+    uint32_t time = OVERDRAW_CACHE_SIZE + 1;
+
+    std::vector<uint32_t> hardClusters {};
+
+    for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+        const uint32_t misses = simulateMisses({ &indices[triangle * 3], 3 }, timestamps, time, OVERDRAW_CACHE_SIZE);
+
+        if (triangle == 0 || misses == 3) {
+            hardClusters.push_back(triangle);
+        }
+    }
+    hardClusters.push_back(static_cast<uint32_t>(triangleCount));
+
+    // 2. 각 hard cluster 안에서 ACMR 이 threshold 이내로 유지되는 만큼씩 soft cluster 로 분할
+    std::vector<uint32_t> clusters {};
+    std::ranges::fill(timestamps, 0);
+    time = OVERDRAW_CACHE_SIZE + 1;
+
+    for (size_t cluster = 0; cluster + 1 < hardClusters.size(); cluster++) {
+        const uint32_t begin = hardClusters[cluster];
+        const uint32_t end = hardClusters[cluster + 1];
+
+        const float clusterAcmr = analyzeVertexCache(
+            { &indices[begin * 3], (end - begin) * 3 }, vertices.size(), OVERDRAW_CACHE_SIZE
+        ).acmr;
+
+        clusters.push_back(begin);
+        uint32_t softBegin = begin;
+        uint32_t softMisses = 0;
+
+        for (uint32_t triangle = begin; triangle < end; triangle++) {
+            softMisses += simulateMisses({ &indices[triangle * 3], 3 }, timestamps, time, OVERDRAW_CACHE_SIZE);
+
+            const uint32_t softTriangles = triangle + 1 - softBegin;
+
+            if (triangle + 1 < end && static_cast<float>(softMisses) / softTriangles <= clusterAcmr * threshold) {
+                clusters.push_back(triangle + 1);
+                softBegin = triangle + 1;
+                softMisses = 0;
+                // 새 cluster 는 빈 cache 에서 시작한다고 가정
+                time += OVERDRAW_CACHE_SIZE + 1;
+            }
+        }
+    }
+    clusters.push_back(static_cast<uint32_t>(triangleCount));
+
+    // 3. cluster 중심이 mesh 중심에서 cluster normal 방향으로 얼마나 나가 있는지로 정렬
+    glm::vec3 meshCentroid { 0.0f };
+    float meshArea = 0.0f;
+
+    struct ClusterKey {
+        float sortKey;
+        uint32_t cluster;
+    };
+    std::vector<glm::vec3> clusterCentroids(clusters.size() - 1, glm::vec3 { 0.0f });
+    std::vector<glm::vec3> clusterNormals(clusters.size() - 1, glm::vec3 { 0.0f });
+
+    for (size_t cluster = 0; cluster + 1 < clusters.size(); cluster++) {
+        float clusterArea = 0.0f;
+
+        for (uint32_t triangle = clusters[cluster]; triangle < clusters[cluster + 1]; triangle++) {
+            const glm::vec3& p0 = vertices[indices[triangle * 3]].position;
+            const glm::vec3& p1 = vertices[indices[triangle * 3 + 1]].position;
+            const glm::vec3& p2 = vertices[indices[triangle * 3 + 2]].position;
+
+            const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            const float area = glm::length(normal);
+            const glm::vec3 centroid = (p0 + p1 + p2) / 3.0f;
+
+            clusterCentroids[cluster] += centroid * area;
+            clusterNormals[cluster] += normal;
+            clusterArea += area;
+        }
+        meshCentroid += clusterCentroids[cluster];
+        meshArea += clusterArea;
+
+        if (clusterArea > 0.0f) {
+            clusterCentroids[cluster] /= clusterArea;
+        }
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+
+    std::vector<ClusterKey> clusterKeys(clusters.size() - 1);
+
+    for (uint32_t cluster = 0; cluster + 1 < clusters.size(); cluster++) {
+        const float normalLength = glm::length(clusterNormals[cluster]);
+        const glm::vec3 normal = normalLength > 0.0f ? clusterNormals[cluster] / normalLength : glm::vec3 { 0.0f };
+
+        clusterKeys[cluster] = { glm::dot(clusterCentroids[cluster] - meshCentroid, normal), cluster };
+    }
+    // 바깥을 향하는 cluster 가 먼저 그려져야 안쪽 cluster 가 depth test 로 걸러짐
+    std::ranges::stable_sort(clusterKeys, std::ranges::greater {}, &ClusterKey::sortKey);
+
+    std::vector<uint32_t> result {};
+    result.reserve(indices.size());
+
+    for (const ClusterKey& clusterKey : clusterKeys) {
+        const uint32_t begin = clusters[clusterKey.cluster];
+        const uint32_t end = clusters[clusterKey.cluster + 1];
+        result.insert(result.end(), indices.begin() + begin * 3, indices.begin() + end * 3);
+    }
+    indices = std::move(result);
+}
+
+void MeshOptimizer::optimizeVertexFetch(MeshData& mesh) {
+    constexpr uint32_t UNASSIGNED = UINT32_MAX;
+
+    std::vector<uint32_t> remap(mesh.vertices.size(), UNASSIGNED);
+    std::vector<MeshVertex> vertices {};
+    vertices.reserve(mesh.vertices.size());
+
+    for (uint32_t& index : mesh.indices) {
+        if (remap[index] == UNASSIGNED) {
+            remap[index] = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(mesh.vertices[index]);
+        }
+        index = remap[index];
+    }
+    mesh.vertices = std::move(vertices);
+}
+
+void MeshOptimizer::optimize(MeshData& mesh) {
+    optimizeVertexCache(mesh.indices, mesh.vertices.size());
+    optimizeOverdraw(mesh.indices, mesh.vertices);
+    optimizeVertexFetch(mesh);
+}
+
+MeshOptimizer::VertexCacheStatistics MeshOptimizer::analyzeVertexCache(
+    std::span<const uint32_t> indices,
+    size_t vertexCount,
+    uint32_t cacheSize
+) {
+    if (indices.empty() || vertexCount == 0) {
+        return { 0.0f, 0.0f };
+    }
+    std::vector<uint32_t> timestamps(vertexCount, 0);
+    uint32_t time = cacheSize + 1;
+    uint32_t misses = 0;
+
+    for (size_t index = 0; index + 2 < indices.size(); index += 3) {
+        misses += simulateMisses(indices.subspan(index, 3), timestamps, time, cacheSize);
+    }
+    std::vector<bool> isUsed(vertexCount, false);
+
+    for (const uint32_t index : indices) {
+        isUsed[index] = true;
+    }
+    const auto usedCount = static_cast<float>(std::ranges::count(isUsed, true));
+
+    return {
+        static_cast<float>(misses) / static_cast<float>(indices.size() / 3),
+        static_cast<float>(misses) / usedCount,
+    };
+}
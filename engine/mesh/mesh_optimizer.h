@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "mesh_data.h"
+
+namespace MeshOptimizer {
+
+    struct VertexCacheStatistics {
+        // average cache miss ratio (triangle 당 miss, 0.5 ~ 3)
+        float acmr;
+        // average transformed vertex ratio (1 이 최적)
+        float atvr;
+    };
+
+    // bit 단위로 같은 vertex 를 합침. indices 가 비어 있으면 비indexed triangle list 로 취급
+    void deduplicate(MeshData& mesh);
+
+    // 같은 position 을 공유하는 vertex 끼리 면적 가중 normal 을 누적
+    // onlyMissing 이면 normal 이 0 인 vertex 만 채우고 작성된 normal (hard edge) 은 유지
+    void generateNormals(MeshData& mesh, bool onlyMissing = false);
+
+    // Forsyth 의 linear-speed 알고리즘으로 post-transform cache 재사용을 높임
+    void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+    // cache 순서를 크게 해치지 않는 cluster 단위로 나눈 뒤 바깥을 향하는 cluster 를 먼저 그림
+    // threshold: cluster 분할 시 허용하는 ACMR 증가 비율
+    void optimizeOverdraw(std::vector<uint32_t>& indices, std::span<const MeshVertex> vertices, float threshold = 1.05f);
+
+    // index 가 처음 참조하는 순서로 vertex 를 재배치 (참조되지 않는 vertex 는 제거)
+    void optimizeVertexFetch(MeshData& mesh);
+
+    // vertex cache -> overdraw -> vertex fetch 순서로 적용
+    void optimize(MeshData& mesh);
+
+    // FIFO cache 시뮬레이션
+    VertexCacheStatistics analyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize = 16);
+}
@@ -0,0 +1,419 @@
+#include "mesh_simplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+
+#include "mesh_optimizer.h"
+
+namespace {
+    // 열린 경계에 더하는 수직 plane 의 가중치. 경계가 안쪽으로 말려 들어가는 것을 막음
+    constexpr double BORDER_WEIGHT = 10.0;
+    // collapse 후 triangle normal 이 약 75 도 넘게 돌면 뒤집힌 것으로 봄
+    constexpr double MIN_NORMAL_COS = 0.25;
+    // 이전 LOD 보다 이만큼도 줄지 않으면 (고정된 vertex 가 많거나 오차 한계) 더 만들지 않음
+    constexpr float MIN_LOD_REDUCTION = 0.85f;
+
+    enum class VertexKind : uint8_t {
+        MANIFOLD,
+        // 열린 경계 위. 경계 edge 를 따라서만 움직임
+        BORDER,
+        // seam 또는 non-manifold. 움직이지 않음
+        LOCKED,
+    };
+
+    // plane 까지 거리 제곱의 가중합 (대칭 4x4 행렬의 10 개 성분)
+    struct Quadric {
+        double a2, b2, c2, d2;
+        double ab, ac, ad, bc, bd, cd;
+        double weight;
+
+        Quadric& operator+=(const Quadric& other) {
+            a2 += other.a2;
+            b2 += other.b2;
+            c2 += other.c2;
+            d2 += other.d2;
+            ab += other.ab;
+            ac += other.ac;
+            ad += other.ad;
+            bc += other.bc;
+            bd += other.bd;
+            cd += other.cd;
+            weight += other.weight;
+            return *this;
+        }
+    };
+
+    // normal . p + distance = 0
+    Quadric createPlaneQuadric(const glm::dvec3& normal, double distance, double weight) {
+        const double a = normal.x;
+        const double b = normal.y;
+        const double c = normal.z;
+        const double d = distance;
+
+        return {
+            a * a * weight, b * b * weight, c * c * weight, d * d * weight,
+            a * b * weight, a * c * weight, a * d * weight, b * c * weight, b * d * weight, c * d * weight,
+            weight,
+        };
+    }
+
+    // 가중 평균한 거리 제곱
+    double getError(const Quadric& quadric, const glm::dvec3& position) {
+        if (quadric.weight <= 0.0) {
+            return 0.0;
+        }
+        const double x = position.x;
+        const double y = position.y;
+        const double z = position.z;
+        const double value = quadric.a2 * x * x + quadric.b2 * y * y + quadric.c2 * z * z + quadric.d2
+            + 2.0 * (quadric.ab * x * y + quadric.ac * x * z + quadric.bc * y * z + quadric.ad * x + quadric.bd * y + quadric.cd * z);
+
+        return std::max(value, 0.0) / quadric.weight;
+    }
+
+    uint64_t getEdgeKey(uint32_t a, uint32_t b) {
+        return (uint64_t { std::min(a, b) } << 32) | std::max(a, b);
+    }
+
+    // 방향 없는 edge 마다 인접 triangle 수
+    std::unordered_map<uint64_t, uint32_t> countEdges(std::span<const uint32_t> indices) {
+        std::unordered_map<uint64_t, uint32_t> edgeCounts;
+        edgeCounts.reserve(indices.size());
+
+        for (size_t triangle = 0; triangle < indices.size(); triangle += 3) {
+            for (size_t corner = 0; corner < 3; corner++) {
+                edgeCounts[getEdgeKey(indices[triangle + corner], indices[triangle + (corner + 1) % 3])]++;
+            }
+        }
+        return edgeCounts;
+    }
+
+    bool canCollapse(VertexKind from, VertexKind to, bool isBorderEdge) {
+        switch (from) {
+            case VertexKind::MANIFOLD:
+                return true;
+            case VertexKind::BORDER:
+                return isBorderEdge && to != VertexKind::MANIFOLD;
+            case VertexKind::LOCKED:
+                return false;
+        }
+        return false;
+    }
+
+    struct Collapse {
+        uint32_t from;
+        uint32_t to;
+        double error;
+        bool isBorderEdge;
+    };
+
+    struct PositionHash {
+        size_t operator()(const glm::vec3& position) const {
+            return std::hash<std::string_view> {}({ reinterpret_cast<const char*>(&position), sizeof(glm::vec3) });
+        }
+    };
+
+    class Simplifier {
+    public:
+        Simplifier(std::span<const MeshVertex> vertices, std::span<const uint32_t> indices)
+            : m_indices(indices.begin(), indices.end()), m_positions(vertices.size()), m_kinds(vertices.size(), VertexKind::MANIFOLD),
+              m_quadrics(vertices.size(), Quadric {}), m_remap(vertices.size()), m_isTouched(vertices.size()) {
+            std::unordered_map<glm::vec3, uint32_t, PositionHash> positionCounts;
+            positionCounts.reserve(vertices.size());
+
+            for (size_t vertex = 0; vertex < vertices.size(); vertex++) {
+                m_positions[vertex] = glm::dvec3 { vertices[vertex].position };
+                positionCounts[vertices[vertex].position]++;
+            }
+            // attribute 가 다른 vertex 를 따로 움직이면 seam 이 벌어짐
+            for (size_t vertex = 0; vertex < vertices.size(); vertex++) {
+                if (positionCounts[vertices[vertex].position] > 1) {
+                    m_kinds[vertex] = VertexKind::LOCKED;
+                }
+            }
+            const std::unordered_map<uint64_t, uint32_t> edgeCounts = countEdges(m_indices);
+
+            for (const auto& [key, count] : edgeCounts) {
+                for (const auto vertex : { static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key) }) {
+                    if (count > 2) {
+                        m_kinds[vertex] = VertexKind::LOCKED;
+                    } else if (count == 1 && m_kinds[vertex] == VertexKind::MANIFOLD) {
+                        m_kinds[vertex] = VertexKind::BORDER;
+                    }
+                }
+            }
+            initializeQuadrics(edgeCounts);
+        }
+
+        // 한 pass 에서 서로 겹치지 않는 collapse 를 오차 순으로 적용. 적용한 것이 없으면 false
+        bool collapse(size_t targetIndexCount, double maxErrorSquared) {
+            const std::vector<Collapse> collapses = findCollapses();
+
+            if (collapses.empty()) {
+                return false;
+            }
+            buildAdjacency();
+            std::iota(m_remap.begin(), m_remap.end(), 0u);
+            std::fill(m_isTouched.begin(), m_isTouched.end(), false);
+
+            const size_t removableCount = (m_indices.size() - targetIndexCount) / 3;
+            size_t removedCount = 0;
+
+            for (const Collapse& collapse : collapses) {
+                if (collapse.error > maxErrorSquared) {
+                    break;
+                }
+                // 주변 triangle 이 이번 pass 에서 이미 바뀐 vertex 는 다음 pass 에서 다시 평가
+                if (m_isTouched[collapse.from] || m_isTouched[collapse.to] || hasFlippedTriangle(collapse.from, collapse.to)) {
+                    continue;
+                }
+                m_remap[collapse.from] = collapse.to;
+                m_quadrics[collapse.to] += m_quadrics[collapse.from];
+                m_isTouched[collapse.from] = true;
+                m_isTouched[collapse.to] = true;
+                m_maxErrorSquared = std::max(m_maxErrorSquared, collapse.error);
+
+                // 내부 edge 는 양쪽 triangle 두 개, 경계 edge 는 하나가 사라짐
+                removedCount += collapse.isBorderEdge ? 1 : 2;
+
+                if (removedCount >= removableCount) {
+                    break;
+                }
+            }
+            if (removedCount == 0) {
+                return false;
+            }
+            size_t writeIndex = 0;
+
+            for (size_t triangle = 0; triangle < m_indices.size(); triangle += 3) {
+                const uint32_t a = m_remap[m_indices[triangle + 0]];
+                const uint32_t b = m_remap[m_indices[triangle + 1]];
+                const uint32_t c = m_remap[m_indices[triangle + 2]];
+
+                if (a == b || b == c || a == c) {
+                    continue;
+                }
+                m_indices[writeIndex++] = a;
+                m_indices[writeIndex++] = b;
+                m_indices[writeIndex++] = c;
+            }
+            m_indices.resize(writeIndex);
+            return true;
+        }
+
+        [[nodiscard]]
+        std::vector<uint32_t>& getIndices() {
+            return m_indices;
+        }
+
+        [[nodiscard]]
+        float getMaxError() const {
+            return static_cast<float>(std::sqrt(m_maxErrorSquared));
+        }
+
+    private:
+        void initializeQuadrics(const std::unordered_map<uint64_t, uint32_t>& edgeCounts) {
+            for (size_t triangle = 0; triangle < m_indices.size(); triangle += 3) {
+                const uint32_t corners[] { m_indices[triangle], m_indices[triangle + 1], m_indices[triangle + 2] };
+                const glm::dvec3 cross = glm::cross(
+                    m_positions[corners[1]] - m_positions[corners[0]],
+                    m_positions[corners[2]] - m_positions[corners[0]]
+                );
+                const double length = glm::length(cross);
+
+                if (length <= 0.0) {
+                    continue;
+                }
+                const glm::dvec3 normal = cross / length;
+                // 넓은 triangle 의 plane 일수록 크게 반영
+                const Quadric quadric = createPlaneQuadric(normal, -glm::dot(normal, m_positions[corners[0]]), length * 0.5);
+
+                for (const uint32_t corner : corners) {
+                    m_quadrics[corner] += quadric;
+                }
+                for (size_t corner = 0; corner < 3; corner++) {
+                    const uint32_t a = corners[corner];
+                    const uint32_t b = corners[(corner + 1) % 3];
+
+                    if (edgeCounts.at(getEdgeKey(a, b)) != 1) {
+                        continue;
+                    }
+                    // 경계 edge 를 지나고 triangle 에 수직인 plane
+                    const glm::dvec3 edge = m_positions[b] - m_positions[a];
+                    const glm::dvec3 borderCross = glm::cross(edge, normal);
+                    const double borderLength = glm::length(borderCross);
+
+                    if (borderLength <= 0.0) {
+                        continue;
+                    }
+                    const glm::dvec3 borderNormal = borderCross / borderLength;
+                    const Quadric borderQuadric = createPlaneQuadric(
+                        borderNormal,
+                        -glm::dot(borderNormal, m_positions[a]),
+                        glm::dot(edge, edge) * BORDER_WEIGHT
+                    );
+                    m_quadrics[a] += borderQuadric;
+                    m_quadrics[b] += borderQuadric;
+                }
+            }
+        }
+
+        // edge 마다 오차가 작은 방향 하나
+        std::vector<Collapse> findCollapses() const {
+            const std::unordered_map<uint64_t, uint32_t> edgeCounts = countEdges(m_indices);
+            std::vector<Collapse> collapses;
+            collapses.reserve(edgeCounts.size());
+
+            for (const auto& [key, count] : edgeCounts) {
+                const auto a = static_cast<uint32_t>(key >> 32);
+                const auto b = static_cast<uint32_t>(key);
+                Collapse best { a, b, std::numeric_limits<double>::infinity(), count == 1 };
+
+                for (const auto& [from, to] : { std::pair { a, b }, std::pair { b, a } }) {
+                    if (!canCollapse(m_kinds[from], m_kinds[to], best.isBorderEdge)) {
+                        continue;
+                    }
+                    Quadric quadric = m_quadrics[from];
+                    quadric += m_quadrics[to];
+                    const double error = getError(quadric, m_positions[to]);
+
+                    if (error < best.error) {
+                        best = { from, to, error, best.isBorderEdge };
+                    }
+                }
+                if (std::isfinite(best.error)) {
+                    collapses.push_back(best);
+                }
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& left, const Collapse& right) {
+                return left.error < right.error;
+            });
+            return collapses;
+        }
+
+        // vertex -> triangle (CSR)
+        void buildAdjacency() {
+            m_triangleOffsets.assign(m_positions.size() + 1, 0);
+
+            for (const uint32_t index : m_indices) {
+                m_triangleOffsets[index + 1]++;
+            }
+            std::partial_sum(m_triangleOffsets.begin(), m_triangleOffsets.end(), m_triangleOffsets.begin());
+            m_vertexTriangles.resize(m_indices.size());
+            std::vector<uint32_t> cursors(m_triangleOffsets.begin(), m_triangleOffsets.end() - 1);
+
+            for (size_t index = 0; index < m_indices.size(); index++) {
+                m_vertexTriangles[cursors[m_indices[index]]++] = static_cast<uint32_t>(index / 3);
+            }
+        }
+
+        bool hasFlippedTriangle(uint32_t from, uint32_t to) const {
+            for (uint32_t offset = m_triangleOffsets[from]; offset < m_triangleOffsets[from + 1]; offset++) {
+                const size_t triangle = size_t { m_vertexTriangles[offset] } * 3;
+                // 이번 pass 에서 먼저 합쳐진 이웃을 반영
+                uint32_t corners[] { m_remap[m_indices[triangle]], m_remap[m_indices[triangle + 1]], m_remap[m_indices[triangle + 2]] };
+
+                // to 를 포함하는 triangle 은 사라짐
+                if (corners[0] == to || corners[1] == to || corners[2] == to
+                    || corners[0] == corners[1] || corners[1] == corners[2] || corners[0] == corners[2]) {
+                    continue;
+                }
+                const glm::dvec3 before = glm::cross(
+                    m_positions[corners[1]] - m_positions[corners[0]],
+                    m_positions[corners[2]] - m_positions[corners[0]]
+                );
+                std::replace(std::begin(corners), std::end(corners), from, to);
+
+                const glm::dvec3 after = glm::cross(
+                    m_positions[corners[1]] - m_positions[corners[0]],
+                    m_positions[corners[2]] - m_positions[corners[0]]
+                );
+                const double lengths = glm::length(before) * glm::length(after);
+
+                if (lengths <= 0.0 || glm::dot(before, after) < MIN_NORMAL_COS * lengths) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::vector<uint32_t>       m_indices;
+        std::vector<glm::dvec3>     m_positions;
+        std::vector<VertexKind>     m_kinds;
+        std::vector<Quadric>        m_quadrics;
+        std::vector<uint32_t>       m_remap;
+        std::vector<bool>           m_isTouched;
+        std::vector<uint32_t>       m_triangleOffsets;
+        std::vector<uint32_t>       m_vertexTriangles;
+        double                      m_maxErrorSquared = 0.0;
+    };
+}
+
+std::vector<uint32_t> MeshSimplifier::simplify(
+    std::span<const MeshVertex> vertices,
+    std::span<const uint32_t> indices,
+    size_t targetIndexCount,
+    float maxError,
+    float* resultError
+) {
+    Simplifier simplifier { vertices, indices };
+    const double maxErrorSquared = double { maxError } * maxError;
+
+    while (simplifier.getIndices().size() > targetIndexCount && simplifier.collapse(targetIndexCount, maxErrorSquared)) {
+    }
+    if (resultError != nullptr) {
+        *resultError = simplifier.getMaxError();
+    }
+    return std::move(simplifier.getIndices());
+}
+
+void MeshSimplifier::generateLods(MeshData& mesh, const LodSettings& settings) {
+    // 이미 LOD 가 있으면 LOD 0 부터 다시 만듦
+    if (!mesh.lods.empty()) {
+        mesh.indices.resize(mesh.lods[0].indexCount);
+    }
+    const std::vector<uint32_t> baseIndices = mesh.indices;
+    mesh.lods = { { 0, static_cast<uint32_t>(baseIndices.size()), 0.0f } };
+
+    if (mesh.vertices.empty()) {
+        return;
+    }
+    glm::vec3 boundsMin = mesh.vertices[0].position;
+    glm::vec3 boundsMax = mesh.vertices[0].position;
+
+    for (const MeshVertex& vertex : mesh.vertices) {
+        boundsMin = glm::min(boundsMin, vertex.position);
+        boundsMax = glm::max(boundsMax, vertex.position);
+    }
+    const float maxError = glm::distance(boundsMin, boundsMax) * 0.5f * settings.maxRelativeError;
+    size_t previousIndexCount = baseIndices.size();
+    float previousError = 0.0f;
+
+    while (mesh.lods.size() < settings.maxLodCount) {
+        const size_t targetIndexCount = static_cast<size_t>(static_cast<float>(previousIndexCount / 3) * settings.reductionRatio) * 3;
+
+        if (targetIndexCount / 3 < settings.minTriangleCount) {
+            break;
+        }
+        // 매번 원본에서 줄여야 오차가 원본 기준으로 측정됨
+        float error = 0.0f;
+        std::vector<uint32_t> lodIndices = simplify(mesh.vertices, baseIndices, targetIndexCount, maxError, &error);
+
+        if (static_cast<float>(lodIndices.size()) > static_cast<float>(previousIndexCount) * MIN_LOD_REDUCTION) {
+            break;
+        }
+        MeshOptimizer::optimizeVertexCache(lodIndices, mesh.vertices.size());
+
+        // 선택이 거리에 대해 단조롭도록 오차는 줄어들지 않게 함
+        error = std::max(error, previousError);
+        mesh.lods.push_back({ static_cast<uint32_t>(mesh.indices.size()), static_cast<uint32_t>(lodIndices.size()), error });
+        mesh.indices.insert(mesh.indices.end(), lodIndices.begin(), lodIndices.end());
+
+        previousIndexCount = lodIndices.size();
+        previousError = error;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "mesh_data.h"
+
+namespace MeshSimplifier {
+
+    struct LodSettings {
+        // LOD 0 포함 (MeshFormat::MAX_LODS 이하)
+        uint32_t maxLodCount = 8;
+        // 이전 LOD 대비 목표 triangle 비율
+        float reductionRatio = 0.5f;
+        // bounding sphere 반지름 대비 허용하는 최대 오차
+        float maxRelativeError = 0.1f;
+        // 이보다 적은 triangle 의 LOD 는 만들지 않음
+        uint32_t minTriangleCount = 32;
+    };
+
+    // Garland-Heckbert quadric error 기반 edge collapse. 한 끝점을 다른 끝점으로 합치므로 vertex buffer 는 그대로 공유
+    // 위치가 같은 vertex 가 여럿인 (uv / normal seam) vertex 는 고정하고, 열린 경계는 경계를 따라서만 합침
+    // targetIndexCount 에 도달하거나 다음 collapse 의 오차가 maxError 를 넘으면 멈춤
+    // resultError: 적용한 collapse 중 가장 큰 object space 오차
+    std::vector<uint32_t> simplify(
+        std::span<const MeshVertex> vertices,
+        std::span<const uint32_t> indices,
+        size_t targetIndexCount,
+        float maxError,
+        float* resultError = nullptr
+    );
+
+    // mesh.indices 를 LOD 0 으로 두고 그 뒤에 점점 거친 LOD 를 이어 붙여 mesh.lods 를 채움
+    // MeshOptimizer::optimize 이후에 호출 (각 LOD 는 따로 vertex cache 최적화)
+    void generateLods(MeshData& mesh, const LodSettings& settings = {});
+}
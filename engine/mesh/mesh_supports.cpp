@@ -0,0 +1,59 @@
+#include "mesh_supports.h"
+
+#include <cstddef>
+#include <glm/glm.hpp>
+
+VkVertexInputBindingDescription MeshSupports::getVertexBindingDescription(uint32_t binding) {
+    VkVertexInputBindingDescription bindingDescription {};
+
+    bindingDescription.binding = binding;
+    bindingDescription.stride = sizeof(PackedVertex);
+    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    return bindingDescription;
+}
+
+std::array<VkVertexInputAttributeDescription, 3> MeshSupports::getVertexAttributeDescriptions(uint32_t binding) {
+    std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions {};
+
+    attributeDescriptions[0].location = 0;
+    attributeDescriptions[0].binding = binding;
+    attributeDescriptions[0].format = VK_FORMAT_R16G16B16A16_SFLOAT;
+    attributeDescriptions[0].offset = offsetof(PackedVertex, position);
+
+    attributeDescriptions[1].location = 1;
+    attributeDescriptions[1].binding = binding;
+    attributeDescriptions[1].format = VK_FORMAT_R16G16_SNORM;
+    attributeDescriptions[1].offset = offsetof(PackedVertex, normal);
+
+    attributeDescriptions[2].location = 2;
+    attributeDescriptions[2].binding = binding;
+    attributeDescriptions[2].format = VK_FORMAT_R16G16_SFLOAT;
+    attributeDescriptions[2].offset = offsetof(PackedVertex, uv);
+
+    return attributeDescriptions;
+}
+
+VertexInputLayout MeshSupports::createInstancedVertexInputLayout() {
+    constexpr uint32_t instanceBinding = 1;
+    constexpr uint32_t instanceLocation = 3;
+
+    VertexInputLayout layout {};
+    layout.bindings.push_back(getVertexBindingDescription(0));
+    layout.bindings.push_back({ instanceBinding, sizeof(glm::mat4), VK_VERTEX_INPUT_RATE_INSTANCE });
+
+    for (const VkVertexInputAttributeDescription& attribute : getVertexAttributeDescriptions(0)) {
+        layout.attributes.push_back(attribute);
+    }
+    // mat4 는 column 마다 location 하나
+    for (uint32_t column = 0; column < 4; column++) {
+        layout.attributes.push_back({
+            instanceLocation + column, instanceBinding, VK_FORMAT_R32G32B32A32_SFLOAT, static_cast<uint32_t>(column * sizeof(glm::vec4))
+        });
+    }
+    return layout;
+}
+
+VkIndexType MeshSupports::getIndexType(const CookedMesh& mesh) {
+    return mesh.header->indexSize == sizeof(uint16_t) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+}
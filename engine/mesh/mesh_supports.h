@@ -0,0 +1,19 @@
+#pragma once
+
+#include <array>
+#include <vulkan/vulkan_core.h>
+
+#include "mesh_cooker.h"
+#include "../shader/spirv_reflection.h"
+
+namespace MeshSupports {
+
+    // location 0: position (half4), 1: octahedral normal (snorm16x2), 2: uv (half2)
+    VkVertexInputBindingDescription getVertexBindingDescription(uint32_t binding = 0);
+    std::array<VkVertexInputAttributeDescription, 3> getVertexAttributeDescriptions(uint32_t binding = 0);
+
+    // binding 0: PackedVertex, binding 1: InstanceBuffer 의 world mat4 (instance rate, location 3 ~ 6)
+    VertexInputLayout createInstancedVertexInputLayout();
+
+    VkIndexType getIndexType(const CookedMesh& mesh);
+}
@@ -0,0 +1,422 @@
+#include "particle_system.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#include "../engine_component_factory.h"
+#include "../memory/host_allocator.h"
+#include "../pipeline/graphics_pipeline_supports.h"
+#include "../util/alignment.h"
+#include "../util/byte_streams.h"
+
+namespace {
+    constexpr auto SIMULATE_SHADER_NAME { "particle_simulate.comp.spv" };
+    constexpr auto VERTEX_SHADER_NAME { "particle.vert.spv" };
+    constexpr auto FRAGMENT_SHADER_NAME { "particle.frag.spv" };
+
+    // particle_simulate.comp 의 local_size
+    constexpr uint32_t GROUP_SIZE = 64;
+    // 1024 이상의 2 의 거듭제곱이면 입자 구간이 256 (minStorageBufferOffsetAlignment 최대값) 의 배수
+    constexpr uint32_t MIN_CAPACITY = 1024;
+    constexpr VkDeviceSize SECTION_ALIGNMENT = 256;
+
+    // particle_simulate.comp 의 pass
+    constexpr uint32_t INIT_PASS = 0;
+    constexpr uint32_t EMIT_PASS = 1;
+    constexpr uint32_t PREPARE_PASS = 2;
+    constexpr uint32_t SIMULATE_PASS = 3;
+
+    // particle_simulate.comp 의 Particle
+    struct GpuParticle {
+        // w: size
+        glm::vec4 position;
+        // w: age
+        glm::vec4 velocity;
+        glm::vec4 color;
+        float lifetime;
+        float reserved[3];
+    };
+    static_assert(sizeof(GpuParticle) == 64);
+
+    // particle_simulate.comp 의 push constant
+    struct SimulatePushConstants {
+        // w: radius
+        glm::vec4 emitterPosition;
+        // w: velocitySpread
+        glm::vec4 emitterVelocity;
+        glm::vec4 color;
+        // w: drag
+        glm::vec4 gravity;
+        glm::vec2 lifetime;
+        float size;
+        float deltaTime;
+        uint32_t count;
+        uint32_t pass;
+        uint32_t seed;
+        uint32_t capacity;
+    };
+
+    // particle.vert 의 push constant
+    struct DrawPushConstants {
+        glm::mat4 viewProjection;
+        glm::vec4 cameraRight;
+        glm::vec4 cameraUp;
+    };
+
+    // dead list 는 { int count; uint indices[] }, alive list 는 { VkDrawIndirectCommand; uint indices[] }
+    VkDeviceSize getListSize(uint32_t capacity) {
+        return sizeof(VkDrawIndirectCommand) + VkDeviceSize { capacity } * sizeof(uint32_t);
+    }
+
+    uint32_t getGroupCount(uint32_t count) {
+        return (count + GROUP_SIZE - 1) / GROUP_SIZE;
+    }
+}
+
+ParticleSystem::ParticleSystem(
+    VkPhysicalDevice physicalDevice,
+    VkDevice device,
+    DeletionQueue& deletionQueue,
+    ResourceRegistry& resources,
+    PipelineLayoutCache& pipelineLayoutCache,
+    VkRenderPass renderPass,
+    uint32_t capacity
+) : m_physicalDevice(physicalDevice), m_device(device), m_deletionQueue(deletionQueue), m_resources(resources),
+    m_pipelineLayoutCache(pipelineLayoutCache), m_capacity(std::bit_ceil(std::max(capacity, MIN_CAPACITY))) {
+    createBuffer();
+    createPipelines(renderPass);
+    createDescriptorSets();
+}
+
+ParticleSystem::~ParticleSystem() {
+    m_deletionQueue.retire(m_descriptorPool);
+    m_deletionQueue.retire(m_buffer.buffer);
+    m_deletionQueue.retire(m_buffer.memory);
+
+    ResourceRegistry::release(m_resources.pipelines, m_simulatePipeline, m_deletionQueue);
+    ResourceRegistry::release(m_resources.pipelines, m_drawPipeline, m_deletionQueue);
+}
+
+uint32_t ParticleSystem::addEmitter(const ParticleEmitter& emitter) {
+    m_emitters.push_back({ emitter });
+    return static_cast<uint32_t>(m_emitters.size() - 1);
+}
+
+void ParticleSystem::swapRemoveEmitter(uint32_t index) {
+    m_emitters[index] = m_emitters.back();
+    m_emitters.pop_back();
+}
+
+std::vector<char> ParticleSystem::serializeState() const {
+    std::vector<char> output;
+    ByteStreams::write(output, m_gravity);
+    ByteStreams::write(output, m_drag);
+    ByteStreams::write(output, m_viewProjection);
+    ByteStreams::write(output, m_cameraRight);
+    ByteStreams::write(output, m_cameraUp);
+    ByteStreams::write(output, static_cast<uint32_t>(m_emitters.size()));
+
+    for (const EmitterState& state : m_emitters) {
+        ByteStreams::write(output, state.emitter);
+    }
+    return output;
+}
+
+bool ParticleSystem::deserializeState(std::span<const char> state) {
+    glm::vec3 gravity;
+    float drag;
+    glm::mat4 viewProjection;
+    glm::vec3 cameraRight;
+    glm::vec3 cameraUp;
+    uint32_t emitterCount;
+    std::vector<ParticleEmitter> emitters;
+
+    if (!ByteStreams::read(state, gravity) || !ByteStreams::read(state, drag) || !ByteStreams::read(state, viewProjection)
+        || !ByteStreams::read(state, cameraRight) || !ByteStreams::read(state, cameraUp) || !ByteStreams::read(state, emitterCount)
+        || !ByteStreams::readArray(state, emitters, emitterCount)) {
+        return false;
+    }
+    m_gravity = gravity;
+    m_drag = drag;
+    m_viewProjection = viewProjection;
+    m_cameraRight = cameraRight;
+    m_cameraUp = cameraUp;
+    m_emitters.resize(emitterCount);
+
+    for (uint32_t index = 0; index < emitterCount; index++) {
+        m_emitters[index].emitter = emitters[index];
+    }
+    return true;
+}
+
+void ParticleSystem::reset() {
+    // 다음 recordSimulation 의 INIT_PASS 가 모든 입자를 dead list 로 되돌림
+    m_isInitialized = false;
+    m_currentList = 0;
+    m_seed = 0;
+
+    for (EmitterState& state : m_emitters) {
+        state.pendingCount = 0.0f;
+    }
+}
+
+void ParticleSystem::setCamera(const glm::mat4& view, const glm::mat4& projection) {
+    m_viewProjection = projection * view;
+    // view 행렬의 첫 두 행이 world space 의 camera 오른쪽, 위쪽
+    m_cameraRight = { view[0][0], view[1][0], view[2][0] };
+    m_cameraUp = { view[0][1], view[1][1], view[2][1] };
+}
+
+void ParticleSystem::recordSimulation(VkCommandBuffer commandBuffer, float deltaTime) {
+    deltaTime = std::clamp(deltaTime, 0.0f, MAX_DELTA_TIME);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, *m_resources.pipelines.get(m_simulatePipeline));
+    vkCmdBindDescriptorSets(
+        commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, *m_resources.pipelineLayouts.get(m_simulatePipelineLayout),
+        0, 1, &m_simulateDescriptorSets[m_currentList], 0, nullptr
+    );
+    // 지난 frame 의 draw 가 입자와 list 를 다 읽은 뒤에 씀
+    MemorySupports::recordMemoryBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+    );
+    const auto recordComputeBarrier = [&]() {
+        MemorySupports::recordMemoryBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+        );
+    };
+    // 처음에는 모든 입자가 dead list 에 있음
+    if (!m_isInitialized) {
+        recordPass(commandBuffer, INIT_PASS, m_capacity, nullptr, deltaTime);
+        vkCmdDispatch(commandBuffer, getGroupCount(m_capacity), 1, 1);
+        recordComputeBarrier();
+        m_isInitialized = true;
+    }
+    // emitter 끼리는 atomic 으로만 list 를 건드리므로 사이에 barrier 가 필요 없음
+    bool hasEmitted = false;
+
+    for (EmitterState& state : m_emitters) {
+        state.pendingCount += state.emitter.rate * deltaTime;
+        const auto emitCount = static_cast<uint32_t>(std::min(state.pendingCount, static_cast<float>(m_capacity)));
+        state.pendingCount -= static_cast<float>(emitCount);
+
+        if (emitCount == 0) {
+            continue;
+        }
+        recordPass(commandBuffer, EMIT_PASS, emitCount, &state, deltaTime);
+        vkCmdDispatch(commandBuffer, getGroupCount(emitCount), 1, 1);
+        hasEmitted = true;
+    }
+    if (hasEmitted) {
+        recordComputeBarrier();
+    }
+    // 살아 있는 수로 시뮬레이션 dispatch 크기를 정하고 다음 list 를 비움
+    recordPass(commandBuffer, PREPARE_PASS, 0, nullptr, deltaTime);
+    vkCmdDispatch(commandBuffer, 1, 1, 1);
+
+    MemorySupports::recordMemoryBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+    );
+    recordPass(commandBuffer, SIMULATE_PASS, 0, nullptr, deltaTime);
+    vkCmdDispatchIndirect(commandBuffer, m_buffer.buffer, m_dispatchOffset);
+
+    // draw 가 살아남은 입자와 그 수를 읽음
+    MemorySupports::recordMemoryBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT
+    );
+    m_currentList = 1 - m_currentList;
+}
+
+void ParticleSystem::recordDraw(VkCommandBuffer commandBuffer) const {
+    if (!m_isInitialized) {
+        return;
+    }
+    VkPipelineLayout pipelineLayout = *m_resources.pipelineLayouts.get(m_drawPipelineLayout);
+    const DrawPushConstants pushConstants {
+        m_viewProjection,
+        glm::vec4 { m_cameraRight, 0.0f },
+        glm::vec4 { m_cameraUp, 0.0f },
+    };
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *m_resources.pipelines.get(m_drawPipeline));
+    vkCmdBindDescriptorSets(
+        commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &m_drawDescriptorSets[m_currentList], 0, nullptr
+    );
+    vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(DrawPushConstants), &pushConstants);
+
+    // 방금 시뮬레이션이 채운 list 의 header 가 { 6, 살아 있는 수, 0, 0 }
+    vkCmdDrawIndirect(commandBuffer, m_buffer.buffer, m_aliveListOffsets[m_currentList], 1, sizeof(VkDrawIndirectCommand));
+}
+
+void ParticleSystem::createBuffer() {
+    m_deadListOffset = VkDeviceSize { m_capacity } * sizeof(GpuParticle);
+    m_aliveListOffsets[0] = Alignments::alignUp(m_deadListOffset + getListSize(m_capacity), SECTION_ALIGNMENT);
+    m_aliveListOffsets[1] = Alignments::alignUp(m_aliveListOffsets[0] + getListSize(m_capacity), SECTION_ALIGNMENT);
+    m_dispatchOffset = Alignments::alignUp(m_aliveListOffsets[1] + getListSize(m_capacity), SECTION_ALIGNMENT);
+
+    m_buffer = MemorySupports::createBuffer(
+        m_physicalDevice,
+        m_device,
+        m_dispatchOffset + sizeof(VkDispatchIndirectCommand),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        m_deletionQueue.getMemoryBudget()
+    );
+}
+
+void ParticleSystem::createPipelines(VkRenderPass renderPass) {
+    const ShaderModule& simulateShader = m_resources.getShader(SIMULATE_SHADER_NAME);
+    const ShaderReflection* simulateStages[] { &simulateShader.reflection };
+    m_simulatePipelineLayout = m_pipelineLayoutCache.getPipelineLayout(m_resources, simulateStages);
+    m_simulatePipeline = m_resources.pipelines.create(EngineComponentFactory::createComputePipeline(
+        m_device,
+        *m_resources.pipelineLayouts.get(m_simulatePipelineLayout),
+        GraphicsPipelineSupports::createPipelineShaderStageCreateInfo(VK_SHADER_STAGE_COMPUTE_BIT, simulateShader.module)
+    ));
+
+    const ShaderModule& vertexShader = m_resources.getShader(VERTEX_SHADER_NAME);
+    const ShaderModule& fragmentShader = m_resources.getShader(FRAGMENT_SHADER_NAME);
+    const ShaderReflection* drawStages[] { &vertexShader.reflection, &fragmentShader.reflection };
+    m_drawPipelineLayout = m_pipelineLayoutCache.getPipelineLayout(m_resources, drawStages);
+
+    const VkPipelineShaderStageCreateInfo shaderStages[] {
+        GraphicsPipelineSupports::createPipelineShaderStageCreateInfo(VK_SHADER_STAGE_VERTEX_BIT, vertexShader.module),
+        GraphicsPipelineSupports::createPipelineShaderStageCreateInfo(VK_SHADER_STAGE_FRAGMENT_BIT, fragmentShader.module),
+    };
+    // 정점 입력 없이 storage buffer 에서 읽음
+    auto vertexInputState = GraphicsPipelineSupports::createPipelineVertexInputStateCreateInfo();
+    auto inputAssemblyState = GraphicsPipelineSupports::createPipelineInputAssemblyStateCreateInfo();
+    auto rasterizationState = GraphicsPipelineSupports::createPipelineRasterizationStateCreateInfo();
+    rasterizationState.cullMode = VK_CULL_MODE_NONE;
+    auto multisampleState = GraphicsPipelineSupports::createPipelineMultisampleStateCreateInfo();
+
+    // 불투명 객체에는 가려지지만 입자끼리는 정렬 없이 더함
+    auto depthStencilState = GraphicsPipelineSupports::createPipelineDepthStencilStateCreateInfo();
+    depthStencilState.depthWriteEnable = VK_FALSE;
+    auto colorBlendAttachment = GraphicsPipelineSupports::createPipelineColorBlendAttachmentState();
+    colorBlendAttachment.blendEnable = VK_TRUE;
+    colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    auto colorBlendState = GraphicsPipelineSupports::createPipelineColorBlendStateCreateInfo(&colorBlendAttachment);
+
+    auto viewportState = GraphicsPipelineSupports::createPipelineViewportStateCreateInfo();
+
+    const VkGraphicsPipelineCreateInfo pipelineCreateInfo = EngineComponentFactory::createGraphicsPipelineCreateInfo(
+        shaderStages,
+        viewportState,
+        vertexInputState,
+        inputAssemblyState,
+        rasterizationState,
+        multisampleState,
+        depthStencilState,
+        colorBlendState,
+        *m_resources.pipelineLayouts.get(m_drawPipelineLayout),
+        renderPass
+    );
+    VkPipeline drawPipeline;
+
+    if (vkCreateGraphicsPipelines(m_device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_PIPELINE), &drawPipeline) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create particle pipeline!");
+    }
+    m_drawPipeline = m_resources.pipelines.create(drawPipeline);
+}
+
+void ParticleSystem::createDescriptorSets() {
+    // 시뮬레이션은 list 방향마다 storage buffer 5, draw 는 2
+    const VkDescriptorPoolSize poolSizes[] {
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2 * 5 + 2 * 2 },
+    };
+    m_descriptorPool = EngineComponentFactory::createDescriptorPool(m_device, poolSizes, 4);
+
+    const auto allocate = [&](PipelineLayoutHandle pipelineLayout, VkDescriptorSet (&descriptorSets)[2]) {
+        std::span<const DescriptorSetLayoutHandle> setLayouts = m_pipelineLayoutCache.getSetLayouts(pipelineLayout);
+
+        if (setLayouts.empty()) {
+            throw std::runtime_error("particle shader has no descriptor set!");
+        }
+        VkDescriptorSetLayout layout = *m_resources.descriptorSetLayouts.get(setLayouts[0]);
+        const VkDescriptorSetLayout layouts[] { layout, layout };
+
+        VkDescriptorSetAllocateInfo allocateInfo {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.descriptorPool = m_descriptorPool;
+        allocateInfo.descriptorSetCount = 2;
+        allocateInfo.pSetLayouts = layouts;
+
+        if (vkAllocateDescriptorSets(m_device, &allocateInfo, descriptorSets) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate particle descriptor sets!");
+        }
+    };
+    allocate(m_simulatePipelineLayout, m_simulateDescriptorSets);
+    allocate(m_drawPipelineLayout, m_drawDescriptorSets);
+
+    const VkDeviceSize listSize = getListSize(m_capacity);
+    const VkDescriptorBufferInfo particleInfo { m_buffer.buffer, 0, m_deadListOffset };
+    const VkDescriptorBufferInfo deadListInfo { m_buffer.buffer, m_deadListOffset, listSize };
+    const VkDescriptorBufferInfo dispatchInfo { m_buffer.buffer, m_dispatchOffset, sizeof(VkDispatchIndirectCommand) };
+
+    // set i: alive list i 를 읽고 다른 list 에 씀. draw set i 는 시뮬레이션 후의 list i 를 그림
+    for (uint32_t list = 0; list < 2; list++) {
+        const VkDescriptorBufferInfo currentInfo { m_buffer.buffer, m_aliveListOffsets[list], listSize };
+        const VkDescriptorBufferInfo nextInfo { m_buffer.buffer, m_aliveListOffsets[1 - list], listSize };
+
+        // particle_simulate.comp 와 particle.vert 의 binding 순서
+        const VkDescriptorBufferInfo* simulateInfos[] { &particleInfo, &deadListInfo, &currentInfo, &nextInfo, &dispatchInfo };
+        const VkDescriptorBufferInfo* drawInfos[] { &particleInfo, &currentInfo };
+        VkWriteDescriptorSet writes[std::size(simulateInfos) + std::size(drawInfos)] {};
+
+        for (uint32_t binding = 0; binding < std::size(writes); binding++) {
+            const bool isSimulate = binding < std::size(simulateInfos);
+
+            writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[binding].dstSet = isSimulate ? m_simulateDescriptorSets[list] : m_drawDescriptorSets[list];
+            writes[binding].dstBinding = isSimulate ? binding : binding - static_cast<uint32_t>(std::size(simulateInfos));
+            writes[binding].descriptorCount = 1;
+            writes[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[binding].pBufferInfo = isSimulate ? simulateInfos[binding] : drawInfos[binding - std::size(simulateInfos)];
+        }
+        vkUpdateDescriptorSets(m_device, static_cast<uint32_t>(std::size(writes)), writes, 0, nullptr);
+    }
+}
+
+void ParticleSystem::recordPass(VkCommandBuffer commandBuffer, uint32_t pass, uint32_t count, const EmitterState* emitter, float deltaTime) {
+    SimulatePushConstants pushConstants {};
+    pushConstants.gravity = glm::vec4 { m_gravity, m_drag };
+    pushConstants.deltaTime = deltaTime;
+    pushConstants.count = count;
+    pushConstants.pass = pass;
+    pushConstants.seed = ++m_seed;
+    pushConstants.capacity = m_capacity;
+
+    if (emitter != nullptr) {
+        const ParticleEmitter& settings = emitter->emitter;
+        pushConstants.emitterPosition = glm::vec4 { settings.position, settings.radius };
+        pushConstants.emitterVelocity = glm::vec4 { settings.velocity, settings.velocitySpread };
+        pushConstants.color = settings.color;
+        pushConstants.lifetime = { settings.minLifetime, std::max(settings.maxLifetime, settings.minLifetime) };
+        pushConstants.size = settings.size;
+    }
+    vkCmdPushConstants(
+        commandBuffer, *m_resources.pipelineLayouts.get(m_simulatePipelineLayout), VK_SHADER_STAGE_COMPUTE_BIT,
+        0, sizeof(SimulatePushConstants), &pushConstants
+    );
+}
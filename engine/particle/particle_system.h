@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan_core.h>
+
+#include "../memory/memory_supports.h"
+#include "../pipeline/pipeline_layout_cache.h"
+#include "../resource/deletion_queue.h"
+#include "../resource/resource_registry.h"
+
+struct ParticleEmitter {
+    glm::vec3 position { 0.0f };
+    // 이 반지름의 구 안에서 생성
+    float radius = 0.1f;
+    glm::vec3 velocity { 0.0f, 1.0f, 0.0f };
+    // velocity 에 더하는 무작위 속도의 최대 크기
+    float velocitySpread = 0.5f;
+    glm::vec4 color { 1.0f };
+    float minLifetime = 1.0f;
+    float maxLifetime = 2.0f;
+    // billboard 한 변의 world 크기
+    float size = 0.05f;
+    // 초당 생성 수
+    float rate = 1000.0f;
+};
+
+// 생성, 적분, 죽은 입자 회수를 모두 compute 로 처리하는 GPU 입자
+// dead list 와 ping-pong alive list 를 atomic counter 로 관리하고,
+// alive list 의 header 가 그대로 VkDrawIndirectCommand 라 GPU 가 센 수만큼 그림 (CPU 는 dispatch 만 기록)
+class ParticleSystem {
+public:
+    ParticleSystem(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        DeletionQueue& deletionQueue,
+        ResourceRegistry& resources,
+        PipelineLayoutCache& pipelineLayoutCache,
+        VkRenderPass renderPass,
+        uint32_t capacity
+    );
+
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+    ~ParticleSystem();
+
+    uint32_t addEmitter(const ParticleEmitter& emitter);
+
+    [[nodiscard]]
+    ParticleEmitter& getEmitter(uint32_t index) {
+        return m_emitters[index].emitter;
+    }
+
+    // 마지막 emitter 를 index 로 옮김 (이미 생성된 입자는 수명이 다할 때까지 남음)
+    void swapRemoveEmitter(uint32_t index);
+
+    // drag: 초당 속도 감쇠 비율
+    void setForces(const glm::vec3& gravity, float drag) {
+        m_gravity = gravity;
+        m_drag = drag;
+    }
+
+    // billboard 방향과 투영. 다음 recordDraw 부터 반영
+    void setCamera(const glm::mat4& view, const glm::mat4& projection);
+
+    // render pass 밖에서 기록. deltaTime 은 MAX_DELTA_TIME 으로 제한
+    void recordSimulation(VkCommandBuffer commandBuffer, float deltaTime);
+
+    // recordSimulation 이후 render pass 안에서 기록
+    void recordDraw(VkCommandBuffer commandBuffer) const;
+
+    // 생성 중인 emitter 가 있으면 계속 다시 그려야 함
+    [[nodiscard]]
+    bool isActive() const {
+        return !m_emitters.empty();
+    }
+
+    [[nodiscard]]
+    uint32_t getCapacity() const {
+        return m_capacity;
+    }
+
+    // emitter, 힘, camera. 생성 누적값 (pendingCount) 은 deltaTime 에서 다시 계산되므로 제외
+    [[nodiscard]]
+    std::vector<char> serializeState() const;
+
+    // 같은 index 의 emitter 는 생성 누적값을 유지. 형식이 맞지 않으면 false
+    bool deserializeState(std::span<const char> state);
+
+    // 모든 입자를 지우고 처음 상태로 (재생을 반복할 때 같은 입자가 생성되도록)
+    void reset();
+
+    // 다음 recordSimulation 이 쓰는 난수 seed
+    [[nodiscard]]
+    uint32_t getSeed() const {
+        return m_seed;
+    }
+
+    void setSeed(uint32_t seed) {
+        m_seed = seed;
+    }
+
+private:
+    static constexpr float MAX_DELTA_TIME = 0.1f;
+
+    struct EmitterState {
+        ParticleEmitter emitter;
+        // 소수점 이하 생성 수를 다음 frame 으로 넘김
+        float pendingCount = 0.0f;
+    };
+
+    void createBuffer();
+    void createPipelines(VkRenderPass renderPass);
+    void createDescriptorSets();
+
+    void recordPass(VkCommandBuffer commandBuffer, uint32_t pass, uint32_t count, const EmitterState* emitter, float deltaTime);
+
+    VkPhysicalDevice            m_physicalDevice;
+    VkDevice                    m_device;
+    DeletionQueue&              m_deletionQueue;
+    ResourceRegistry&           m_resources;
+    PipelineLayoutCache&        m_pipelineLayoutCache;
+    uint32_t                    m_capacity;
+
+    std::vector<EmitterState>   m_emitters;
+    glm::vec3                   m_gravity { 0.0f, -9.8f, 0.0f };
+    float                       m_drag = 0.1f;
+    glm::mat4                   m_viewProjection { 1.0f };
+    glm::vec3                   m_cameraRight { 1.0f, 0.0f, 0.0f };
+    glm::vec3                   m_cameraUp { 0.0f, 1.0f, 0.0f };
+    uint32_t                    m_seed = 0;
+
+    // [particles | dead list | alive list 0 | alive list 1 | dispatch args]
+    BufferAllocation            m_buffer;
+    VkDeviceSize                m_deadListOffset = 0;
+    VkDeviceSize                m_aliveListOffsets[2] {};
+    VkDeviceSize                m_dispatchOffset = 0;
+    // 이번 frame 에 읽는 alive list. 시뮬레이션 후 다른 list 로 바뀜
+    uint32_t                    m_currentList = 0;
+    bool                        m_isInitialized = false;
+
+    PipelineLayoutHandle        m_simulatePipelineLayout;
+    PipelineHandle              m_simulatePipeline;
+    PipelineLayoutHandle        m_drawPipelineLayout;
+    PipelineHandle              m_drawPipeline;
+    VkDescriptorPool            m_descriptorPool = VK_NULL_HANDLE;
+    // alive list 방향마다 하나
+    VkDescriptorSet             m_simulateDescriptorSets[2] {};
+    VkDescriptorSet             m_drawDescriptorSets[2] {};
+};
@@ -0,0 +1,79 @@
+#include "frame_descriptor_pool.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "../engine_component_factory.h"
+
+FrameDescriptorPool::FrameDescriptorPool(
+    VkDevice device,
+    DeletionQueue& deletionQueue,
+    uint32_t framesInFlight,
+    std::span<const VkDescriptorPoolSize> poolSizes,
+    uint32_t maxSets
+) : m_device(device), m_deletionQueue(deletionQueue), m_poolSizes(poolSizes.begin(), poolSizes.end()), m_maxSets(maxSets),
+    m_frames(std::max(framesInFlight, 1u)) {
+    for (FramePools& frame : m_frames) {
+        frame.pools.push_back(EngineComponentFactory::createDescriptorPool(m_device, m_poolSizes, m_maxSets));
+    }
+    m_currentFrame = &m_frames.front();
+}
+
+FrameDescriptorPool::~FrameDescriptorPool() {
+    for (const FramePools& frame : m_frames) {
+        for (VkDescriptorPool pool : frame.pools) {
+            m_deletionQueue.retire(pool);
+        }
+    }
+}
+
+void FrameDescriptorPool::begin(uint64_t frame) {
+    m_currentFrame = &m_frames[frame % m_frames.size()];
+
+    // set 을 하나씩 해제하지 않고 pool 단위로 비움
+    for (VkDescriptorPool pool : m_currentFrame->pools) {
+        vkResetDescriptorPool(m_device, pool, 0);
+    }
+    m_currentFrame->current = 0;
+    m_currentFrame->currentSetCount = 0;
+}
+
+VkDescriptorSet FrameDescriptorPool::allocate(VkDescriptorSetLayout layout) {
+    VkDescriptorSetAllocateInfo allocateInfo {};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &layout;
+
+    FramePools& frame = *m_currentFrame;
+
+    while (true) {
+        allocateInfo.descriptorPool = frame.pools[frame.current];
+        VkDescriptorSet descriptorSet;
+        const VkResult result = vkAllocateDescriptorSets(m_device, &allocateInfo, &descriptorSet);
+
+        if (result == VK_SUCCESS) {
+            frame.currentSetCount++;
+            return descriptorSet;
+        }
+        // 빈 pool 에서도 실패하면 poolSizes 로는 이 layout 을 할당할 수 없음
+        if (frame.currentSetCount == 0) {
+            throw std::runtime_error("failed to allocate frame descriptor set!");
+        }
+        // 1.0 에서는 pool 부족이 OUT_OF_POOL_MEMORY 대신 메모리 부족으로 보고될 수 있어 결과 코드로 구분하지 않음
+        frame.current++;
+        frame.currentSetCount = 0;
+
+        if (frame.current == frame.pools.size()) {
+            frame.pools.push_back(EngineComponentFactory::createDescriptorPool(m_device, m_poolSizes, m_maxSets));
+        }
+    }
+}
+
+size_t FrameDescriptorPool::getPoolCount() const {
+    size_t poolCount = 0;
+
+    for (const FramePools& frame : m_frames) {
+        poolCount += frame.pools.size();
+    }
+    return poolCount;
+}
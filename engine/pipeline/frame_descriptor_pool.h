@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+#include "../resource/deletion_queue.h"
+
+// frame in flight 마다 descriptor pool 을 두고, 그 frame 에 할당한 set 은 begin 의 vkResetDescriptorPool 로 한 번에 회수
+// pool 이 가득 차면 같은 frame 에 pool 을 더 만들어 이어 쓰고, 이후 reset 에서 함께 재사용
+class FrameDescriptorPool {
+public:
+    FrameDescriptorPool(
+        VkDevice device,
+        DeletionQueue& deletionQueue,
+        uint32_t framesInFlight,
+        std::span<const VkDescriptorPoolSize> poolSizes,
+        uint32_t maxSets
+    );
+
+    FrameDescriptorPool(const FrameDescriptorPool&) = delete;
+    FrameDescriptorPool& operator=(const FrameDescriptorPool&) = delete;
+
+    ~FrameDescriptorPool();
+
+    // frame 의 pool 을 모두 reset. 이 context 의 fence 를 기다린 뒤 호출
+    void begin(uint64_t frame);
+
+    // 이번 frame 이 끝날 때까지만 유효한 set
+    VkDescriptorSet allocate(VkDescriptorSetLayout layout);
+
+    // 모든 frame 의 pool 수. 계속 늘면 poolSizes 가 작은 것
+    [[nodiscard]]
+    size_t getPoolCount() const;
+
+private:
+    struct FramePools {
+        std::vector<VkDescriptorPool> pools;
+        // 지금 할당하는 pool. 앞의 pool 은 가득 참
+        size_t current = 0;
+        uint32_t currentSetCount = 0;
+    };
+
+    VkDevice                            m_device;
+    DeletionQueue&                      m_deletionQueue;
+    std::vector<VkDescriptorPoolSize>   m_poolSizes;
+    uint32_t                            m_maxSets;
+    std::vector<FramePools>             m_frames;
+    FramePools*                         m_currentFrame = nullptr;
+};
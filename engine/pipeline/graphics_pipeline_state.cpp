@@ -0,0 +1,54 @@
+#include "graphics_pipeline_state.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "graphics_pipeline_supports.h"
+#include "../util/hash.h"
+
+void GraphicsPipelineState::setShaders(std::span<const ShaderVariant* const> variants) {
+    if (variants.size() > MAX_SHADER_STAGES) {
+        throw std::runtime_error("too many shader stages for graphics pipeline!");
+    }
+    shaders.fill(nullptr);
+    std::ranges::copy(variants, shaders.begin());
+}
+
+void GraphicsPipelineState::setVertexInput(const VertexInputLayout& vertexInput) {
+    if (vertexInput.bindings.size() > MAX_VERTEX_BINDINGS || vertexInput.attributes.size() > MAX_VERTEX_ATTRIBUTES) {
+        throw std::runtime_error("too many vertex inputs for graphics pipeline!");
+    }
+    // 쓰지 않는 칸도 hash 에 들어가므로 비워 둠
+    vertexBindings = {};
+    vertexAttributes = {};
+    std::ranges::copy(vertexInput.bindings, vertexBindings.begin());
+    std::ranges::copy(vertexInput.attributes, vertexAttributes.begin());
+    vertexBindingCount = static_cast<uint32_t>(vertexInput.bindings.size());
+    vertexAttributeCount = static_cast<uint32_t>(vertexInput.attributes.size());
+}
+
+VkPipelineColorBlendAttachmentState GraphicsPipelineState::createColorBlendAttachment() const {
+    VkPipelineColorBlendAttachmentState colorBlendAttachment = GraphicsPipelineSupports::createPipelineColorBlendAttachmentState();
+    colorBlendAttachment.colorWriteMask = colorWriteMask;
+
+    if (blend == BlendMode::DISABLED) {
+        return colorBlendAttachment;
+    }
+    colorBlendAttachment.blendEnable = VK_TRUE;
+    colorBlendAttachment.srcColorBlendFactor = blend == BlendMode::PREMULTIPLIED_ALPHA ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_SRC_ALPHA;
+    colorBlendAttachment.dstColorBlendFactor = blend == BlendMode::ADDITIVE ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstAlphaBlendFactor = blend == BlendMode::ADDITIVE ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    return colorBlendAttachment;
+}
+
+uint64_t GraphicsPipelineState::hash() const {
+    return Hashes::hashValue(*this);
+}
+
+bool GraphicsPipelineState::operator==(const GraphicsPipelineState& other) const {
+    return std::memcmp(this, &other, sizeof(GraphicsPipelineState)) == 0;
+}
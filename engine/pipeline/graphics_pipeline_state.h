@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vulkan/vulkan_core.h>
+
+#include "../shader/shader_variants.h"
+#include "../shader/spirv_reflection.h"
+
+// color attachment 의 blend 식. 색은 모두 ADD
+enum class BlendMode : uint32_t {
+    DISABLED,
+    // src * srcAlpha + dst * (1 - srcAlpha)
+    ALPHA,
+    // 색에 alpha 가 미리 곱해진 texture 용. src + dst * (1 - srcAlpha)
+    PREMULTIPLIED_ALPHA,
+    // src * srcAlpha + dst
+    ADDITIVE,
+};
+
+// graphics pipeline 하나를 결정하는 상태. 기본값은 GraphicsPipelineSupports 의 기본 state 와 같음
+// padding 없이 고정 크기 필드만 두어 byte 단위로 hash / 비교
+// Vulkan 1.0 에는 dynamic rendering 이 없으므로 attachment format 과 sample 수는 renderPass 가 결정 (호환되는 pass 끼리는 pipeline 을 공유해도 됨)
+struct GraphicsPipelineState {
+    // vertex, tessellation control / evaluation, geometry, fragment
+    static constexpr size_t MAX_SHADER_STAGES = 5;
+    static constexpr size_t MAX_VERTEX_BINDINGS = 4;
+    // maxVertexInputAttributes 의 최소 보장값
+    static constexpr size_t MAX_VERTEX_ATTRIBUTES = 16;
+
+    // 앞에서부터 채우고 나머지는 nullptr. variant 는 ShaderVariantCache 에 있는 동안 주소가 유지됨
+    std::array<const ShaderVariant*, MAX_SHADER_STAGES> shaders {};
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    uint32_t subpass = 0;
+    VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+    VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+    VkFrontFace frontFace = VK_FRONT_FACE_CLOCKWISE;
+    // renderPass 의 attachment sample 수와 같아야 함
+    VkSampleCountFlagBits sampleCount = VK_SAMPLE_COUNT_1_BIT;
+    VkBool32 depthTest = VK_TRUE;
+    VkBool32 depthWrite = VK_TRUE;
+    VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS;
+    // subpass 의 color attachment 수. 모든 attachment 에 같은 blend 를 씀
+    uint32_t colorAttachmentCount = 1;
+    BlendMode blend = BlendMode::DISABLED;
+    VkColorComponentFlags colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    uint32_t vertexBindingCount = 0;
+    uint32_t vertexAttributeCount = 0;
+    std::array<VkVertexInputBindingDescription, MAX_VERTEX_BINDINGS> vertexBindings {};
+    std::array<VkVertexInputAttributeDescription, MAX_VERTEX_ATTRIBUTES> vertexAttributes {};
+
+    void setShaders(std::span<const ShaderVariant* const> variants);
+
+    // reflection 으로 만든 layout 을 복사. 최대 개수를 넘으면 예외
+    void setVertexInput(const VertexInputLayout& vertexInput);
+
+    [[nodiscard]]
+    std::span<const VkVertexInputBindingDescription> getVertexBindings() const {
+        return { vertexBindings.data(), vertexBindingCount };
+    }
+
+    [[nodiscard]]
+    std::span<const VkVertexInputAttributeDescription> getVertexAttributes() const {
+        return { vertexAttributes.data(), vertexAttributeCount };
+    }
+
+    // blend 와 colorWriteMask 로 만든 attachment 하나의 blend state
+    [[nodiscard]]
+    VkPipelineColorBlendAttachmentState createColorBlendAttachment() const;
+
+    [[nodiscard]]
+    uint64_t hash() const;
+
+    bool operator==(const GraphicsPipelineState& other) const;
+};
+
+static_assert(std::has_unique_object_representations_v<GraphicsPipelineState>, "GraphicsPipelineState must not have padding");
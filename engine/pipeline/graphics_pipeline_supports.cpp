@@ -1,11 +1,18 @@
 #include "graphics_pipeline_supports.h"
 
-VkPipelineShaderStageCreateInfo GraphicsPipelineSupports::createPipelineShaderStageCreateInfo(VkShaderStageFlagBits stage, VkShaderModule shaderModule) {
+#include <iterator>
+
+VkPipelineShaderStageCreateInfo GraphicsPipelineSupports::createPipelineShaderStageCreateInfo(
+    VkShaderStageFlagBits stage,
+    VkShaderModule shaderModule,
+    const VkSpecializationInfo* specializationInfo
+) {
     VkPipelineShaderStageCreateInfo shaderStageCreateInfo{};
     shaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     shaderStageCreateInfo.stage = stage;
     shaderStageCreateInfo.module = shaderModule;
     shaderStageCreateInfo.pName = "main";
+    shaderStageCreateInfo.pSpecializationInfo = specializationInfo;
     return shaderStageCreateInfo;
 }
 
@@ -19,6 +26,19 @@ VkPipelineVertexInputStateCreateInfo GraphicsPipelineSupports::createPipelineVer
     return vertexInputStateCreateInfo;
 }
 
+VkPipelineVertexInputStateCreateInfo GraphicsPipelineSupports::createPipelineVertexInputStateCreateInfo(
+    std::span<const VkVertexInputBindingDescription> bindings,
+    std::span<const VkVertexInputAttributeDescription> attributes
+) {
+    VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo{};
+    vertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputStateCreateInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindings.size());
+    vertexInputStateCreateInfo.pVertexBindingDescriptions = bindings.data();
+    vertexInputStateCreateInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributes.size());
+    vertexInputStateCreateInfo.pVertexAttributeDescriptions = attributes.data();
+    return vertexInputStateCreateInfo;
+}
+
 VkPipelineInputAssemblyStateCreateInfo GraphicsPipelineSupports::createPipelineInputAssemblyStateCreateInfo() {
     VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateCreateInfo{};
     inputAssemblyStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
@@ -37,6 +57,22 @@ VkPipelineViewportStateCreateInfo GraphicsPipelineSupports::createPipelineViewpo
     return viewportStateCreateInfo;
 }
 
+VkPipelineViewportStateCreateInfo GraphicsPipelineSupports::createPipelineViewportStateCreateInfo() {
+    return createPipelineViewportStateCreateInfo(nullptr, nullptr);
+}
+
+const VkPipelineDynamicStateCreateInfo& GraphicsPipelineSupports::getViewportDynamicState() {
+    static constexpr VkDynamicState dynamicStates[] { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+    static const VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo {
+        VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+        nullptr,
+        0,
+        static_cast<uint32_t>(std::size(dynamicStates)),
+        dynamicStates,
+    };
+    return dynamicStateCreateInfo;
+}
+
 VkPipelineRasterizationStateCreateInfo GraphicsPipelineSupports::createPipelineRasterizationStateCreateInfo() {
     VkPipelineRasterizationStateCreateInfo rasterizationStateCreateInfo{};
     rasterizationStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
@@ -58,6 +94,17 @@ VkPipelineMultisampleStateCreateInfo GraphicsPipelineSupports::createPipelineMul
     return multisampleStateCreateInfo;
 }
 
+VkPipelineDepthStencilStateCreateInfo GraphicsPipelineSupports::createPipelineDepthStencilStateCreateInfo() {
+    VkPipelineDepthStencilStateCreateInfo depthStencilStateCreateInfo{};
+    depthStencilStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencilStateCreateInfo.depthTestEnable = VK_TRUE;
+    depthStencilStateCreateInfo.depthWriteEnable = VK_TRUE;
+    depthStencilStateCreateInfo.depthCompareOp = VK_COMPARE_OP_LESS;
+    depthStencilStateCreateInfo.depthBoundsTestEnable = VK_FALSE;
+    depthStencilStateCreateInfo.stencilTestEnable = VK_FALSE;
+    return depthStencilStateCreateInfo;
+}
+
 VkPipelineColorBlendAttachmentState GraphicsPipelineSupports::createPipelineColorBlendAttachmentState() {
     VkPipelineColorBlendAttachmentState colorBlendAttachment{};
     colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
@@ -84,3 +131,24 @@ VkPipelineLayoutCreateInfo GraphicsPipelineSupports::createPipelineLayoutCreateI
     pipelineLayoutCreateInfo.pPushConstantRanges = nullptr;
     return pipelineLayoutCreateInfo;
 }
+
+VkPipelineLayoutCreateInfo GraphicsPipelineSupports::createPipelineLayoutCreateInfo(
+    std::span<const VkDescriptorSetLayout> setLayouts,
+    std::span<const VkPushConstantRange> pushConstantRanges
+) {
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutCreateInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+    pipelineLayoutCreateInfo.pSetLayouts = setLayouts.data();
+    pipelineLayoutCreateInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size());
+    pipelineLayoutCreateInfo.pPushConstantRanges = pushConstantRanges.data();
+    return pipelineLayoutCreateInfo;
+}
+
+VkDescriptorSetLayoutCreateInfo GraphicsPipelineSupports::createDescriptorSetLayoutCreateInfo(std::span<const VkDescriptorSetLayoutBinding> bindings) {
+    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+    descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    descriptorSetLayoutCreateInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+    return descriptorSetLayoutCreateInfo;
+}
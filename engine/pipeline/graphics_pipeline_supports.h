@@ -1,16 +1,36 @@
 #pragma once
 
+#include <span>
 #include <vulkan/vulkan.h>
 
 namespace GraphicsPipelineSupports {
 
-    VkPipelineShaderStageCreateInfo createPipelineShaderStageCreateInfo(VkShaderStageFlagBits stage, VkShaderModule shaderModule);
+    VkPipelineShaderStageCreateInfo createPipelineShaderStageCreateInfo(
+        VkShaderStageFlagBits stage,
+        VkShaderModule shaderModule,
+        const VkSpecializationInfo* specializationInfo = nullptr
+    );
     VkPipelineVertexInputStateCreateInfo createPipelineVertexInputStateCreateInfo();
+    VkPipelineVertexInputStateCreateInfo createPipelineVertexInputStateCreateInfo(
+        std::span<const VkVertexInputBindingDescription> bindings,
+        std::span<const VkVertexInputAttributeDescription> attributes
+    );
     VkPipelineInputAssemblyStateCreateInfo createPipelineInputAssemblyStateCreateInfo();
     VkPipelineViewportStateCreateInfo createPipelineViewportStateCreateInfo(const VkViewport *viewport, const VkRect2D *scissor);
+    // viewport / scissor 를 dynamic state 로 받는 pipeline 용. 개수만 지정
+    VkPipelineViewportStateCreateInfo createPipelineViewportStateCreateInfo();
+    // viewport / scissor 는 record 시점에 지정하므로 크기가 다른 창끼리 pipeline 공유 가능
+    const VkPipelineDynamicStateCreateInfo& getViewportDynamicState();
     VkPipelineRasterizationStateCreateInfo createPipelineRasterizationStateCreateInfo();
     VkPipelineMultisampleStateCreateInfo createPipelineMultisampleStateCreateInfo();
+    // depth test / write, 가까운 것이 통과 (LESS)
+    VkPipelineDepthStencilStateCreateInfo createPipelineDepthStencilStateCreateInfo();
     VkPipelineColorBlendAttachmentState createPipelineColorBlendAttachmentState();
     VkPipelineColorBlendStateCreateInfo createPipelineColorBlendStateCreateInfo(const VkPipelineColorBlendAttachmentState *colorBlendAttachment);
     VkPipelineLayoutCreateInfo createPipelineLayoutCreateInfo();
+    VkPipelineLayoutCreateInfo createPipelineLayoutCreateInfo(
+        std::span<const VkDescriptorSetLayout> setLayouts,
+        std::span<const VkPushConstantRange> pushConstantRanges
+    );
+    VkDescriptorSetLayoutCreateInfo createDescriptorSetLayoutCreateInfo(std::span<const VkDescriptorSetLayoutBinding> bindings);
 }
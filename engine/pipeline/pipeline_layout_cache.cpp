@@ -0,0 +1,156 @@
+#include "pipeline_layout_cache.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "graphics_pipeline_supports.h"
+#include "../memory/host_allocator.h"
+#include "../util/hash.h"
+
+namespace {
+    VkDescriptorType toDynamicType(VkDescriptorType descriptorType) {
+        switch (descriptorType) {
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+            default:
+                return descriptorType;
+        }
+    }
+}
+
+PipelineLayoutHandle PipelineLayoutCache::getPipelineLayout(
+    ResourceRegistry& resources,
+    std::span<const ShaderReflection* const> stages,
+    uint32_t dynamicBufferSets
+) {
+    // set 별로 stage 의 binding 을 합침
+    std::vector<std::vector<VkDescriptorSetLayoutBinding>> sets {};
+    VkShaderStageFlags pushConstantStages = 0;
+    uint32_t pushConstantBegin = UINT32_MAX;
+    uint32_t pushConstantEnd = 0;
+
+    for (const ShaderReflection* stage : stages) {
+        for (const ReflectedBinding& reflected : stage->bindings) {
+            if (sets.size() <= reflected.set) {
+                sets.resize(reflected.set + 1);
+            }
+            std::vector<VkDescriptorSetLayoutBinding>& bindings = sets[reflected.set];
+            auto existing = std::ranges::find(bindings, reflected.binding, &VkDescriptorSetLayoutBinding::binding);
+            const bool isDynamic = reflected.set < 32 && (dynamicBufferSets >> reflected.set & 1) != 0;
+            const VkDescriptorType descriptorType = isDynamic ? toDynamicType(reflected.descriptorType) : reflected.descriptorType;
+
+            if (existing == bindings.end()) {
+                bindings.push_back({ reflected.binding, descriptorType, reflected.descriptorCount, static_cast<VkShaderStageFlags>(stage->stage), nullptr });
+                continue;
+            }
+            if (existing->descriptorType != descriptorType) {
+                throw std::runtime_error(
+                    "descriptor type mismatch at set " + std::to_string(reflected.set) + " binding " + std::to_string(reflected.binding)
+                );
+            }
+            existing->descriptorCount = std::max(existing->descriptorCount, reflected.descriptorCount);
+            existing->stageFlags |= stage->stage;
+        }
+        if (stage->pushConstantSize > 0) {
+            pushConstantStages |= stage->stage;
+            pushConstantBegin = std::min(pushConstantBegin, stage->pushConstantOffset);
+            pushConstantEnd = std::max(pushConstantEnd, stage->pushConstantOffset + stage->pushConstantSize);
+        }
+    }
+    // 중간에 빈 set 은 binding 없는 layout 으로 채움
+    std::vector<DescriptorSetLayoutHandle> setLayouts {};
+    setLayouts.reserve(sets.size());
+
+    for (std::vector<VkDescriptorSetLayoutBinding>& bindings : sets) {
+        std::ranges::sort(bindings, {}, &VkDescriptorSetLayoutBinding::binding);
+        setLayouts.push_back(getDescriptorSetLayout(resources, bindings));
+    }
+    std::vector<PushConstantRange> pushConstantRanges {};
+
+    if (pushConstantStages != 0) {
+        pushConstantRanges.push_back({ pushConstantStages, pushConstantBegin, pushConstantEnd - pushConstantBegin });
+    }
+    uint64_t hash = Hashes::hashBytes(setLayouts.data(), setLayouts.size() * sizeof(DescriptorSetLayoutHandle));
+    hash = Hashes::hashBytes(pushConstantRanges.data(), pushConstantRanges.size() * sizeof(PushConstantRange), hash);
+
+    std::vector<PipelineLayoutEntry>& bucket = m_pipelineLayouts[hash];
+
+    for (const PipelineLayoutEntry& entry : bucket) {
+        if (entry.setLayouts == setLayouts && entry.pushConstantRanges == pushConstantRanges) {
+            m_hitCount++;
+            return entry.handle;
+        }
+    }
+    std::vector<VkDescriptorSetLayout> vulkanSetLayouts {};
+    std::vector<VkPushConstantRange> vulkanPushConstantRanges {};
+
+    for (DescriptorSetLayoutHandle setLayout : setLayouts) {
+        vulkanSetLayouts.push_back(*resources.descriptorSetLayouts.get(setLayout));
+    }
+    for (const PushConstantRange& range : pushConstantRanges) {
+        vulkanPushConstantRanges.push_back({ range.stageFlags, range.offset, range.size });
+    }
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo = GraphicsPipelineSupports::createPipelineLayoutCreateInfo(vulkanSetLayouts, vulkanPushConstantRanges);
+    VkPipelineLayout pipelineLayout;
+
+    if (vkCreatePipelineLayout(m_device, &pipelineLayoutInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_PIPELINE_LAYOUT), &pipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create pipeline layout!");
+    }
+    PipelineLayoutHandle handle = resources.pipelineLayouts.create(pipelineLayout);
+
+    bucket.push_back({ std::move(setLayouts), std::move(pushConstantRanges), handle });
+    m_pipelineLayoutCount++;
+    return handle;
+}
+
+DescriptorSetLayoutHandle PipelineLayoutCache::getDescriptorSetLayout(ResourceRegistry& resources, std::span<const VkDescriptorSetLayoutBinding> bindings) {
+    std::vector<LayoutBinding> key {};
+    key.reserve(bindings.size());
+
+    for (const VkDescriptorSetLayoutBinding& binding : bindings) {
+        key.push_back({ binding.binding, binding.descriptorType, binding.descriptorCount, binding.stageFlags });
+    }
+    std::ranges::sort(key, {}, &LayoutBinding::binding);
+
+    const uint64_t hash = Hashes::hashBytes(key.data(), key.size() * sizeof(LayoutBinding));
+    std::vector<DescriptorSetLayoutEntry>& bucket = m_descriptorSetLayouts[hash];
+
+    for (const DescriptorSetLayoutEntry& entry : bucket) {
+        if (entry.bindings == key) {
+            m_hitCount++;
+            return entry.handle;
+        }
+    }
+    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutInfo = GraphicsPipelineSupports::createDescriptorSetLayoutCreateInfo(bindings);
+    VkDescriptorSetLayout descriptorSetLayout;
+
+    if (vkCreateDescriptorSetLayout(m_device, &descriptorSetLayoutInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT), &descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create descriptor set layout!");
+    }
+    DescriptorSetLayoutHandle handle = resources.descriptorSetLayouts.create(descriptorSetLayout);
+
+    bucket.push_back({ std::move(key), handle });
+    m_descriptorSetLayoutCount++;
+    return handle;
+}
+
+std::span<const DescriptorSetLayoutHandle> PipelineLayoutCache::getSetLayouts(PipelineLayoutHandle pipelineLayout) const {
+    for (const auto& [hash, bucket] : m_pipelineLayouts) {
+        for (const PipelineLayoutEntry& entry : bucket) {
+            if (entry.handle == pipelineLayout) {
+                return entry.setLayouts;
+            }
+        }
+    }
+    return {};
+}
+
+void PipelineLayoutCache::clear() {
+    m_descriptorSetLayouts.clear();
+    m_pipelineLayouts.clear();
+    m_descriptorSetLayoutCount = 0;
+    m_pipelineLayoutCount = 0;
+}
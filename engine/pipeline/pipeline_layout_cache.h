@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+#include "../resource/resource_registry.h"
+#include "../shader/spirv_reflection.h"
+
+// reflection 결과로 descriptor set layout / pipeline layout 을 만들고, 구성이 같으면 재사용
+// 객체의 소유권은 ResourceRegistry 에 있으므로 registry 를 비우면 clear 필요
+class PipelineLayoutCache {
+public:
+    explicit PipelineLayoutCache(VkDevice device) : m_device(device) {}
+
+    // 각 stage 의 binding 을 set 별로 합치고 push constant 는 하나의 range 로 합침
+    // dynamicBufferSets 의 bit 에 해당하는 set 의 uniform / storage buffer 는 *_DYNAMIC 으로 만듦 (LinearBufferAllocator 용)
+    PipelineLayoutHandle getPipelineLayout(
+        ResourceRegistry& resources,
+        std::span<const ShaderReflection* const> stages,
+        uint32_t dynamicBufferSets = 0
+    );
+
+    DescriptorSetLayoutHandle getDescriptorSetLayout(ResourceRegistry& resources, std::span<const VkDescriptorSetLayoutBinding> bindings);
+
+    // descriptor set 할당용. 이 cache 가 만든 layout 이 아니면 빈 span
+    [[nodiscard]]
+    std::span<const DescriptorSetLayoutHandle> getSetLayouts(PipelineLayoutHandle pipelineLayout) const;
+
+    void clear();
+
+    [[nodiscard]]
+    size_t getDescriptorSetLayoutCount() const {
+        return m_descriptorSetLayoutCount;
+    }
+
+    [[nodiscard]]
+    size_t getPipelineLayoutCount() const {
+        return m_pipelineLayoutCount;
+    }
+
+    // 이미 있는 layout 으로 처리된 요청 수
+    [[nodiscard]]
+    uint64_t getHitCount() const {
+        return m_hitCount;
+    }
+
+private:
+    struct LayoutBinding {
+        uint32_t binding;
+        VkDescriptorType descriptorType;
+        uint32_t descriptorCount;
+        VkShaderStageFlags stageFlags;
+
+        bool operator==(const LayoutBinding&) const = default;
+    };
+
+    struct PushConstantRange {
+        VkShaderStageFlags stageFlags;
+        uint32_t offset;
+        uint32_t size;
+
+        bool operator==(const PushConstantRange&) const = default;
+    };
+
+    struct DescriptorSetLayoutEntry {
+        // binding 오름차순
+        std::vector<LayoutBinding> bindings;
+        DescriptorSetLayoutHandle handle;
+    };
+
+    struct PipelineLayoutEntry {
+        std::vector<DescriptorSetLayoutHandle> setLayouts;
+        std::vector<PushConstantRange> pushConstantRanges;
+        PipelineLayoutHandle handle;
+    };
+
+    VkDevice m_device;
+    // hash 충돌 시 같은 bucket 에서 구성으로 비교
+    std::unordered_map<uint64_t, std::vector<DescriptorSetLayoutEntry>> m_descriptorSetLayouts;
+    std::unordered_map<uint64_t, std::vector<PipelineLayoutEntry>> m_pipelineLayouts;
+    size_t m_descriptorSetLayoutCount = 0;
+    size_t m_pipelineLayoutCount = 0;
+    uint64_t m_hitCount = 0;
+};
@@ -0,0 +1,414 @@
+#include "pipeline_state_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "../engine_component_factory.h"
+#include "../memory/host_allocator.h"
+#include "../util/hash.h"
+
+namespace {
+    constexpr VkGraphicsPipelineLibraryFlagsEXT LIBRARY_PARTS[] {
+        VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+        VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+        VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+        VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+    };
+
+    // part 가 쓰는 필드만 남긴 상태. 나머지만 다른 pipeline 끼리 library 를 공유
+    GraphicsPipelineState createLibraryState(const GraphicsPipelineState& state, VkGraphicsPipelineLibraryFlagsEXT part) {
+        GraphicsPipelineState libraryState {};
+        size_t shaderCount = 0;
+
+        switch (part) {
+            case VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT:
+                libraryState.topology = state.topology;
+                libraryState.vertexBindingCount = state.vertexBindingCount;
+                libraryState.vertexAttributeCount = state.vertexAttributeCount;
+                libraryState.vertexBindings = state.vertexBindings;
+                libraryState.vertexAttributes = state.vertexAttributes;
+                break;
+            case VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT:
+                for (const ShaderVariant* variant : state.shaders) {
+                    if (variant != nullptr && variant->key.type != FRAGMENT_SHADER) {
+                        libraryState.shaders[shaderCount++] = variant;
+                    }
+                }
+                libraryState.layout = state.layout;
+                libraryState.renderPass = state.renderPass;
+                libraryState.subpass = state.subpass;
+                libraryState.polygonMode = state.polygonMode;
+                libraryState.cullMode = state.cullMode;
+                libraryState.frontFace = state.frontFace;
+                break;
+            case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT:
+                for (const ShaderVariant* variant : state.shaders) {
+                    if (variant != nullptr && variant->key.type == FRAGMENT_SHADER) {
+                        libraryState.shaders[shaderCount++] = variant;
+                    }
+                }
+                libraryState.layout = state.layout;
+                libraryState.renderPass = state.renderPass;
+                libraryState.subpass = state.subpass;
+                libraryState.sampleCount = state.sampleCount;
+                libraryState.depthTest = state.depthTest;
+                libraryState.depthWrite = state.depthWrite;
+                libraryState.depthCompareOp = state.depthCompareOp;
+                break;
+            case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT:
+                libraryState.renderPass = state.renderPass;
+                libraryState.subpass = state.subpass;
+                libraryState.sampleCount = state.sampleCount;
+                libraryState.colorAttachmentCount = state.colorAttachmentCount;
+                libraryState.blend = state.blend;
+                libraryState.colorWriteMask = state.colorWriteMask;
+                break;
+            default:
+                break;
+        }
+        return libraryState;
+    }
+}
+
+PipelineStateCache::~PipelineStateCache() {
+    clear();
+}
+
+bool PipelineStateCache::isPipelineLibrarySupported(VkInstance instance, VkPhysicalDevice physicalDevice) {
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+
+    std::vector<VkExtensionProperties> extensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensions.data());
+
+    const auto hasExtension = [&extensions](const char* extensionName) {
+        return std::ranges::any_of(extensions, [extensionName](const VkExtensionProperties& extension) {
+            return std::strcmp(extension.extensionName, extensionName) == 0;
+        });
+    };
+    if (!hasExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) || !hasExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME)) {
+        return false;
+    }
+    // Vulkan 1.0 에서는 VK_KHR_get_physical_device_properties2 로 질의 (instance 에 켜지 않았으면 nullptr)
+    const auto getFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+        vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")
+    );
+    const auto getProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(
+        vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR")
+    );
+
+    if (getFeatures2 == nullptr || getProperties2 == nullptr) {
+        return false;
+    }
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT libraryFeatures {};
+    libraryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+
+    VkPhysicalDeviceFeatures2KHR features {};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+    features.pNext = &libraryFeatures;
+    getFeatures2(physicalDevice, &features);
+
+    VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT libraryProperties {};
+    libraryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+
+    VkPhysicalDeviceProperties2KHR properties {};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+    properties.pNext = &libraryProperties;
+    getProperties2(physicalDevice, &properties);
+
+    return libraryFeatures.graphicsPipelineLibrary == VK_TRUE && libraryProperties.graphicsPipelineLibraryFastLinking == VK_TRUE;
+}
+
+PipelineHandle PipelineStateCache::getPipeline(ResourceRegistry& resources, const GraphicsPipelineState& state) {
+    const uint64_t hash = state.hash();
+
+    if (Entry* entry = find(hash, state)) {
+        if (!entry->handle.isValid()) {
+            complete(resources, *entry);
+        }
+        if (entry->exception) {
+            std::rethrow_exception(entry->exception);
+        }
+        m_hitCount++;
+        return entry->handle;
+    }
+    m_missCount++;
+
+    // 생성에 실패하면 entry 를 남기지 않음
+    if (!m_usePipelineLibraries) {
+        const VkPipeline pipeline = EngineComponentFactory::createGraphicsPipeline(m_device, state);
+        Entry& entry = insert(hash, state);
+        entry.handle = resources.pipelines.create(pipeline);
+        return entry.handle;
+    }
+    const Libraries libraries = getLibraries(state, false);
+
+    if (const std::exception_ptr exception = waitForLibraries(libraries)) {
+        std::rethrow_exception(exception);
+    }
+    const VkPipeline pipeline = link(state, libraries, false);
+    Entry& entry = insert(hash, state);
+    entry.libraries = libraries;
+    registerLinked(resources, entry, pipeline);
+    return entry.handle;
+}
+
+PipelineHandle PipelineStateCache::getPipelineAsync(ResourceRegistry& resources, const GraphicsPipelineState& state, PipelineHandle fallback) {
+    const uint64_t hash = state.hash();
+
+    if (Entry* entry = find(hash, state)) {
+        if (!entry->handle.isValid()) {
+            if (!isReady(*entry)) {
+                m_fallbackCount++;
+                return fallback;
+            }
+            complete(resources, *entry);
+        }
+        if (entry->exception) {
+            std::rethrow_exception(entry->exception);
+        }
+        m_hitCount++;
+        return entry->handle;
+    }
+    m_missCount++;
+
+    Entry& entry = insert(hash, state);
+    m_pendingCount++;
+
+    if (m_usePipelineLibraries) {
+        entry.entryState = EntryState::WAITING_LIBRARIES;
+        entry.libraries = getLibraries(state, true);
+
+        // 필요한 library 가 이미 모두 있으면 fast link 만 하므로 바로 반환
+        if (isReady(entry)) {
+            complete(resources, entry);
+
+            if (entry.exception) {
+                std::rethrow_exception(entry.exception);
+            }
+            return entry.handle;
+        }
+    } else {
+        entry.entryState = EntryState::CREATING;
+
+        // 워커에서는 Vulkan 객체만 만들고, registry 등록은 요청한 스레드가 complete 에서 함
+        m_jobSystem.run([device = m_device, &entry] {
+            try {
+                entry.pipeline = EngineComponentFactory::createGraphicsPipeline(device, entry.state);
+            } catch (...) {
+                entry.exception = std::current_exception();
+            }
+        }, &entry.counter);
+    }
+    m_fallbackCount++;
+    return fallback;
+}
+
+void PipelineStateCache::prepareLibraries(const GraphicsPipelineState& state) {
+    if (m_usePipelineLibraries) {
+        getLibraries(state, true);
+    }
+}
+
+void PipelineStateCache::collect(ResourceRegistry& resources, DeletionQueue& deletionQueue) {
+    for (size_t index = 0; index < m_optimizingEntries.size();) {
+        Entry& entry = *m_optimizingEntries[index];
+
+        if (!entry.counter.isDone()) {
+            index++;
+            continue;
+        }
+        m_jobSystem.wait(entry.counter);
+        entry.entryState = EntryState::READY;
+
+        // 최적화 link 에 실패했으면 fast link 한 pipeline 을 계속 씀
+        if (entry.pipeline != VK_NULL_HANDLE) {
+            VkPipeline* pipeline = resources.pipelines.get(entry.handle);
+
+            // 이미 record 한 command buffer 가 fast link 한 pipeline 을 쓰고 있을 수 있음
+            if (pipeline != nullptr) {
+                deletionQueue.retire(*pipeline);
+                *pipeline = entry.pipeline;
+                m_optimizedCount++;
+            } else {
+                deletionQueue.retire(entry.pipeline);
+            }
+            entry.pipeline = VK_NULL_HANDLE;
+        }
+        m_optimizingEntries[index] = m_optimizingEntries.back();
+        m_optimizingEntries.pop_back();
+    }
+}
+
+void PipelineStateCache::clear() {
+    // library 와 registry 에 넘기지 못한 pipeline 은 GPU 가 쓴 적이 없으므로 바로 파괴
+    for (const auto& [hash, bucket] : m_entries) {
+        for (const std::unique_ptr<Entry>& entry : bucket) {
+            m_jobSystem.wait(entry->counter);
+
+            if (entry->pipeline != VK_NULL_HANDLE) {
+                vkDestroyPipeline(m_device, entry->pipeline, HostAllocators::getCallbacks(VK_OBJECT_TYPE_PIPELINE));
+            }
+        }
+    }
+    for (const auto& [hash, bucket] : m_libraries) {
+        for (const std::unique_ptr<LibraryEntry>& library : bucket) {
+            m_jobSystem.wait(library->counter);
+
+            if (library->library != VK_NULL_HANDLE) {
+                vkDestroyPipeline(m_device, library->library, HostAllocators::getCallbacks(VK_OBJECT_TYPE_PIPELINE));
+            }
+        }
+    }
+    m_entries.clear();
+    m_libraries.clear();
+    m_optimizingEntries.clear();
+    m_pipelineCount = 0;
+    m_libraryCount = 0;
+    m_pendingCount = 0;
+}
+
+PipelineStateCache::Entry* PipelineStateCache::find(uint64_t hash, const GraphicsPipelineState& state) {
+    auto bucket = m_entries.find(hash);
+
+    if (bucket == m_entries.end()) {
+        return nullptr;
+    }
+    for (const std::unique_ptr<Entry>& entry : bucket->second) {
+        if (entry->state == state) {
+            return entry.get();
+        }
+    }
+    return nullptr;
+}
+
+PipelineStateCache::Entry& PipelineStateCache::insert(uint64_t hash, const GraphicsPipelineState& state) {
+    auto entry = std::make_unique<Entry>();
+    entry->state = state;
+    m_pipelineCount++;
+    return *m_entries[hash].emplace_back(std::move(entry));
+}
+
+PipelineStateCache::Libraries PipelineStateCache::getLibraries(const GraphicsPipelineState& state, bool isAsync) {
+    Libraries libraries {};
+
+    for (size_t index = 0; index < LIBRARY_PART_COUNT; index++) {
+        const VkGraphicsPipelineLibraryFlagsEXT part = LIBRARY_PARTS[index];
+        const GraphicsPipelineState libraryState = createLibraryState(state, part);
+        std::vector<std::unique_ptr<LibraryEntry>>& bucket = m_libraries[Hashes::hashValue(part, libraryState.hash())];
+
+        auto existing = std::ranges::find_if(bucket, [&](const std::unique_ptr<LibraryEntry>& library) {
+            return library->part == part && library->state == libraryState;
+        });
+
+        if (existing != bucket.end()) {
+            libraries[index] = existing->get();
+            continue;
+        }
+        auto created = std::make_unique<LibraryEntry>();
+        created->state = libraryState;
+        created->part = part;
+
+        LibraryEntry& library = *bucket.emplace_back(std::move(created));
+        libraries[index] = &library;
+        m_libraryCount++;
+
+        // 실패는 library 에 남겨 이 library 를 쓰는 요청마다 전달
+        auto createLibrary = [device = m_device, &library] {
+            try {
+                library.library = EngineComponentFactory::createGraphicsPipeline(device, library.state, library.part);
+            } catch (...) {
+                library.exception = std::current_exception();
+            }
+        };
+
+        if (isAsync) {
+            m_jobSystem.run(std::move(createLibrary), &library.counter);
+        } else {
+            createLibrary();
+        }
+    }
+    return libraries;
+}
+
+bool PipelineStateCache::isReady(const Entry& entry) const {
+    switch (entry.entryState) {
+        case EntryState::CREATING:
+            return entry.counter.isDone();
+        case EntryState::WAITING_LIBRARIES:
+            return std::ranges::all_of(entry.libraries, [](const LibraryEntry* library) {
+                return library->counter.isDone();
+            });
+        default:
+            return true;
+    }
+}
+
+std::exception_ptr PipelineStateCache::waitForLibraries(const Libraries& libraries) {
+    std::exception_ptr exception {};
+
+    for (const LibraryEntry* library : libraries) {
+        m_jobSystem.wait(library->counter);
+
+        if (library->exception && !exception) {
+            exception = library->exception;
+        }
+    }
+    return exception;
+}
+
+VkPipeline PipelineStateCache::link(const GraphicsPipelineState& state, const Libraries& libraries, bool isOptimized) const {
+    std::array<VkPipeline, LIBRARY_PART_COUNT> libraryPipelines {};
+
+    std::ranges::transform(libraries, libraryPipelines.begin(), &LibraryEntry::library);
+    return EngineComponentFactory::linkGraphicsPipeline(m_device, state.layout, libraryPipelines, isOptimized);
+}
+
+void PipelineStateCache::registerLinked(ResourceRegistry& resources, Entry& entry, VkPipeline pipeline) {
+    entry.handle = resources.pipelines.create(pipeline);
+    entry.entryState = EntryState::OPTIMIZING;
+    m_optimizingEntries.push_back(&entry);
+
+    // library 에 남긴 link time optimization 정보로 monolithic 과 같은 수준의 pipeline 을 다시 만듦
+    m_jobSystem.run([this, &entry] {
+        try {
+            entry.pipeline = link(entry.state, entry.libraries, true);
+        } catch (...) {
+            // collect 에서 fast link 한 pipeline 을 그대로 둠
+        }
+    }, &entry.counter);
+}
+
+void PipelineStateCache::complete(ResourceRegistry& resources, Entry& entry) {
+    if (entry.entryState == EntryState::CREATING) {
+        // 이미 끝났으면 바로 반환. job 이 counter 의 잠금을 놓을 때까지 기다리는 의미도 있음
+        m_jobSystem.wait(entry.counter);
+        entry.entryState = EntryState::READY;
+        m_pendingCount--;
+
+        if (entry.pipeline != VK_NULL_HANDLE) {
+            entry.handle = resources.pipelines.create(entry.pipeline);
+            entry.pipeline = VK_NULL_HANDLE;
+        }
+        return;
+    }
+    if (entry.entryState != EntryState::WAITING_LIBRARIES) {
+        return;
+    }
+    entry.entryState = EntryState::READY;
+    m_pendingCount--;
+    entry.exception = waitForLibraries(entry.libraries);
+
+    if (entry.exception) {
+        return;
+    }
+    VkPipeline pipeline;
+
+    try {
+        pipeline = link(entry.state, entry.libraries, false);
+    } catch (...) {
+        entry.exception = std::current_exception();
+        return;
+    }
+    registerLinked(resources, entry, pipeline);
+}
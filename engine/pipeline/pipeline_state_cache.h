@@ -0,0 +1,172 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+#include "graphics_pipeline_state.h"
+#include "../resource/deletion_queue.h"
+#include "../resource/resource_registry.h"
+#include "../thread/job_system.h"
+
+// GraphicsPipelineState 를 hash 로 보관해 같은 상태의 요청에는 같은 pipeline 을 반환하고, 처음 보는 조합은 요청 시점에 만듦
+// VK_EXT_graphics_pipeline_library 를 쓰면 vertex input / pre-rasterization / fragment shader / fragment output 을
+// 따로 library 로 만들어 두고, 새 조합은 library 를 빠르게 link 해서 바로 쓰고 최적화 link 는 job 으로 만들어 collect 에서 교체
+// pipeline 의 소유권은 ResourceRegistry 에 있으므로 registry 를 비우면 clear 필요
+// 요청은 한 스레드 (render thread) 에서만 호출. 생성과 최적화 link 만 JobSystem 의 워커에서 실행됨
+class PipelineStateCache {
+public:
+    // usePipelineLibraries 는 device 에 graphics pipeline library 를 켰을 때만 true
+    PipelineStateCache(VkDevice device, JobSystem& jobSystem, bool usePipelineLibraries = false)
+        : m_device(device), m_jobSystem(jobSystem), m_usePipelineLibraries(usePipelineLibraries) {}
+
+    PipelineStateCache(const PipelineStateCache&) = delete;
+    PipelineStateCache& operator=(const PipelineStateCache&) = delete;
+
+    ~PipelineStateCache();
+
+    // extension 과 feature 가 있고 fast linking 을 지원하는지. 없으면 link 가 monolithic 생성만큼 느릴 수 있어 쓰지 않음
+    static bool isPipelineLibrarySupported(VkInstance instance, VkPhysicalDevice physicalDevice);
+
+    // 없으면 바로 만듦. 비동기로 만드는 중이면 끝날 때까지 대기
+    PipelineHandle getPipeline(ResourceRegistry& resources, const GraphicsPipelineState& state);
+
+    // 없으면 job 으로 만들기 시작하고, 끝나기 전까지는 fallback 을 반환 (draw 가 멈추지 않도록)
+    // library 를 쓰면 필요한 library 가 이미 있을 때 바로 link 해서 반환
+    // 생성에 실패했으면 그 뒤의 요청에서 예외
+    PipelineHandle getPipelineAsync(ResourceRegistry& resources, const GraphicsPipelineState& state, PipelineHandle fallback);
+
+    // library 만 미리 만들어 둠 (로딩 중 호출). 이후 같은 shader / 상태의 요청은 link 만 함
+    void prepareLibraries(const GraphicsPipelineState& state);
+
+    // 끝난 최적화 link 로 registry 의 pipeline 을 교체 (handle 은 그대로). 이전 pipeline 은 GPU 가 끝낸 뒤 파괴
+    // frame 시작마다 호출
+    void collect(ResourceRegistry& resources, DeletionQueue& deletionQueue);
+
+    // 만드는 중인 job 을 기다리고, registry 에 넘기지 못한 pipeline 과 library 는 직접 파괴
+    void clear();
+
+    [[nodiscard]]
+    bool isUsingPipelineLibraries() const {
+        return m_usePipelineLibraries;
+    }
+
+    // 만들었거나 만드는 중인 pipeline 수
+    [[nodiscard]]
+    size_t size() const {
+        return m_pipelineCount;
+    }
+
+    [[nodiscard]]
+    size_t getLibraryCount() const {
+        return m_libraryCount;
+    }
+
+    // 이미 만든 pipeline 으로 처리된 요청 수
+    [[nodiscard]]
+    uint64_t getHitCount() const {
+        return m_hitCount;
+    }
+
+    // 새 pipeline 을 만들기 시작한 요청 수
+    [[nodiscard]]
+    uint64_t getMissCount() const {
+        return m_missCount;
+    }
+
+    // 만드는 중이라 fallback 을 반환한 요청 수
+    [[nodiscard]]
+    uint64_t getFallbackCount() const {
+        return m_fallbackCount;
+    }
+
+    // 아직 쓸 수 있는 pipeline 이 없는 요청 수
+    [[nodiscard]]
+    size_t getPendingCount() const {
+        return m_pendingCount;
+    }
+
+    // fast link 로 쓰는 중이고 최적화 link 를 기다리는 pipeline 수
+    [[nodiscard]]
+    size_t getOptimizingCount() const {
+        return m_optimizingEntries.size();
+    }
+
+    // 최적화 link 로 교체된 pipeline 수
+    [[nodiscard]]
+    uint64_t getOptimizedCount() const {
+        return m_optimizedCount;
+    }
+
+private:
+    // VkGraphicsPipelineLibraryFlagBitsEXT 순서
+    static constexpr size_t LIBRARY_PART_COUNT = 4;
+
+    struct LibraryEntry {
+        // 이 부분에 쓰이지 않는 필드는 기본값으로 비운 상태
+        GraphicsPipelineState state;
+        VkGraphicsPipelineLibraryFlagsEXT part;
+        // job 으로 만들면 counter 가 0 이 된 뒤에 읽음
+        JobCounter counter;
+        VkPipeline library = VK_NULL_HANDLE;
+        std::exception_ptr exception;
+    };
+
+    using Libraries = std::array<LibraryEntry*, LIBRARY_PART_COUNT>;
+
+    enum class EntryState {
+        // monolithic pipeline 을 job 으로 만드는 중
+        CREATING,
+        // library 가 job 으로 만들어지길 기다리는 중
+        WAITING_LIBRARIES,
+        // fast link 한 pipeline 을 쓰면서 최적화 link 를 기다리는 중
+        OPTIMIZING,
+        READY,
+    };
+
+    struct Entry {
+        GraphicsPipelineState state;
+        EntryState entryState = EntryState::READY;
+        PipelineHandle handle;
+        // library 를 쓰지 않으면 모두 nullptr
+        Libraries libraries {};
+        // 아래는 job 이 쓰고 counter 가 0 이 된 뒤에 요청한 스레드가 읽음
+        JobCounter counter;
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        std::exception_ptr exception;
+    };
+
+    Entry* find(uint64_t hash, const GraphicsPipelineState& state);
+    Entry& insert(uint64_t hash, const GraphicsPipelineState& state);
+
+    // 없는 library 를 만듦. isAsync 면 job 으로 만들기 시작만 함
+    Libraries getLibraries(const GraphicsPipelineState& state, bool isAsync);
+    [[nodiscard]]
+    bool isReady(const Entry& entry) const;
+    // library 를 기다린 뒤 실패한 것이 있으면 그 예외
+    std::exception_ptr waitForLibraries(const Libraries& libraries);
+    VkPipeline link(const GraphicsPipelineState& state, const Libraries& libraries, bool isOptimized) const;
+    // fast link 한 pipeline 을 등록하고 최적화 link 를 시작
+    void registerLinked(ResourceRegistry& resources, Entry& entry, VkPipeline pipeline);
+    // 끝난 (또는 기다린) job 의 결과를 registry 에 등록. 실패하면 entry.exception 에 남김
+    void complete(ResourceRegistry& resources, Entry& entry);
+
+    VkDevice                    m_device;
+    JobSystem&                  m_jobSystem;
+    bool                        m_usePipelineLibraries;
+    // hash 충돌 시 같은 bucket 에서 상태로 비교. job 이 Entry 를 가리키므로 주소가 바뀌지 않도록 unique_ptr
+    std::unordered_map<uint64_t, std::vector<std::unique_ptr<Entry>>> m_entries;
+    std::unordered_map<uint64_t, std::vector<std::unique_ptr<LibraryEntry>>> m_libraries;
+    std::vector<Entry*>         m_optimizingEntries;
+    size_t                      m_pipelineCount = 0;
+    size_t                      m_libraryCount = 0;
+    size_t                      m_pendingCount = 0;
+    uint64_t                    m_hitCount = 0;
+    uint64_t                    m_missCount = 0;
+    uint64_t                    m_fallbackCount = 0;
+    uint64_t                    m_optimizedCount = 0;
+};
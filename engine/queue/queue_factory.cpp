@@ -28,6 +28,16 @@ QueueFamilyIndices QueueFactory::getQueueFamilyIndices(VkPhysicalDevice physical
     QueueFamilyIndices queueFamilyIndices {};
     std::vector<VkQueueFamilyProperties> queueFamilyPropertiesList = getQueueFamilyProperties(physicalDevice);
 
+    // 같은 family 면 swapchain image 의 소유권을 넘기는 barrier 와 present queue 의 submit 이 필요 없음
+    for (int index = 0; auto& queueFamilyProperties : queueFamilyPropertiesList) {
+        if (supportsGraphics(queueFamilyProperties) && supportsPresentation(physicalDevice, index, surface)) {
+            queueFamilyIndices.graphicsFamily = index;
+            queueFamilyIndices.presentFamily = index;
+            return queueFamilyIndices;
+        }
+        index++;
+    }
+    // 없으면 각각 처음 찾은 family
     for (int index = 0; auto& queueFamilyProperties : queueFamilyPropertiesList) {
         if (!queueFamilyIndices.hasGraphicsFamily() && supportsGraphics(queueFamilyProperties)) {
             queueFamilyIndices.graphicsFamily = index;
@@ -43,6 +53,49 @@ QueueFamilyIndices QueueFactory::getQueueFamilyIndices(VkPhysicalDevice physical
     return queueFamilyIndices;
 }
 
+bool QueueFactory::supportsOwnershipTransfer(const VkQueueFamilyProperties& queueFamilyProperties) {
+    constexpr VkQueueFlags barrierQueueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+    return (queueFamilyProperties.queueFlags & barrierQueueFlags) != 0;
+}
+
+PresentSharing QueueFactory::getPresentSharing(VkPhysicalDevice physicalDevice, const QueueFamilyIndices& queueFamilyIndices) {
+    if (queueFamilyIndices.isUnified()) {
+        return PresentSharing::UNIFIED;
+    }
+    // CONCURRENT 는 driver 가 image 압축을 끌 수 있어 가능하면 EXCLUSIVE 로 두고 소유권을 넘김
+    std::vector<VkQueueFamilyProperties> queueFamilyPropertiesList = getQueueFamilyProperties(physicalDevice);
+
+    if (supportsOwnershipTransfer(queueFamilyPropertiesList[queueFamilyIndices.presentFamily.value()])) {
+        return PresentSharing::OWNERSHIP_TRANSFER;
+    }
+    return PresentSharing::CONCURRENT;
+}
+
+VkImageMemoryBarrier QueueFactory::createOwnershipTransferBarrier(
+    VkImage image,
+    VkImageLayout layout,
+    uint32_t srcQueueFamilyIndex,
+    uint32_t dstQueueFamilyIndex,
+    VkAccessFlags srcAccessMask
+) {
+    // acquire 쪽의 srcAccessMask 는 무시되고, present 는 memory 접근이 아니라 dstAccessMask 는 0
+    VkImageMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.image = image;
+    barrier.oldLayout = layout;
+    barrier.newLayout = layout;
+    barrier.srcAccessMask = srcAccessMask;
+    barrier.dstAccessMask = 0;
+    barrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+    barrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+    return barrier;
+}
+
 VkDeviceQueueCreateInfo QueueFactory::createDeviceQueueCreateInfo(const float* queuePriority, uint32_t queueFamilyIndex) {
     VkDeviceQueueCreateInfo queueCreateInfo {};
     queueCreateInfo.queueCount = 1;
@@ -66,4 +119,10 @@ std::vector<VkDeviceQueueCreateInfo> QueueFactory::createQueueCreateInfos(
         queueCreateInfoList.push_back(queueCreateInfo);
     }
     return queueCreateInfoList;
+}
+
+VkQueue QueueFactory::getDeviceQueue(VkDevice device, uint32_t queueFamilyIndex) {
+    VkQueue queue;
+    vkGetDeviceQueue(device, queueFamilyIndex, 0, &queue);
+    return queue;
 }
\ No newline at end of file
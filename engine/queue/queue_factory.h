@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <set>
 #include <vector>
 #include <vulkan/vulkan_core.h>
@@ -20,6 +21,11 @@ struct QueueFamilyIndices {
         return hasGraphicsFamily() && hasPresentFamily();
     }
 
+    // 한 family 가 그리기와 present 를 모두 맡음
+    bool isUnified() const {
+        return isComplete() && graphicsFamily.value() == presentFamily.value();
+    }
+
     std::set<uint32_t> getUniqueQueueIndexSet() {
         return {
             graphicsFamily.value(),
@@ -28,13 +34,38 @@ struct QueueFamilyIndices {
     }
 };
 
+// graphics queue 가 그린 swapchain image 를 present queue 가 쓰는 방식
+enum class PresentSharing {
+    // 같은 family 라 넘길 필요 없음
+    UNIFIED,
+    // EXCLUSIVE swapchain. graphics queue 에서 release, present queue 에서 acquire barrier 로 소유권을 넘김
+    OWNERSHIP_TRANSFER,
+    // present family 가 barrier 를 기록할 수 없어 CONCURRENT swapchain 으로 두 family 가 공유
+    CONCURRENT,
+};
+
 namespace QueueFactory {
 
     std::vector<VkQueueFamilyProperties> getQueueFamilyProperties(VkPhysicalDevice physicalDevice);
 
     // Device의 Queue Family 위치를 가져옴 (graphics index, presentation index)
+    // 둘 다 지원하는 family 가 있으면 그 family 하나를 씀
     QueueFamilyIndices getQueueFamilyIndices(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface);
 
+    // vkCmdPipelineBarrier 를 기록할 수 있는 family 인지 (graphics, compute, transfer 중 하나)
+    bool supportsOwnershipTransfer(const VkQueueFamilyProperties& queueFamilyProperties);
+
+    PresentSharing getPresentSharing(VkPhysicalDevice physicalDevice, const QueueFamilyIndices& queueFamilyIndices);
+
+    // srcQueueFamilyIndex 에서 dstQueueFamilyIndex 로 소유권을 넘기는 barrier. release 와 acquire 에 같은 값으로 기록
+    VkImageMemoryBarrier createOwnershipTransferBarrier(
+        VkImage image,
+        VkImageLayout layout,
+        uint32_t srcQueueFamilyIndex,
+        uint32_t dstQueueFamilyIndex,
+        VkAccessFlags srcAccessMask
+    );
+
     VkDeviceQueueCreateInfo createDeviceQueueCreateInfo(const float* queuePriority, uint32_t queueFamilyIndex);
 
     std::vector<VkDeviceQueueCreateInfo> createQueueCreateInfos(
@@ -42,5 +73,7 @@ namespace QueueFactory {
         VkSurfaceKHR surface,
         const float* queuePriority
     );
+
+    VkQueue getDeviceQueue(VkDevice device, uint32_t queueFamilyIndex);
 }
 
@@ -0,0 +1,145 @@
+#include "deletion_queue.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "../memory/host_allocator.h"
+#include "../memory/memory_budget.h"
+
+DeletionQueue::~DeletionQueue() {
+    // Engine 이 먼저 flush 해야 함. 남아있다면 누수 대신 파괴
+    flush();
+}
+
+void DeletionQueue::retire(VkObjectType objectType, uint64_t handle, uint64_t lastUsedValue) {
+    std::lock_guard lock { m_mutex };
+
+    const RetiredHandle retiredHandle { objectType, handle, lastUsedValue };
+
+    // 대부분 현재 frame 으로 들어오므로 뒤에 붙이는 경우가 일반적
+    if (m_pending.empty() || m_pending.back().retireValue <= lastUsedValue) {
+        m_pending.push_back(retiredHandle);
+        return;
+    }
+    const auto position = std::ranges::upper_bound(m_pending, lastUsedValue, {}, &RetiredHandle::retireValue);
+    m_pending.insert(position, retiredHandle);
+}
+
+void DeletionQueue::advance(uint64_t recordingValue, uint64_t completedValue) {
+    {
+        std::lock_guard lock { m_mutex };
+        m_recordingValue = recordingValue;
+    }
+    collect(completedValue);
+}
+
+void DeletionQueue::collect(uint64_t completedValue) {
+    std::vector<RetiredHandle> batch {};
+    {
+        std::lock_guard lock { m_mutex };
+        const auto end = std::ranges::upper_bound(m_pending, completedValue, {}, &RetiredHandle::retireValue);
+        batch.assign(m_pending.begin(), end);
+        m_pending.erase(m_pending.begin(), end);
+    }
+    // lock 밖에서 파괴하여 다른 thread 의 retire 를 막지 않음
+    for (const RetiredHandle& retiredHandle : batch) {
+        destroy(retiredHandle);
+    }
+}
+
+void DeletionQueue::flush() {
+    std::deque<RetiredHandle> batch {};
+    {
+        std::lock_guard lock { m_mutex };
+        batch.swap(m_pending);
+    }
+    for (const RetiredHandle& retiredHandle : batch) {
+        destroy(retiredHandle);
+    }
+}
+
+uint64_t DeletionQueue::getRecordingValue() const {
+    std::lock_guard lock { m_mutex };
+    return m_recordingValue;
+}
+
+size_t DeletionQueue::getPendingCount() const {
+    std::lock_guard lock { m_mutex };
+    return m_pending.size();
+}
+
+template<typename T>
+T toVulkanHandle(uint64_t handle) {
+    return reinterpret_cast<T>(handle);
+}
+
+void DeletionQueue::destroy(const RetiredHandle& retiredHandle) const {
+    const uint64_t handle = retiredHandle.handle;
+    // 생성 시 넘긴 것과 같은 object type 의 callbacks
+    const VkAllocationCallbacks* allocator = HostAllocators::getCallbacks(retiredHandle.objectType);
+
+    switch (retiredHandle.objectType) {
+        case VK_OBJECT_TYPE_BUFFER:
+            vkDestroyBuffer(m_device, toVulkanHandle<VkBuffer>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_BUFFER_VIEW:
+            vkDestroyBufferView(m_device, toVulkanHandle<VkBufferView>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_IMAGE:
+            vkDestroyImage(m_device, toVulkanHandle<VkImage>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_IMAGE_VIEW:
+            vkDestroyImageView(m_device, toVulkanHandle<VkImageView>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_SAMPLER:
+            vkDestroySampler(m_device, toVulkanHandle<VkSampler>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_DEVICE_MEMORY:
+            vkFreeMemory(m_device, toVulkanHandle<VkDeviceMemory>(handle), allocator);
+
+            if (m_memoryBudget != nullptr) {
+                m_memoryBudget->onFree(toVulkanHandle<VkDeviceMemory>(handle));
+            }
+            break;
+        case VK_OBJECT_TYPE_SHADER_MODULE:
+            vkDestroyShaderModule(m_device, toVulkanHandle<VkShaderModule>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_PIPELINE:
+            vkDestroyPipeline(m_device, toVulkanHandle<VkPipeline>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_PIPELINE_LAYOUT:
+            vkDestroyPipelineLayout(m_device, toVulkanHandle<VkPipelineLayout>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_RENDER_PASS:
+            vkDestroyRenderPass(m_device, toVulkanHandle<VkRenderPass>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_FRAMEBUFFER:
+            vkDestroyFramebuffer(m_device, toVulkanHandle<VkFramebuffer>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT:
+            vkDestroyDescriptorSetLayout(m_device, toVulkanHandle<VkDescriptorSetLayout>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_DESCRIPTOR_POOL:
+            vkDestroyDescriptorPool(m_device, toVulkanHandle<VkDescriptorPool>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_COMMAND_POOL:
+            vkDestroyCommandPool(m_device, toVulkanHandle<VkCommandPool>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_SEMAPHORE:
+            vkDestroySemaphore(m_device, toVulkanHandle<VkSemaphore>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_FENCE:
+            vkDestroyFence(m_device, toVulkanHandle<VkFence>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_QUERY_POOL:
+            vkDestroyQueryPool(m_device, toVulkanHandle<VkQueryPool>(handle), allocator);
+            break;
+        case VK_OBJECT_TYPE_SWAPCHAIN_KHR:
+            vkDestroySwapchainKHR(m_device, toVulkanHandle<VkSwapchainKHR>(handle), allocator);
+            break;
+        default:
+            std::cerr << "unsupported object type in deletion queue: " << retiredHandle.objectType << std::endl;
+            break;
+    }
+}
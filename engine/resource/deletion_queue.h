@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vulkan/vulkan_core.h>
+
+// Vulkan handle 타입 -> VkObjectType 매핑
+template<typename T>
+struct VulkanObjectTraits;
+
+#define DECLARE_VULKAN_OBJECT_TRAITS(HandleType, ObjectType)   \
+    template<>                                                  \
+    struct VulkanObjectTraits<HandleType> {                     \
+        static constexpr VkObjectType objectType = ObjectType;  \
+    };
+
+DECLARE_VULKAN_OBJECT_TRAITS(VkBuffer,              VK_OBJECT_TYPE_BUFFER)
+DECLARE_VULKAN_OBJECT_TRAITS(VkBufferView,          VK_OBJECT_TYPE_BUFFER_VIEW)
+DECLARE_VULKAN_OBJECT_TRAITS(VkImage,               VK_OBJECT_TYPE_IMAGE)
+DECLARE_VULKAN_OBJECT_TRAITS(VkImageView,           VK_OBJECT_TYPE_IMAGE_VIEW)
+DECLARE_VULKAN_OBJECT_TRAITS(VkSampler,             VK_OBJECT_TYPE_SAMPLER)
+DECLARE_VULKAN_OBJECT_TRAITS(VkDeviceMemory,        VK_OBJECT_TYPE_DEVICE_MEMORY)
+DECLARE_VULKAN_OBJECT_TRAITS(VkShaderModule,        VK_OBJECT_TYPE_SHADER_MODULE)
+DECLARE_VULKAN_OBJECT_TRAITS(VkPipeline,            VK_OBJECT_TYPE_PIPELINE)
+DECLARE_VULKAN_OBJECT_TRAITS(VkPipelineLayout,      VK_OBJECT_TYPE_PIPELINE_LAYOUT)
+DECLARE_VULKAN_OBJECT_TRAITS(VkRenderPass,          VK_OBJECT_TYPE_RENDER_PASS)
+DECLARE_VULKAN_OBJECT_TRAITS(VkFramebuffer,         VK_OBJECT_TYPE_FRAMEBUFFER)
+DECLARE_VULKAN_OBJECT_TRAITS(VkDescriptorSetLayout, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT)
+DECLARE_VULKAN_OBJECT_TRAITS(VkDescriptorPool,      VK_OBJECT_TYPE_DESCRIPTOR_POOL)
+DECLARE_VULKAN_OBJECT_TRAITS(VkCommandPool,         VK_OBJECT_TYPE_COMMAND_POOL)
+DECLARE_VULKAN_OBJECT_TRAITS(VkSemaphore,           VK_OBJECT_TYPE_SEMAPHORE)
+DECLARE_VULKAN_OBJECT_TRAITS(VkFence,               VK_OBJECT_TYPE_FENCE)
+DECLARE_VULKAN_OBJECT_TRAITS(VkQueryPool,           VK_OBJECT_TYPE_QUERY_POOL)
+DECLARE_VULKAN_OBJECT_TRAITS(VkSwapchainKHR,        VK_OBJECT_TYPE_SWAPCHAIN_KHR)
+
+#undef DECLARE_VULKAN_OBJECT_TRAITS
+
+class MemoryBudget;
+
+struct RetiredHandle {
+    VkObjectType objectType;
+    uint64_t handle;
+    // 이 값 이하의 frame(timeline value)을 GPU가 완료하면 파괴 가능
+    uint64_t retireValue;
+};
+
+// GPU가 마지막으로 사용한 frame 이 끝난 뒤에 handle 을 일괄 파괴하는 큐
+class DeletionQueue {
+public:
+    explicit DeletionQueue(VkDevice device) : m_device(device) {}
+
+    DeletionQueue(const DeletionQueue&) = delete;
+    DeletionQueue& operator=(const DeletionQueue&) = delete;
+
+    ~DeletionQueue();
+
+    template<typename T>
+    void retire(T handle) {
+        retire(handle, getRecordingValue());
+    }
+
+    template<typename T>
+    void retire(T handle, uint64_t lastUsedValue) {
+        if (handle == VK_NULL_HANDLE) {
+            return;
+        }
+        retire(VulkanObjectTraits<T>::objectType, reinterpret_cast<uint64_t>(handle), lastUsedValue);
+    }
+
+    void retire(VkObjectType objectType, uint64_t handle, uint64_t lastUsedValue);
+
+    // CPU가 기록 중인 frame 과 GPU가 완료한 frame 을 갱신하고, 완료된 handle 을 파괴
+    void advance(uint64_t recordingValue, uint64_t completedValue);
+
+    // completedValue 이하로 태그된 handle 을 모두 파괴
+    void collect(uint64_t completedValue);
+
+    // 남은 handle 을 모두 파괴 (호출 전 vkDeviceWaitIdle 필요)
+    void flush();
+
+    [[nodiscard]]
+    uint64_t getRecordingValue() const;
+
+    [[nodiscard]]
+    size_t getPendingCount() const;
+
+    // 파괴하는 VkDeviceMemory 를 budget 에서 빼고, 할당하는 쪽도 이 budget 으로 집계
+    void setMemoryBudget(MemoryBudget* memoryBudget) {
+        m_memoryBudget = memoryBudget;
+    }
+
+    [[nodiscard]]
+    MemoryBudget* getMemoryBudget() const {
+        return m_memoryBudget;
+    }
+
+private:
+    void destroy(const RetiredHandle& retiredHandle) const;
+
+    VkDevice                    m_device;
+    mutable std::mutex          m_mutex;
+    // retireValue 오름차순 유지
+    std::deque<RetiredHandle>   m_pending;
+    uint64_t                    m_recordingValue = 0;
+    MemoryBudget*               m_memoryBudget = nullptr;
+};
+
+// 소멸 시 DeletionQueue 에 자동으로 retire 되는 Vulkan handle 래퍼
+template<typename T>
+class UniqueHandle {
+public:
+    UniqueHandle() = default;
+
+    UniqueHandle(DeletionQueue* deletionQueue, T handle)
+        : m_deletionQueue(deletionQueue), m_handle(handle) {}
+
+    UniqueHandle(const UniqueHandle&) = delete;
+    UniqueHandle& operator=(const UniqueHandle&) = delete;
+
+    UniqueHandle(UniqueHandle&& other) noexcept
+        : m_deletionQueue(other.m_deletionQueue),
+          m_handle(std::exchange(other.m_handle, VK_NULL_HANDLE)),
+          m_lastUsedValue(other.m_lastUsedValue) {}
+
+    UniqueHandle& operator=(UniqueHandle&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_deletionQueue = other.m_deletionQueue;
+            m_handle = std::exchange(other.m_handle, VK_NULL_HANDLE);
+            m_lastUsedValue = other.m_lastUsedValue;
+        }
+        return *this;
+    }
+
+    ~UniqueHandle() {
+        reset();
+    }
+
+    // 이 handle 을 사용하는 명령을 기록한 frame 을 알림
+    void markUsed(uint64_t frameValue) {
+        if (frameValue > m_lastUsedValue) {
+            m_lastUsedValue = frameValue;
+        }
+    }
+
+    void reset() {
+        if (m_handle == VK_NULL_HANDLE || !m_deletionQueue) {
+            return;
+        }
+        const uint64_t recordingValue = m_deletionQueue->getRecordingValue();
+        m_deletionQueue->retire(m_handle, m_lastUsedValue > recordingValue ? m_lastUsedValue : recordingValue);
+        m_handle = VK_NULL_HANDLE;
+    }
+
+    [[nodiscard]]
+    T release() {
+        return std::exchange(m_handle, VK_NULL_HANDLE);
+    }
+
+    [[nodiscard]]
+    T get() const {
+        return m_handle;
+    }
+
+    explicit operator bool() const {
+        return m_handle != VK_NULL_HANDLE;
+    }
+
+private:
+    DeletionQueue*  m_deletionQueue = nullptr;
+    T               m_handle = VK_NULL_HANDLE;
+    uint64_t        m_lastUsedValue = 0;
+};
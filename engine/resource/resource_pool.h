@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// 32bit generational handle: 하위 20bit slot index, 상위 12bit generation
+// generation 은 1부터 시작하므로 value 0 은 항상 invalid
+template<typename Tag>
+struct ResourceHandle {
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+    static constexpr uint32_t MAX_INDEX = INDEX_MASK;
+
+    uint32_t value = 0;
+
+    static ResourceHandle of(uint32_t index, uint32_t generation) {
+        return { (generation << INDEX_BITS) | index };
+    }
+
+    [[nodiscard]]
+    uint32_t index() const {
+        return value & INDEX_MASK;
+    }
+
+    [[nodiscard]]
+    uint32_t generation() const {
+        return value >> INDEX_BITS;
+    }
+
+    [[nodiscard]]
+    bool isValid() const {
+        return value != 0;
+    }
+
+    bool operator==(const ResourceHandle&) const = default;
+};
+
+// handle 로 접근하는 dense 배열 저장소
+// 값은 연속 메모리에 유지되고 (swap-remove), 조회는 slot 한 번을 거쳐 O(1)
+template<typename T, typename Tag = T>
+class ResourcePool {
+public:
+    using Handle = ResourceHandle<Tag>;
+
+    void reserve(size_t capacity) {
+        m_values.reserve(capacity);
+        m_valueSlots.reserve(capacity);
+        m_slots.reserve(capacity);
+    }
+
+    Handle create(T value) {
+        uint32_t slotIndex;
+
+        if (!m_freeSlots.empty()) {
+            slotIndex = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            if (m_slots.size() > Handle::MAX_INDEX) {
+                throw std::runtime_error("resource pool is full!");
+            }
+            slotIndex = static_cast<uint32_t>(m_slots.size());
+            m_slots.push_back({ 0, 1 });
+        }
+        Slot& slot = m_slots[slotIndex];
+        slot.valueIndex = static_cast<uint32_t>(m_values.size());
+
+        m_values.push_back(std::move(value));
+        m_valueSlots.push_back(slotIndex);
+
+        return Handle::of(slotIndex, slot.generation);
+    }
+
+    [[nodiscard]]
+    bool contains(Handle handle) const {
+        const uint32_t slotIndex = handle.index();
+        return handle.isValid()
+            && slotIndex < m_slots.size()
+            && m_slots[slotIndex].generation == handle.generation()
+            && m_slots[slotIndex].valueIndex != INVALID_VALUE_INDEX;
+    }
+
+    // 오래된 handle 이면 nullptr
+    [[nodiscard]]
+    T* get(Handle handle) {
+        return contains(handle) ? &m_values[m_slots[handle.index()].valueIndex] : nullptr;
+    }
+
+    [[nodiscard]]
+    const T* get(Handle handle) const {
+        return contains(handle) ? &m_values[m_slots[handle.index()].valueIndex] : nullptr;
+    }
+
+    // 제거된 값을 돌려줌 (Vulkan handle 파괴는 호출자 책임)
+    T remove(Handle handle) {
+        if (!contains(handle)) {
+            throw std::runtime_error("invalid resource handle!");
+        }
+        Slot& slot = m_slots[handle.index()];
+        const uint32_t valueIndex = slot.valueIndex;
+        const uint32_t lastIndex = static_cast<uint32_t>(m_values.size() - 1);
+
+        T removed = std::move(m_values[valueIndex]);
+
+        if (valueIndex != lastIndex) {
+            m_values[valueIndex] = std::move(m_values[lastIndex]);
+            m_valueSlots[valueIndex] = m_valueSlots[lastIndex];
+            m_slots[m_valueSlots[valueIndex]].valueIndex = valueIndex;
+        }
+        m_values.pop_back();
+        m_valueSlots.pop_back();
+
+        slot.valueIndex = INVALID_VALUE_INDEX;
+        // generation 0 은 invalid handle 용으로 남겨둠
+        slot.generation = slot.generation == Handle::GENERATION_MASK ? 1 : slot.generation + 1;
+        m_freeSlots.push_back(handle.index());
+
+        return removed;
+    }
+
+    // values() 의 i 번째 값을 가리키는 handle
+    [[nodiscard]]
+    Handle handleAt(size_t valueIndex) const {
+        const uint32_t slotIndex = m_valueSlots[valueIndex];
+        return Handle::of(slotIndex, m_slots[slotIndex].generation);
+    }
+
+    [[nodiscard]]
+    std::span<T> values() {
+        return m_values;
+    }
+
+    [[nodiscard]]
+    std::span<const T> values() const {
+        return m_values;
+    }
+
+    [[nodiscard]]
+    size_t size() const {
+        return m_values.size();
+    }
+
+    [[nodiscard]]
+    bool empty() const {
+        return m_values.empty();
+    }
+
+    void clear() {
+        m_values.clear();
+        m_valueSlots.clear();
+
+        for (uint32_t slotIndex = 0; slotIndex < m_slots.size(); slotIndex++) {
+            Slot& slot = m_slots[slotIndex];
+
+            if (slot.valueIndex != INVALID_VALUE_INDEX) {
+                slot.valueIndex = INVALID_VALUE_INDEX;
+                slot.generation = slot.generation == Handle::GENERATION_MASK ? 1 : slot.generation + 1;
+                m_freeSlots.push_back(slotIndex);
+            }
+        }
+    }
+
+    auto begin() { return m_values.begin(); }
+    auto end() { return m_values.end(); }
+    auto begin() const { return m_values.begin(); }
+    auto end() const { return m_values.end(); }
+
+private:
+    static constexpr uint32_t INVALID_VALUE_INDEX = UINT32_MAX;
+
+    struct Slot {
+        uint32_t valueIndex;
+        uint32_t generation;
+    };
+
+    std::vector<T>          m_values;
+    std::vector<uint32_t>   m_valueSlots;
+    std::vector<Slot>       m_slots;
+    std::vector<uint32_t>   m_freeSlots;
+};
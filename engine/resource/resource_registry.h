@@ -0,0 +1,112 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vulkan/vulkan_core.h>
+
+#include "deletion_queue.h"
+#include "resource_pool.h"
+#include "../shader/shaders.h"
+#include "../shader/spirv_reflection.h"
+
+struct ShaderModule {
+    // asset pack 의 이름 (예: hiz_downsample.comp.spv)
+    std::string name;
+    ShaderType type;
+    VkShaderModule module;
+    ShaderReflection reflection;
+};
+
+using ShaderMap = ResourcePool<ShaderModule>;
+using ImageViewPool = ResourcePool<VkImageView>;
+using PipelinePool = ResourcePool<VkPipeline>;
+using PipelineLayoutPool = ResourcePool<VkPipelineLayout>;
+using DescriptorSetLayoutPool = ResourcePool<VkDescriptorSetLayout>;
+using FramebufferPool = ResourcePool<VkFramebuffer>;
+
+using ShaderHandle = ShaderMap::Handle;
+using ImageViewHandle = ImageViewPool::Handle;
+using PipelineHandle = PipelinePool::Handle;
+using PipelineLayoutHandle = PipelineLayoutPool::Handle;
+using DescriptorSetLayoutHandle = DescriptorSetLayoutPool::Handle;
+using FramebufferHandle = FramebufferPool::Handle;
+
+namespace ResourceRegistries {
+
+    inline VkShaderModule getVulkanHandle(const ShaderModule& shaderModule) {
+        return shaderModule.module;
+    }
+
+    template<typename T>
+    T getVulkanHandle(T handle) {
+        return handle;
+    }
+}
+
+// Engine 이 소유하는 Vulkan 객체 저장소
+// 모든 조회는 generational handle 로 O(1), 할당 없음
+struct ResourceRegistry {
+    ShaderMap               shaderModules;
+    ImageViewPool           imageViews;
+    PipelinePool            pipelines;
+    PipelineLayoutPool      pipelineLayouts;
+    DescriptorSetLayoutPool descriptorSetLayouts;
+    // 창마다 WindowSurface 가 swapchain image 순서로 handle 을 가짐
+    FramebufferPool         framebuffers;
+
+    [[nodiscard]]
+    const ShaderModule* findShader(ShaderType shaderType) const {
+        for (const ShaderModule& shaderModule : shaderModules) {
+            if (shaderModule.type == shaderType) {
+                return &shaderModule;
+            }
+        }
+        return nullptr;
+    }
+
+    // compute shader 는 stage 당 여러 개이므로 이름으로 찾음
+    [[nodiscard]]
+    const ShaderModule* findShader(std::string_view name) const {
+        for (const ShaderModule& shaderModule : shaderModules) {
+            if (shaderModule.name == name) {
+                return &shaderModule;
+            }
+        }
+        return nullptr;
+    }
+
+    // 반드시 pack 에 있어야 하는 shader
+    [[nodiscard]]
+    const ShaderModule& getShader(std::string_view name) const {
+        const ShaderModule* shaderModule = findShader(name);
+
+        if (shaderModule == nullptr) {
+            throw std::runtime_error("shader not found: " + std::string { name });
+        }
+        return *shaderModule;
+    }
+
+    // pool 에서 제거하고 GPU 사용이 끝난 뒤 파괴되도록 retire
+    template<typename T, typename Tag>
+    static void release(ResourcePool<T, Tag>& pool, ResourceHandle<Tag> handle, DeletionQueue& deletionQueue) {
+        deletionQueue.retire(ResourceRegistries::getVulkanHandle(pool.remove(handle)));
+    }
+
+    template<typename T, typename Tag>
+    static void releaseAll(ResourcePool<T, Tag>& pool, DeletionQueue& deletionQueue) {
+        for (const T& value : pool) {
+            deletionQueue.retire(ResourceRegistries::getVulkanHandle(value));
+        }
+        pool.clear();
+    }
+
+    void releaseAll(DeletionQueue& deletionQueue) {
+        releaseAll(pipelines, deletionQueue);
+        releaseAll(pipelineLayouts, deletionQueue);
+        releaseAll(descriptorSetLayouts, deletionQueue);
+        releaseAll(framebuffers, deletionQueue);
+        releaseAll(shaderModules, deletionQueue);
+        releaseAll(imageViews, deletionQueue);
+    }
+};
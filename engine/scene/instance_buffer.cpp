@@ -0,0 +1,51 @@
+#include "instance_buffer.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+InstanceBuffer::InstanceBuffer(VkPhysicalDevice physicalDevice, VkDevice device, DeletionQueue& deletionQueue, uint32_t framesInFlight)
+    : m_physicalDevice(physicalDevice), m_device(device), m_deletionQueue(deletionQueue), m_slots(std::max(framesInFlight, 1u)) {}
+
+InstanceBuffer::~InstanceBuffer() {
+    for (Slot& slot : m_slots) {
+        destroy(slot);
+    }
+}
+
+InstanceBuffer::Slot& InstanceBuffer::acquire(uint64_t frame, uint32_t instanceCount) {
+    Slot& slot = m_slots[frame % m_slots.size()];
+
+    if (instanceCount <= slot.capacity) {
+        return slot;
+    }
+    // 이전 buffer 는 이 slot 을 마지막으로 쓴 frame 이 끝난 뒤 파괴
+    destroy(slot);
+
+    const uint32_t capacity = std::bit_ceil(std::max(instanceCount, 64u));
+    slot.allocation = MemorySupports::createBuffer(
+        m_physicalDevice,
+        m_device,
+        VkDeviceSize { capacity } * sizeof(glm::mat4),
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        m_deletionQueue.getMemoryBudget(),
+        MemoryCategory::TRANSIENT
+    );
+    void* mapped = nullptr;
+
+    if (vkMapMemory(m_device, slot.allocation.memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+        throw std::runtime_error("failed to map instance buffer!");
+    }
+    slot.instances = static_cast<glm::mat4*>(mapped);
+    slot.capacity = capacity;
+    slot.writtenVersion = 0;
+    return slot;
+}
+
+void InstanceBuffer::destroy(Slot& slot) {
+    // 매핑은 vkFreeMemory 에서 함께 해제됨
+    m_deletionQueue.retire(slot.allocation.buffer);
+    m_deletionQueue.retire(slot.allocation.memory);
+    slot = {};
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan_core.h>
+
+#include "../memory/memory_supports.h"
+#include "../resource/deletion_queue.h"
+
+// frame in flight 마다 하나씩 두는 host-visible instance buffer (instance 당 world mat4)
+// CPU 가 매핑된 메모리에 바로 기록하고, 정점 셰이더가 instance rate 로 읽음
+class InstanceBuffer {
+public:
+    struct Slot {
+        BufferAllocation allocation;
+        glm::mat4* instances = nullptr;
+        uint32_t capacity = 0;
+        // 이 slot 에 마지막으로 기록된 SceneGraph version (0 이면 내용 없음)
+        uint64_t writtenVersion = 0;
+    };
+
+    InstanceBuffer(VkPhysicalDevice physicalDevice, VkDevice device, DeletionQueue& deletionQueue, uint32_t framesInFlight);
+
+    InstanceBuffer(const InstanceBuffer&) = delete;
+    InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+    ~InstanceBuffer();
+
+    // frame 이 사용할 slot. capacity 가 부족하면 재생성하고 writtenVersion 을 초기화
+    Slot& acquire(uint64_t frame, uint32_t instanceCount);
+
+    [[nodiscard]]
+    VkBuffer getBuffer(uint64_t frame) const {
+        return m_slots[frame % m_slots.size()].allocation.buffer;
+    }
+
+private:
+    void destroy(Slot& slot);
+
+    VkPhysicalDevice    m_physicalDevice;
+    VkDevice            m_device;
+    DeletionQueue&      m_deletionQueue;
+    std::vector<Slot>   m_slots;
+};
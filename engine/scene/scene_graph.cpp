@@ -0,0 +1,254 @@
+#include "scene_graph.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+glm::mat4 Transform::toMatrix() const {
+    glm::mat4 matrix = glm::mat4_cast(rotation);
+    matrix[0] *= scale.x;
+    matrix[1] *= scale.y;
+    matrix[2] *= scale.z;
+    matrix[3] = glm::vec4(position, 1.0f);
+    return matrix;
+}
+
+SceneNodeHandle SceneGraph::create(const Transform& local, SceneNodeHandle parent) {
+    const uint32_t parentIndex = parent.isValid() ? getIndex(parent) : INVALID_INDEX;
+    const uint32_t depth = parentIndex == INVALID_INDEX ? 0 : m_depths[parentIndex] + 1;
+
+    uint32_t slotIndex;
+
+    if (!m_freeSlots.empty()) {
+        slotIndex = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        if (m_slots.size() > SceneNodeHandle::MAX_INDEX) {
+            throw std::runtime_error("scene graph is full!");
+        }
+        slotIndex = static_cast<uint32_t>(m_slots.size());
+        m_slots.push_back({ INVALID_INDEX, 1 });
+    }
+    const auto index = static_cast<uint32_t>(m_locals.size());
+    m_slots[slotIndex].index = index;
+
+    // 맨 뒤에 붙이므로 부모가 자식보다 앞이라는 조건은 항상 유지됨
+    m_locals.push_back(local);
+    m_worlds.emplace_back(1.0f);
+    m_parents.push_back(parentIndex);
+    m_depths.push_back(depth);
+    m_dirty.push_back(1);
+    m_changedVersions.push_back(0);
+    m_indexSlots.push_back(slotIndex);
+
+    // 마지막 깊이보다 얕은 노드가 들어오면 다음 update 에서 재정렬
+    if (depth + 2 < m_levelOffsets.size()) {
+        m_isOrderDirty = true;
+    } else {
+        m_levelOffsets.resize(depth + 2, index);
+    }
+    m_levelOffsets.back() = index + 1;
+    m_hasDirty = true;
+
+    return SceneNodeHandle::of(slotIndex, m_slots[slotIndex].generation);
+}
+
+void SceneGraph::destroy(SceneNodeHandle handle) {
+    const uint32_t rootIndex = getIndex(handle);
+    const auto nodeCount = static_cast<uint32_t>(m_locals.size());
+
+    // 부모가 항상 앞에 있으므로 한 번의 순회로 하위 노드를 모두 표시
+    std::vector<uint8_t> isRemoved(nodeCount, 0);
+    isRemoved[rootIndex] = 1;
+
+    for (uint32_t index = rootIndex + 1; index < nodeCount; index++) {
+        const uint32_t parent = m_parents[index];
+        isRemoved[index] = parent != INVALID_INDEX && isRemoved[parent];
+    }
+    // 순서를 유지한 채 압축하므로 깊이 정렬이 깨지지 않음
+    std::vector<uint32_t> remap(nodeCount, INVALID_INDEX);
+    uint32_t count = 0;
+
+    for (uint32_t index = 0; index < nodeCount; index++) {
+        const uint32_t slotIndex = m_indexSlots[index];
+
+        if (isRemoved[index]) {
+            Slot& slot = m_slots[slotIndex];
+            slot.index = INVALID_INDEX;
+            slot.generation = slot.generation == SceneNodeHandle::GENERATION_MASK ? 1 : slot.generation + 1;
+            m_freeSlots.push_back(slotIndex);
+            continue;
+        }
+        const uint32_t parent = m_parents[index];
+
+        m_locals[count] = m_locals[index];
+        m_worlds[count] = m_worlds[index];
+        m_parents[count] = parent == INVALID_INDEX ? INVALID_INDEX : remap[parent];
+        m_depths[count] = m_depths[index];
+        m_dirty[count] = m_dirty[index];
+        m_changedVersions[count] = m_changedVersions[index];
+        m_indexSlots[count] = slotIndex;
+        m_slots[slotIndex].index = count;
+
+        remap[index] = count++;
+    }
+    m_locals.resize(count);
+    m_worlds.resize(count);
+    m_parents.resize(count);
+    m_depths.resize(count);
+    m_dirty.resize(count);
+    m_changedVersions.resize(count);
+    m_indexSlots.resize(count);
+
+    if (!m_isOrderDirty) {
+        rebuildLevels();
+    }
+    m_layoutVersion = m_version + 1;
+}
+
+void SceneGraph::setLocalTransform(SceneNodeHandle handle, const Transform& local) {
+    const uint32_t index = getIndex(handle);
+    m_locals[index] = local;
+    m_dirty[index] = 1;
+    m_hasDirty = true;
+}
+
+bool SceneGraph::contains(SceneNodeHandle handle) const {
+    const uint32_t slotIndex = handle.index();
+    return handle.isValid()
+        && slotIndex < m_slots.size()
+        && m_slots[slotIndex].generation == handle.generation()
+        && m_slots[slotIndex].index != INVALID_INDEX;
+}
+
+uint32_t SceneGraph::getIndex(SceneNodeHandle handle) const {
+    if (!contains(handle)) {
+        throw std::runtime_error("invalid scene node handle!");
+    }
+    return m_slots[handle.index()].index;
+}
+
+void SceneGraph::update(JobSystem& jobSystem, InstanceBuffer& instanceBuffer, uint64_t frame) {
+    const auto nodeCount = static_cast<uint32_t>(m_locals.size());
+
+    if (m_isOrderDirty) {
+        sortByDepth();
+    }
+    InstanceBuffer::Slot& slot = instanceBuffer.acquire(frame, nodeCount);
+
+    // world 행렬은 바뀐 노드가 있거나 배치가 바뀌었을 때만 다시 계산
+    if (m_hasDirty || m_layoutVersion > m_version) {
+        m_version++;
+
+        // 깊이 d 의 노드는 d - 1 의 결과만 읽으므로 깊이마다 한 번씩 동기화
+        for (uint32_t depth = 0; depth + 1 < m_levelOffsets.size(); depth++) {
+            const uint32_t levelBegin = m_levelOffsets[depth];
+            const uint32_t levelEnd = m_levelOffsets[depth + 1];
+
+            jobSystem.parallelFor(levelEnd - levelBegin, GRAIN_SIZE, [&](uint32_t begin, uint32_t end) {
+                updateRange(levelBegin + begin, levelBegin + end, slot);
+            });
+        }
+        m_hasDirty = false;
+    } else if (slot.writtenVersion < m_version) {
+        // frame in flight 의 다른 slot 이 뒤처진 경우: 계산은 끝났으므로 그 뒤에 바뀐 노드만 복사
+        jobSystem.parallelFor(nodeCount, GRAIN_SIZE, [&](uint32_t begin, uint32_t end) {
+            copyRange(begin, end, slot);
+        });
+    }
+    slot.writtenVersion = m_version;
+}
+
+void SceneGraph::updateRange(uint32_t begin, uint32_t end, InstanceBuffer::Slot& slot) {
+    // 배치가 바뀌었거나 slot 이 새로 만들어졌으면 전부 다시 기록
+    const bool isSlotStale = m_layoutVersion > slot.writtenVersion;
+
+    for (uint32_t index = begin; index < end; index++) {
+        const uint32_t parent = m_parents[index];
+        const bool isParentChanged = parent != INVALID_INDEX && m_changedVersions[parent] == m_version;
+
+        if (m_dirty[index] || isParentChanged) {
+            const glm::mat4 local = m_locals[index].toMatrix();
+            m_worlds[index] = parent == INVALID_INDEX ? local : m_worlds[parent] * local;
+            m_changedVersions[index] = m_version;
+            m_dirty[index] = 0;
+        }
+        // 이 slot 이 마지막으로 기록된 이후 바뀐 노드만 write-combined 메모리에 순차 기록
+        if (isSlotStale || m_changedVersions[index] > slot.writtenVersion) {
+            slot.instances[index] = m_worlds[index];
+        }
+    }
+}
+
+void SceneGraph::copyRange(uint32_t begin, uint32_t end, InstanceBuffer::Slot& slot) const {
+    const bool isSlotStale = m_layoutVersion > slot.writtenVersion;
+
+    for (uint32_t index = begin; index < end; index++) {
+        if (isSlotStale || m_changedVersions[index] > slot.writtenVersion) {
+            slot.instances[index] = m_worlds[index];
+        }
+    }
+}
+
+void SceneGraph::sortByDepth() {
+    const auto nodeCount = static_cast<uint32_t>(m_locals.size());
+    m_isOrderDirty = false;
+    m_layoutVersion = m_version + 1;
+
+    if (nodeCount == 0) {
+        m_levelOffsets.assign(1, 0);
+        return;
+    }
+    const uint32_t depthCount = *std::ranges::max_element(m_depths) + 1;
+
+    // 깊이별 시작 위치 (안정 counting sort 라 같은 깊이 안의 순서는 유지)
+    std::vector<uint32_t> offsets(depthCount + 1, 0);
+
+    for (uint32_t depth : m_depths) {
+        offsets[depth + 1]++;
+    }
+    for (uint32_t depth = 0; depth < depthCount; depth++) {
+        offsets[depth + 1] += offsets[depth];
+    }
+    std::vector<uint32_t> remap(nodeCount);
+    std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+
+    for (uint32_t index = 0; index < nodeCount; index++) {
+        remap[index] = cursors[m_depths[index]]++;
+    }
+
+    auto permute = [&](auto& values) {
+        std::remove_reference_t<decltype(values)> sorted(values.size());
+
+        for (uint32_t index = 0; index < nodeCount; index++) {
+            sorted[remap[index]] = std::move(values[index]);
+        }
+        values = std::move(sorted);
+    };
+    permute(m_locals);
+    permute(m_worlds);
+    permute(m_parents);
+    permute(m_depths);
+    permute(m_dirty);
+    permute(m_changedVersions);
+    permute(m_indexSlots);
+
+    for (uint32_t index = 0; index < nodeCount; index++) {
+        uint32_t& parent = m_parents[index];
+
+        if (parent != INVALID_INDEX) {
+            parent = remap[parent];
+        }
+        m_slots[m_indexSlots[index]].index = index;
+    }
+    m_levelOffsets = std::move(offsets);
+}
+
+void SceneGraph::rebuildLevels() {
+    m_levelOffsets.assign(1, 0);
+
+    for (uint32_t index = 0; index < m_depths.size(); index++) {
+        m_levelOffsets.resize(m_depths[index] + 2, index);
+    }
+    m_levelOffsets.back() = static_cast<uint32_t>(m_depths.size());
+}
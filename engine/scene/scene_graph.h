@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "instance_buffer.h"
+#include "../resource/resource_pool.h"
+#include "../thread/job_system.h"
+
+struct Transform {
+    glm::vec3 position { 0.0f };
+    glm::quat rotation { 1.0f, 0.0f, 0.0f, 0.0f };
+    glm::vec3 scale { 1.0f };
+
+    [[nodiscard]]
+    glm::mat4 toMatrix() const;
+};
+
+struct SceneNodeTag {};
+using SceneNodeHandle = ResourceHandle<SceneNodeTag>;
+
+// 노드를 깊이 순으로 정렬된 연속 배열에 저장하는 scene graph
+// 부모는 항상 자식보다 앞에 있으므로 world 행렬을 깊이 단위로 병렬 계산할 수 있고,
+// local 이 바뀐 노드와 그 하위 노드만 다시 계산
+class SceneGraph {
+public:
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    // parent 가 invalid handle 이면 root
+    SceneNodeHandle create(const Transform& local, SceneNodeHandle parent = {});
+
+    // 하위 노드까지 함께 제거
+    void destroy(SceneNodeHandle handle);
+
+    void setLocalTransform(SceneNodeHandle handle, const Transform& local);
+
+    [[nodiscard]]
+    bool contains(SceneNodeHandle handle) const;
+
+    [[nodiscard]]
+    const Transform& getLocalTransform(SceneNodeHandle handle) const {
+        return m_locals[getIndex(handle)];
+    }
+
+    // 마지막 update 시점의 world 행렬
+    [[nodiscard]]
+    const glm::mat4& getWorldMatrix(SceneNodeHandle handle) const {
+        return m_worlds[getIndex(handle)];
+    }
+
+    // instance buffer 에서의 위치. 노드 추가/제거 후 다음 update 에서 바뀔 수 있음
+    [[nodiscard]]
+    uint32_t getInstanceIndex(SceneNodeHandle handle) const {
+        return getIndex(handle);
+    }
+
+    // 바뀐 world 행렬을 계산하고 이번 frame 의 instance buffer slot 에 기록
+    void update(JobSystem& jobSystem, InstanceBuffer& instanceBuffer, uint64_t frame);
+
+    // 다음 update 에서 다시 계산할 노드가 있는지
+    [[nodiscard]]
+    bool hasChanges() const {
+        return m_hasDirty || m_isOrderDirty;
+    }
+
+    [[nodiscard]]
+    size_t size() const {
+        return m_locals.size();
+    }
+
+    // instance 순서의 world 행렬 (frame capture 가 instance buffer 대신 읽음)
+    [[nodiscard]]
+    std::span<const glm::mat4> getWorldMatrices() const {
+        return m_worlds;
+    }
+
+    // world 행렬이 바뀔 때마다 증가
+    [[nodiscard]]
+    uint64_t getVersion() const {
+        return m_version;
+    }
+
+    [[nodiscard]]
+    uint32_t getDepthCount() const {
+        return static_cast<uint32_t>(m_levelOffsets.size()) - 1;
+    }
+
+private:
+    // parallelFor 의 job 하나가 처리할 노드 수
+    static constexpr uint32_t GRAIN_SIZE = 1024;
+
+    struct Slot {
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    uint32_t getIndex(SceneNodeHandle handle) const;
+
+    // 깊이 순서가 깨졌으면 counting sort 로 다시 정렬
+    void sortByDepth();
+    void rebuildLevels();
+
+    void updateRange(uint32_t begin, uint32_t end, InstanceBuffer::Slot& slot);
+    // 계산 없이 slot 이 마지막으로 기록된 이후 바뀐 world 행렬만 복사
+    void copyRange(uint32_t begin, uint32_t end, InstanceBuffer::Slot& slot) const;
+
+    // 깊이 순 dense 배열
+    std::vector<Transform>  m_locals;
+    std::vector<glm::mat4>  m_worlds;
+    std::vector<uint32_t>   m_parents;
+    std::vector<uint32_t>   m_depths;
+    std::vector<uint8_t>    m_dirty;
+    // world 가 마지막으로 바뀐 version
+    std::vector<uint64_t>   m_changedVersions;
+    std::vector<uint32_t>   m_indexSlots;
+
+    // 깊이 d 의 노드는 [m_levelOffsets[d], m_levelOffsets[d + 1])
+    std::vector<uint32_t>   m_levelOffsets { 0 };
+
+    std::vector<Slot>       m_slots;
+    std::vector<uint32_t>   m_freeSlots;
+
+    uint64_t                m_version = 0;
+    // 노드 배치가 바뀌어 instance buffer 전체를 다시 써야 하는 version
+    uint64_t                m_layoutVersion = 0;
+    bool                    m_hasDirty = false;
+    bool                    m_isOrderDirty = false;
+};
@@ -1,5 +1,7 @@
 #include "render_pass_supports.h"
 
+#include <stdexcept>
+
 
 VkAttachmentDescription RenderPassSupports::createAttachmentDescription(VkFormat format) {
     VkAttachmentDescription attachmentDescription {};
@@ -15,6 +17,47 @@ VkAttachmentDescription RenderPassSupports::createAttachmentDescription(VkFormat
     return attachmentDescription;
 }
 
+VkAttachmentDescription RenderPassSupports::createAttachmentDescription(VkFormat format, RenderPassLoad load) {
+    VkAttachmentDescription attachmentDescription = createAttachmentDescription(format);
+
+    if (load == RenderPassLoad::CLEAR) {
+        attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    } else {
+        attachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+        attachmentDescription.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    }
+    return attachmentDescription;
+}
+
+VkAttachmentDescription RenderPassSupports::createAttachmentDescription(VkFormat format, RenderPassLoad load, VkImageLayout finalLayout) {
+    VkAttachmentDescription attachmentDescription = createAttachmentDescription(format, load);
+    attachmentDescription.finalLayout = finalLayout;
+    return attachmentDescription;
+}
+
+VkAttachmentDescription RenderPassSupports::createDepthAttachmentDescription(VkFormat format, RenderPassLoad load) {
+    VkAttachmentDescription attachmentDescription {};
+    attachmentDescription.format = format;
+    attachmentDescription.samples = VK_SAMPLE_COUNT_1_BIT;
+    attachmentDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachmentDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+
+    if (load == RenderPassLoad::CLEAR) {
+        // 이 depth 로 Hi-Z pyramid 를 만듦
+        attachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        attachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        attachmentDescription.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    } else {
+        // 마지막 pass 이후에는 depth 를 읽지 않음
+        attachmentDescription.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+        attachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachmentDescription.initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    }
+    return attachmentDescription;
+}
+
 VkAttachmentReference RenderPassSupports::createAttachmentReference() {
     VkAttachmentReference attachmentReference {};
     attachmentReference.attachment = 0;
@@ -22,6 +65,13 @@ VkAttachmentReference RenderPassSupports::createAttachmentReference() {
     return attachmentReference;
 }
 
+VkAttachmentReference RenderPassSupports::createDepthAttachmentReference() {
+    VkAttachmentReference attachmentReference {};
+    attachmentReference.attachment = 1;
+    attachmentReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    return attachmentReference;
+}
+
 VkSubpassDescription RenderPassSupports::createSubpassDescription(const VkAttachmentReference* attachmentReference) {
     VkSubpassDescription subpassDescription {};
     subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
@@ -30,13 +80,56 @@ VkSubpassDescription RenderPassSupports::createSubpassDescription(const VkAttach
     return subpassDescription;
 }
 
+VkSubpassDescription RenderPassSupports::createSubpassDescription(
+    const VkAttachmentReference* attachmentReference,
+    const VkAttachmentReference* depthAttachmentReference
+) {
+    VkSubpassDescription subpassDescription = createSubpassDescription(attachmentReference);
+    subpassDescription.pDepthStencilAttachment = depthAttachmentReference;
+    return subpassDescription;
+}
+
 VkSubpassDependency RenderPassSupports::createSubpassDependency() {
     VkSubpassDependency subpassDependency {};
     subpassDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
     subpassDependency.dstSubpass = 0;
-    subpassDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    subpassDependency.srcAccessMask = 0;
-    subpassDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    subpassDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    subpassDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+        | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT
+        | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    subpassDependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    subpassDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+        | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT
+        | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    subpassDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT
+        | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+        | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT
+        | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    return subpassDependency;
+}
+
+VkSubpassDependency RenderPassSupports::createExternalSubpassDependency() {
+    VkSubpassDependency subpassDependency {};
+    subpassDependency.srcSubpass = 0;
+    subpassDependency.dstSubpass = VK_SUBPASS_EXTERNAL;
+    subpassDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    subpassDependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    subpassDependency.dstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+    subpassDependency.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
     return subpassDependency;
-}
\ No newline at end of file
+}
+
+VkFormat RenderPassSupports::findDepthFormat(VkPhysicalDevice physicalDevice) {
+    // stencil 이 없는 format 만 사용해야 depth aspect 하나로 attachment 와 sampling 모두 가능
+    constexpr VkFormat candidates[] { VK_FORMAT_D32_SFLOAT, VK_FORMAT_X8_D24_UNORM_PACK32, VK_FORMAT_D16_UNORM };
+    constexpr VkFormatFeatureFlags requiredFeatures = VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+
+    for (VkFormat format : candidates) {
+        VkFormatProperties properties;
+        vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &properties);
+
+        if ((properties.optimalTilingFeatures & requiredFeatures) == requiredFeatures) {
+            return format;
+        }
+    }
+    throw std::runtime_error("failed to find supported depth format!");
+}
@@ -2,10 +2,31 @@
 
 #include <vulkan/vulkan_core.h>
 
+// 한 frame 을 여러 render pass 로 나눠 그릴 때 attachment 를 어떻게 이어받는지
+enum class RenderPassLoad {
+    // 첫 pass: color / depth 를 지우고, depth 는 Hi-Z 생성을 위해 sampling 가능한 layout 으로 끝냄
+    CLEAR,
+    // 이어 그리는 pass: 앞 pass 의 결과를 load 하고 color 는 present 로 끝냄
+    LOAD,
+};
+
 namespace RenderPassSupports {
 
     VkAttachmentDescription createAttachmentDescription(VkFormat format);
+    VkAttachmentDescription createAttachmentDescription(VkFormat format, RenderPassLoad load);
+    // load 의 color layout 대신 finalLayout 으로 끝냄 (pass 하나로 끝나는 창, offscreen target 등)
+    VkAttachmentDescription createAttachmentDescription(VkFormat format, RenderPassLoad load, VkImageLayout finalLayout);
+    VkAttachmentDescription createDepthAttachmentDescription(VkFormat format, RenderPassLoad load);
     VkAttachmentReference createAttachmentReference();
+    // depth 는 항상 attachment 1
+    VkAttachmentReference createDepthAttachmentReference();
     VkSubpassDescription createSubpassDescription(const VkAttachmentReference *attachmentReference);
+    VkSubpassDescription createSubpassDescription(const VkAttachmentReference *attachmentReference, const VkAttachmentReference *depthAttachmentReference);
+    // 이전 frame / 이전 pass 의 color, depth 쓰기와 compute 의 depth 읽기 이후에 시작
     VkSubpassDependency createSubpassDependency();
+    // pass 가 끝난 attachment 를 compute (Hi-Z) 와 transfer (캡처) 가 읽을 수 있도록 함
+    VkSubpassDependency createExternalSubpassDependency();
+
+    // depth attachment 와 sampling 을 모두 지원하는 depth 전용 format
+    VkFormat findDepthFormat(VkPhysicalDevice physicalDevice);
 }
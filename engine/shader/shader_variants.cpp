@@ -0,0 +1,94 @@
+#include "shader_variants.h"
+
+#include <algorithm>
+
+#include "../pipeline/graphics_pipeline_supports.h"
+#include "../util/hash.h"
+
+uint64_t ShaderVariantKey::hash() const {
+    uint64_t hash = Hashes::hashValue(type);
+    hash = Hashes::hashValue(module, hash);
+    return Hashes::hashBytes(constants.data(), constants.size() * sizeof(SpecializationConstant), hash);
+}
+
+VkPipelineShaderStageCreateInfo ShaderVariant::getStageCreateInfo() const {
+    return GraphicsPipelineSupports::createPipelineShaderStageCreateInfo(
+        static_cast<VkShaderStageFlagBits>(key.type),
+        key.module,
+        key.constants.empty() ? nullptr : &specializationInfo
+    );
+}
+
+void ShaderVariantCache::setDefaults(VkShaderModule module, std::span<const SpecializationConstant> defaults) {
+    m_defaults[module].assign(defaults.begin(), defaults.end());
+}
+
+const ShaderVariant& ShaderVariantCache::get(ShaderType type, VkShaderModule module, std::span<const SpecializationConstant> constants) {
+    ShaderVariantKey key = normalize(type, module, constants);
+    const uint64_t hash = key.hash();
+
+    std::vector<std::unique_ptr<ShaderVariant>>& bucket = m_variants[hash];
+
+    for (const std::unique_ptr<ShaderVariant>& variant : bucket) {
+        if (variant->key == key) {
+            m_hitCount++;
+            return *variant;
+        }
+    }
+    auto variant = std::make_unique<ShaderVariant>();
+    variant->key = std::move(key);
+    variant->hash = hash;
+
+    for (const SpecializationConstant& constant : variant->key.constants) {
+        const auto offset = static_cast<uint32_t>(variant->data.size() * sizeof(uint32_t));
+        variant->mapEntries.push_back({ constant.id, offset, sizeof(uint32_t) });
+        variant->data.push_back(constant.value);
+    }
+    variant->specializationInfo = {
+        static_cast<uint32_t>(variant->mapEntries.size()),
+        variant->mapEntries.data(),
+        variant->data.size() * sizeof(uint32_t),
+        variant->data.data(),
+    };
+    m_variantCount++;
+    return *bucket.emplace_back(std::move(variant));
+}
+
+void ShaderVariantCache::remove(VkShaderModule module) {
+    m_defaults.erase(module);
+
+    for (auto iterator = m_variants.begin(); iterator != m_variants.end();) {
+        std::vector<std::unique_ptr<ShaderVariant>>& bucket = iterator->second;
+
+        m_variantCount -= std::erase_if(bucket, [&](const std::unique_ptr<ShaderVariant>& variant) {
+            return variant->key.module == module;
+        });
+        iterator = bucket.empty() ? m_variants.erase(iterator) : std::next(iterator);
+    }
+}
+
+ShaderVariantKey ShaderVariantCache::normalize(ShaderType type, VkShaderModule module, std::span<const SpecializationConstant> constants) const {
+    ShaderVariantKey key { type, module, { constants.begin(), constants.end() } };
+
+    // 같은 id 가 여러 번 오면 마지막 값 사용
+    std::ranges::stable_sort(key.constants, {}, &SpecializationConstant::id);
+
+    std::vector<SpecializationConstant> unique {};
+
+    for (const SpecializationConstant& constant : key.constants) {
+        if (!unique.empty() && unique.back().id == constant.id) {
+            unique.back() = constant;
+        } else {
+            unique.push_back(constant);
+        }
+    }
+    // module 이 선언하지 않은 id 는 무시되고, 기본값과 같은 값은 지정하지 않은 것과 같은 코드가 되므로 제거
+    if (const auto defaults = m_defaults.find(module); defaults != m_defaults.end()) {
+        std::erase_if(unique, [&](const SpecializationConstant& constant) {
+            const auto declared = std::ranges::find(defaults->second, constant.id, &SpecializationConstant::id);
+            return declared == defaults->second.end() || declared->value == constant.value;
+        });
+    }
+    key.constants = std::move(unique);
+    return key;
+}
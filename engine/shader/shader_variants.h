@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+#include "shaders.h"
+
+// GLSL 의 layout(constant_id = N) 과 맞춰야 하는 feature toggle id
+namespace ShaderFeatures {
+    // shader.frag: 정점 색을 쓸지 (false 면 흰색)
+    constexpr uint32_t VERTEX_COLOR = 0;
+}
+
+// bool / int / uint / float 모두 4byte 로 전달
+struct SpecializationConstant {
+    uint32_t id;
+    uint32_t value;
+
+    bool operator==(const SpecializationConstant&) const = default;
+};
+
+struct ShaderVariantKey {
+    ShaderType type;
+    VkShaderModule module;
+    // id 오름차순. module 이 선언하지 않은 id 와 기본값과 같은 값은 제거된 상태
+    std::vector<SpecializationConstant> constants;
+
+    bool operator==(const ShaderVariantKey&) const = default;
+
+    [[nodiscard]]
+    uint64_t hash() const;
+};
+
+// 하나의 module 과 specialization constant 조합
+// 드라이버가 pipeline 생성 시 상수를 접어서 분기 없는 코드를 만듦
+struct ShaderVariant {
+    ShaderVariantKey key;
+    uint64_t hash;
+    std::vector<VkSpecializationMapEntry> mapEntries;
+    std::vector<uint32_t> data;
+    VkSpecializationInfo specializationInfo;
+
+    // 반환값은 variant 가 cache 에 있는 동안 유효한 포인터를 가짐
+    [[nodiscard]]
+    VkPipelineShaderStageCreateInfo getStageCreateInfo() const;
+};
+
+// 요청된 variant 만 만들어 hash 로 보관. 순서나 기본값 지정 여부, 선언되지 않은 id 만 다른 요청은 같은 variant 로 합침
+// 여러 stage 에 같은 feature 목록을 넘겨도 그 stage 가 쓰는 constant 만 key 에 남음
+class ShaderVariantCache {
+public:
+    // module 이 선언한 constant 의 기본값 (reflection 의 specializationDefaults)
+    // 등록한 module 은 목록에 없는 id 를 key 에서 제외하고, 등록하지 않은 module 은 모든 constant 를 key 에 포함
+    void setDefaults(VkShaderModule module, std::span<const SpecializationConstant> defaults);
+
+    const ShaderVariant& get(ShaderType type, VkShaderModule module, std::span<const SpecializationConstant> constants = {});
+
+    // module 을 쓰는 variant 를 제거 (module 파괴 전에 호출)
+    void remove(VkShaderModule module);
+
+    [[nodiscard]]
+    size_t size() const {
+        return m_variantCount;
+    }
+
+    // 이미 있는 variant 로 처리된 요청 수
+    [[nodiscard]]
+    uint64_t getHitCount() const {
+        return m_hitCount;
+    }
+
+private:
+    ShaderVariantKey normalize(ShaderType type, VkShaderModule module, std::span<const SpecializationConstant> constants) const;
+
+    std::unordered_map<VkShaderModule, std::vector<SpecializationConstant>> m_defaults;
+    // hash 충돌 시 같은 bucket 에서 key 로 비교
+    std::unordered_map<uint64_t, std::vector<std::unique_ptr<ShaderVariant>>> m_variants;
+    size_t m_variantCount = 0;
+    uint64_t m_hitCount = 0;
+};
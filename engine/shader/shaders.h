@@ -2,16 +2,25 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include "vulkan/vulkan_core.h"
 
 enum ShaderType {
     VERTEX_SHADER = VK_SHADER_STAGE_VERTEX_BIT,
     FRAGMENT_SHADER = VK_SHADER_STAGE_FRAGMENT_BIT,
     GEOMETRY_SHADER = VK_SHADER_STAGE_GEOMETRY_BIT,
+    COMPUTE_SHADER = VK_SHADER_STAGE_COMPUTE_BIT,
 };
 
 namespace Shaders {
     constexpr auto SHADER_DIR { "./shaders" };
+    // 기본 graphics pipeline 의 program (shader.vert, shader.frag)
+    constexpr std::string_view DEFAULT_PROGRAM { "shader" };
+
+    // "particle.vert.spv" -> "particle". 같은 program 의 graphics stage 가 하나의 pipeline 을 이룸
+    inline std::string_view getProgramName(std::string_view fileName) {
+        return fileName.substr(0, fileName.find('.'));
+    }
 
     inline ShaderType getShaderType(const std::string& fileName) {
         if (fileName.find(".vert") != std::string::npos) {
@@ -23,6 +32,9 @@ namespace Shaders {
         if (fileName.find(".geom") != std::string::npos) {
             return GEOMETRY_SHADER;
         }
+        if (fileName.find(".comp") != std::string::npos) {
+            return COMPUTE_SHADER;
+        }
         throw std::runtime_error("Shader type not found: " + fileName);
     }
 }
\ No newline at end of file
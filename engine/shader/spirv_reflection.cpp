@@ -0,0 +1,563 @@
+#include "spirv_reflection.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "../util/hash.h"
+
+namespace {
+    constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+    constexpr uint32_t HEADER_WORD_COUNT = 5;
+
+    enum Op : uint32_t {
+        OP_ENTRY_POINT = 15,
+        OP_TYPE_BOOL = 20,
+        OP_TYPE_INT = 21,
+        OP_TYPE_FLOAT = 22,
+        OP_TYPE_VECTOR = 23,
+        OP_TYPE_MATRIX = 24,
+        OP_TYPE_IMAGE = 25,
+        OP_TYPE_SAMPLER = 26,
+        OP_TYPE_SAMPLED_IMAGE = 27,
+        OP_TYPE_ARRAY = 28,
+        OP_TYPE_RUNTIME_ARRAY = 29,
+        OP_TYPE_STRUCT = 30,
+        OP_TYPE_POINTER = 32,
+        OP_CONSTANT = 43,
+        OP_SPEC_CONSTANT_TRUE = 48,
+        OP_SPEC_CONSTANT_FALSE = 49,
+        OP_SPEC_CONSTANT = 50,
+        OP_VARIABLE = 59,
+        OP_DECORATE = 71,
+        OP_MEMBER_DECORATE = 72,
+    };
+
+    enum Decoration : uint32_t {
+        DECORATION_SPEC_ID = 1,
+        DECORATION_BLOCK = 2,
+        DECORATION_BUFFER_BLOCK = 3,
+        DECORATION_ARRAY_STRIDE = 6,
+        DECORATION_MATRIX_STRIDE = 7,
+        DECORATION_BUILT_IN = 11,
+        DECORATION_LOCATION = 30,
+        DECORATION_BINDING = 33,
+        DECORATION_DESCRIPTOR_SET = 34,
+        DECORATION_OFFSET = 35,
+    };
+
+    enum StorageClass : uint32_t {
+        STORAGE_UNIFORM_CONSTANT = 0,
+        STORAGE_INPUT = 1,
+        STORAGE_UNIFORM = 2,
+        STORAGE_PUSH_CONSTANT = 9,
+        STORAGE_STORAGE_BUFFER = 12,
+    };
+
+    enum ImageDim : uint32_t {
+        DIM_BUFFER = 5,
+        DIM_SUBPASS_DATA = 6,
+    };
+
+    constexpr uint32_t UNDEFINED = UINT32_MAX;
+
+    struct Member {
+        uint32_t offset = UNDEFINED;
+        uint32_t matrixStride = 0;
+    };
+
+    // result id 하나에 대한 선언과 decoration
+    struct Id {
+        uint32_t opcode = 0;
+        // type: result id 이후의 operand, variable / constant: result type 이후의 operand
+        std::vector<uint32_t> operands;
+        uint32_t resultType = 0;
+
+        uint32_t set = UNDEFINED;
+        uint32_t binding = UNDEFINED;
+        uint32_t location = UNDEFINED;
+        uint32_t specId = UNDEFINED;
+        uint32_t arrayStride = 0;
+        bool isBuiltIn = false;
+        bool isBlock = false;
+        bool isBufferBlock = false;
+        std::vector<Member> members;
+    };
+
+    uint32_t getOperand(std::span<const uint32_t> operands, size_t index) {
+        if (index >= operands.size()) {
+            throw std::runtime_error("missing SPIR-V operand!");
+        }
+        return operands[index];
+    }
+
+    class Parser {
+    public:
+        explicit Parser(std::span<const uint32_t> words) : m_words(words) {
+            if (words.size() < HEADER_WORD_COUNT || words[0] != SPIRV_MAGIC) {
+                throw std::runtime_error("invalid SPIR-V!");
+            }
+            m_ids.resize(words[3]);
+        }
+
+        ShaderReflection parse() {
+            ShaderReflection reflection {};
+            bool hasEntryPoint = false;
+
+            for (size_t offset = HEADER_WORD_COUNT; offset < m_words.size();) {
+                const uint32_t wordCount = m_words[offset] >> 16;
+                const uint32_t opcode = m_words[offset] & 0xFFFF;
+
+                if (wordCount == 0 || offset + wordCount > m_words.size()) {
+                    throw std::runtime_error("corrupted SPIR-V instruction!");
+                }
+                if (opcode == OP_ENTRY_POINT) {
+                    // 첫 entry point 의 execution model 사용
+                    if (!hasEntryPoint) {
+                        reflection.stage = getStage(getOperand(m_words.subspan(offset + 1, wordCount - 1), 0));
+                        hasEntryPoint = true;
+                    }
+                } else {
+                    parseInstruction(opcode, m_words.subspan(offset + 1, wordCount - 1));
+                }
+                offset += wordCount;
+            }
+            if (!hasEntryPoint) {
+                throw std::runtime_error("SPIR-V has no entry point!");
+            }
+            for (const Id& id : m_ids) {
+                if (id.opcode == OP_VARIABLE) {
+                    reflectVariable(id, reflection);
+                } else if (id.specId != UNDEFINED && (id.opcode == OP_SPEC_CONSTANT_TRUE || id.opcode == OP_SPEC_CONSTANT_FALSE || id.opcode == OP_SPEC_CONSTANT)) {
+                    const uint32_t value = id.opcode == OP_SPEC_CONSTANT ? id.operands.at(0) : id.opcode == OP_SPEC_CONSTANT_TRUE;
+                    reflection.specializationDefaults.push_back({ id.specId, value });
+                }
+            }
+            if (reflection.stage != VK_SHADER_STAGE_VERTEX_BIT) {
+                reflection.vertexInputs.clear();
+            }
+            std::ranges::sort(reflection.bindings, [](const ReflectedBinding& left, const ReflectedBinding& right) {
+                return left.set != right.set ? left.set < right.set : left.binding < right.binding;
+            });
+            std::ranges::sort(reflection.vertexInputs, {}, &ReflectedVertexInput::location);
+            std::ranges::sort(reflection.specializationDefaults, {}, &SpecializationConstant::id);
+            return reflection;
+        }
+
+    private:
+        Id& getId(uint32_t idValue) {
+            if (idValue >= m_ids.size()) {
+                throw std::runtime_error("SPIR-V id out of bound!");
+            }
+            return m_ids[idValue];
+        }
+
+        void parseInstruction(uint32_t opcode, std::span<const uint32_t> operands) {
+            switch (opcode) {
+                case OP_TYPE_BOOL:
+                case OP_TYPE_INT:
+                case OP_TYPE_FLOAT:
+                case OP_TYPE_VECTOR:
+                case OP_TYPE_MATRIX:
+                case OP_TYPE_IMAGE:
+                case OP_TYPE_SAMPLER:
+                case OP_TYPE_SAMPLED_IMAGE:
+                case OP_TYPE_ARRAY:
+                case OP_TYPE_RUNTIME_ARRAY:
+                case OP_TYPE_STRUCT:
+                case OP_TYPE_POINTER: {
+                    Id& id = getId(getOperand(operands, 0));
+                    id.opcode = opcode;
+                    id.operands.assign(operands.begin() + 1, operands.end());
+
+                    if (opcode == OP_TYPE_STRUCT) {
+                        id.members.resize(id.operands.size());
+                    }
+                    break;
+                }
+                case OP_CONSTANT:
+                case OP_SPEC_CONSTANT_TRUE:
+                case OP_SPEC_CONSTANT_FALSE:
+                case OP_SPEC_CONSTANT:
+                case OP_VARIABLE: {
+                    Id& id = getId(getOperand(operands, 1));
+                    id.opcode = opcode;
+                    id.resultType = operands[0];
+                    id.operands.assign(operands.begin() + 2, operands.end());
+                    break;
+                }
+                case OP_DECORATE: {
+                    Id& id = getId(getOperand(operands, 0));
+                    decorate(id, getOperand(operands, 1), operands.subspan(2));
+                    break;
+                }
+                case OP_MEMBER_DECORATE: {
+                    Id& id = getId(getOperand(operands, 0));
+                    const uint32_t memberIndex = getOperand(operands, 1);
+
+                    if (id.members.size() <= memberIndex) {
+                        id.members.resize(memberIndex + 1);
+                    }
+                    if (getOperand(operands, 2) == DECORATION_OFFSET) {
+                        id.members[memberIndex].offset = getOperand(operands, 3);
+                    } else if (operands[2] == DECORATION_MATRIX_STRIDE) {
+                        id.members[memberIndex].matrixStride = getOperand(operands, 3);
+                    } else if (operands[2] == DECORATION_BUILT_IN) {
+                        id.isBuiltIn = true;
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        static void decorate(Id& id, uint32_t decoration, std::span<const uint32_t> values) {
+            switch (decoration) {
+                case DECORATION_SPEC_ID: id.specId = getOperand(values, 0); break;
+                case DECORATION_BLOCK: id.isBlock = true; break;
+                case DECORATION_BUFFER_BLOCK: id.isBufferBlock = true; break;
+                case DECORATION_ARRAY_STRIDE: id.arrayStride = getOperand(values, 0); break;
+                case DECORATION_BUILT_IN: id.isBuiltIn = true; break;
+                case DECORATION_LOCATION: id.location = getOperand(values, 0); break;
+                case DECORATION_BINDING: id.binding = getOperand(values, 0); break;
+                case DECORATION_DESCRIPTOR_SET: id.set = getOperand(values, 0); break;
+                default: break;
+            }
+        }
+
+        static VkShaderStageFlagBits getStage(uint32_t executionModel) {
+            switch (executionModel) {
+                case 0: return VK_SHADER_STAGE_VERTEX_BIT;
+                case 1: return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+                case 2: return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+                case 3: return VK_SHADER_STAGE_GEOMETRY_BIT;
+                case 4: return VK_SHADER_STAGE_FRAGMENT_BIT;
+                case 5: return VK_SHADER_STAGE_COMPUTE_BIT;
+                default: throw std::runtime_error("unsupported SPIR-V execution model!");
+            }
+        }
+
+        void reflectVariable(const Id& variable, ShaderReflection& reflection) {
+            const Id& pointer = getId(variable.resultType);
+
+            if (pointer.opcode != OP_TYPE_POINTER || variable.operands.empty()) {
+                return;
+            }
+            const uint32_t storageClass = variable.operands[0];
+            const uint32_t typeId = pointer.operands.at(1);
+
+            switch (storageClass) {
+                case STORAGE_UNIFORM_CONSTANT:
+                case STORAGE_UNIFORM:
+                case STORAGE_STORAGE_BUFFER:
+                    reflectDescriptor(variable, storageClass, typeId, reflection);
+                    break;
+                case STORAGE_PUSH_CONSTANT:
+                    reflectPushConstant(typeId, reflection);
+                    break;
+                case STORAGE_INPUT:
+                    reflectVertexInput(variable, typeId, reflection);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void reflectDescriptor(const Id& variable, uint32_t storageClass, uint32_t typeId, ShaderReflection& reflection) {
+            if (variable.binding == UNDEFINED) {
+                return;
+            }
+            uint32_t descriptorCount = 1;
+            const Id* type = &getId(typeId);
+
+            // 배열이면 원소 타입까지 내려감. runtime array 는 1 개로 취급
+            while (type->opcode == OP_TYPE_ARRAY || type->opcode == OP_TYPE_RUNTIME_ARRAY) {
+                if (type->opcode == OP_TYPE_ARRAY) {
+                    descriptorCount *= getConstant(type->operands.at(1));
+                }
+                type = &getId(type->operands.at(0));
+            }
+            VkDescriptorType descriptorType;
+
+            switch (type->opcode) {
+                case OP_TYPE_SAMPLED_IMAGE:
+                    descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                    break;
+                case OP_TYPE_SAMPLER:
+                    descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+                    break;
+                case OP_TYPE_IMAGE: {
+                    const uint32_t dim = type->operands.at(1);
+                    const bool isStorage = type->operands.at(5) == 2;
+
+                    if (dim == DIM_SUBPASS_DATA) {
+                        descriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                    } else if (dim == DIM_BUFFER) {
+                        descriptorType = isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                    } else {
+                        descriptorType = isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+                    }
+                    break;
+                }
+                case OP_TYPE_STRUCT:
+                    // 구 GLSL 의 buffer 는 Uniform + BufferBlock 으로 나옴
+                    descriptorType = storageClass == STORAGE_STORAGE_BUFFER || type->isBufferBlock
+                        ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+                        : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                    break;
+                default:
+                    return;
+            }
+            reflection.bindings.push_back({ variable.set == UNDEFINED ? 0 : variable.set, variable.binding, descriptorType, descriptorCount });
+        }
+
+        void reflectPushConstant(uint32_t typeId, ShaderReflection& reflection) {
+            const Id& type = getId(typeId);
+
+            if (type.opcode != OP_TYPE_STRUCT) {
+                return;
+            }
+            uint32_t begin = UNDEFINED;
+
+            for (const Member& member : type.members) {
+                begin = std::min(begin, member.offset);
+            }
+            const uint32_t end = getTypeSize(typeId, 0);
+
+            reflection.pushConstantOffset = begin == UNDEFINED ? 0 : begin;
+            reflection.pushConstantSize = end - reflection.pushConstantOffset;
+        }
+
+        void reflectVertexInput(const Id& variable, uint32_t typeId, ShaderReflection& reflection) {
+            if (variable.isBuiltIn || variable.location == UNDEFINED) {
+                return;
+            }
+            const Id& type = getId(typeId);
+
+            // 행렬 입력은 column 마다 location 하나
+            if (type.opcode == OP_TYPE_MATRIX) {
+                const VkFormat format = getFormat(type.operands.at(0));
+
+                for (uint32_t column = 0; column < type.operands.at(1); column++) {
+                    reflection.vertexInputs.push_back({ variable.location + column, format });
+                }
+                return;
+            }
+            reflection.vertexInputs.push_back({ variable.location, getFormat(typeId) });
+        }
+
+        uint32_t getConstant(uint32_t idValue) {
+            const Id& constant = getId(idValue);
+
+            if (constant.opcode != OP_CONSTANT && constant.opcode != OP_SPEC_CONSTANT) {
+                throw std::runtime_error("unsupported SPIR-V array length!");
+            }
+            return constant.operands.at(0);
+        }
+
+        // std140 / std430 / scalar 에 관계없이 decoration 의 offset 과 stride 를 따름
+        uint32_t getTypeSize(uint32_t typeId, uint32_t matrixStride) {
+            const Id& type = getId(typeId);
+
+            switch (type.opcode) {
+                case OP_TYPE_BOOL:
+                    return 4;
+                case OP_TYPE_INT:
+                case OP_TYPE_FLOAT:
+                    return type.operands.at(0) / 8;
+                case OP_TYPE_VECTOR:
+                    return getTypeSize(type.operands.at(0), 0) * type.operands.at(1);
+                case OP_TYPE_MATRIX: {
+                    const uint32_t columnCount = type.operands.at(1);
+                    return matrixStride ? matrixStride * columnCount : getTypeSize(type.operands.at(0), 0) * columnCount;
+                }
+                case OP_TYPE_ARRAY: {
+                    const uint32_t length = getConstant(type.operands.at(1));
+                    const uint32_t stride = type.arrayStride ? type.arrayStride : getTypeSize(type.operands.at(0), matrixStride);
+                    return stride * length;
+                }
+                case OP_TYPE_RUNTIME_ARRAY:
+                    return 0;
+                case OP_TYPE_STRUCT: {
+                    uint32_t size = 0;
+
+                    for (size_t index = 0; index < type.operands.size(); index++) {
+                        const Member member = index < type.members.size() ? type.members[index] : Member {};
+                        const uint32_t offset = member.offset == UNDEFINED ? size : member.offset;
+                        size = std::max(size, offset + getTypeSize(type.operands[index], member.matrixStride));
+                    }
+                    return size;
+                }
+                default:
+                    return 0;
+            }
+        }
+
+        VkFormat getFormat(uint32_t typeId) {
+            const Id& type = getId(typeId);
+            uint32_t componentCount = 1;
+            const Id* component = &type;
+
+            if (type.opcode == OP_TYPE_VECTOR) {
+                componentCount = type.operands.at(1);
+                component = &getId(type.operands.at(0));
+            }
+            const uint32_t width = component->operands.empty() ? 32 : component->operands[0];
+            const uint32_t index = componentCount - 1;
+
+            if (component->opcode == OP_TYPE_FLOAT) {
+                static constexpr VkFormat FLOAT16[] { VK_FORMAT_R16_SFLOAT, VK_FORMAT_R16G16_SFLOAT, VK_FORMAT_R16G16B16_SFLOAT, VK_FORMAT_R16G16B16A16_SFLOAT };
+                static constexpr VkFormat FLOAT32[] { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+                static constexpr VkFormat FLOAT64[] { VK_FORMAT_R64_SFLOAT, VK_FORMAT_R64G64_SFLOAT, VK_FORMAT_R64G64B64_SFLOAT, VK_FORMAT_R64G64B64A64_SFLOAT };
+                return width == 16 ? FLOAT16[index] : width == 64 ? FLOAT64[index] : FLOAT32[index];
+            }
+            if (component->opcode == OP_TYPE_INT) {
+                static constexpr VkFormat SINT32[] { VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT };
+                static constexpr VkFormat UINT32[] { VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT };
+                return component->operands.at(1) ? SINT32[index] : UINT32[index];
+            }
+            throw std::runtime_error("unsupported vertex input type!");
+        }
+
+        std::span<const uint32_t> m_words;
+        std::vector<Id> m_ids;
+    };
+
+    struct CacheHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t codeHash;
+        uint32_t codeSize;
+        uint32_t stage;
+        uint32_t pushConstantOffset;
+        uint32_t pushConstantSize;
+        uint32_t bindingCount;
+        uint32_t vertexInputCount;
+        uint32_t specializationCount;
+        uint32_t reserved;
+    };
+
+    constexpr uint32_t CACHE_MAGIC = 0x46455253; // "SREF"
+    constexpr uint32_t CACHE_VERSION = 1;
+
+    template<typename T>
+    void append(std::vector<char>& output, const std::vector<T>& values) {
+        const auto* bytes = reinterpret_cast<const char*>(values.data());
+        output.insert(output.end(), bytes, bytes + values.size() * sizeof(T));
+    }
+
+    template<typename T>
+    bool read(std::span<const char>& input, std::vector<T>& values, uint32_t count) {
+        const size_t size = size_t { count } * sizeof(T);
+
+        if (input.size() < size) {
+            return false;
+        }
+        values.resize(count);
+        std::memcpy(values.data(), input.data(), size);
+        input = input.subspan(size);
+        return true;
+    }
+}
+
+ShaderReflection SpirvReflection::reflect(std::span<const char> code) {
+    if (code.size() % sizeof(uint32_t) != 0) {
+        throw std::runtime_error("invalid SPIR-V size!");
+    }
+    // asset pack 의 blob 은 16byte 정렬이지만 외부 버퍼도 받을 수 있도록 복사
+    std::vector<uint32_t> words(code.size() / sizeof(uint32_t));
+    std::memcpy(words.data(), code.data(), code.size());
+
+    return Parser { words }.parse();
+}
+
+std::vector<char> SpirvReflection::serialize(const ShaderReflection& reflection, std::span<const char> code) {
+    const CacheHeader header {
+        CACHE_MAGIC,
+        CACHE_VERSION,
+        Hashes::hashBytes(code.data(), code.size()),
+        static_cast<uint32_t>(code.size()),
+        static_cast<uint32_t>(reflection.stage),
+        reflection.pushConstantOffset,
+        reflection.pushConstantSize,
+        static_cast<uint32_t>(reflection.bindings.size()),
+        static_cast<uint32_t>(reflection.vertexInputs.size()),
+        static_cast<uint32_t>(reflection.specializationDefaults.size()),
+        0,
+    };
+    std::vector<char> output(sizeof(CacheHeader));
+    std::memcpy(output.data(), &header, sizeof(CacheHeader));
+
+    append(output, reflection.bindings);
+    append(output, reflection.vertexInputs);
+    append(output, reflection.specializationDefaults);
+    return output;
+}
+
+std::optional<ShaderReflection> SpirvReflection::deserialize(std::span<const char> cache, std::span<const char> code) {
+    CacheHeader header {};
+
+    if (cache.size() < sizeof(CacheHeader)) {
+        return std::nullopt;
+    }
+    std::memcpy(&header, cache.data(), sizeof(CacheHeader));
+
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.codeSize != code.size()
+        || header.codeHash != Hashes::hashBytes(code.data(), code.size())) {
+        return std::nullopt;
+    }
+    std::span<const char> input = cache.subspan(sizeof(CacheHeader));
+
+    ShaderReflection reflection {};
+    reflection.stage = static_cast<VkShaderStageFlagBits>(header.stage);
+    reflection.pushConstantOffset = header.pushConstantOffset;
+    reflection.pushConstantSize = header.pushConstantSize;
+
+    if (!read(input, reflection.bindings, header.bindingCount)
+        || !read(input, reflection.vertexInputs, header.vertexInputCount)
+        || !read(input, reflection.specializationDefaults, header.specializationCount)) {
+        return std::nullopt;
+    }
+    return reflection;
+}
+
+VertexInputLayout SpirvReflection::createVertexInputLayout(const ShaderReflection& vertexReflection) {
+    VertexInputLayout layout {};
+    uint32_t offset = 0;
+
+    for (const ReflectedVertexInput& input : vertexReflection.vertexInputs) {
+        layout.attributes.push_back({ input.location, 0, input.format, offset });
+        offset += getFormatSize(input.format);
+    }
+    if (!layout.attributes.empty()) {
+        layout.bindings.push_back({ 0, offset, VK_VERTEX_INPUT_RATE_VERTEX });
+    }
+    return layout;
+}
+
+uint32_t SpirvReflection::getFormatSize(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_R16_SFLOAT: return 2;
+        case VK_FORMAT_R16G16_SFLOAT: return 4;
+        case VK_FORMAT_R16G16B16_SFLOAT: return 6;
+        case VK_FORMAT_R16G16B16A16_SFLOAT: return 8;
+        case VK_FORMAT_R32_SFLOAT:
+        case VK_FORMAT_R32_SINT:
+        case VK_FORMAT_R32_UINT: return 4;
+        case VK_FORMAT_R32G32_SFLOAT:
+        case VK_FORMAT_R32G32_SINT:
+        case VK_FORMAT_R32G32_UINT:
+        case VK_FORMAT_R64_SFLOAT: return 8;
+        case VK_FORMAT_R32G32B32_SFLOAT:
+        case VK_FORMAT_R32G32B32_SINT:
+        case VK_FORMAT_R32G32B32_UINT: return 12;
+        case VK_FORMAT_R32G32B32A32_SFLOAT:
+        case VK_FORMAT_R32G32B32A32_SINT:
+        case VK_FORMAT_R32G32B32A32_UINT:
+        case VK_FORMAT_R64G64_SFLOAT: return 16;
+        case VK_FORMAT_R64G64B64_SFLOAT: return 24;
+        case VK_FORMAT_R64G64B64A64_SFLOAT: return 32;
+        default: throw std::runtime_error("unknown vertex format size!");
+    }
+}
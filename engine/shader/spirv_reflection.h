@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+#include "shader_variants.h"
+
+struct ReflectedBinding {
+    uint32_t set;
+    uint32_t binding;
+    VkDescriptorType descriptorType;
+    uint32_t descriptorCount;
+};
+
+struct ReflectedVertexInput {
+    uint32_t location;
+    VkFormat format;
+};
+
+// SPIR-V 하나에서 pipeline layout 과 vertex input 을 만드는 데 필요한 정보
+struct ShaderReflection {
+    VkShaderStageFlagBits stage;
+    // (set, binding) 오름차순
+    std::vector<ReflectedBinding> bindings;
+    // pushConstantSize 가 0 이면 push constant 없음
+    uint32_t pushConstantOffset;
+    uint32_t pushConstantSize;
+    // vertex stage 의 입력만, location 오름차순
+    std::vector<ReflectedVertexInput> vertexInputs;
+    // OpSpecConstant* 의 기본값
+    std::vector<SpecializationConstant> specializationDefaults;
+};
+
+struct VertexInputLayout {
+    std::vector<VkVertexInputBindingDescription> bindings;
+    std::vector<VkVertexInputAttributeDescription> attributes;
+};
+
+namespace SpirvReflection {
+
+    ShaderReflection reflect(std::span<const char> code);
+
+    // asset pack 에 SPIR-V 옆에 저장해 두는 reflection 결과 (.spv.refl)
+    constexpr auto CACHE_EXTENSION { ".refl" };
+
+    std::vector<char> serialize(const ShaderReflection& reflection, std::span<const char> code);
+
+    // code 와 맞지 않거나 형식이 다르면 nullopt
+    std::optional<ShaderReflection> deserialize(std::span<const char> cache, std::span<const char> code);
+
+    // location 순서로 binding 0 에 빈틈없이 배치한 per-vertex 입력
+    VertexInputLayout createVertexInputLayout(const ShaderReflection& vertexReflection);
+
+    uint32_t getFormatSize(VkFormat format);
+}
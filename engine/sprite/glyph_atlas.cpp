@@ -0,0 +1,125 @@
+#include "glyph_atlas.h"
+
+#include <algorithm>
+
+namespace {
+    constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+}
+
+GlyphAtlas::GlyphAtlas(SpriteAtlas& atlas, float lineHeight) : m_atlas(atlas), m_lineHeight(lineHeight) {
+    m_asciiIndices.fill(INVALID_INDEX);
+}
+
+bool GlyphAtlas::addGlyph(char32_t codepoint, const GlyphMetrics& metrics, std::span<const uint8_t> coverage) {
+    Glyph glyph {};
+    glyph.bearing = metrics.bearing;
+    glyph.size = { static_cast<float>(metrics.width), static_cast<float>(metrics.height) };
+    glyph.advance = metrics.advance;
+
+    if (metrics.width > 0 && metrics.height > 0) {
+        const size_t pixelCount = size_t { metrics.width } * metrics.height;
+
+        if (coverage.size() < pixelCount) {
+            return false;
+        }
+        std::vector<uint8_t> pixels(pixelCount * SpriteAtlas::CHANNEL_COUNT, 0xFF);
+
+        for (size_t pixel = 0; pixel < pixelCount; pixel++) {
+            pixels[pixel * SpriteAtlas::CHANNEL_COUNT + 3] = coverage[pixel];
+        }
+        std::optional<AtlasRegion> region = m_atlas.add(metrics.width, metrics.height, pixels);
+
+        if (!region) {
+            return false;
+        }
+        glyph.region = *region;
+    }
+    // 같은 글자를 다시 등록하면 덮어씀 (이전 영역은 atlas 에 남음)
+    const Glyph* existing = findGlyph(codepoint);
+
+    if (existing != nullptr) {
+        m_glyphs[existing - m_glyphs.data()] = glyph;
+        return true;
+    }
+    const auto index = static_cast<uint32_t>(m_glyphs.size());
+    m_glyphs.push_back(glyph);
+
+    if (codepoint < ASCII_COUNT) {
+        m_asciiIndices[codepoint] = index;
+    } else {
+        m_otherIndices.emplace(codepoint, index);
+    }
+    return true;
+}
+
+const Glyph* GlyphAtlas::findGlyph(char32_t codepoint) const {
+    uint32_t index = INVALID_INDEX;
+
+    if (codepoint < ASCII_COUNT) {
+        index = m_asciiIndices[codepoint];
+    } else if (const auto found = m_otherIndices.find(codepoint); found != m_otherIndices.end()) {
+        index = found->second;
+    }
+    return index == INVALID_INDEX ? nullptr : &m_glyphs[index];
+}
+
+glm::vec2 GlyphAtlas::measure(std::string_view text, float scale) const {
+    float lineWidth = 0.0f;
+    float width = 0.0f;
+    uint32_t lineCount = text.empty() ? 0 : 1;
+
+    for (size_t offset = 0; offset < text.size();) {
+        const char32_t codepoint = decodeNext(text, offset);
+
+        if (codepoint == U'\n') {
+            width = std::max(width, lineWidth);
+            lineWidth = 0.0f;
+            lineCount++;
+            continue;
+        }
+        if (const Glyph* glyph = findGlyph(codepoint)) {
+            lineWidth += glyph->advance * scale;
+        }
+    }
+    return { std::max(width, lineWidth), static_cast<float>(lineCount) * m_lineHeight * scale };
+}
+
+char32_t GlyphAtlas::decodeNext(std::string_view text, size_t& offset) {
+    const auto lead = static_cast<uint8_t>(text[offset]);
+
+    if (lead < 0x80) {
+        offset++;
+        return lead;
+    }
+    uint32_t length;
+    char32_t codepoint;
+
+    if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+        codepoint = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+        codepoint = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+        codepoint = lead & 0x07;
+    } else {
+        offset++;
+        return REPLACEMENT_CHARACTER;
+    }
+    if (offset + length > text.size()) {
+        offset++;
+        return REPLACEMENT_CHARACTER;
+    }
+    for (uint32_t index = 1; index < length; index++) {
+        const auto continuation = static_cast<uint8_t>(text[offset + index]);
+
+        if ((continuation & 0xC0) != 0x80) {
+            offset++;
+            return REPLACEMENT_CHARACTER;
+        }
+        codepoint = (codepoint << 6) | (continuation & 0x3F);
+    }
+    offset += length;
+    return codepoint;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "sprite_atlas.h"
+
+// 미리 rasterize 된 glyph 의 배치 정보 (pixel 단위)
+struct GlyphMetrics {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    // pen 위치 (baseline) 에서 bitmap 왼쪽 위까지. y 는 아래가 +
+    glm::vec2 bearing { 0.0f };
+    float advance = 0.0f;
+};
+
+struct Glyph {
+    AtlasRegion region;
+    glm::vec2 bearing;
+    glm::vec2 size;
+    float advance;
+};
+
+// 한 글꼴의 glyph 를 SpriteAtlas 에 올림. sprite 와 같은 page 를 쓰므로 글자와 sprite 가 한 draw 로 합쳐짐
+// coverage 는 흰색 RGBA 의 alpha 로 바뀌어 vertex color 가 글자색이 됨
+class GlyphAtlas {
+public:
+    GlyphAtlas(SpriteAtlas& atlas, float lineHeight);
+
+    // coverage 는 width * height byte. atlas 에 자리가 없으면 false (공백처럼 bitmap 이 없으면 advance 만 등록)
+    bool addGlyph(char32_t codepoint, const GlyphMetrics& metrics, std::span<const uint8_t> coverage);
+
+    // 등록되지 않은 글자는 nullptr
+    [[nodiscard]]
+    const Glyph* findGlyph(char32_t codepoint) const;
+
+    [[nodiscard]]
+    float getLineHeight() const {
+        return m_lineHeight;
+    }
+
+    // 줄바꿈을 포함한 text 의 크기
+    [[nodiscard]]
+    glm::vec2 measure(std::string_view text, float scale = 1.0f) const;
+
+    // UTF-8 의 다음 code point. 잘못된 byte 는 U+FFFD 로 바꾸고 한 byte 진행
+    static char32_t decodeNext(std::string_view text, size_t& offset);
+
+private:
+    static constexpr uint32_t ASCII_COUNT = 128;
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    SpriteAtlas&                m_atlas;
+    float                       m_lineHeight;
+    std::vector<Glyph>          m_glyphs;
+    // 대부분의 HUD 글자는 ASCII 라 map 을 거치지 않음
+    std::array<uint32_t, ASCII_COUNT>       m_asciiIndices;
+    std::unordered_map<char32_t, uint32_t>  m_otherIndices;
+};
@@ -0,0 +1,96 @@
+#include "sprite_atlas.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    constexpr uint32_t WHITE_SIZE = 2;
+}
+
+SpriteAtlas::SpriteAtlas(uint32_t pageSize, uint32_t maxPageCount)
+    : m_pageSize(pageSize), m_maxPageCount(std::max(maxPageCount, 1u)) {
+    const std::vector<uint8_t> white(WHITE_SIZE * WHITE_SIZE * CHANNEL_COUNT, 0xFF);
+    std::optional<AtlasRegion> whiteRegion = add(WHITE_SIZE, WHITE_SIZE, white);
+
+    if (!whiteRegion) {
+        throw std::runtime_error("sprite atlas page is too small!");
+    }
+    // texel 중심만 쓰면 filtering 에 상관없이 흰색
+    const glm::vec2 halfTexel { 0.5f / static_cast<float>(m_pageSize) };
+    m_whiteRegion = *whiteRegion;
+    m_whiteRegion.uvMin += halfTexel;
+    m_whiteRegion.uvMax -= halfTexel;
+}
+
+std::optional<AtlasRegion> SpriteAtlas::add(uint32_t width, uint32_t height, std::span<const uint8_t> pixels) {
+    if (width == 0 || height == 0 || pixels.size() < size_t { width } * height * CHANNEL_COUNT) {
+        return std::nullopt;
+    }
+    if (width + PADDING > m_pageSize || height + PADDING > m_pageSize) {
+        return std::nullopt;
+    }
+    uint32_t pageIndex = 0;
+    std::optional<glm::uvec2> position;
+
+    for (; pageIndex < m_pages.size(); pageIndex++) {
+        if ((position = allocate(m_pages[pageIndex], width, height))) {
+            break;
+        }
+    }
+    if (!position) {
+        if (m_pages.size() >= m_maxPageCount) {
+            return std::nullopt;
+        }
+        m_pages.emplace_back();
+        position = allocate(m_pages.back(), width, height);
+    }
+    const glm::vec2 texelSize { 1.0f / static_cast<float>(m_pageSize) };
+    const uint32_t x = position->x;
+    const uint32_t y = position->y;
+
+    AtlasRegion region {};
+    region.page = pageIndex;
+    region.uvMin = glm::vec2 { static_cast<float>(x), static_cast<float>(y) } * texelSize;
+    region.uvMax = glm::vec2 { static_cast<float>(x + width), static_cast<float>(y + height) } * texelSize;
+    region.width = width;
+    region.height = height;
+
+    m_uploads.push_back({ pageIndex, x, y, width, height, { pixels.begin(), pixels.begin() + size_t { width } * height * CHANNEL_COUNT } });
+    return region;
+}
+
+std::vector<AtlasUpload> SpriteAtlas::takeUploads() {
+    return std::exchange(m_uploads, {});
+}
+
+std::optional<glm::uvec2> SpriteAtlas::allocate(Page& page, uint32_t width, uint32_t height) {
+    const uint32_t paddedWidth = width + PADDING;
+    const uint32_t paddedHeight = height + PADDING;
+    Shelf* bestShelf = nullptr;
+
+    // 남는 높이가 가장 적은 shelf
+    for (Shelf& shelf : page.shelves) {
+        if (shelf.height < paddedHeight || shelf.usedWidth + paddedWidth > m_pageSize) {
+            continue;
+        }
+        if (bestShelf == nullptr || shelf.height < bestShelf->height) {
+            bestShelf = &shelf;
+        }
+    }
+    // 맞는 shelf 가 너무 크면 공간 낭비가 크므로 새 shelf 를 엶
+    if (bestShelf != nullptr && bestShelf->height > paddedHeight * 2 && page.usedHeight + paddedHeight <= m_pageSize) {
+        bestShelf = nullptr;
+    }
+    if (bestShelf == nullptr) {
+        if (page.usedHeight + paddedHeight > m_pageSize) {
+            return std::nullopt;
+        }
+        page.shelves.push_back({ page.usedHeight, paddedHeight, 0 });
+        page.usedHeight += paddedHeight;
+        bestShelf = &page.shelves.back();
+    }
+    const glm::uvec2 position { bestShelf->usedWidth, bestShelf->y };
+    bestShelf->usedWidth += paddedWidth;
+    return position;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+// atlas 안의 한 영역. uv 는 page 기준 [0, 1]
+struct AtlasRegion {
+    uint32_t page = 0;
+    glm::vec2 uvMin { 0.0f };
+    glm::vec2 uvMax { 0.0f };
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+// page 에 올려야 하는 RGBA8 이미지. 렌더러가 가져가서 업로드
+struct AtlasUpload {
+    uint32_t page;
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+    std::vector<uint8_t> pixels;
+};
+
+// 고정 크기 page 에 shelf packing 으로 작은 이미지를 모음
+// 같은 page 의 sprite 와 glyph 는 한 draw 로 합쳐짐. 꽉 차면 새 page 를 엶
+class SpriteAtlas {
+public:
+    static constexpr uint32_t CHANNEL_COUNT = 4;
+    // 선형 filtering 이 이웃 영역을 읽지 않도록 영역 사이에 두는 간격
+    static constexpr uint32_t PADDING = 1;
+
+    explicit SpriteAtlas(uint32_t pageSize = 1024, uint32_t maxPageCount = 16);
+
+    // pixels 는 RGBA8, width * height * 4 byte. page 보다 크거나 page 가 부족하면 nullopt
+    std::optional<AtlasRegion> add(uint32_t width, uint32_t height, std::span<const uint8_t> pixels);
+
+    // 가장자리 texel 은 흰색 불투명이라 단색 사각형을 같은 page 로 그릴 수 있음
+    [[nodiscard]]
+    const AtlasRegion& getWhiteRegion() const {
+        return m_whiteRegion;
+    }
+
+    // 마지막 호출 이후 추가된 이미지
+    std::vector<AtlasUpload> takeUploads();
+
+    [[nodiscard]]
+    uint32_t getPageSize() const {
+        return m_pageSize;
+    }
+
+    [[nodiscard]]
+    uint32_t getPageCount() const {
+        return static_cast<uint32_t>(m_pages.size());
+    }
+
+    [[nodiscard]]
+    uint32_t getMaxPageCount() const {
+        return m_maxPageCount;
+    }
+
+private:
+    // 높이가 같은 줄. 새 영역은 가장 알맞은 shelf 의 오른쪽에 붙임
+    struct Shelf {
+        uint32_t y;
+        uint32_t height;
+        uint32_t usedWidth;
+    };
+
+    struct Page {
+        std::vector<Shelf> shelves;
+        uint32_t usedHeight = 0;
+    };
+
+    // page 안의 texel 위치. 자리가 없으면 nullopt
+    std::optional<glm::uvec2> allocate(Page& page, uint32_t width, uint32_t height);
+
+    uint32_t                    m_pageSize;
+    uint32_t                    m_maxPageCount;
+    std::vector<Page>           m_pages;
+    std::vector<AtlasUpload>    m_uploads;
+    AtlasRegion                 m_whiteRegion;
+};
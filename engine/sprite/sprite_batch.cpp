@@ -0,0 +1,105 @@
+#include "sprite_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+void SpriteBatch::begin(std::span<SpriteVertex> vertices) {
+    m_vertices = vertices.data();
+    m_quadCapacity = static_cast<uint32_t>(vertices.size() / VERTICES_PER_QUAD);
+    m_quadCount = 0;
+    m_droppedQuadCount = 0;
+    m_batches.clear();
+    m_recordedVertices.clear();
+}
+
+void SpriteBatch::draw(const AtlasRegion& region, glm::vec2 position, glm::vec2 size, const glm::vec4& color, SpriteBlend blend) {
+    pushQuad(region.page, blend, position, position + size, region.uvMin, region.uvMax, packColor(color));
+}
+
+glm::vec2 SpriteBatch::drawText(
+    const GlyphAtlas& glyphs,
+    std::string_view text,
+    glm::vec2 position,
+    float scale,
+    const glm::vec4& color,
+    SpriteBlend blend
+) {
+    const uint32_t packedColor = packColor(color);
+    glm::vec2 pen = position;
+
+    for (size_t offset = 0; offset < text.size();) {
+        const char32_t codepoint = GlyphAtlas::decodeNext(text, offset);
+
+        if (codepoint == U'\n') {
+            pen = { position.x, pen.y + glyphs.getLineHeight() * scale };
+            continue;
+        }
+        const Glyph* glyph = glyphs.findGlyph(codepoint);
+
+        if (glyph == nullptr) {
+            continue;
+        }
+        // 공백처럼 bitmap 이 없는 글자는 advance 만
+        if (glyph->region.width > 0) {
+            // pixel 경계에 맞춰야 glyph 가 번지지 않음
+            const glm::vec2 min = glm::floor(pen + glyph->bearing * scale + glm::vec2 { 0.5f });
+            pushQuad(glyph->region.page, blend, min, min + glyph->size * scale, glyph->region.uvMin, glyph->region.uvMax, packedColor);
+        }
+        pen.x += glyph->advance * scale;
+    }
+    return pen;
+}
+
+void SpriteBatch::append(std::span<const SpriteVertex> vertices, std::span<const SpriteDrawBatch> batches) {
+    for (const SpriteDrawBatch& batch : batches) {
+        const uint32_t quadCount = std::min(batch.quadCount, m_quadCapacity - m_quadCount);
+        m_droppedQuadCount += batch.quadCount - quadCount;
+
+        if (quadCount == 0) {
+            continue;
+        }
+        m_batches.push_back({ batch.page, batch.blend, m_quadCount, quadCount });
+
+        const auto source = vertices.subspan(size_t { batch.firstQuad } * VERTICES_PER_QUAD, size_t { quadCount } * VERTICES_PER_QUAD);
+        std::ranges::copy(source, m_vertices + size_t { m_quadCount } * VERTICES_PER_QUAD);
+        m_quadCount += quadCount;
+
+        if (m_isRecording) {
+            m_recordedVertices.insert(m_recordedVertices.end(), source.begin(), source.end());
+        }
+    }
+}
+
+uint32_t SpriteBatch::packColor(const glm::vec4& color) {
+    const auto toByte = [](float value) {
+        return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    };
+    return toByte(color.x) | (toByte(color.y) << 8) | (toByte(color.z) << 16) | (toByte(color.w) << 24);
+}
+
+void SpriteBatch::pushQuad(uint32_t page, SpriteBlend blend, glm::vec2 min, glm::vec2 max, glm::vec2 uvMin, glm::vec2 uvMax, uint32_t color) {
+    if (m_quadCount >= m_quadCapacity) {
+        m_droppedQuadCount++;
+        return;
+    }
+    // 직전 quad 와 상태가 같으면 draw 를 늘리기만 함
+    if (m_batches.empty() || m_batches.back().page != page || m_batches.back().blend != blend) {
+        m_batches.push_back({ page, blend, m_quadCount, 0 });
+    }
+    m_batches.back().quadCount++;
+
+    const SpriteVertex quad[VERTICES_PER_QUAD] {
+        { min, uvMin, color },
+        { { max.x, min.y }, { uvMax.x, uvMin.y }, color },
+        { max, uvMax, color },
+        { { min.x, max.y }, { uvMin.x, uvMax.y }, color },
+    };
+    // 매핑된 메모리에 순서대로 씀 (write-combined 메모리를 읽지 않도록 대입만)
+    std::ranges::copy(quad, m_vertices + size_t { m_quadCount } * VERTICES_PER_QUAD);
+    m_quadCount++;
+
+    if (m_isRecording) {
+        m_recordedVertices.insert(m_recordedVertices.end(), std::begin(quad), std::end(quad));
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "glyph_atlas.h"
+#include "sprite_atlas.h"
+
+// 2D pipeline state. 바뀌면 새 draw 가 필요
+enum class SpriteBlend : uint8_t {
+    // straight alpha
+    ALPHA,
+    ADDITIVE,
+};
+
+// sprite.vert 의 입력. position 은 framebuffer pixel (왼쪽 위가 원점)
+struct SpriteVertex {
+    glm::vec2 position;
+    glm::vec2 uv;
+    // RGBA8 (R 이 하위 byte)
+    uint32_t color;
+};
+static_assert(sizeof(SpriteVertex) == 20);
+
+// 같은 page 와 blend 로 이어진 quad 구간. draw 하나가 됨
+struct SpriteDrawBatch {
+    uint32_t page;
+    SpriteBlend blend;
+    uint32_t firstQuad;
+    uint32_t quadCount;
+};
+
+// 매핑된 vertex 메모리에 quad 를 바로 쓰고, 상태가 바뀔 때만 batch 를 끊음
+// 그린 순서를 유지하므로 겹친 sprite 의 앞뒤가 바뀌지 않음
+class SpriteBatch {
+public:
+    static constexpr uint32_t VERTICES_PER_QUAD = 4;
+    static constexpr uint32_t INDICES_PER_QUAD = 6;
+
+    // vertices 는 quad 4 개 단위. 이전 batch 는 버림
+    void begin(std::span<SpriteVertex> vertices);
+
+    void draw(const AtlasRegion& region, glm::vec2 position, glm::vec2 size, const glm::vec4& color = glm::vec4 { 1.0f }, SpriteBlend blend = SpriteBlend::ALPHA);
+
+    // position 은 첫 줄의 baseline 시작점. 반환값은 마지막 글자 다음의 pen 위치
+    glm::vec2 drawText(
+        const GlyphAtlas& glyphs,
+        std::string_view text,
+        glm::vec2 position,
+        float scale = 1.0f,
+        const glm::vec4& color = glm::vec4 { 1.0f },
+        SpriteBlend blend = SpriteBlend::ALPHA
+    );
+
+    [[nodiscard]]
+    std::span<const SpriteDrawBatch> getBatches() const {
+        return m_batches;
+    }
+
+    [[nodiscard]]
+    uint32_t getQuadCount() const {
+        return m_quadCount;
+    }
+
+    // capacity 를 넘어 버려진 quad. 다음 frame 의 ring 크기를 정하는 데 씀
+    [[nodiscard]]
+    uint32_t getDroppedQuadCount() const {
+        return m_droppedQuadCount;
+    }
+
+    // 기록된 batch 를 그대로 이어 붙임 (frame 재생용). firstQuad 는 vertices 기준
+    void append(std::span<const SpriteVertex> vertices, std::span<const SpriteDrawBatch> batches);
+
+    // 켜 두면 매핑된 메모리에 쓰는 quad 를 CPU 쪽에도 남김 (frame 캡처용). begin 뒤 첫 quad 전에 설정
+    void setRecording(bool isRecording) {
+        m_isRecording = isRecording;
+    }
+
+    [[nodiscard]]
+    bool isRecording() const {
+        return m_isRecording;
+    }
+
+    // 이번 frame 에 쓴 quad 의 vertex 사본. write-combined 메모리는 읽지 않으므로 setRecording 을 켠 frame 에만 채워짐
+    [[nodiscard]]
+    std::span<const SpriteVertex> getVertices() const {
+        return m_recordedVertices;
+    }
+
+    static uint32_t packColor(const glm::vec4& color);
+
+private:
+    void pushQuad(uint32_t page, SpriteBlend blend, glm::vec2 min, glm::vec2 max, glm::vec2 uvMin, glm::vec2 uvMax, uint32_t color);
+
+    SpriteVertex*                   m_vertices = nullptr;
+    uint32_t                        m_quadCapacity = 0;
+    uint32_t                        m_quadCount = 0;
+    uint32_t                        m_droppedQuadCount = 0;
+    std::vector<SpriteDrawBatch>    m_batches;
+    bool                            m_isRecording = false;
+    std::vector<SpriteVertex>       m_recordedVertices;
+};
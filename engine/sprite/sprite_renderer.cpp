@@ -0,0 +1,440 @@
+#include "sprite_renderer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+#include "../engine_component_factory.h"
+#include "../memory/host_allocator.h"
+#include "../pipeline/graphics_pipeline_supports.h"
+#include "../texture/texture_supports.h"
+
+namespace {
+    constexpr auto VERTEX_SHADER_NAME { "sprite.vert.spv" };
+    constexpr auto FRAGMENT_SHADER_NAME { "sprite.frag.spv" };
+
+    // sprite.vert 의 push constant. pixel 좌표 -> NDC
+    struct SpritePushConstants {
+        glm::vec2 scale;
+        glm::vec2 offset;
+    };
+
+    VkPipelineColorBlendAttachmentState createBlendAttachment(SpriteBlend blend) {
+        VkPipelineColorBlendAttachmentState colorBlendAttachment = GraphicsPipelineSupports::createPipelineColorBlendAttachmentState();
+        colorBlendAttachment.blendEnable = VK_TRUE;
+        colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        colorBlendAttachment.dstColorBlendFactor = blend == SpriteBlend::ADDITIVE ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+        colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        colorBlendAttachment.dstAlphaBlendFactor = blend == SpriteBlend::ADDITIVE ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+        return colorBlendAttachment;
+    }
+}
+
+SpriteRenderer::SpriteRenderer(
+    VkPhysicalDevice physicalDevice,
+    VkDevice device,
+    DeletionQueue& deletionQueue,
+    ResourceRegistry& resources,
+    PipelineLayoutCache& pipelineLayoutCache,
+    VkRenderPass renderPass,
+    uint32_t framesInFlight
+) : m_physicalDevice(physicalDevice), m_device(device), m_deletionQueue(deletionQueue), m_resources(resources),
+    m_pipelineLayoutCache(pipelineLayoutCache), m_framesInFlight(std::max(framesInFlight, 1u)) {
+    // page 가장자리 너머를 읽지 않도록 clamp
+    VkSamplerCreateInfo samplerCreateInfo = TextureSupports::createSamplerCreateInfo(0.0f);
+    samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+
+    if (vkCreateSampler(m_device, &samplerCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_SAMPLER), &m_sampler) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create sprite sampler!");
+    }
+    createPipelines(renderPass);
+    createDescriptorPool();
+    createRing(MIN_QUAD_CAPACITY);
+}
+
+SpriteRenderer::~SpriteRenderer() {
+    destroyRing();
+
+    for (const Page& page : m_pages) {
+        m_deletionQueue.retire(page.view);
+        m_deletionQueue.retire(page.allocation.image);
+        m_deletionQueue.retire(page.allocation.memory);
+    }
+    m_deletionQueue.retire(m_descriptorPool);
+    m_deletionQueue.retire(m_sampler);
+
+    for (PipelineHandle pipeline : m_pipelines) {
+        ResourceRegistry::release(m_resources.pipelines, pipeline, m_deletionQueue);
+    }
+}
+
+SpriteBatch& SpriteRenderer::begin(uint64_t frame) {
+    // 지난 frame 이 넘쳤으면 다음 frame 부터 다 들어가도록 키움 (이전 ring 은 GPU 가 끝낸 뒤 파괴)
+    const uint32_t requiredQuadCount = m_batch.getQuadCount() + m_batch.getDroppedQuadCount();
+
+    if (requiredQuadCount > m_quadCapacity) {
+        destroyRing();
+        createRing(std::bit_ceil(requiredQuadCount));
+    }
+    m_currentSlot = static_cast<uint32_t>(frame % m_framesInFlight);
+
+    const size_t vertexCount = size_t { m_quadCapacity } * SpriteBatch::VERTICES_PER_QUAD;
+    m_batch.begin({ m_mappedVertices + vertexCount * m_currentSlot, vertexCount });
+    return m_batch;
+}
+
+void SpriteRenderer::recordUploads(VkCommandBuffer commandBuffer) {
+    m_recordedUploads = m_atlas.takeUploads();
+    std::ranges::move(m_pendingUploads, std::back_inserter(m_recordedUploads));
+    m_pendingUploads.clear();
+
+    const std::vector<AtlasUpload>& uploads = m_recordedUploads;
+    uint32_t pageCount = std::max(m_atlas.getPageCount(), m_reservedPageCount);
+
+    for (const AtlasUpload& upload : uploads) {
+        pageCount = std::max(pageCount, upload.page + 1);
+    }
+    while (m_pages.size() < pageCount) {
+        addPage();
+    }
+    recordPageClears(commandBuffer);
+
+    if (uploads.empty()) {
+        return;
+    }
+    VkDeviceSize stagingSize = 0;
+
+    for (const AtlasUpload& upload : uploads) {
+        stagingSize += upload.pixels.size();
+    }
+    // 복사가 끝난 뒤 파괴되도록 바로 retire
+    const BufferAllocation staging = MemorySupports::createBuffer(
+        m_physicalDevice,
+        m_device,
+        stagingSize,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        m_deletionQueue.getMemoryBudget(),
+        MemoryCategory::TRANSIENT
+    );
+    void* mapped;
+
+    if (vkMapMemory(m_device, staging.memory, 0, stagingSize, 0, &mapped) != VK_SUCCESS) {
+        throw std::runtime_error("failed to map sprite staging buffer!");
+    }
+    // page 별로 모아 한 번의 copy 로 올림
+    std::vector<std::vector<VkBufferImageCopy>> pageCopies(m_pages.size());
+    VkDeviceSize offset = 0;
+
+    for (const AtlasUpload& upload : uploads) {
+        std::memcpy(static_cast<char*>(mapped) + offset, upload.pixels.data(), upload.pixels.size());
+
+        VkBufferImageCopy copy = TextureSupports::createBufferImageCopy(offset, 0, { upload.width, upload.height });
+        copy.imageOffset = { static_cast<int32_t>(upload.x), static_cast<int32_t>(upload.y), 0 };
+        pageCopies[upload.page].push_back(copy);
+        offset += upload.pixels.size();
+    }
+    vkUnmapMemory(m_device, staging.memory);
+
+    for (uint32_t pageIndex = 0; pageIndex < m_pages.size(); pageIndex++) {
+        const std::vector<VkBufferImageCopy>& copies = pageCopies[pageIndex];
+
+        if (copies.empty()) {
+            continue;
+        }
+        Page& page = m_pages[pageIndex];
+        VkImage image = page.allocation.image;
+
+        // 이미 올린 영역은 남겨야 하므로 처음 쓰는 page 만 UNDEFINED 에서 전환
+        TextureSupports::recordImageBarrier(
+            commandBuffer,
+            TextureSupports::createImageMemoryBarrier(
+                image, 0, 1,
+                page.isInitialized ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT
+            ),
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT
+        );
+        vkCmdCopyBufferToImage(
+            commandBuffer, staging.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(copies.size()), copies.data()
+        );
+        TextureSupports::recordImageBarrier(
+            commandBuffer,
+            TextureSupports::createImageMemoryBarrier(
+                image, 0, 1,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT
+            ),
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+        );
+        page.isInitialized = true;
+    }
+    m_deletionQueue.retire(staging.buffer);
+    m_deletionQueue.retire(staging.memory);
+}
+
+void SpriteRenderer::queueUpload(AtlasUpload upload) {
+    const uint32_t pageSize = m_atlas.getPageSize();
+
+    if (upload.page >= m_atlas.getMaxPageCount() || upload.width > pageSize || upload.height > pageSize
+        || upload.x > pageSize - upload.width || upload.y > pageSize - upload.height
+        || upload.pixels.size() != size_t { upload.width } * upload.height * SpriteAtlas::CHANNEL_COUNT) {
+        throw std::runtime_error("sprite upload is out of atlas page!");
+    }
+    m_pendingUploads.push_back(std::move(upload));
+}
+
+void SpriteRenderer::recordPageClears(VkCommandBuffer commandBuffer) {
+    std::vector<bool> hasUpload(m_pages.size(), false);
+
+    for (const AtlasUpload& upload : m_recordedUploads) {
+        hasUpload[upload.page] = true;
+    }
+    constexpr VkClearColorValue clearColor {};
+    const VkImageSubresourceRange range { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+    for (uint32_t pageIndex = 0; pageIndex < m_pages.size(); pageIndex++) {
+        Page& page = m_pages[pageIndex];
+
+        if (page.isInitialized || hasUpload[pageIndex]) {
+            continue;
+        }
+        TextureSupports::recordImageBarrier(
+            commandBuffer,
+            TextureSupports::createImageMemoryBarrier(
+                page.allocation.image, 0, 1, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT
+            ),
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT
+        );
+        vkCmdClearColorImage(commandBuffer, page.allocation.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1, &range);
+        TextureSupports::recordImageBarrier(
+            commandBuffer,
+            TextureSupports::createImageMemoryBarrier(
+                page.allocation.image, 0, 1,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT
+            ),
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+        );
+        page.isInitialized = true;
+    }
+}
+
+void SpriteRenderer::recordDraw(VkCommandBuffer commandBuffer, VkExtent2D extent) {
+    const std::span<const SpriteDrawBatch> batches = m_batch.getBatches();
+    m_stats = { m_batch.getQuadCount(), 0, m_batch.getDroppedQuadCount() };
+
+    if (batches.empty() || m_pages.empty()) {
+        return;
+    }
+    VkPipelineLayout pipelineLayout = *m_resources.pipelineLayouts.get(m_pipelineLayout);
+    const VkDeviceSize vertexOffset = VkDeviceSize { m_currentSlot } * m_quadCapacity * SpriteBatch::VERTICES_PER_QUAD * sizeof(SpriteVertex);
+    const SpritePushConstants pushConstants {
+        { 2.0f / static_cast<float>(extent.width), 2.0f / static_cast<float>(extent.height) },
+        { -1.0f, -1.0f },
+    };
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_vertexRing.buffer, &vertexOffset);
+    vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
+
+    // 두 pipeline 이 layout 을 공유하므로 push constant 와 descriptor set 은 pipeline 이 바뀌어도 유지됨
+    const SpriteDrawBatch* previous = nullptr;
+
+    for (const SpriteDrawBatch& batch : batches) {
+        if (batch.page >= m_pages.size()) {
+            continue;
+        }
+        if (previous == nullptr || previous->blend != batch.blend) {
+            vkCmdBindPipeline(
+                commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *m_resources.pipelines.get(m_pipelines[static_cast<uint32_t>(batch.blend)])
+            );
+        }
+        if (previous == nullptr) {
+            vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(SpritePushConstants), &pushConstants);
+        }
+        if (previous == nullptr || previous->page != batch.page) {
+            vkCmdBindDescriptorSets(
+                commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &m_pages[batch.page].descriptorSet, 0, nullptr
+            );
+        }
+        vkCmdDrawIndexed(
+            commandBuffer, batch.quadCount * SpriteBatch::INDICES_PER_QUAD, 1, batch.firstQuad * SpriteBatch::INDICES_PER_QUAD, 0, 0
+        );
+        m_stats.drawCount++;
+        previous = &batch;
+    }
+}
+
+void SpriteRenderer::createRing(uint32_t quadCapacity) {
+    m_quadCapacity = std::max(quadCapacity, MIN_QUAD_CAPACITY);
+
+    const VkDeviceSize vertexSize = VkDeviceSize { m_quadCapacity } * SpriteBatch::VERTICES_PER_QUAD * sizeof(SpriteVertex);
+    m_vertexRing = MemorySupports::createBuffer(
+        m_physicalDevice,
+        m_device,
+        vertexSize * m_framesInFlight,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        m_deletionQueue.getMemoryBudget(),
+        MemoryCategory::TRANSIENT
+    );
+    void* mapped = nullptr;
+
+    if (vkMapMemory(m_device, m_vertexRing.memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+        throw std::runtime_error("failed to map sprite vertex ring!");
+    }
+    m_mappedVertices = static_cast<SpriteVertex*>(mapped);
+
+    // 모든 quad 가 같은 index 패턴이라 ring 의 어느 구간에도 그대로 씀
+    const VkDeviceSize indexSize = VkDeviceSize { m_quadCapacity } * SpriteBatch::INDICES_PER_QUAD * sizeof(uint32_t);
+    m_indexBuffer = MemorySupports::createBuffer(
+        m_physicalDevice,
+        m_device,
+        indexSize,
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        m_deletionQueue.getMemoryBudget()
+    );
+    if (vkMapMemory(m_device, m_indexBuffer.memory, 0, indexSize, 0, &mapped) != VK_SUCCESS) {
+        throw std::runtime_error("failed to map sprite index buffer!");
+    }
+    auto* indices = static_cast<uint32_t*>(mapped);
+
+    for (uint32_t quad = 0; quad < m_quadCapacity; quad++) {
+        const uint32_t vertex = quad * SpriteBatch::VERTICES_PER_QUAD;
+        const uint32_t quadIndices[SpriteBatch::INDICES_PER_QUAD] { vertex, vertex + 1, vertex + 2, vertex + 2, vertex + 3, vertex };
+        std::memcpy(indices + size_t { quad } * SpriteBatch::INDICES_PER_QUAD, quadIndices, sizeof(quadIndices));
+    }
+    vkUnmapMemory(m_device, m_indexBuffer.memory);
+}
+
+void SpriteRenderer::destroyRing() {
+    // 매핑은 vkFreeMemory 에서 함께 해제됨
+    m_deletionQueue.retire(m_vertexRing.buffer);
+    m_deletionQueue.retire(m_vertexRing.memory);
+    m_deletionQueue.retire(m_indexBuffer.buffer);
+    m_deletionQueue.retire(m_indexBuffer.memory);
+    m_vertexRing = {};
+    m_indexBuffer = {};
+    m_mappedVertices = nullptr;
+    m_quadCapacity = 0;
+}
+
+void SpriteRenderer::createPipelines(VkRenderPass renderPass) {
+    const ShaderModule& vertexShader = m_resources.getShader(VERTEX_SHADER_NAME);
+    const ShaderModule& fragmentShader = m_resources.getShader(FRAGMENT_SHADER_NAME);
+    const ShaderReflection* stages[] { &vertexShader.reflection, &fragmentShader.reflection };
+    m_pipelineLayout = m_pipelineLayoutCache.getPipelineLayout(m_resources, stages);
+
+    const VkPipelineShaderStageCreateInfo shaderStages[] {
+        GraphicsPipelineSupports::createPipelineShaderStageCreateInfo(VK_SHADER_STAGE_VERTEX_BIT, vertexShader.module),
+        GraphicsPipelineSupports::createPipelineShaderStageCreateInfo(VK_SHADER_STAGE_FRAGMENT_BIT, fragmentShader.module),
+    };
+    const VkVertexInputBindingDescription bindings[] {
+        { 0, sizeof(SpriteVertex), VK_VERTEX_INPUT_RATE_VERTEX },
+    };
+    const VkVertexInputAttributeDescription attributes[] {
+        { 0, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(SpriteVertex, position) },
+        { 1, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(SpriteVertex, uv) },
+        { 2, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(SpriteVertex, color) },
+    };
+    auto vertexInputState = GraphicsPipelineSupports::createPipelineVertexInputStateCreateInfo(bindings, attributes);
+    auto inputAssemblyState = GraphicsPipelineSupports::createPipelineInputAssemblyStateCreateInfo();
+    auto rasterizationState = GraphicsPipelineSupports::createPipelineRasterizationStateCreateInfo();
+    rasterizationState.cullMode = VK_CULL_MODE_NONE;
+    auto multisampleState = GraphicsPipelineSupports::createPipelineMultisampleStateCreateInfo();
+
+    // scene 위에 그린 순서대로 덮음
+    auto depthStencilState = GraphicsPipelineSupports::createPipelineDepthStencilStateCreateInfo();
+    depthStencilState.depthTestEnable = VK_FALSE;
+    depthStencilState.depthWriteEnable = VK_FALSE;
+
+    auto viewportState = GraphicsPipelineSupports::createPipelineViewportStateCreateInfo();
+
+    for (const SpriteBlend blend : { SpriteBlend::ALPHA, SpriteBlend::ADDITIVE }) {
+        const VkPipelineColorBlendAttachmentState colorBlendAttachment = createBlendAttachment(blend);
+        auto colorBlendState = GraphicsPipelineSupports::createPipelineColorBlendStateCreateInfo(&colorBlendAttachment);
+
+        const VkGraphicsPipelineCreateInfo pipelineCreateInfo = EngineComponentFactory::createGraphicsPipelineCreateInfo(
+            shaderStages,
+            viewportState,
+            vertexInputState,
+            inputAssemblyState,
+            rasterizationState,
+            multisampleState,
+            depthStencilState,
+            colorBlendState,
+            *m_resources.pipelineLayouts.get(m_pipelineLayout),
+            renderPass
+        );
+        VkPipeline pipeline;
+
+        if (vkCreateGraphicsPipelines(m_device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_PIPELINE), &pipeline) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create sprite pipeline!");
+        }
+        m_pipelines[static_cast<uint32_t>(blend)] = m_resources.pipelines.create(pipeline);
+    }
+}
+
+void SpriteRenderer::createDescriptorPool() {
+    // page 마다 sampler 하나
+    const VkDescriptorPoolSize poolSizes[] {
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_atlas.getMaxPageCount() },
+    };
+    m_descriptorPool = EngineComponentFactory::createDescriptorPool(m_device, poolSizes, m_atlas.getMaxPageCount());
+}
+
+void SpriteRenderer::addPage() {
+    Page page {};
+    const uint32_t pageSize = m_atlas.getPageSize();
+
+    const VkImageCreateInfo imageCreateInfo = MemorySupports::createImageCreateInfo(
+        { pageSize, pageSize }, 1, PAGE_FORMAT, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+    );
+    page.allocation = MemorySupports::createImage(
+        m_physicalDevice, m_device, imageCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_deletionQueue.getMemoryBudget(), MemoryCategory::IMAGE
+    );
+    const VkImageViewCreateInfo viewCreateInfo = TextureSupports::createImageViewCreateInfo(page.allocation.image, PAGE_FORMAT, 1);
+
+    if (vkCreateImageView(m_device, &viewCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_IMAGE_VIEW), &page.view) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create sprite atlas view!");
+    }
+    std::span<const DescriptorSetLayoutHandle> setLayouts = m_pipelineLayoutCache.getSetLayouts(m_pipelineLayout);
+
+    if (setLayouts.empty()) {
+        throw std::runtime_error("sprite shader has no descriptor set!");
+    }
+    VkDescriptorSetLayout setLayout = *m_resources.descriptorSetLayouts.get(setLayouts[0]);
+
+    VkDescriptorSetAllocateInfo allocateInfo {};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.descriptorPool = m_descriptorPool;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &setLayout;
+
+    if (vkAllocateDescriptorSets(m_device, &allocateInfo, &page.descriptorSet) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate sprite descriptor set!");
+    }
+    const VkDescriptorImageInfo imageInfo { m_sampler, page.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+
+    VkWriteDescriptorSet write {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = page.descriptorSet;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+    vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+
+    m_pages.push_back(page);
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+#include "sprite_atlas.h"
+#include "sprite_batch.h"
+#include "../memory/memory_supports.h"
+#include "../pipeline/pipeline_layout_cache.h"
+#include "../resource/deletion_queue.h"
+#include "../resource/resource_registry.h"
+
+// frame 마다 render thread 에서 HUD 를 채우는 callback
+using SpriteCallback = std::function<void(SpriteBatch& batch)>;
+
+// 마지막 recordDraw 의 결과
+struct SpriteStats {
+    uint32_t quadCount;
+    uint32_t drawCount;
+    uint32_t droppedQuadCount;
+};
+
+// HUD / overlay 용 batched 2D renderer
+// frame in flight 마다 구간을 나눈 persistently mapped vertex ring 에 SpriteBatch 가 quad 를 바로 쓰고,
+// atlas page 나 blend 가 바뀌는 곳에서만 draw 를 끊음. index 는 quad 패턴이 고정이라 한 번만 채움
+class SpriteRenderer {
+public:
+    SpriteRenderer(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        DeletionQueue& deletionQueue,
+        ResourceRegistry& resources,
+        PipelineLayoutCache& pipelineLayoutCache,
+        VkRenderPass renderPass,
+        uint32_t framesInFlight
+    );
+
+    SpriteRenderer(const SpriteRenderer&) = delete;
+    SpriteRenderer& operator=(const SpriteRenderer&) = delete;
+
+    ~SpriteRenderer();
+
+    // sprite 이미지와 GlyphAtlas 가 올라가는 atlas. 추가된 영역은 다음 recordUploads 에서 반영
+    [[nodiscard]]
+    SpriteAtlas& getAtlas() {
+        return m_atlas;
+    }
+
+    // frame 의 ring 구간을 열어 batch 를 돌려줌. 지난 frame 에 넘친 만큼 ring 을 키움
+    SpriteBatch& begin(uint64_t frame);
+
+    // render pass 밖에서 기록. 새로 추가된 atlas 영역과 queueUpload 로 넣은 영역을 page 에 복사
+    void recordUploads(VkCommandBuffer commandBuffer);
+
+    // atlas 를 거치지 않고 page 에 올릴 영역 (frame 재생용). 필요하면 page 를 추가
+    void queueUpload(AtlasUpload upload);
+
+    // 다음 recordUploads 에서 page 를 pageCount 개까지 만들어 둠 (frame 재생용). 업로드가 없는 page 는 투명하게 지움
+    void reservePages(uint32_t pageCount) {
+        m_reservedPageCount = std::max(m_reservedPageCount, std::min(pageCount, m_atlas.getMaxPageCount()));
+    }
+
+    // 마지막 recordUploads 가 올린 영역 (frame 캡처용)
+    [[nodiscard]]
+    std::span<const AtlasUpload> getRecordedUploads() const {
+        return m_recordedUploads;
+    }
+
+    // begin 으로 채운 batch 를 render pass 안에서 그림. extent 는 그리는 framebuffer 의 크기 (창마다 다시 기록 가능)
+    void recordDraw(VkCommandBuffer commandBuffer, VkExtent2D extent);
+
+    // 마지막 begin 으로 채운 batch
+    [[nodiscard]]
+    const SpriteBatch& getBatch() const {
+        return m_batch;
+    }
+
+    [[nodiscard]]
+    const SpriteStats& getStats() const {
+        return m_stats;
+    }
+
+private:
+    static constexpr uint32_t MIN_QUAD_CAPACITY = 4096;
+    static constexpr VkFormat PAGE_FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
+
+    struct Page {
+        ImageAllocation allocation;
+        VkImageView view = VK_NULL_HANDLE;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        // 한 번이라도 업로드되어 SHADER_READ_ONLY 인지
+        bool isInitialized = false;
+    };
+
+    void createRing(uint32_t quadCapacity);
+    void destroyRing();
+    void createPipelines(VkRenderPass renderPass);
+    void createDescriptorPool();
+    void addPage();
+    // 아직 아무것도 올라가지 않은 page 를 sampling 가능한 상태로 만듦
+    void recordPageClears(VkCommandBuffer commandBuffer);
+
+    VkPhysicalDevice            m_physicalDevice;
+    VkDevice                    m_device;
+    DeletionQueue&              m_deletionQueue;
+    ResourceRegistry&           m_resources;
+    PipelineLayoutCache&        m_pipelineLayoutCache;
+    uint32_t                    m_framesInFlight;
+
+    SpriteAtlas                 m_atlas;
+    SpriteBatch                 m_batch;
+    SpriteStats                 m_stats {};
+    std::vector<AtlasUpload>    m_pendingUploads;
+    std::vector<AtlasUpload>    m_recordedUploads;
+    uint32_t                    m_reservedPageCount = 0;
+
+    // [frame 0 | frame 1 | ...] 각 구간이 m_quadCapacity 개의 quad
+    BufferAllocation            m_vertexRing;
+    SpriteVertex*               m_mappedVertices = nullptr;
+    BufferAllocation            m_indexBuffer;
+    uint32_t                    m_quadCapacity = 0;
+    // 이번 frame 이 쓰는 ring 구간
+    uint32_t                    m_currentSlot = 0;
+
+    std::vector<Page>           m_pages;
+    VkSampler                   m_sampler = VK_NULL_HANDLE;
+    VkDescriptorPool            m_descriptorPool = VK_NULL_HANDLE;
+    PipelineLayoutHandle        m_pipelineLayout;
+    // SpriteBlend 순서
+    PipelineHandle              m_pipelines[2];
+};
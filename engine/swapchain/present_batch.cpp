@@ -0,0 +1,104 @@
+#include "present_batch.h"
+
+#include <stdexcept>
+
+void PresentBatch::clear() {
+    m_windows.clear();
+    m_waitSemaphores.clear();
+    m_waitStages.clear();
+    m_signalSemaphores.clear();
+    m_presentWaitSemaphores.clear();
+    m_ownershipWaitSemaphores.clear();
+    m_ownershipWaitStages.clear();
+    m_ownershipCommandBuffers.clear();
+    m_ownershipSignalSemaphores.clear();
+    m_swapchains.clear();
+    m_imageIndices.clear();
+}
+
+void PresentBatch::add(WindowSurface& window, uint64_t frame) {
+    m_windows.push_back(&window);
+    m_waitSemaphores.push_back(window.getImageAvailableSemaphore(frame));
+    m_waitStages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    m_signalSemaphores.push_back(window.getRenderFinishedSemaphore());
+
+    if (window.getPresentSharing() == PresentSharing::OWNERSHIP_TRANSFER) {
+        // acquire barrier 는 release 와 같은 image 에 대해 graphics submit 이 끝난 뒤 실행되어야 함
+        m_ownershipWaitSemaphores.push_back(window.getRenderFinishedSemaphore());
+        m_ownershipWaitStages.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        m_ownershipCommandBuffers.push_back(window.getOwnershipAcquireCommandBuffer());
+        m_ownershipSignalSemaphores.push_back(window.getOwnershipAcquiredSemaphore());
+        m_presentWaitSemaphores.push_back(window.getOwnershipAcquiredSemaphore());
+    } else {
+        m_presentWaitSemaphores.push_back(window.getRenderFinishedSemaphore());
+    }
+    m_swapchains.push_back(window.getSwapchain());
+    m_imageIndices.push_back(window.getImageIndex());
+}
+
+VkSubmitInfo PresentBatch::createSubmitInfo(const VkCommandBuffer* commandBuffer) const {
+    VkSubmitInfo submitInfo {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount = static_cast<uint32_t>(m_waitSemaphores.size());
+    submitInfo.pWaitSemaphores = m_waitSemaphores.data();
+    submitInfo.pWaitDstStageMask = m_waitStages.data();
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = commandBuffer;
+    submitInfo.signalSemaphoreCount = static_cast<uint32_t>(m_signalSemaphores.size());
+    submitInfo.pSignalSemaphores = m_signalSemaphores.data();
+    return submitInfo;
+}
+
+void PresentBatch::recordOwnershipReleases(VkCommandBuffer commandBuffer) const {
+    for (const WindowSurface* window : m_windows) {
+        window->recordOwnershipRelease(commandBuffer);
+    }
+}
+
+void PresentBatch::present(VkQueue presentQueue) {
+    if (m_swapchains.empty()) {
+        return;
+    }
+    if (!m_ownershipCommandBuffers.empty()) {
+        VkSubmitInfo submitInfo {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.waitSemaphoreCount = static_cast<uint32_t>(m_ownershipWaitSemaphores.size());
+        submitInfo.pWaitSemaphores = m_ownershipWaitSemaphores.data();
+        submitInfo.pWaitDstStageMask = m_ownershipWaitStages.data();
+        submitInfo.commandBufferCount = static_cast<uint32_t>(m_ownershipCommandBuffers.size());
+        submitInfo.pCommandBuffers = m_ownershipCommandBuffers.data();
+        submitInfo.signalSemaphoreCount = static_cast<uint32_t>(m_ownershipSignalSemaphores.size());
+        submitInfo.pSignalSemaphores = m_ownershipSignalSemaphores.data();
+
+        if (vkQueueSubmit(presentQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+            throw std::runtime_error("failed to submit swapchain ownership transfer!");
+        }
+    }
+    m_results.assign(m_swapchains.size(), VK_SUCCESS);
+
+    VkPresentInfoKHR presentInfo {};
+    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.waitSemaphoreCount = static_cast<uint32_t>(m_presentWaitSemaphores.size());
+    presentInfo.pWaitSemaphores = m_presentWaitSemaphores.data();
+    presentInfo.swapchainCount = static_cast<uint32_t>(m_swapchains.size());
+    presentInfo.pSwapchains = m_swapchains.data();
+    presentInfo.pImageIndices = m_imageIndices.data();
+    // 반환값은 가장 나쁜 결과 하나뿐이라 창마다 받음
+    presentInfo.pResults = m_results.data();
+
+    const VkResult presentResult = vkQueuePresentKHR(presentQueue, &presentInfo);
+
+    if (presentResult != VK_SUCCESS && presentResult != VK_SUBOPTIMAL_KHR && presentResult != VK_ERROR_OUT_OF_DATE_KHR) {
+        throw std::runtime_error("failed to present swapchain image!");
+    }
+    // 창 크기가 바뀐 것이므로 다음 frame 전에 Engine 이 그 창만 다시 만듦
+    for (size_t index = 0; index < m_results.size(); index++) {
+        const VkResult result = m_results[index];
+
+        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+            m_windows[index]->markOutOfDate();
+        } else if (result != VK_SUCCESS) {
+            throw std::runtime_error("failed to present swapchain image!");
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+#include "window_surface.h"
+
+// 한 frame 에 그리는 창들을 모아 submit 하나와 vkQueuePresentKHR 하나로 처리
+// present family 가 다른 창 (OWNERSHIP_TRANSFER) 은 present 전에 present queue 에서 acquire barrier 를 먼저 submit
+// 배열은 frame 마다 할당하지 않도록 재사용
+class PresentBatch {
+public:
+    void clear();
+
+    // acquire 가 끝난 창. submit 은 그 image 를 기다리고 끝나면 present 용 semaphore 를 signal
+    void add(WindowSurface& window, uint64_t frame);
+
+    [[nodiscard]]
+    std::span<const WindowSurface* const> getWindows() const {
+        return m_windows;
+    }
+
+    // 반환값은 이 batch 의 배열을 가리키므로 다음 clear 전까지만 유효
+    [[nodiscard]]
+    VkSubmitInfo createSubmitInfo(const VkCommandBuffer* commandBuffer) const;
+
+    // OWNERSHIP_TRANSFER 인 창마다 release barrier 를 기록. submit 할 command buffer 의 마지막에 호출
+    void recordOwnershipReleases(VkCommandBuffer commandBuffer) const;
+
+    // 모든 swapchain 을 한 번에 present. OUT_OF_DATE 인 창은 재생성하도록 표시하고 그 밖의 실패는 throw
+    void present(VkQueue presentQueue);
+
+private:
+    std::vector<WindowSurface*>         m_windows;
+    std::vector<VkSemaphore>            m_waitSemaphores;
+    std::vector<VkPipelineStageFlags>   m_waitStages;
+    std::vector<VkSemaphore>            m_signalSemaphores;
+    // 창마다 present 가 기다리는 semaphore. 소유권을 넘기는 창은 acquire barrier 의 semaphore
+    std::vector<VkSemaphore>            m_presentWaitSemaphores;
+    // acquire barrier 의 submit 이 기다리는 semaphore 와 그 command buffer
+    std::vector<VkSemaphore>            m_ownershipWaitSemaphores;
+    std::vector<VkPipelineStageFlags>   m_ownershipWaitStages;
+    std::vector<VkCommandBuffer>        m_ownershipCommandBuffers;
+    std::vector<VkSemaphore>            m_ownershipSignalSemaphores;
+    std::vector<VkSwapchainKHR>         m_swapchains;
+    std::vector<uint32_t>               m_imageIndices;
+    std::vector<VkResult>               m_results;
+};
@@ -0,0 +1,201 @@
+#include "window_surface.h"
+
+#include <stdexcept>
+
+#include "swapchain_supports.h"
+#include "../engine_component_factory.h"
+#include "../shader/render_pass_supports.h"
+
+WindowSurface::WindowSurface(
+    GLFWwindow* window,
+    VkSurfaceKHR surface,
+    VkPhysicalDevice physicalDevice,
+    VkDevice device,
+    ResourceRegistry& resources,
+    const QueueFamilyIndices& queueFamilyIndices,
+    uint32_t framesInFlight,
+    MemoryBudget* budget
+) : m_window(window), m_surface(surface), m_physicalDevice(physicalDevice), m_device(device),
+    m_queueFamilyIndices(queueFamilyIndices), m_budget(budget) {
+    m_graphicsFamily = queueFamilyIndices.graphicsFamily.value();
+    m_presentFamily = queueFamilyIndices.presentFamily.value();
+    m_presentSharing = QueueFactory::getPresentSharing(physicalDevice, queueFamilyIndices);
+
+    for (uint32_t frame = 0; frame < framesInFlight; frame++) {
+        m_imageAvailableSemaphores.push_back(EngineComponentFactory::createSemaphore(device));
+    }
+    createSwapchainResources(resources, SwapchainSupports::getSwapchainSupportDetails(physicalDevice, surface));
+}
+
+void WindowSurface::createFramebuffers(ResourceRegistry& resources, VkRenderPass renderPass) {
+    m_renderPass = renderPass;
+    m_framebuffers.reserve(m_imageViews.size());
+
+    // depth 는 image 끼리 공유 (한 번에 한 frame 만 그리므로)
+    for (ImageViewHandle imageView : m_imageViews) {
+        const VkImageView attachments[] { *resources.imageViews.get(imageView), m_depthTarget.view };
+        VkFramebuffer framebuffer = EngineComponentFactory::createFramebuffer(m_device, renderPass, attachments, m_extent);
+        m_framebuffers.push_back(resources.framebuffers.create(framebuffer));
+    }
+}
+
+bool WindowSurface::acquire(uint64_t frame) {
+    if (isClosed() || m_needsRecreate) {
+        return false;
+    }
+    const VkResult acquireResult = vkAcquireNextImageKHR(
+        m_device, m_swapchain, UINT64_MAX, getImageAvailableSemaphore(frame), VK_NULL_HANDLE, &m_imageIndex
+    );
+    // semaphore 는 signal 되지 않으므로 이번 frame 에서 빼기만 하면 됨
+    if (acquireResult == VK_ERROR_OUT_OF_DATE_KHR) {
+        m_needsRecreate = true;
+        return false;
+    }
+    if (acquireResult == VK_SUBOPTIMAL_KHR) {
+        m_needsRecreate = true;
+    } else if (acquireResult != VK_SUCCESS) {
+        throw std::runtime_error("failed to acquire swapchain image!");
+    }
+    return true;
+}
+
+bool WindowSurface::recreate(ResourceRegistry& resources, DeletionQueue& deletionQueue) {
+    const SwapchainSupportDetails swapchainSupportDetails = SwapchainSupports::getSwapchainSupportDetails(m_physicalDevice, m_surface);
+    const VkExtent2D extent = swapchainSupportDetails.getProperExtent();
+
+    if (extent.width == 0 || extent.height == 0) {
+        return false;
+    }
+    // render pass 와 pipeline 을 다른 창과 공유하므로 format 은 바뀌면 안 됨
+    if (swapchainSupportDetails.getProperSurfaceFormat().format != m_format) {
+        throw std::runtime_error("swapchain format changed while recreating!");
+    }
+    destroySwapchainResources(resources, deletionQueue);
+    const VkSwapchainKHR oldSwapchain = m_swapchain;
+    createSwapchainResources(resources, swapchainSupportDetails);
+    // 새 swapchain 을 만드는 동안 살아 있어야 하므로 그 뒤에 retire
+    deletionQueue.retire(oldSwapchain);
+    createFramebuffers(resources, m_renderPass);
+
+    m_needsRecreate = false;
+    return true;
+}
+
+void WindowSurface::recordOwnershipRelease(VkCommandBuffer commandBuffer) const {
+    if (m_presentSharing != PresentSharing::OWNERSHIP_TRANSFER) {
+        return;
+    }
+    // render pass 와 캡처 복사가 끝난 뒤 넘김. layout 은 render pass 가 바꿔 둔 PRESENT_SRC 그대로
+    const VkImageMemoryBarrier barrier = QueueFactory::createOwnershipTransferBarrier(
+        getImage(), VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, m_graphicsFamily, m_presentFamily, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+    );
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &barrier
+    );
+}
+
+void WindowSurface::destroy(ResourceRegistry& resources, DeletionQueue& deletionQueue) {
+    destroySwapchainResources(resources, deletionQueue);
+    // image view 와 framebuffer 보다 나중에 파괴되도록 마지막에 retire
+    deletionQueue.retire(m_swapchain);
+    m_swapchain = VK_NULL_HANDLE;
+
+    for (VkSemaphore semaphore : m_imageAvailableSemaphores) {
+        deletionQueue.retire(semaphore);
+    }
+    m_imageAvailableSemaphores.clear();
+}
+
+void WindowSurface::createSwapchainResources(ResourceRegistry& resources, SwapchainSupportDetails swapchainSupportDetails) {
+    // 재생성이면 m_swapchain 은 이전 것. surface 에는 swapchain 이 하나만 있을 수 있으므로 넘겨서 교체
+    m_swapchain = EngineComponentFactory::createSwapchain(
+        m_device, m_surface, swapchainSupportDetails, m_queueFamilyIndices, m_presentSharing, m_swapchain
+    );
+    m_extent = swapchainSupportDetails.getProperExtent();
+    m_format = swapchainSupportDetails.getProperSurfaceFormat().format;
+
+    const VkImageUsageFlags imageUsage = EngineComponentFactory::getSwapchainImageUsage(swapchainSupportDetails.surfaceCapabilities);
+    m_supportsCapture = (imageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) != 0;
+
+    m_images = EngineComponentFactory::getSwapchainImages(m_device, m_swapchain);
+    m_imageViews.reserve(m_images.size());
+
+    for (VkImage image : m_images) {
+        m_imageViews.push_back(resources.imageViews.create(EngineComponentFactory::createImageView(m_device, m_format, image)));
+        m_renderFinishedSemaphores.push_back(EngineComponentFactory::createSemaphore(m_device));
+    }
+    createDepthTarget();
+
+    if (m_presentSharing == PresentSharing::OWNERSHIP_TRANSFER) {
+        createOwnershipTransfer();
+    }
+}
+
+void WindowSurface::destroySwapchainResources(ResourceRegistry& resources, DeletionQueue& deletionQueue) {
+    for (FramebufferHandle framebuffer : m_framebuffers) {
+        ResourceRegistry::release(resources.framebuffers, framebuffer, deletionQueue);
+    }
+    for (ImageViewHandle imageView : m_imageViews) {
+        ResourceRegistry::release(resources.imageViews, imageView, deletionQueue);
+    }
+    for (VkSemaphore semaphore : m_renderFinishedSemaphores) {
+        deletionQueue.retire(semaphore);
+    }
+    for (VkSemaphore semaphore : m_ownershipAcquiredSemaphores) {
+        deletionQueue.retire(semaphore);
+    }
+    // command buffer 는 pool 과 함께 해제
+    if (m_ownershipCommandPool != VK_NULL_HANDLE) {
+        deletionQueue.retire(m_ownershipCommandPool);
+    }
+    deletionQueue.retire(m_depthTarget.view);
+    deletionQueue.retire(m_depthTarget.allocation.image);
+    deletionQueue.retire(m_depthTarget.allocation.memory);
+
+    m_framebuffers.clear();
+    m_imageViews.clear();
+    m_images.clear();
+    m_renderFinishedSemaphores.clear();
+    m_ownershipAcquiredSemaphores.clear();
+    m_ownershipCommandBuffers.clear();
+    m_ownershipCommandPool = VK_NULL_HANDLE;
+    m_depthTarget = {};
+    m_imageIndex = 0;
+}
+
+void WindowSurface::createDepthTarget() {
+    // occlusion culling 의 Hi-Z 입력으로도 쓰므로 sampling 가능하게 생성
+    m_depthTarget.format = RenderPassSupports::findDepthFormat(m_physicalDevice);
+    m_depthTarget.allocation = MemorySupports::createImage(
+        m_physicalDevice,
+        m_device,
+        MemorySupports::createImageCreateInfo(m_extent, 1, m_depthTarget.format, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT),
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        m_budget
+    );
+    m_depthTarget.view = EngineComponentFactory::createImageView(m_device, m_depthTarget.format, m_depthTarget.allocation.image, VK_IMAGE_ASPECT_DEPTH_BIT);
+}
+
+void WindowSurface::createOwnershipTransfer() {
+    m_ownershipCommandPool = EngineComponentFactory::createCommandPool(m_device, m_presentFamily);
+
+    for (VkImage image : m_images) {
+        // present queue 에는 memory 접근이 없으므로 graphics queue 의 submit 을 semaphore 로 기다리기만 하면 됨
+        const VkImageMemoryBarrier barrier = QueueFactory::createOwnershipTransferBarrier(
+            image, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, m_graphicsFamily, m_presentFamily, 0
+        );
+        VkCommandBuffer commandBuffer = EngineComponentFactory::createCommandBuffer(m_device, m_ownershipCommandPool);
+        // 같은 image 의 이전 submit 이 끝나기 전에 다시 submit 될 수 있으므로 SIMULTANEOUS_USE
+        EngineComponentFactory::beginCommandBuffer(commandBuffer, VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT);
+        vkCmdPipelineBarrier(
+            commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier
+        );
+        EngineComponentFactory::endCommandBuffer(commandBuffer);
+
+        m_ownershipCommandBuffers.push_back(commandBuffer);
+        m_ownershipAcquiredSemaphores.push_back(EngineComponentFactory::createSemaphore(m_device));
+    }
+}
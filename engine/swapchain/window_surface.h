@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <GLFW/glfw3.h>
+
+#include "swapchain_supports.h"
+#include "../memory/memory_supports.h"
+#include "../queue/queue_factory.h"
+#include "../resource/deletion_queue.h"
+#include "../resource/resource_registry.h"
+
+// 창마다 하나씩 두는 depth attachment. 주 창의 것은 EARLY pass 의 결과로 Hi-Z 를 만듦
+struct DepthTarget {
+    ImageAllocation allocation;
+    VkImageView view;
+    VkFormat format;
+};
+
+// 창 하나와 그 swapchain, attachment, present 동기화 객체
+// device, render pass, pipeline 은 모든 창이 공유하고 여기에는 창 크기에 묶인 것만 둠
+// graphics 와 present family 가 다르면 image 의 소유권을 넘기는 acquire command buffer 도 여기에 둠
+class WindowSurface {
+public:
+    WindowSurface(
+        GLFWwindow* window,
+        VkSurfaceKHR surface,
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        ResourceRegistry& resources,
+        const QueueFamilyIndices& queueFamilyIndices,
+        uint32_t framesInFlight,
+        MemoryBudget* budget = nullptr
+    );
+
+    WindowSurface(const WindowSurface&) = delete;
+    WindowSurface& operator=(const WindowSurface&) = delete;
+
+    // swapchain image 마다 framebuffer 하나. render pass 는 format 이 같은 창끼리 공유
+    void createFramebuffers(ResourceRegistry& resources, VkRenderPass renderPass);
+
+    // frame 의 semaphore 로 다음 image 를 받음. 닫혔거나 swapchain 이 창과 맞지 않으면 false (render thread 에서만 호출)
+    // OUT_OF_DATE 면 이번 frame 은 건너뛰고, SUBOPTIMAL 이면 이번 image 는 쓰되 다음 frame 전에 재생성하도록 표시
+    bool acquire(uint64_t frame);
+
+    // present 가 OUT_OF_DATE 를 받았을 때 PresentBatch 가 호출
+    void markOutOfDate() {
+        m_needsRecreate = true;
+    }
+
+    [[nodiscard]]
+    bool needsRecreate() const {
+        return m_needsRecreate;
+    }
+
+    // 새 크기로 swapchain, framebuffer, depth target 을 다시 만듦. 이전 것을 쓰는 GPU 작업이 모두 끝난 뒤 호출
+    // 최소화되어 크기가 0 이면 아무것도 하지 않고 false (다음 frame 에 다시 시도)
+    bool recreate(ResourceRegistry& resources, DeletionQueue& deletionQueue);
+
+    // OWNERSHIP_TRANSFER 일 때 이번 image 를 present family 로 넘기는 release barrier 를 기록. 아니면 아무것도 안 함
+    // 이 image 에 쓰는 마지막 명령 뒤에 graphics queue 의 command buffer 에 기록
+    void recordOwnershipRelease(VkCommandBuffer commandBuffer) const;
+
+    // GPU 사용이 끝난 뒤 파괴되도록 retire. surface 와 GLFW 창은 device 파괴 후 Engine 이 정리
+    void destroy(ResourceRegistry& resources, DeletionQueue& deletionQueue);
+
+    [[nodiscard]]
+    GLFWwindow* getWindow() const {
+        return m_window;
+    }
+
+    [[nodiscard]]
+    VkSurfaceKHR getSurface() const {
+        return m_surface;
+    }
+
+    [[nodiscard]]
+    VkSwapchainKHR getSwapchain() const {
+        return m_swapchain;
+    }
+
+    [[nodiscard]]
+    VkExtent2D getExtent() const {
+        return m_extent;
+    }
+
+    [[nodiscard]]
+    VkFormat getFormat() const {
+        return m_format;
+    }
+
+    [[nodiscard]]
+    const DepthTarget& getDepthTarget() const {
+        return m_depthTarget;
+    }
+
+    // 마지막 acquire 로 받은 image
+    [[nodiscard]]
+    uint32_t getImageIndex() const {
+        return m_imageIndex;
+    }
+
+    [[nodiscard]]
+    VkImage getImage() const {
+        return m_images[m_imageIndex];
+    }
+
+    [[nodiscard]]
+    FramebufferHandle getFramebuffer() const {
+        return m_framebuffers[m_imageIndex];
+    }
+
+    [[nodiscard]]
+    VkSemaphore getImageAvailableSemaphore(uint64_t frame) const {
+        return m_imageAvailableSemaphores[frame % m_imageAvailableSemaphores.size()];
+    }
+
+    // present 가 image 를 쓰는 동안 유지해야 하므로 swapchain image 마다 하나
+    [[nodiscard]]
+    VkSemaphore getRenderFinishedSemaphore() const {
+        return m_renderFinishedSemaphores[m_imageIndex];
+    }
+
+    [[nodiscard]]
+    PresentSharing getPresentSharing() const {
+        return m_presentSharing;
+    }
+
+    // present queue 에서 실행할 acquire barrier. OWNERSHIP_TRANSFER 가 아니면 VK_NULL_HANDLE
+    [[nodiscard]]
+    VkCommandBuffer getOwnershipAcquireCommandBuffer() const {
+        return m_ownershipCommandBuffers.empty() ? VK_NULL_HANDLE : m_ownershipCommandBuffers[m_imageIndex];
+    }
+
+    // acquire barrier 가 끝나면 signal. OWNERSHIP_TRANSFER 가 아니면 VK_NULL_HANDLE
+    [[nodiscard]]
+    VkSemaphore getOwnershipAcquiredSemaphore() const {
+        return m_ownershipAcquiredSemaphores.empty() ? VK_NULL_HANDLE : m_ownershipAcquiredSemaphores[m_imageIndex];
+    }
+
+    // swapchain image 를 transfer source 로 쓸 수 있는지
+    [[nodiscard]]
+    bool supportsCapture() const {
+        return m_supportsCapture;
+    }
+
+    [[nodiscard]]
+    bool isClosed() const {
+        return m_isClosed.load(std::memory_order_acquire);
+    }
+
+    // 이후 frame 부터 그리지 않음. 어느 스레드에서나 호출 가능
+    void close() {
+        m_isClosed.store(true, std::memory_order_release);
+    }
+
+private:
+    // 창 크기에 묶인 것. 생성자와 recreate 가 같이 씀 (swapchain 자체는 destroy 와 recreate 가 따로 retire)
+    void createSwapchainResources(ResourceRegistry& resources, SwapchainSupportDetails swapchainSupportDetails);
+    void destroySwapchainResources(ResourceRegistry& resources, DeletionQueue& deletionQueue);
+    void createDepthTarget();
+    // image 마다 acquire barrier 를 한 번 기록해 두고 매 frame 재사용
+    void createOwnershipTransfer();
+
+    GLFWwindow*                     m_window;
+    VkSurfaceKHR                    m_surface;
+    VkPhysicalDevice                m_physicalDevice;
+    VkDevice                        m_device;
+    QueueFamilyIndices              m_queueFamilyIndices;
+    MemoryBudget*                   m_budget;
+    uint32_t                        m_graphicsFamily;
+    uint32_t                        m_presentFamily;
+    PresentSharing                  m_presentSharing;
+    VkSwapchainKHR                  m_swapchain = VK_NULL_HANDLE;
+    VkExtent2D                      m_extent {};
+    VkFormat                        m_format = VK_FORMAT_UNDEFINED;
+    std::vector<VkImage>            m_images;
+    // swapchain image 순서와 같음
+    std::vector<ImageViewHandle>    m_imageViews;
+    std::vector<FramebufferHandle>  m_framebuffers;
+    // 재생성할 때 framebuffer 를 다시 만드는 render pass
+    VkRenderPass                    m_renderPass = VK_NULL_HANDLE;
+    DepthTarget                     m_depthTarget {};
+    bool                            m_supportsCapture = false;
+    // frame in flight 마다 하나
+    std::vector<VkSemaphore>        m_imageAvailableSemaphores;
+    std::vector<VkSemaphore>        m_renderFinishedSemaphores;
+    // 아래는 OWNERSHIP_TRANSFER 일 때만. pool 은 present family 용이고 나머지는 swapchain image 마다 하나
+    VkCommandPool                   m_ownershipCommandPool = VK_NULL_HANDLE;
+    std::vector<VkCommandBuffer>    m_ownershipCommandBuffers;
+    std::vector<VkSemaphore>        m_ownershipAcquiredSemaphores;
+    uint32_t                        m_imageIndex = 0;
+    bool                            m_needsRecreate = false;
+    std::atomic<bool>               m_isClosed = false;
+};
@@ -0,0 +1,139 @@
+#include "image_decoder.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <stdexcept>
+#include <string>
+
+DecodedImage ImageDecoder::decode(const BinaryFile& binaryFile) {
+    const std::string& fileName = binaryFile.fileName;
+
+    if (fileName.ends_with(".tga")) {
+        return decodeTga(binaryFile);
+    }
+    if (fileName.ends_with(".ppm")) {
+        return decodePpm(binaryFile);
+    }
+    throw std::runtime_error("Image format not supported: " + fileName);
+}
+
+DecodedImage ImageDecoder::decodeTga(const BinaryFile& binaryFile) {
+    constexpr size_t HEADER_SIZE = 18;
+    constexpr uint8_t UNCOMPRESSED_TRUE_COLOR = 2;
+
+    const auto* bytes = reinterpret_cast<const uint8_t*>(binaryFile.data());
+
+    if (binaryFile.size() < HEADER_SIZE || bytes[2] != UNCOMPRESSED_TRUE_COLOR) {
+        throw std::runtime_error("Unsupported TGA: " + binaryFile.fileName);
+    }
+    const uint8_t idLength = bytes[0];
+    const uint32_t width = bytes[12] | bytes[13] << 8;
+    const uint32_t height = bytes[14] | bytes[15] << 8;
+    const uint32_t bytesPerPixel = bytes[16] / 8;
+    // descriptor bit 5: 원점이 좌상단
+    const bool isTopLeft = bytes[17] & 0x20;
+
+    const size_t dataOffset = HEADER_SIZE + idLength;
+
+    if ((bytesPerPixel != 3 && bytesPerPixel != 4) || binaryFile.size() < dataOffset + size_t { width } * height * bytesPerPixel) {
+        throw std::runtime_error("Corrupted TGA: " + binaryFile.fileName);
+    }
+    DecodedImage image { width, height, std::vector<uint8_t>(size_t { width } * height * CHANNEL_COUNT) };
+
+    for (uint32_t y = 0; y < height; y++) {
+        const uint32_t sourceRow = isTopLeft ? y : height - 1 - y;
+        const uint8_t* source = bytes + dataOffset + size_t { sourceRow } * width * bytesPerPixel;
+        uint8_t* destination = image.pixels.data() + size_t { y } * width * CHANNEL_COUNT;
+
+        for (uint32_t x = 0; x < width; x++, source += bytesPerPixel, destination += CHANNEL_COUNT) {
+            // BGR(A) -> RGBA
+            destination[0] = source[2];
+            destination[1] = source[1];
+            destination[2] = source[0];
+            destination[3] = bytesPerPixel == 4 ? source[3] : 0xFF;
+        }
+    }
+    return image;
+}
+
+DecodedImage ImageDecoder::decodePpm(const BinaryFile& binaryFile) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(binaryFile.data());
+    const size_t size = binaryFile.size();
+    size_t offset = 0;
+
+    auto readToken = [&]() {
+        std::string token {};
+
+        while (offset < size) {
+            if (bytes[offset] == '#') {
+                while (offset < size && bytes[offset] != '\n') offset++;
+            } else if (std::isspace(bytes[offset])) {
+                offset++;
+            } else {
+                break;
+            }
+        }
+        while (offset < size && !std::isspace(bytes[offset])) {
+            token.push_back(static_cast<char>(bytes[offset++]));
+        }
+        return token;
+    };
+
+    if (readToken() != "P6") {
+        throw std::runtime_error("Unsupported PPM: " + binaryFile.fileName);
+    }
+    const uint32_t width = std::stoul(readToken());
+    const uint32_t height = std::stoul(readToken());
+    const uint32_t maxValue = std::stoul(readToken());
+    // header 뒤의 공백 한 글자
+    offset++;
+
+    if (maxValue != 255 || size < offset + size_t { width } * height * 3) {
+        throw std::runtime_error("Corrupted PPM: " + binaryFile.fileName);
+    }
+    DecodedImage image { width, height, std::vector<uint8_t>(size_t { width } * height * CHANNEL_COUNT) };
+
+    const uint8_t* source = bytes + offset;
+    uint8_t* destination = image.pixels.data();
+
+    for (size_t pixel = 0; pixel < size_t { width } * height; pixel++, source += 3, destination += CHANNEL_COUNT) {
+        destination[0] = source[0];
+        destination[1] = source[1];
+        destination[2] = source[2];
+        destination[3] = 0xFF;
+    }
+    return image;
+}
+
+DecodedImage ImageDecoder::downsample(const DecodedImage& image) {
+    const uint32_t width = std::max(image.width / 2, 1u);
+    const uint32_t height = std::max(image.height / 2, 1u);
+
+    DecodedImage result { width, height, std::vector<uint8_t>(size_t { width } * height * CHANNEL_COUNT) };
+
+    for (uint32_t y = 0; y < height; y++) {
+        const uint32_t y0 = std::min(y * 2, image.height - 1);
+        const uint32_t y1 = std::min(y * 2 + 1, image.height - 1);
+
+        for (uint32_t x = 0; x < width; x++) {
+            const uint32_t x0 = std::min(x * 2, image.width - 1);
+            const uint32_t x1 = std::min(x * 2 + 1, image.width - 1);
+
+            const uint8_t* p00 = &image.pixels[(size_t { y0 } * image.width + x0) * CHANNEL_COUNT];
+            const uint8_t* p01 = &image.pixels[(size_t { y0 } * image.width + x1) * CHANNEL_COUNT];
+            const uint8_t* p10 = &image.pixels[(size_t { y1 } * image.width + x0) * CHANNEL_COUNT];
+            const uint8_t* p11 = &image.pixels[(size_t { y1 } * image.width + x1) * CHANNEL_COUNT];
+            uint8_t* destination = &result.pixels[(size_t { y } * width + x) * CHANNEL_COUNT];
+
+            for (uint32_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+                destination[channel] = static_cast<uint8_t>((p00[channel] + p01[channel] + p10[channel] + p11[channel] + 2) / 4);
+            }
+        }
+    }
+    return result;
+}
+
+uint32_t ImageDecoder::getMipLevelCount(uint32_t width, uint32_t height) {
+    return std::bit_width(std::max(width, height));
+}
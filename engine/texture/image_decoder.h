@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../util/binary_file_utils.h"
+
+// RGBA8 로 디코딩된 하나의 mip level
+struct DecodedImage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;
+
+    size_t size() const {
+        return pixels.size();
+    }
+
+    bool isEmpty() const {
+        return pixels.empty();
+    }
+};
+
+namespace ImageDecoder {
+
+    constexpr uint32_t CHANNEL_COUNT = 4;
+
+    // 비압축 TGA (24/32bit), 바이너리 PPM (P6) 지원
+    DecodedImage decode(const BinaryFile& binaryFile);
+
+    DecodedImage decodeTga(const BinaryFile& binaryFile);
+    DecodedImage decodePpm(const BinaryFile& binaryFile);
+
+    // 2x2 box filter 로 한 단계 축소
+    DecodedImage downsample(const DecodedImage& image);
+
+    uint32_t getMipLevelCount(uint32_t width, uint32_t height);
+}
@@ -0,0 +1,500 @@
+#include "texture_streamer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include "texture_supports.h"
+#include "../memory/host_allocator.h"
+#include "../engine_component_factory.h"
+
+constexpr VkFormat TEXTURE_FORMAT = VK_FORMAT_R8G8B8A8_SRGB;
+
+TextureStreamer::TextureStreamer(
+    VkPhysicalDevice physicalDevice,
+    VkDevice device,
+    VkQueue queue,
+    uint32_t queueFamilyIndex,
+    DeletionQueue& deletionQueue,
+    JobSystem& jobSystem,
+    const AssetPack* assetPack,
+    TextureStreamingConfig config
+) : m_deletionQueue(deletionQueue), m_jobSystem(jobSystem) {
+    m_physicalDevice = physicalDevice;
+    m_device = device;
+    m_queue = queue;
+    m_assetPack = assetPack;
+    m_config = config;
+    m_commandPool = EngineComponentFactory::createCommandPool(device, queueFamilyIndex);
+    // blit 을 지원하지 않으면 워커에서 CPU 로 mip 체인 생성
+    m_supportsLinearBlit = TextureSupports::supportsLinearBlit(physicalDevice, TEXTURE_FORMAT);
+}
+
+TextureStreamer::~TextureStreamer() {
+    // 아직 시작하지 않은 decode job 은 바로 끝나도록 표시
+    m_isStopping = true;
+    m_jobSystem.wait(m_decodeCounter);
+
+    for (const PendingUpload& pendingUpload : m_pendingUploads) {
+        vkWaitForFences(m_device, 1, &pendingUpload.fence, VK_TRUE, UINT64_MAX);
+    }
+    completeUploads();
+
+    for (const StreamedTexture& texture : m_textures) {
+        m_deletionQueue.retire(texture.imageView);
+        m_deletionQueue.retire(texture.allocation.image);
+        m_deletionQueue.retire(texture.allocation.memory);
+    }
+    vkDestroyCommandPool(m_device, m_commandPool, HostAllocators::getCallbacks(VK_OBJECT_TYPE_COMMAND_POOL));
+}
+
+TextureHandle TextureStreamer::request(const std::string& path) {
+    StreamedTexture texture {};
+    texture.path = path;
+    texture.imageView = VK_NULL_HANDLE;
+
+    TextureHandle handle = m_textures.create(std::move(texture));
+    schedule(handle, *m_textures.get(handle), false, 0);
+    return handle;
+}
+
+void TextureStreamer::release(TextureHandle handle) {
+    const StreamedTexture texture = m_textures.remove(handle);
+
+    m_deletionQueue.retire(texture.imageView);
+    m_deletionQueue.retire(texture.allocation.image);
+    m_deletionQueue.retire(texture.allocation.memory);
+    m_residentBytes -= texture.allocation.size;
+}
+
+void TextureStreamer::touch(TextureHandle handle, uint64_t frame, bool fullResolution) {
+    if (StreamedTexture* texture = m_textures.get(handle)) {
+        texture->lastUsedFrame = frame;
+        texture->wantsFullResolution = fullResolution;
+    }
+}
+
+void TextureStreamer::update(uint64_t frame) {
+    completeUploads();
+    startUploads();
+    manageResidency(frame);
+}
+
+VkImageView TextureStreamer::getImageView(TextureHandle handle) const {
+    const StreamedTexture* texture = m_textures.get(handle);
+    return texture ? texture->imageView : VK_NULL_HANDLE;
+}
+
+void TextureStreamer::runDecodeJob(const DecodeJob& job) {
+    if (m_isStopping) {
+        return;
+    }
+    DecodeResult result = decode(job);
+
+    std::lock_guard lock { m_resultMutex };
+    m_results.push_back(std::move(result));
+}
+
+TextureStreamer::DecodeResult TextureStreamer::decode(const DecodeJob& job) const {
+    DecodeResult result {};
+    result.handle = job.handle;
+    result.fullResolution = job.fullResolution;
+    result.reservedBytes = job.reservedBytes;
+
+    try {
+        const BinaryFile binaryFile = m_assetPack && m_assetPack->contains(job.path)
+            ? m_assetPack->readBinaryFile(job.path)
+            : BinaryFileUtils::readBinaryFile(job.path.c_str());
+        DecodedImage image = ImageDecoder::decode(binaryFile);
+
+        const uint32_t mipLevels = ImageDecoder::getMipLevelCount(image.width, image.height);
+        uint32_t tailMip = 0;
+
+        while (tailMip + 1 < mipLevels && std::max(image.width >> tailMip, image.height >> tailMip) > m_config.tailSize) {
+            tailMip++;
+        }
+        result.extent = { image.width, image.height };
+
+        if (job.fullResolution && m_supportsLinearBlit) {
+            // mip 0 만 올리고 나머지는 GPU blit 으로 생성
+            result.firstMip = 0;
+            result.levels.push_back(std::move(image));
+            return result;
+        }
+        result.firstMip = job.fullResolution ? 0 : tailMip;
+
+        // 이미 상주 중인 tail 은 다시 만들지 않고 그대로 붙임
+        const uint32_t lastMip = job.fullResolution && !job.tailLevels.empty()
+            ? mipLevels - static_cast<uint32_t>(job.tailLevels.size())
+            : mipLevels;
+
+        for (uint32_t mipLevel = 0; mipLevel < lastMip; mipLevel++) {
+            DecodedImage next = mipLevel + 1 < lastMip ? ImageDecoder::downsample(image) : DecodedImage {};
+
+            if (mipLevel >= result.firstMip) {
+                result.levels.push_back(std::move(image));
+            }
+            image = std::move(next);
+        }
+
+        if (lastMip < mipLevels) {
+            result.levels.insert(result.levels.end(), job.tailLevels.begin(), job.tailLevels.end());
+        }
+        if (!job.fullResolution) {
+            result.tailLevels = result.levels;
+        }
+    } catch (const std::exception& ex) {
+        result.error = ex.what();
+    }
+    return result;
+}
+
+void TextureStreamer::schedule(TextureHandle handle, StreamedTexture& texture, bool fullResolution, VkDeviceSize reservedBytes) {
+    DecodeJob decodeJob {};
+    decodeJob.handle = handle;
+    decodeJob.path = texture.path;
+    decodeJob.fullResolution = fullResolution;
+    decodeJob.reservedBytes = reservedBytes;
+
+    // GPU blit 이 가능하면 mip 0 만 올리므로 tail 이 필요 없음
+    if (fullResolution && !m_supportsLinearBlit) {
+        decodeJob.tailLevels = texture.tailLevels;
+    }
+    m_jobSystem.run(
+        [this, job = std::move(decodeJob)]() {
+            runDecodeJob(job);
+        },
+        &m_decodeCounter
+    );
+
+    texture.isStreaming = true;
+    m_scheduledBytes += reservedBytes;
+    m_scheduledJobCount++;
+}
+
+void TextureStreamer::completeUploads() {
+    std::erase_if(m_pendingUploads, [&](const PendingUpload& pendingUpload) {
+        if (vkGetFenceStatus(m_device, pendingUpload.fence) != VK_SUCCESS) {
+            return false;
+        }
+        m_replacedBytes -= pendingUpload.replacedBytes;
+
+        if (StreamedTexture* texture = m_textures.get(pendingUpload.handle)) {
+            // 이전 image 는 아직 in-flight frame 이 사용 중일 수 있으므로 retire
+            m_deletionQueue.retire(texture->imageView);
+            m_deletionQueue.retire(texture->allocation.image);
+            m_deletionQueue.retire(texture->allocation.memory);
+            m_residentBytes -= texture->allocation.size;
+
+            texture->allocation = pendingUpload.allocation;
+            texture->imageView = pendingUpload.imageView;
+            texture->residentMip = pendingUpload.residentMip;
+            texture->isStreaming = false;
+        } else {
+            // 업로드 중 release 된 텍스처
+            m_deletionQueue.retire(pendingUpload.imageView);
+            m_deletionQueue.retire(pendingUpload.allocation.image);
+            m_deletionQueue.retire(pendingUpload.allocation.memory);
+            m_residentBytes -= pendingUpload.allocation.size;
+        }
+
+        MemorySupports::destroyBuffer(m_device, pendingUpload.staging, m_deletionQueue.getMemoryBudget());
+        vkFreeCommandBuffers(m_device, m_commandPool, 1, &pendingUpload.commandBuffer);
+        vkDestroyFence(m_device, pendingUpload.fence, HostAllocators::getCallbacks(VK_OBJECT_TYPE_FENCE));
+        return true;
+    });
+}
+
+void TextureStreamer::startUploads() {
+    std::vector<DecodeResult> results {};
+    {
+        std::lock_guard lock { m_resultMutex };
+        const size_t count = std::min<size_t>(m_results.size(), m_config.maxUploadsPerUpdate);
+
+        results.assign(std::make_move_iterator(m_results.begin()), std::make_move_iterator(m_results.begin() + count));
+        m_results.erase(m_results.begin(), m_results.begin() + count);
+    }
+
+    for (DecodeResult& result : results) {
+        StreamedTexture* texture = m_textures.get(result.handle);
+        m_scheduledBytes -= result.reservedBytes;
+        m_scheduledJobCount--;
+
+        if (!texture) {
+            continue;
+        }
+        if (!result.error.empty()) {
+            std::cerr << "failed to stream texture: " << result.error << std::endl;
+            texture->isStreaming = false;
+            continue;
+        }
+        if (!result.fullResolution) {
+            texture->extent = result.extent;
+            texture->mipLevels = ImageDecoder::getMipLevelCount(result.extent.width, result.extent.height);
+            texture->residentMip = texture->mipLevels;
+            texture->tailLevels = std::move(result.tailLevels);
+        }
+        upload(result.handle, *texture, result.firstMip, result.levels);
+    }
+}
+
+void TextureStreamer::upload(TextureHandle handle, StreamedTexture& texture, uint32_t firstMip, const std::vector<DecodedImage>& levels) {
+    const uint32_t levelCount = texture.mipLevels - firstMip;
+    const VkExtent2D extent = TextureSupports::getMipExtent(texture.extent, firstMip);
+
+    PendingUpload pendingUpload {};
+    pendingUpload.handle = handle;
+    pendingUpload.residentMip = firstMip;
+    pendingUpload.replacedBytes = texture.allocation.size;
+
+    try {
+        submitUpload(pendingUpload, extent, levelCount, levels);
+    } catch (...) {
+        discardUpload(pendingUpload);
+        throw;
+    }
+    texture.isStreaming = true;
+    m_residentBytes += pendingUpload.allocation.size;
+    m_replacedBytes += pendingUpload.replacedBytes;
+    m_pendingUploads.push_back(pendingUpload);
+}
+
+void TextureStreamer::submitUpload(PendingUpload& pendingUpload, VkExtent2D extent, uint32_t levelCount, const std::vector<DecodedImage>& levels) {
+    // Create Image
+    VkImageCreateInfo imageCreateInfo = MemorySupports::createImageCreateInfo(
+        extent,
+        levelCount,
+        TEXTURE_FORMAT,
+        VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+    );
+    pendingUpload.allocation = MemorySupports::createImage(
+        m_physicalDevice, m_device, imageCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_deletionQueue.getMemoryBudget(), MemoryCategory::IMAGE
+    );
+
+    VkImageViewCreateInfo imageViewCreateInfo = TextureSupports::createImageViewCreateInfo(pendingUpload.allocation.image, TEXTURE_FORMAT, levelCount);
+
+    // 실패하면 출력 handle 이 정의되지 않으므로 성공한 뒤에 넘김
+    VkImageView imageView;
+
+    if (vkCreateImageView(m_device, &imageViewCreateInfo, HostAllocators::getCallbacks(VK_OBJECT_TYPE_IMAGE_VIEW), &imageView) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create texture image view!");
+    }
+    pendingUpload.imageView = imageView;
+
+    // Fill Staging Buffer
+    VkDeviceSize stagingSize = 0;
+
+    for (const DecodedImage& level : levels) {
+        stagingSize += level.size();
+    }
+    pendingUpload.staging = MemorySupports::createBuffer(
+        m_physicalDevice,
+        m_device,
+        stagingSize,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        m_deletionQueue.getMemoryBudget(),
+        MemoryCategory::TRANSIENT
+    );
+
+    void* mapped;
+
+    if (vkMapMemory(m_device, pendingUpload.staging.memory, 0, stagingSize, 0, &mapped) != VK_SUCCESS) {
+        throw std::runtime_error("failed to map texture staging buffer!");
+    }
+
+    std::vector<VkBufferImageCopy> copyRegions {};
+    VkDeviceSize offset = 0;
+
+    for (uint32_t level = 0; level < levels.size(); level++) {
+        std::memcpy(static_cast<char*>(mapped) + offset, levels[level].pixels.data(), levels[level].size());
+        copyRegions.push_back(TextureSupports::createBufferImageCopy(offset, level, TextureSupports::getMipExtent(extent, level)));
+        offset += levels[level].size();
+    }
+    vkUnmapMemory(m_device, pendingUpload.staging.memory);
+
+    // Record Commands
+    pendingUpload.commandBuffer = EngineComponentFactory::createCommandBuffer(m_device, m_commandPool);
+
+    VkCommandBufferBeginInfo beginInfo {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    VkCommandBuffer commandBuffer = pendingUpload.commandBuffer;
+    VkImage image = pendingUpload.allocation.image;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+    TextureSupports::recordImageBarrier(
+        commandBuffer,
+        TextureSupports::createImageMemoryBarrier(
+            image, 0, levelCount,
+            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            0, VK_ACCESS_TRANSFER_WRITE_BIT
+        ),
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT
+    );
+    vkCmdCopyBufferToImage(
+        commandBuffer,
+        pendingUpload.staging.buffer,
+        image,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        static_cast<uint32_t>(copyRegions.size()),
+        copyRegions.data()
+    );
+
+    // CPU 에서 올라오지 않은 mip 은 바로 위 mip 에서 blit
+    for (uint32_t level = 1; level < levelCount; level++) {
+        const uint32_t sourceLevel = level - 1;
+
+        if (level < levels.size()) {
+            TextureSupports::recordImageBarrier(
+                commandBuffer,
+                TextureSupports::createImageMemoryBarrier(
+                    image, sourceLevel, 1,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                    VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT
+                ),
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+            );
+            continue;
+        }
+        TextureSupports::recordImageBarrier(
+            commandBuffer,
+            TextureSupports::createImageMemoryBarrier(
+                image, sourceLevel, 1,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT
+            ),
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT
+        );
+
+        VkImageBlit imageBlit = TextureSupports::createImageBlit(
+            sourceLevel, TextureSupports::getMipExtent(extent, sourceLevel),
+            level, TextureSupports::getMipExtent(extent, level)
+        );
+        vkCmdBlitImage(
+            commandBuffer,
+            image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1, &imageBlit,
+            VK_FILTER_LINEAR
+        );
+
+        TextureSupports::recordImageBarrier(
+            commandBuffer,
+            TextureSupports::createImageMemoryBarrier(
+                image, sourceLevel, 1,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT
+            ),
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+        );
+    }
+
+    TextureSupports::recordImageBarrier(
+        commandBuffer,
+        TextureSupports::createImageMemoryBarrier(
+            image, levelCount - 1, 1,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT
+        ),
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+    );
+    vkEndCommandBuffer(commandBuffer);
+
+    // Submit
+    pendingUpload.fence = EngineComponentFactory::createFence(m_device, false);
+
+    VkSubmitInfo submitInfo {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+
+    if (vkQueueSubmit(m_queue, 1, &submitInfo, pendingUpload.fence) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit texture upload!");
+    }
+}
+
+void TextureStreamer::discardUpload(const PendingUpload& pendingUpload) {
+    // submit 전에 실패했으므로 GPU 가 쓰지 않은 객체. 만들어진 것만 정리 (VK_NULL_HANDLE 은 retire 가 무시)
+    m_deletionQueue.retire(pendingUpload.imageView);
+    m_deletionQueue.retire(pendingUpload.allocation.image);
+    m_deletionQueue.retire(pendingUpload.allocation.memory);
+    m_deletionQueue.retire(pendingUpload.staging.buffer);
+    m_deletionQueue.retire(pendingUpload.staging.memory);
+    m_deletionQueue.retire(pendingUpload.fence);
+
+    if (pendingUpload.commandBuffer != VK_NULL_HANDLE) {
+        vkFreeCommandBuffers(m_device, m_commandPool, 1, &pendingUpload.commandBuffer);
+    }
+}
+
+void TextureStreamer::manageResidency(uint64_t frame) {
+    // 이번 frame 에 쓰이지 않은 텍스처 중 가장 오래된 것의 높은 mip 을 내림
+    auto evictLeastRecentlyUsed = [&](uint64_t usedBefore) {
+        StreamedTexture* candidate = nullptr;
+        TextureHandle candidateHandle {};
+
+        for (size_t index = 0; index < m_textures.size(); index++) {
+            StreamedTexture& texture = m_textures.values()[index];
+            const uint32_t tailMip = texture.mipLevels - static_cast<uint32_t>(texture.tailLevels.size());
+
+            if (texture.isStreaming || texture.residentMip >= tailMip || texture.lastUsedFrame >= usedBefore) {
+                continue;
+            }
+            if (!candidate || texture.lastUsedFrame < candidate->lastUsedFrame) {
+                candidate = &texture;
+                candidateHandle = m_textures.handleAt(index);
+            }
+        }
+        if (!candidate) {
+            return false;
+        }
+        evict(candidateHandle, *candidate);
+        return true;
+    };
+
+    while (getProjectedBytes() > m_config.memoryBudget && evictLeastRecentlyUsed(frame)) {}
+
+    for (size_t index = 0; index < m_textures.size(); index++) {
+        StreamedTexture& texture = m_textures.values()[index];
+
+        if (
+            texture.isStreaming
+            || !texture.wantsFullResolution
+            || texture.residentMip == 0
+            || texture.residentMip == texture.mipLevels
+            || texture.lastUsedFrame + 1 < frame
+        ) {
+            continue;
+        }
+        const VkDeviceSize requiredBytes = estimateSize(texture, 0);
+
+        while (getProjectedBytes() + requiredBytes > m_config.memoryBudget && evictLeastRecentlyUsed(texture.lastUsedFrame)) {}
+
+        if (getProjectedBytes() + requiredBytes <= m_config.memoryBudget) {
+            schedule(m_textures.handleAt(index), texture, true, requiredBytes);
+        }
+    }
+}
+
+void TextureStreamer::evict(TextureHandle handle, StreamedTexture& texture) {
+    const uint32_t tailMip = texture.mipLevels - static_cast<uint32_t>(texture.tailLevels.size());
+    upload(handle, texture, tailMip, texture.tailLevels);
+}
+
+VkDeviceSize TextureStreamer::estimateSize(const StreamedTexture& texture, uint32_t residentMip) const {
+    VkDeviceSize size = 0;
+
+    for (uint32_t mipLevel = residentMip; mipLevel < texture.mipLevels; mipLevel++) {
+        const VkExtent2D extent = TextureSupports::getMipExtent(texture.extent, mipLevel);
+        size += VkDeviceSize { extent.width } * extent.height * ImageDecoder::CHANNEL_COUNT;
+    }
+    return size;
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+#include "image_decoder.h"
+#include "../asset/asset_pack.h"
+#include "../memory/memory_supports.h"
+#include "../resource/deletion_queue.h"
+#include "../resource/resource_pool.h"
+#include "../thread/job_system.h"
+
+struct TextureStreamingConfig {
+    // 스트리밍 텍스처가 사용할 수 있는 device memory
+    VkDeviceSize memoryBudget = 256ull << 20;
+    // 이 크기 이하의 mip 은 항상 상주
+    uint32_t tailSize = 64;
+    uint32_t maxUploadsPerUpdate = 4;
+};
+
+struct StreamedTexture {
+    std::string path;
+    VkExtent2D extent;
+    uint32_t mipLevels;
+    // 상주 중인 가장 높은 해상도의 mip (mipLevels 이면 아직 로드 전)
+    uint32_t residentMip;
+    // 항상 상주하는 낮은 mip 들 (eviction 시 재업로드용)
+    std::vector<DecodedImage> tailLevels;
+    ImageAllocation allocation;
+    VkImageView imageView;
+    uint64_t lastUsedFrame;
+    bool wantsFullResolution;
+    bool isStreaming;
+};
+
+using TexturePool = ResourcePool<StreamedTexture>;
+using TextureHandle = TexturePool::Handle;
+
+// job system 에서 이미지를 디코딩하고, 낮은 mip 부터 업로드한 뒤
+// 필요할 때 높은 mip 을 스트리밍. memory budget 초과 시 LRU 로 높은 mip 을 내림
+class TextureStreamer {
+public:
+    TextureStreamer(
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        VkQueue queue,
+        uint32_t queueFamilyIndex,
+        DeletionQueue& deletionQueue,
+        JobSystem& jobSystem,
+        // pack 에 없는 경로는 파일에서 직접 읽음 (nullptr 이면 항상 파일)
+        const AssetPack* assetPack,
+        TextureStreamingConfig config = {}
+    );
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    ~TextureStreamer();
+
+    // tail mip 디코딩을 예약하고 즉시 handle 반환
+    TextureHandle request(const std::string& path);
+
+    void release(TextureHandle handle);
+
+    // 이번 frame 에 사용됨을 알림. fullResolution 이면 높은 mip 스트리밍 대상
+    void touch(TextureHandle handle, uint64_t frame, bool fullResolution);
+
+    // 렌더 스레드에서 frame 마다 호출 (queue 를 사용하므로 submit 과 같은 스레드)
+    void update(uint64_t frame);
+
+    // 아직 상주 mip 이 없으면 VK_NULL_HANDLE
+    [[nodiscard]]
+    VkImageView getImageView(TextureHandle handle) const;
+
+    [[nodiscard]]
+    const StreamedTexture* getTexture(TextureHandle handle) const {
+        return m_textures.get(handle);
+    }
+
+    [[nodiscard]]
+    VkDeviceSize getResidentBytes() const {
+        return m_residentBytes;
+    }
+
+    [[nodiscard]]
+    VkDeviceSize getMemoryBudget() const {
+        return m_config.memoryBudget;
+    }
+
+    void setMemoryBudget(VkDeviceSize memoryBudget) {
+        m_config.memoryBudget = memoryBudget;
+    }
+
+    // 디코딩이나 업로드가 진행 중이면 update 를 계속 호출해야 함
+    [[nodiscard]]
+    bool hasPendingWork() const {
+        return m_scheduledJobCount > 0 || !m_pendingUploads.empty();
+    }
+
+private:
+    struct DecodeJob {
+        TextureHandle handle;
+        std::string path;
+        bool fullResolution;
+        // 업로드 전까지 budget 에 미리 잡아두는 크기
+        VkDeviceSize reservedBytes;
+        // full 요청 시 다시 downsample 하지 않고 재사용할 상주 tail mip
+        std::vector<DecodedImage> tailLevels;
+    };
+
+    struct DecodeResult {
+        TextureHandle handle;
+        bool fullResolution;
+        VkDeviceSize reservedBytes;
+        VkExtent2D extent;
+        // residentMip 부터 연속된 CPU mip (GPU blit 가능 시 full 은 mip 0 하나)
+        uint32_t firstMip;
+        std::vector<DecodedImage> levels;
+        std::vector<DecodedImage> tailLevels;
+        std::string error;
+    };
+
+    struct PendingUpload {
+        TextureHandle handle;
+        uint32_t residentMip;
+        // 완료 시 retire 될 이전 allocation 크기
+        VkDeviceSize replacedBytes;
+        ImageAllocation allocation;
+        VkImageView imageView;
+        BufferAllocation staging;
+        VkCommandBuffer commandBuffer;
+        VkFence fence;
+    };
+
+    void runDecodeJob(const DecodeJob& job);
+    DecodeResult decode(const DecodeJob& job) const;
+
+    void schedule(TextureHandle handle, StreamedTexture& texture, bool fullResolution, VkDeviceSize reservedBytes);
+    void completeUploads();
+    void startUploads();
+    void upload(TextureHandle handle, StreamedTexture& texture, uint32_t firstMip, const std::vector<DecodedImage>& levels);
+    // image 생성부터 submit 까지. 실패하면 pendingUpload 에 만들어진 것까지만 채워진 채로 throw
+    void submitUpload(PendingUpload& pendingUpload, VkExtent2D extent, uint32_t levelCount, const std::vector<DecodedImage>& levels);
+    void discardUpload(const PendingUpload& pendingUpload);
+    void manageResidency(uint64_t frame);
+    void evict(TextureHandle handle, StreamedTexture& texture);
+
+    VkDeviceSize estimateSize(const StreamedTexture& texture, uint32_t residentMip) const;
+
+    // 진행 중인 업로드와 예약된 디코딩이 끝난 뒤의 예상 사용량
+    VkDeviceSize getProjectedBytes() const {
+        return m_residentBytes + m_scheduledBytes - m_replacedBytes;
+    }
+
+    VkPhysicalDevice            m_physicalDevice;
+    VkDevice                    m_device;
+    VkQueue                     m_queue;
+    DeletionQueue&              m_deletionQueue;
+    JobSystem&                  m_jobSystem;
+    const AssetPack*            m_assetPack;
+    TextureStreamingConfig      m_config;
+    VkCommandPool               m_commandPool;
+    bool                        m_supportsLinearBlit;
+
+    TexturePool                 m_textures;
+    std::vector<PendingUpload>  m_pendingUploads;
+    VkDeviceSize                m_residentBytes = 0;
+    VkDeviceSize                m_scheduledBytes = 0;
+    VkDeviceSize                m_replacedBytes = 0;
+    // 예약했지만 아직 업로드를 시작하지 않은 decode job 수
+    uint32_t                    m_scheduledJobCount = 0;
+
+    // 진행 중인 decode job (소멸 시 모두 끝날 때까지 대기)
+    JobCounter                  m_decodeCounter;
+    std::mutex                  m_resultMutex;
+    std::vector<DecodeResult>   m_results;
+    std::atomic<bool>           m_isStopping = false;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+namespace TextureSupports {
+
+    VkImageMemoryBarrier createImageMemoryBarrier(
+        VkImage image,
+        uint32_t baseMipLevel,
+        uint32_t levelCount,
+        VkImageLayout oldLayout,
+        VkImageLayout newLayout,
+        VkAccessFlags srcAccessMask,
+        VkAccessFlags dstAccessMask
+    );
+
+    VkBufferImageCopy createBufferImageCopy(VkDeviceSize bufferOffset, uint32_t mipLevel, VkExtent2D extent);
+    VkImageBlit createImageBlit(uint32_t srcMipLevel, VkExtent2D srcExtent, uint32_t dstMipLevel, VkExtent2D dstExtent);
+    VkImageViewCreateInfo createImageViewCreateInfo(VkImage image, VkFormat format, uint32_t mipLevels);
+    VkSamplerCreateInfo createSamplerCreateInfo(float maxLod);
+
+    VkExtent2D getMipExtent(VkExtent2D extent, uint32_t mipLevel);
+    bool supportsLinearBlit(VkPhysicalDevice physicalDevice, VkFormat format);
+
+    void recordImageBarrier(
+        VkCommandBuffer commandBuffer,
+        const VkImageMemoryBarrier& barrier,
+        VkPipelineStageFlags srcStageMask,
+        VkPipelineStageFlags dstStageMask
+    );
+}
@@ -0,0 +1,286 @@
+#include "job_system.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    // 현재 스레드가 속한 job system 과 deque index
+    struct ThreadContext {
+        const JobSystem* owner = nullptr;
+        uint32_t queueIndex = UINT32_MAX;
+    };
+
+    thread_local ThreadContext threadContext {};
+}
+
+JobSystem::JobSystem(uint32_t workerCount) {
+    if (workerCount == 0) {
+        workerCount = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+    }
+    m_mainThreadId = std::this_thread::get_id();
+    threadContext = { this, 0 };
+
+    for (uint32_t index = 0; index <= workerCount; index++) {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+    m_workers.reserve(workerCount);
+
+    for (uint32_t index = 1; index <= workerCount; index++) {
+        m_workers.emplace_back(&JobSystem::runWorker, this, index);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_isStopping.store(true);
+    }
+    m_sleepCondition.notify_all();
+
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+    if (threadContext.owner == this) {
+        threadContext = {};
+    }
+}
+
+void JobSystem::run(Job job, JobCounter* signal, JobCounter* dependency) {
+    if (signal) {
+        signal->m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (dependency && !dependency->isDone()) {
+        std::lock_guard lock(dependency->m_mutex);
+
+        // 잠금 후 다시 확인: 그 사이 0 이 됐다면 대기 목록은 이미 비워짐
+        if (!dependency->isDone()) {
+            dependency->m_waitingJobs.push_back({ std::move(job), signal });
+            return;
+        }
+    }
+    enqueue({ std::move(job), signal });
+}
+
+void JobSystem::wait(const JobCounter& counter) {
+    const bool isMain = isMainThread();
+
+    while (!counter.isDone()) {
+        // main thread 가 기다리는 작업이 main thread job 에 의존할 수 있으므로 함께 처리
+        if (isMain) {
+            processMainThreadJobs();
+        }
+        if (!tryRunJob()) {
+            std::this_thread::yield();
+        }
+    }
+    // 마지막으로 감소시킨 스레드가 잠금을 놓을 때까지 기다린 뒤 반환
+    std::exception_ptr exception {};
+    {
+        std::lock_guard lock(counter.m_mutex);
+        exception = std::exchange(counter.m_exception, nullptr);
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void JobSystem::parallelFor(uint32_t count, uint32_t grainSize, const RangeFunction& function) {
+    grainSize = std::max(grainSize, 1u);
+
+    if (count <= grainSize || m_workers.empty()) {
+        if (count > 0) {
+            function(0, count);
+        }
+        return;
+    }
+    JobCounter counter {};
+    // 워커에서 던진 예외는 모든 range 가 끝난 뒤 호출 스레드에서 다시 던짐
+    std::mutex exceptionMutex;
+    std::exception_ptr exception {};
+
+    auto runRange = [&](uint32_t begin, uint32_t end) {
+        try {
+            function(begin, end);
+        } catch (...) {
+            std::lock_guard lock(exceptionMutex);
+
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    };
+
+    // 첫 range 는 호출 스레드가 직접 실행
+    for (uint32_t begin = grainSize; begin < count; begin += grainSize) {
+        const uint32_t end = std::min(begin + grainSize, count);
+        run([&runRange, begin, end]() { runRange(begin, end); }, &counter);
+    }
+    runRange(0, grainSize);
+    wait(counter);
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void JobSystem::runOnMainThread(Job job, JobCounter* signal) {
+    if (signal) {
+        signal->m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard lock(m_mainThreadQueue.mutex);
+        m_mainThreadQueue.jobs.push_back({ std::move(job), signal });
+    }
+    if (m_mainThreadWakeup) {
+        m_mainThreadWakeup();
+    }
+}
+
+void JobSystem::processMainThreadJobs() {
+    std::deque<QueuedJob> jobs {};
+    {
+        std::lock_guard lock(m_mainThreadQueue.mutex);
+        jobs.swap(m_mainThreadQueue.jobs);
+    }
+    for (QueuedJob& job : jobs) {
+        execute(job);
+    }
+}
+
+bool JobSystem::isMainThread() const {
+    return std::this_thread::get_id() == m_mainThreadId;
+}
+
+void JobSystem::runWorker(uint32_t queueIndex) {
+    threadContext = { this, queueIndex };
+
+    while (!m_isStopping.load(std::memory_order_relaxed)) {
+        if (tryRunJob()) {
+            continue;
+        }
+        std::unique_lock lock(m_sleepMutex);
+        m_sleepingWorkerCount.fetch_add(1);
+        m_sleepCondition.wait(lock, [this]() {
+            return m_isStopping.load() || m_queuedJobCount.load() > 0;
+        });
+        m_sleepingWorkerCount.fetch_sub(1);
+    }
+}
+
+void JobSystem::enqueue(QueuedJob job) {
+    const uint32_t queueIndex = getQueueIndex();
+    WorkQueue& queue = queueIndex == UINT32_MAX ? m_sharedQueue : *m_queues[queueIndex];
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    m_queuedJobCount.fetch_add(1);
+
+    // 워커가 잠들기 직전에 올린 job 을 놓치지 않도록 잠금을 거쳐서 깨움
+    if (m_sleepingWorkerCount.load() > 0) {
+        { std::lock_guard lock(m_sleepMutex); }
+        m_sleepCondition.notify_one();
+    }
+}
+
+bool JobSystem::tryRunJob() {
+    if (m_queuedJobCount.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+    const uint32_t queueIndex = getQueueIndex();
+    QueuedJob job {};
+
+    auto popBack = [&](WorkQueue& queue) {
+        std::lock_guard lock(queue.mutex);
+
+        if (queue.jobs.empty()) {
+            return false;
+        }
+        job = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+        return true;
+    };
+    auto popFront = [&](WorkQueue& queue) {
+        std::lock_guard lock(queue.mutex);
+
+        if (queue.jobs.empty()) {
+            return false;
+        }
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return true;
+    };
+
+    bool hasJob = queueIndex != UINT32_MAX && popBack(*m_queues[queueIndex]);
+
+    if (!hasJob) {
+        hasJob = popFront(m_sharedQueue);
+    }
+    // 자기 deque 다음부터 돌아가며 훔침
+    const auto queueCount = static_cast<uint32_t>(m_queues.size());
+    const uint32_t start = queueIndex == UINT32_MAX ? 0 : queueIndex + 1;
+
+    for (uint32_t offset = 0; !hasJob && offset < queueCount; offset++) {
+        const uint32_t victim = (start + offset) % queueCount;
+
+        if (victim != queueIndex) {
+            hasJob = popFront(*m_queues[victim]);
+        }
+    }
+    if (!hasJob) {
+        return false;
+    }
+    m_queuedJobCount.fetch_sub(1);
+    execute(job);
+    return true;
+}
+
+void JobSystem::execute(QueuedJob& job) {
+    // 예외가 워커 밖으로 나가면 terminate 되고, signal 을 건너뛰면 wait 가 끝나지 않음
+    std::exception_ptr exception {};
+
+    try {
+        job.function();
+    } catch (...) {
+        exception = std::current_exception();
+    }
+    if (exception && !job.signal) {
+        // 다시 던질 곳이 없으므로 기록만 함
+        try {
+            std::rethrow_exception(exception);
+        } catch (const std::exception& error) {
+            std::cerr << "job failed: " << error.what() << std::endl;
+        } catch (...) {
+            std::cerr << "job failed with unknown exception" << std::endl;
+        }
+    }
+    signal(job.signal, exception);
+}
+
+void JobSystem::signal(JobCounter* counter, std::exception_ptr exception) {
+    if (!counter) {
+        return;
+    }
+    std::vector<JobCounter::WaitingJob> waitingJobs {};
+    {
+        std::lock_guard lock(counter->m_mutex);
+
+        if (exception && !counter->m_exception) {
+            counter->m_exception = std::move(exception);
+        }
+
+        if (counter->m_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            waitingJobs.swap(counter->m_waitingJobs);
+        }
+    }
+    for (JobCounter::WaitingJob& waitingJob : waitingJobs) {
+        enqueue({ std::move(waitingJob.function), waitingJob.signal });
+    }
+}
+
+uint32_t JobSystem::getQueueIndex() const {
+    return threadContext.owner == this ? threadContext.queueIndex : UINT32_MAX;
+}
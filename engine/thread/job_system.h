@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 완료되지 않은 job 수. 0 이 되면 이 counter 에 의존하는 job 이 시작됨
+// job 이 던진 예외는 첫 번째 것만 남겨 JobSystem::wait 에서 다시 던짐
+// 파괴는 JobSystem::wait 가 반환한 뒤에만 가능
+class JobCounter {
+public:
+    JobCounter() = default;
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    [[nodiscard]]
+    bool isDone() const {
+        return m_count.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+
+    struct WaitingJob {
+        std::function<void()> function;
+        JobCounter* signal;
+    };
+
+    std::atomic<uint32_t>       m_count = 0;
+    // 감소와 대기 목록 처리를 묶어서 wait 반환 후에는 다른 스레드가 접근하지 않도록 함
+    mutable std::mutex          m_mutex;
+    std::vector<WaitingJob>     m_waitingJobs;
+    // m_mutex 로 보호. wait 가 한 번 다시 던지면 비움
+    mutable std::exception_ptr  m_exception;
+};
+
+// fiber 없이 스레드마다 deque 를 두는 work-stealing job scheduler
+// 소유 스레드는 deque 뒤에서 꺼내고 (LIFO), 다른 스레드는 앞에서 훔침 (FIFO)
+// 생성한 스레드가 main thread 가 되며, GLFW 처럼 main thread 에서만 호출 가능한 작업은 runOnMainThread 로 보냄
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+    using RangeFunction = std::function<void(uint32_t begin, uint32_t end)>;
+
+    // 0 이면 hardware_concurrency - 1
+    explicit JobSystem(uint32_t workerCount = 0);
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    ~JobSystem();
+
+    // signal 은 job 이 끝나면 감소. dependency 가 있으면 0 이 될 때까지 시작을 미룸
+    void run(Job job, JobCounter* signal = nullptr, JobCounter* dependency = nullptr);
+
+    // counter 가 0 이 될 때까지 다른 job 을 대신 실행하며 대기
+    // 이 counter 를 signal 하는 job 이 예외를 던졌으면 다시 던짐
+    void wait(const JobCounter& counter);
+
+    // [0, count) 를 grainSize 크기의 range job 으로 나눠 실행하고 모두 끝나면 반환
+    void parallelFor(uint32_t count, uint32_t grainSize, const RangeFunction& function);
+
+    void runOnMainThread(Job job, JobCounter* signal = nullptr);
+
+    // main thread 가 event 대기 중일 때 깨우는 함수 (예: glfwPostEmptyEvent)
+    // 다른 스레드가 runOnMainThread 를 호출하기 전에 설정
+    void setMainThreadWakeup(std::function<void()> wakeup) {
+        m_mainThreadWakeup = std::move(wakeup);
+    }
+
+    // main thread 의 loop 에서 주기적으로 호출
+    void processMainThreadJobs();
+
+    [[nodiscard]]
+    bool isMainThread() const;
+
+    [[nodiscard]]
+    uint32_t getWorkerCount() const {
+        return static_cast<uint32_t>(m_workers.size());
+    }
+
+private:
+    struct QueuedJob {
+        Job function;
+        JobCounter* signal;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<QueuedJob> jobs;
+    };
+
+    void runWorker(uint32_t queueIndex);
+
+    void enqueue(QueuedJob job);
+    bool tryRunJob();
+    void execute(QueuedJob& job);
+    void signal(JobCounter* counter, std::exception_ptr exception = nullptr);
+
+    // pool 밖의 스레드면 UINT32_MAX
+    uint32_t getQueueIndex() const;
+
+    // 0 번은 main thread, 이후는 워커. pool 밖의 스레드는 shared queue 사용
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    WorkQueue                   m_sharedQueue;
+    WorkQueue                   m_mainThreadQueue;
+    std::thread::id             m_mainThreadId;
+    std::function<void()>       m_mainThreadWakeup;
+
+    std::atomic<uint32_t>       m_queuedJobCount = 0;
+    std::atomic<uint32_t>       m_sleepingWorkerCount = 0;
+    std::mutex                  m_sleepMutex;
+    std::condition_variable     m_sleepCondition;
+    std::atomic<bool>           m_isStopping = false;
+    std::vector<std::thread>    m_workers;
+};
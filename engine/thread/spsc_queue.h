@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+
+// 생산자 하나, 소비자 하나 전용 고정 크기 lock-free ring buffer
+// 각 쪽은 상대 index 를 캐시해 두고 가득 차거나 비었을 때만 다시 읽음
+template<typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+public:
+    // 생산자 스레드에서만 호출. 가득 차면 false
+    bool tryPush(T value) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail - m_cachedHead == Capacity) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+
+            if (tail - m_cachedHead == Capacity) {
+                return false;
+            }
+        }
+        m_slots[tail & MASK] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 소비자 스레드에서만 호출. 비어 있으면 false
+    bool tryPop(T& value) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+            if (head == m_cachedTail) {
+                return false;
+            }
+        }
+        value = std::move(m_slots[head & MASK]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]]
+    static constexpr size_t capacity() {
+        return Capacity;
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+    // 생산자와 소비자 index 가 같은 cache line 을 공유하지 않도록 분리
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail = 0;
+    size_t m_cachedHead = 0;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head = 0;
+    size_t m_cachedTail = 0;
+
+    alignas(CACHE_LINE_SIZE) std::array<T, Capacity> m_slots {};
+};
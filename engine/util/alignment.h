@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Alignments {
+
+    // alignment 는 2 의 거듭제곱
+    constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
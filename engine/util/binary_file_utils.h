@@ -19,8 +19,4 @@ struct BinaryFile {
 namespace BinaryFileUtils {
 
     BinaryFile readBinaryFile(const char* filePath);
-
-    void searchFiles(const char* path, std::vector<BinaryFile>& files);
-
-    std::vector<BinaryFile> getAllFiles();
 }
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// trivially copyable 값을 byte 배열에 이어 쓰고 읽는 helper (직렬화 포맷은 host endian)
+namespace ByteStreams {
+
+    template<typename T>
+    void write(std::vector<char>& output, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* bytes = reinterpret_cast<const char*>(&value);
+        output.insert(output.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<typename T>
+    void writeArray(std::vector<char>& output, std::span<const T> values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* bytes = reinterpret_cast<const char*>(values.data());
+        output.insert(output.end(), bytes, bytes + values.size_bytes());
+    }
+
+    // 남은 크기가 부족하면 false. 성공하면 input 을 읽은 만큼 줄임
+    template<typename T>
+    bool read(std::span<const char>& input, T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        if (input.size() < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, input.data(), sizeof(T));
+        input = input.subspan(sizeof(T));
+        return true;
+    }
+
+    template<typename T>
+    bool readArray(std::span<const char>& input, std::vector<T>& values, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        if (input.size() / sizeof(T) < count) {
+            return false;
+        }
+        values.resize(count);
+        std::memcpy(values.data(), input.data(), count * sizeof(T));
+        input = input.subspan(count * sizeof(T));
+        return true;
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// cache key 용 FNV-1a 64bit
+namespace Hashes {
+    constexpr uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ull;
+    constexpr uint64_t FNV_PRIME = 0x100000001B3ull;
+
+    inline uint64_t hashBytes(const void* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+
+        for (size_t index = 0; index < size; index++) {
+            hash ^= bytes[index];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    // padding 이 없는 trivially copyable 값만 사용
+    template<typename T>
+    uint64_t hashValue(const T& value, uint64_t hash = FNV_OFFSET_BASIS) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return hashBytes(&value, sizeof(T), hash);
+    }
+}
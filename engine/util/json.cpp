@@ -0,0 +1,240 @@
+#include "json.h"
+
+#include <charconv>
+#include <stdexcept>
+
+namespace {
+    class JsonParser {
+    public:
+        explicit JsonParser(std::string_view text) : m_text(text) {}
+
+        JsonValue parseDocument() {
+            JsonValue value = parseValue(0);
+            skipWhitespace();
+
+            if (m_position != m_text.size()) {
+                fail("trailing characters");
+            }
+            return value;
+        }
+
+    private:
+        static constexpr int MAX_DEPTH = 256;
+
+        [[noreturn]]
+        void fail(const char* reason) const {
+            throw std::runtime_error("Invalid JSON at " + std::to_string(m_position) + ": " + reason);
+        }
+
+        void skipWhitespace() {
+            while (m_position < m_text.size()) {
+                const char character = m_text[m_position];
+
+                if (character != ' ' && character != '\t' && character != '\n' && character != '\r') {
+                    break;
+                }
+                m_position++;
+            }
+        }
+
+        char peek() {
+            skipWhitespace();
+            return m_position < m_text.size() ? m_text[m_position] : '\0';
+        }
+
+        void expect(char character) {
+            if (peek() != character) {
+                fail("unexpected character");
+            }
+            m_position++;
+        }
+
+        bool consumeLiteral(std::string_view literal) {
+            if (m_text.substr(m_position, literal.size()) != literal) {
+                return false;
+            }
+            m_position += literal.size();
+            return true;
+        }
+
+        JsonValue parseValue(int depth) {
+            if (depth > MAX_DEPTH) {
+                fail("nesting too deep");
+            }
+            JsonValue value {};
+
+            switch (peek()) {
+                case '{':
+                    value.type = JsonValue::Type::OBJECT;
+                    parseObject(value, depth);
+                    break;
+                case '[':
+                    value.type = JsonValue::Type::ARRAY;
+                    parseArray(value, depth);
+                    break;
+                case '"':
+                    value.type = JsonValue::Type::STRING;
+                    value.string = parseString();
+                    break;
+                case 't':
+                case 'f':
+                    value.type = JsonValue::Type::BOOLEAN;
+                    value.boolean = consumeLiteral("true");
+
+                    if (!value.boolean && !consumeLiteral("false")) {
+                        fail("invalid literal");
+                    }
+                    break;
+                case 'n':
+                    if (!consumeLiteral("null")) {
+                        fail("invalid literal");
+                    }
+                    break;
+                default:
+                    value.type = JsonValue::Type::NUMBER;
+                    value.number = parseNumber();
+                    break;
+            }
+            return value;
+        }
+
+        void parseObject(JsonValue& value, int depth) {
+            expect('{');
+
+            if (peek() == '}') {
+                m_position++;
+                return;
+            }
+            while (true) {
+                if (peek() != '"') {
+                    fail("expected key");
+                }
+                std::string key = parseString();
+                expect(':');
+                value.object.emplace_back(std::move(key), parseValue(depth + 1));
+
+                if (peek() == ',') {
+                    m_position++;
+                    continue;
+                }
+                expect('}');
+                return;
+            }
+        }
+
+        void parseArray(JsonValue& value, int depth) {
+            expect('[');
+
+            if (peek() == ']') {
+                m_position++;
+                return;
+            }
+            while (true) {
+                value.array.push_back(parseValue(depth + 1));
+
+                if (peek() == ',') {
+                    m_position++;
+                    continue;
+                }
+                expect(']');
+                return;
+            }
+        }
+
+        double parseNumber() {
+            double number = 0.0;
+            const char* begin = m_text.data() + m_position;
+            const char* end = m_text.data() + m_text.size();
+            const auto [pointer, error] = std::from_chars(begin, end, number);
+
+            if (error != std::errc {} || pointer == begin) {
+                fail("invalid number");
+            }
+            m_position += pointer - begin;
+            return number;
+        }
+
+        std::string parseString() {
+            expect('"');
+            std::string result {};
+
+            while (m_position < m_text.size()) {
+                const char character = m_text[m_position++];
+
+                if (character == '"') {
+                    return result;
+                }
+                if (character != '\\') {
+                    result.push_back(character);
+                    continue;
+                }
+                if (m_position >= m_text.size()) {
+                    break;
+                }
+                switch (const char escape = m_text[m_position++]) {
+                    case 'b': result.push_back('\b'); break;
+                    case 'f': result.push_back('\f'); break;
+                    case 'n': result.push_back('\n'); break;
+                    case 'r': result.push_back('\r'); break;
+                    case 't': result.push_back('\t'); break;
+                    case 'u': appendCodePoint(result, parseHex4()); break;
+                    default: result.push_back(escape); break;
+                }
+            }
+            fail("unterminated string");
+        }
+
+        uint32_t parseHex4() {
+            if (m_position + 4 > m_text.size()) {
+                fail("invalid escape");
+            }
+            uint32_t codePoint = 0;
+            const auto [pointer, error] = std::from_chars(m_text.data() + m_position, m_text.data() + m_position + 4, codePoint, 16);
+
+            if (error != std::errc {} || pointer != m_text.data() + m_position + 4) {
+                fail("invalid escape");
+            }
+            m_position += 4;
+            return codePoint;
+        }
+
+        static void appendCodePoint(std::string& result, uint32_t codePoint) {
+            if (codePoint < 0x80) {
+                result.push_back(static_cast<char>(codePoint));
+            } else if (codePoint < 0x800) {
+                result.push_back(static_cast<char>(0xC0 | codePoint >> 6));
+                result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            } else {
+                result.push_back(static_cast<char>(0xE0 | codePoint >> 12));
+                result.push_back(static_cast<char>(0x80 | (codePoint >> 6 & 0x3F)));
+                result.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+        }
+
+        std::string_view m_text;
+        size_t m_position = 0;
+    };
+}
+
+const JsonValue* JsonValue::find(std::string_view key) const {
+    for (const auto& [memberKey, memberValue] : object) {
+        if (memberKey == key) {
+            return &memberValue;
+        }
+    }
+    return nullptr;
+}
+
+double JsonValue::getNumber(std::string_view key, double fallback) const {
+    const JsonValue* value = find(key);
+    return value && value->isNumber() ? value->number : fallback;
+}
+
+std::string_view JsonValue::getString(std::string_view key) const {
+    const JsonValue* value = find(key);
+    return value && value->type == Type::STRING ? std::string_view { value->string } : std::string_view {};
+}
+
+JsonValue Json::parse(std::string_view text) {
+    return JsonParser { text }.parseDocument();
+}
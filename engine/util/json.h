@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// glTF 등 설정 파일용 최소 JSON DOM (UTF-8 그대로 보존, \u 이스케이프는 BMP 만)
+struct JsonValue {
+    enum class Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+    Type type = Type::NUL;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    // object 가 아니거나 key 가 없으면 nullptr
+    [[nodiscard]]
+    const JsonValue* find(std::string_view key) const;
+
+    [[nodiscard]]
+    double getNumber(std::string_view key, double fallback) const;
+
+    [[nodiscard]]
+    std::string_view getString(std::string_view key) const;
+
+    [[nodiscard]]
+    bool isNumber() const {
+        return type == Type::NUMBER;
+    }
+
+    [[nodiscard]]
+    bool isArray() const {
+        return type == Type::ARRAY;
+    }
+
+    [[nodiscard]]
+    bool isObject() const {
+        return type == Type::OBJECT;
+    }
+};
+
+namespace Json {
+
+    JsonValue parse(std::string_view text);
+}
@@ -0,0 +1,108 @@
+#include "mapped_file.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+MappedFile MappedFile::open(const char* filePath) {
+    MappedFile mappedFile {};
+
+#if defined(_WIN32)
+    HANDLE fileHandle = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to open file: " + std::string { filePath });
+    }
+    LARGE_INTEGER fileSize {};
+    GetFileSizeEx(fileHandle, &fileSize);
+
+    HANDLE mappingHandle = fileSize.QuadPart > 0
+        ? CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr)
+        : nullptr;
+    // mapping 이 파일 handle 을 유지하므로 바로 닫아도 됨
+    CloseHandle(fileHandle);
+
+    if (!mappingHandle) {
+        throw std::runtime_error("Failed to map file: " + std::string { filePath });
+    }
+    const void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+
+    if (!view) {
+        CloseHandle(mappingHandle);
+        throw std::runtime_error("Failed to map file: " + std::string { filePath });
+    }
+    mappedFile.m_data = static_cast<const char*>(view);
+    mappedFile.m_size = static_cast<size_t>(fileSize.QuadPart);
+    mappedFile.m_mappingHandle = mappingHandle;
+#else
+    const int fileDescriptor = ::open(filePath, O_RDONLY);
+
+    if (fileDescriptor < 0) {
+        throw std::runtime_error("Failed to open file: " + std::string { filePath });
+    }
+    struct stat fileStatus {};
+    void* view = MAP_FAILED;
+
+    if (fstat(fileDescriptor, &fileStatus) == 0 && fileStatus.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    }
+    // mapping 은 fd 를 닫아도 유지됨
+    ::close(fileDescriptor);
+
+    if (view == MAP_FAILED) {
+        throw std::runtime_error("Failed to map file: " + std::string { filePath });
+    }
+    mappedFile.m_data = static_cast<const char*>(view);
+    mappedFile.m_size = static_cast<size_t>(fileStatus.st_size);
+#endif
+    return mappedFile;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)),
+      m_size(std::exchange(other.m_size, 0))
+#if defined(_WIN32)
+      , m_mappingHandle(std::exchange(other.m_mappingHandle, nullptr))
+#endif
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+#if defined(_WIN32)
+        m_mappingHandle = std::exchange(other.m_mappingHandle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+void MappedFile::close() {
+    if (!m_data) {
+        return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mappingHandle);
+    m_mappingHandle = nullptr;
+#else
+    munmap(const_cast<char*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
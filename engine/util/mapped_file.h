@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+// 읽기 전용 memory-mapped 파일. 소멸 시 unmap
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    static MappedFile open(const char* filePath);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    [[nodiscard]]
+    const char* data() const {
+        return m_data;
+    }
+
+    [[nodiscard]]
+    size_t size() const {
+        return m_size;
+    }
+
+    [[nodiscard]]
+    std::span<const char> contents() const {
+        return { m_data, m_size };
+    }
+
+    [[nodiscard]]
+    bool isOpen() const {
+        return m_data != nullptr;
+    }
+
+private:
+    void close();
+
+    const char* m_data = nullptr;
+    size_t      m_size = 0;
+#if defined(_WIN32)
+    void*       m_mappingHandle = nullptr;
+#endif
+};
@@ -1,14 +1,37 @@
 #include <exception>
 #include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
 
 #include "engine/engine.h"
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
-        const Engine engine = Engine::createEngine();
-        engine.waitEventsUntilExit();
+        const std::span<char*> args { argv, static_cast<size_t>(argc) };
+
+        // --replay <file> [repeat]: 기록한 frame 을 창 없이 다시 그리고 시간을 출력
+        if (args.size() >= 3 && std::string_view { args[1] } == "--replay") {
+            const FrameStreamReader reader { args[2] };
+            const uint32_t repeatCount = args.size() >= 4 ? static_cast<uint32_t>(std::stoul(args[3])) : 1;
+
+            Engine engine = Engine::createEngine(true);
+            const FrameReplayStats stats = engine.replay(reader, repeatCount);
+
+            std::cout << stats.frameCount << " frames in " << stats.totalMilliseconds << " ms, frame avg "
+                << stats.averageFrameMilliseconds << " ms (min " << stats.minFrameMilliseconds << ", max "
+                << stats.maxFrameMilliseconds << "), record avg " << stats.averageRecordMilliseconds << " ms" << std::endl;
+            return 0;
+        }
+        Engine engine = Engine::createEngine();
+
+        // --capture <file> <frames>: 처음 frames 개 frame 의 render 입력을 기록
+        if (args.size() >= 4 && std::string_view { args[1] } == "--capture") {
+            engine.startFrameCapture(args[2], static_cast<uint32_t>(std::stoul(args[3])));
+        }
+        engine.run();
     } catch (std::exception& ex) {
         std::cerr << ex.what() << std::endl;
         return -1;
     }
-}
\ No newline at end of file
+}
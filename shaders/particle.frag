@@ -0,0 +1,18 @@
+#version 450
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragCoord;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    // 가장자리로 갈수록 부드럽게 사라지는 원
+    float falloff = 1.0 - smoothstep(0.0, 1.0, dot(fragCoord, fragCoord));
+
+    if (falloff <= 0.0) {
+        discard;
+    }
+    // additive blend 이므로 alpha 를 미리 곱함
+    float alpha = fragColor.a * falloff;
+    outColor = vec4(fragColor.rgb * alpha, alpha);
+}
@@ -0,0 +1,50 @@
+#version 450
+
+// particle_simulate.comp 의 Particle
+struct Particle {
+    // w: size
+    vec4 position;
+    // w: age
+    vec4 velocity;
+    vec4 color;
+    float lifetime;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Particles { Particle particles[]; };
+// 이번 frame 에 살아 있는 입자. header 는 vkCmdDrawIndirect 가 읽음
+layout(std430, set = 0, binding = 1) readonly buffer AliveList {
+    uvec4 header;
+    uint indices[];
+} alive;
+
+layout(push_constant) uniform PushConstants {
+    mat4 viewProjection;
+    vec4 cameraRight;
+    vec4 cameraUp;
+};
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragCoord;
+
+// triangle 2 개로 된 billboard
+const vec2 corners[6] = vec2[](
+    vec2(-1.0, -1.0),
+    vec2(1.0, -1.0),
+    vec2(1.0, 1.0),
+    vec2(-1.0, -1.0),
+    vec2(1.0, 1.0),
+    vec2(-1.0, 1.0)
+);
+
+void main() {
+    Particle particle = particles[alive.indices[gl_InstanceIndex]];
+    vec2 corner = corners[gl_VertexIndex];
+    vec3 position = particle.position.xyz
+        + (cameraRight.xyz * corner.x + cameraUp.xyz * corner.y) * particle.position.w * 0.5;
+
+    gl_Position = viewProjection * vec4(position, 1.0);
+    // 수명이 다할수록 흐려짐
+    float fade = 1.0 - clamp(particle.velocity.w / particle.lifetime, 0.0, 1.0);
+    fragColor = vec4(particle.color.rgb, particle.color.a * fade);
+    fragCoord = corner;
+}
@@ -1,8 +1,11 @@
 #version 450
 
+// ShaderFeatures::VERTEX_COLOR. variant 마다 상수로 접혀 분기가 사라짐
+layout(constant_id = 0) const bool VERTEX_COLOR = true;
+
 layout(location = 0) in vec3 fragColor;
 layout(location = 0) out vec4 outColor;
 
 void main() {
-    outColor = vec4(fragColor, 1.0);
+    outColor = VERTEX_COLOR ? vec4(fragColor, 1.0) : vec4(1.0);
 }
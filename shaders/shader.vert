@@ -1,20 +1,32 @@
 #version 450
 
+// PackedVertex (MeshSupports::createInstancedVertexInputLayout)
+layout(location = 0) in vec4 inPosition;
+// octahedral normal
+layout(location = 1) in vec2 inNormal;
+layout(location = 2) in vec2 inUv;
+// InstanceBuffer 의 world 행렬
+layout(location = 3) in mat4 inWorld;
+
+layout(push_constant) uniform PushConstants {
+    // CullingView::viewProjection
+    mat4 viewProjection;
+};
+
 layout(location = 0) out vec3 fragColor;
 
-vec2 positions[3] = vec2[](
-    vec2(0.0, -0.5),
-    vec2(0.5, 0.5),
-    vec2(-0.5, 0.5)
-);
+// MeshCooker 의 encodeOctahedral 역변환
+vec3 decodeOctahedral(vec2 encoded) {
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
 
-vec3 colors[3] = vec3[](
-    vec3(1.0, 0.0, 0.0),
-    vec3(0.0, 1.0, 0.0),
-    vec3(0.0, 0.0, 1.0)
-);
+    if (normal.z < 0.0) {
+        normal.xy = (1.0 - abs(normal.yx)) * vec2(normal.x >= 0.0 ? 1.0 : -1.0, normal.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(normal);
+}
 
 void main() {
-    gl_Position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
-    fragColor = colors[gl_VertexIndex];
+    gl_Position = viewProjection * inWorld * vec4(inPosition.xyz, 1.0);
+    // 조명이 없으므로 world normal 을 색으로 씀
+    fragColor = normalize(mat3(inWorld) * decodeOctahedral(inNormal)) * 0.5 + 0.5;
 }
@@ -0,0 +1,13 @@
+#version 450
+
+layout(set = 0, binding = 0) uniform sampler2D atlas;
+
+layout(location = 0) in vec2 fragUv;
+layout(location = 1) in vec4 fragColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    // glyph 는 흰색 + coverage alpha 라 vertex color 가 글자색
+    outColor = texture(atlas, fragUv) * fragColor;
+}
@@ -0,0 +1,21 @@
+#version 450
+
+// SpriteVertex. position 은 framebuffer pixel
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec2 inUv;
+layout(location = 2) in vec4 inColor;
+
+layout(push_constant) uniform PushConstants {
+    // pixel -> NDC
+    vec2 scale;
+    vec2 offset;
+};
+
+layout(location = 0) out vec2 fragUv;
+layout(location = 1) out vec4 fragColor;
+
+void main() {
+    gl_Position = vec4(inPosition * scale + offset, 0.0, 1.0);
+    fragUv = inUv;
+    fragColor = inColor;
+}
@@ -0,0 +1,74 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../engine/asset/asset_pack_writer.h"
+
+std::vector<char> readFile(const std::filesystem::path& filePath) {
+    std::ifstream fileStream { filePath, std::ios::binary };
+
+    if (!fileStream.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filePath.string());
+    }
+    return { std::istreambuf_iterator<char> { fileStream }, std::istreambuf_iterator<char> {} };
+}
+
+// 사용법: AssetPacker <output.pak> [--store | --lz4 | --root <dir>] <파일 또는 디렉토리>...
+// 디렉토리는 재귀로 포함하고, 이름은 해당 디렉토리 기준 상대 경로 ('/' 구분)
+// 파일은 --root 아래에 있으면 root 기준 상대 경로, 아니면 파일 이름만 사용
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: AssetPacker <output.pak> [--store | --lz4 | --root <dir>] <path>..." << std::endl;
+        return 1;
+    }
+    AssetPackWriter writer {};
+    bool compress = false;
+    std::filesystem::path rootPath {};
+
+    try {
+        for (int index = 2; index < argc; index++) {
+            const std::string argument { argv[index] };
+
+            if (argument == "--store") {
+                compress = false;
+                continue;
+            }
+            if (argument == "--lz4") {
+                compress = true;
+                continue;
+            }
+            if (argument == "--root" && index + 1 < argc) {
+                rootPath = argv[++index];
+                continue;
+            }
+            const std::filesystem::path inputPath { argument };
+
+            if (std::filesystem::is_directory(inputPath)) {
+                for (const auto& entry : std::filesystem::recursive_directory_iterator(inputPath)) {
+                    if (!entry.is_regular_file()) {
+                        continue;
+                    }
+                    const std::string name = std::filesystem::relative(entry.path(), inputPath).generic_string();
+                    writer.add(name, readFile(entry.path()), compress);
+                }
+            } else {
+                const std::filesystem::path relativePath = rootPath.empty()
+                    ? std::filesystem::path {}
+                    : std::filesystem::relative(inputPath, rootPath);
+                const bool isUnderRoot = !relativePath.empty() && *relativePath.begin() != "..";
+
+                const std::string name = isUnderRoot ? relativePath.generic_string() : inputPath.filename().string();
+                writer.add(name, readFile(inputPath), compress);
+            }
+        }
+        writer.write(argv[1]);
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    std::cout << "Packed " << writer.size() << " assets -> " << argv[1] << std::endl;
+    return 0;
+}
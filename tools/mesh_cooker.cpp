@@ -0,0 +1,56 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "../engine/mesh/mesh_cooker.h"
+#include "../engine/mesh/mesh_importer.h"
+#include "../engine/mesh/mesh_optimizer.h"
+#include "../engine/mesh/mesh_simplifier.h"
+
+// 사용법: MeshCooker <input.obj|.gltf|.glb> <output.mesh>
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: MeshCooker <input> <output.mesh>" << std::endl;
+        return 1;
+    }
+    const std::filesystem::path inputPath { argv[1] };
+
+    try {
+        const BinaryFile binaryFile = BinaryFileUtils::readBinaryFile(argv[1]);
+
+        if (binaryFile.contents.empty()) {
+            throw std::runtime_error("Failed to read mesh: " + inputPath.string());
+        }
+        // glTF 외부 buffer 는 입력 파일 기준 상대 경로
+        const MeshImporter::BufferLoader bufferLoader = [&](std::string_view uri) {
+            const std::filesystem::path bufferPath = inputPath.parent_path() / std::filesystem::path { uri };
+            return BinaryFileUtils::readBinaryFile(bufferPath.string().c_str()).contents;
+        };
+        MeshData mesh = MeshImporter::import(binaryFile, bufferLoader);
+
+        const auto before = MeshOptimizer::analyzeVertexCache(mesh.indices, mesh.vertices.size());
+        MeshOptimizer::optimize(mesh);
+        const auto after = MeshOptimizer::analyzeVertexCache(mesh.indices, mesh.vertices.size());
+        MeshSimplifier::generateLods(mesh);
+
+        const std::vector<char> cooked = MeshCooker::cook(mesh);
+        std::ofstream fileStream { argv[2], std::ios::binary | std::ios::trunc };
+        fileStream.write(cooked.data(), static_cast<std::streamsize>(cooked.size()));
+
+        if (!fileStream) {
+            throw std::runtime_error("Failed to write mesh: " + std::string { argv[2] });
+        }
+        std::cout << inputPath.filename().string()
+            << ": " << mesh.vertices.size() << " vertices, " << mesh.lods[0].indexCount / 3 << " triangles"
+            << ", ACMR " << before.acmr << " -> " << after.acmr
+            << ", ATVR " << before.atvr << " -> " << after.atvr << std::endl;
+
+        for (size_t lod = 1; lod < mesh.lods.size(); lod++) {
+            std::cout << "  LOD " << lod << ": " << mesh.lods[lod].indexCount / 3 << " triangles, error " << mesh.lods[lod].error << std::endl;
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
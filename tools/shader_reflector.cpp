@@ -0,0 +1,33 @@
+#include <fstream>
+#include <iostream>
+
+#include "../engine/shader/spirv_reflection.h"
+#include "../engine/util/binary_file_utils.h"
+
+// 사용법: ShaderReflector <input.spv> <output.spv.refl>
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: ShaderReflector <input.spv> <output.spv.refl>" << std::endl;
+        return 1;
+    }
+    try {
+        const BinaryFile binaryFile = BinaryFileUtils::readBinaryFile(argv[1]);
+
+        if (binaryFile.contents.empty()) {
+            throw std::runtime_error("Failed to read SPIR-V: " + std::string { argv[1] });
+        }
+        const ShaderReflection reflection = SpirvReflection::reflect(binaryFile.contents);
+        const std::vector<char> serialized = SpirvReflection::serialize(reflection, binaryFile.contents);
+
+        std::ofstream fileStream { argv[2], std::ios::binary | std::ios::trunc };
+        fileStream.write(serialized.data(), static_cast<std::streamsize>(serialized.size()));
+
+        if (!fileStream) {
+            throw std::runtime_error("Failed to write reflection: " + std::string { argv[2] });
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}